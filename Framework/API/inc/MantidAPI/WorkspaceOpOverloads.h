@@ -99,6 +99,8 @@ struct MANTID_API_DLL WorkspaceHelpers {
                            const bool firstOnly = false);
   // Checks whether a the X vectors in a workspace are actually the same vector
   static bool sharedXData(const MatrixWorkspace &WS);
+  // Makes the spectra with identical X values share a single X vector
+  static size_t shareIdenticalXData(MatrixWorkspace &WS);
   // Divides the data in a workspace by the bin width to make it a distribution
   // (or the reverse)
   static void makeDistribution(MatrixWorkspace_sptr workspace,
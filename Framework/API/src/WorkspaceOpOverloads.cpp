@@ -8,6 +8,7 @@
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidHistogramData/HistogramXPool.h"
 
 #include <numeric>
 
@@ -407,6 +408,32 @@ MatrixWorkspace_sptr operator/=(const MatrixWorkspace_sptr lhs,
 // Now the WorkspaceHelpers methods
 //----------------------------------------------------------------------
 
+namespace {
+/** Checks whether two X vectors match, to within a relative tolerance of their
+ *  sums. X vectors shared between the spectra match without being compared.
+ *  @param x1 :: The first X vector
+ *  @param x2 :: The second X vector
+ *  @return True if the X vectors match
+ */
+bool matchingX(const HistogramData::HistogramX &x1,
+               const HistogramData::HistogramX &x2) {
+  if (&x1 == &x2)
+    return true;
+  const double firstSum = std::accumulate(x1.begin(), x1.end(), 0.);
+  const double secondSum = std::accumulate(x2.begin(), x2.end(), 0.);
+  if (std::abs(firstSum) < 1.0E-7 && std::abs(secondSum) < 1.0E-7) {
+    for (size_t i = 0; i < x1.size(); i++) {
+      if (std::abs(x1[i] - x2[i]) > 1.0E-7)
+        return false;
+    }
+  } else if (std::abs(firstSum - secondSum) /
+                 std::max<double>(std::abs(firstSum), std::abs(secondSum)) >
+             1.0E-7)
+    return false;
+  return true;
+}
+} // namespace
+
 /** Checks whether a workspace has common bins (or values) in X
  *  @param WS :: The workspace to check
  *  @return True if the bins match
@@ -428,6 +455,9 @@ bool WorkspaceHelpers::commonBoundaries(const MatrixWorkspace &WS) {
   const size_t numHist = WS.getNumberHistograms();
   for (size_t j = 1; j < numHist; ++j) {
     const auto &x_j = WS.x(j);
+    // Spectra sharing the X vector of the first one match it
+    if (&x_j == &x_0)
+      continue;
     // they should all have the same number of x-values
     if (x_0.size() != x_j.size())
       return false;
@@ -467,16 +497,7 @@ bool WorkspaceHelpers::matchingBins(const MatrixWorkspace &ws1,
     return false;
 
   // Now check the first spectrum
-  const double firstWS = std::accumulate(ws1.x(0).begin(), ws1.x(0).end(), 0.);
-  const double secondWS = std::accumulate(ws2.x(0).begin(), ws2.x(0).end(), 0.);
-  if (std::abs(firstWS) < 1.0E-7 && std::abs(secondWS) < 1.0E-7) {
-    for (size_t i = 0; i < ws1.x(0).size(); i++) {
-      if (std::abs(ws1.x(0)[i] - ws2.x(0)[i]) > 1.0E-7)
-        return false;
-    }
-  } else if (std::abs(firstWS - secondWS) /
-                 std::max<double>(std::abs(firstWS), std::abs(secondWS)) >
-             1.0E-7)
+  if (!matchingX(ws1.x(0), ws2.x(0)))
     return false;
 
   // If we were only asked to check the first spectrum, return now
@@ -502,19 +523,7 @@ bool WorkspaceHelpers::matchingBins(const MatrixWorkspace &ws1,
   if (!step)
     step = 1;
   for (size_t i = step; i < numHist; i += step) {
-    const double firstWSLoop =
-        std::accumulate(ws1.x(i).begin(), ws1.x(i).end(), 0.);
-    const double secondWSLoop =
-        std::accumulate(ws2.x(i).begin(), ws2.x(i).end(), 0.);
-    if (std::abs(firstWSLoop) < 1.0E-7 && std::abs(secondWSLoop) < 1.0E-7) {
-      for (size_t j = 0; j < ws1.x(i).size(); j++) {
-        if (std::abs(ws1.x(i)[j] - ws2.x(i)[j]) > 1.0E-7)
-          return false;
-      }
-    } else if (std::abs(firstWSLoop - secondWSLoop) /
-                   std::max<double>(std::abs(firstWSLoop),
-                                    std::abs(secondWSLoop)) >
-               1.0E-7)
+    if (!matchingX(ws1.x(i), ws2.x(i)))
       return false;
   }
 
@@ -532,6 +541,24 @@ bool WorkspaceHelpers::sharedXData(const MatrixWorkspace &WS) {
   return true;
 }
 
+/** Makes the spectra of a workspace with identical X values share a single X
+ *  vector, which saves the memory of the duplicates. The values are compared
+ *  exactly, so the data are unchanged.
+ *  @param WS :: The workspace to deduplicate the X vectors of
+ *  @return The number of distinct X vectors left in the workspace
+ */
+size_t WorkspaceHelpers::shareIdenticalXData(MatrixWorkspace &WS) {
+  HistogramData::HistogramXPool pool;
+  const size_t numHist = WS.getNumberHistograms();
+  for (size_t i = 0; i < numHist; ++i) {
+    const auto x = WS.sharedX(i);
+    const auto interned = pool.intern(x);
+    if (interned != x)
+      WS.setSharedX(i, interned);
+  }
+  return pool.size();
+}
+
 /** Divides the data in a workspace by the bin width to make it a distribution.
  *  Can also reverse this operation (i.e. multiply by the bin width).
  *  Sets the isDistribution() flag accordingly.
@@ -115,6 +115,41 @@ public:
     //  - for large workspaces, only 1 in 10 of the spectra are checked.
   }
 
+  void test_shareIdenticalXData() {
+    auto ws = boost::make_shared<WorkspaceTester>();
+    ws->initialize(4, 3, 2);
+    // Give every spectrum its own copy of the X values
+    for (size_t i = 0; i < 4; ++i)
+      ws->dataX(i) = {1.0, 2.0, 3.0};
+    ws->dataX(3)[2] = 4.0;
+    TS_ASSERT(!WorkspaceHelpers::sharedXData(*ws));
+    TS_ASSERT_DIFFERS(&ws->x(0), &ws->x(1));
+
+    TS_ASSERT_EQUALS(WorkspaceHelpers::shareIdenticalXData(*ws), 2);
+    TS_ASSERT_EQUALS(&ws->x(0), &ws->x(1));
+    TS_ASSERT_EQUALS(&ws->x(0), &ws->x(2));
+    TS_ASSERT_DIFFERS(&ws->x(0), &ws->x(3));
+    TS_ASSERT_EQUALS(ws->x(0)[2], 3.0);
+    TS_ASSERT_EQUALS(ws->x(3)[2], 4.0);
+
+    // Modifying a spectrum does not affect the others sharing its X
+    ws->mutableX(1)[0] = 0.5;
+    TS_ASSERT_EQUALS(ws->x(0)[0], 1.0);
+    TS_ASSERT_EQUALS(ws->x(2)[0], 1.0);
+  }
+
+  void test_matchingBins_shared_x() {
+    auto ws1 = boost::make_shared<WorkspaceTester>();
+    ws1->initialize(2, 2, 1);
+    auto ws2 = boost::make_shared<WorkspaceTester>();
+    ws2->initialize(2, 2, 1);
+    ws2->setSharedX(0, ws1->sharedX(0));
+    ws2->setSharedX(1, ws1->sharedX(1));
+    TS_ASSERT(WorkspaceHelpers::matchingBins(*ws1, *ws2));
+    ws2->mutableX(1)[0] = -2.0;
+    TS_ASSERT(!WorkspaceHelpers::matchingBins(*ws1, *ws2));
+  }
+
   void test_matchingBins_negative_sum() // Added in response to bug #7391
   {
     auto ws1 = boost::make_shared<WorkspaceTester>();
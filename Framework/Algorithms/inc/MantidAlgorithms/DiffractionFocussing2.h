@@ -2,6 +2,7 @@
 #define MANTID_ALGORITHMS_DIFFRACTIONFOCUSSING2_H_
 
 #include "MantidAPI/Algorithm.h"
+#include "MantidAPI/Progress.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/GroupingWorkspace.h"
 #include "MantidIndexing/SpectrumNumber.h"
@@ -39,6 +40,8 @@ namespace Algorithms {
  that will ensure
  preserving the number of bins in the initial workspace.
  3) All histograms are read and rebinned to the new grid for their group.
+ The events of an EventWorkspace are histogrammed directly into the new grid
+ instead, or, with PreserveEvents, merged into one TOF-sorted list per group.
  4) A new workspace with N histograms is created.
 
  Since the new X boundaries depend on the group and not the entire workspace,
@@ -108,6 +111,12 @@ private:
 
   // For events
   void execEvent();
+  bool mergeGroupEvents(const std::vector<std::size_t> &indices,
+                        DataObjects::EventList &groupEL,
+                        std::size_t numberOfPartitions) const;
+  void histogramEvents(std::vector<MantidVec> &counts,
+                       std::vector<MantidVec> &errorsSquared,
+                       API::Progress &prog);
 
   /// Loop over the workspace and determine the rebin parameters
   /// (Xmin,Xmax,step) for each group.
@@ -147,6 +156,13 @@ private:
   std::vector<Indexing::SpectrumNumber> m_validGroups;
 };
 
+/// Merge TOF-sorted event vectors into a single sorted vector, merging
+/// numberOfPartitions ranges of TOF in parallel.
+template <class T>
+DLLExport void
+mergeSortedEvents(const std::vector<const std::vector<T> *> &inputs,
+                  std::vector<T> &output, size_t numberOfPartitions);
+
 } // namespace Algorithm
 } // namespace Mantid
 
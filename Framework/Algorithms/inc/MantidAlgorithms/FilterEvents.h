@@ -103,6 +103,12 @@ private:
   /// create output workspaces in the case of using MatrixWorkspace for
   /// splitters
   void createOutputWorkspacesMatrixCase();
+  /// create an (empty) output workspace for one splitting target
+  API::MatrixWorkspace_sptr createTargetWorkspace() const;
+  /// declare the output property of a splitting target's workspace
+  void declareTargetWorkspaceProperty(const std::string &propertyname,
+                                      const std::string &wsname,
+                                      API::MatrixWorkspace_sptr ws);
 
   /// Set up detector calibration parameters
   void setupDetectorTOFCalibration();
@@ -127,6 +133,15 @@ private:
   /// Filter events by splitters in format of vector
   void filterEventsByVectorSplitters(double progressamount);
 
+  /// Get the event lists that the events of one spectrum are split into
+  std::map<int, DataObjects::EventList *>
+  getSpectrumOutputs(size_t iws,
+                     std::map<int, DataObjects::EventList> &histogramLists);
+  /// Histogram the split event lists of one spectrum into the outputs
+  void
+  histogramSpectrumOutputs(size_t iws,
+                           std::map<int, DataObjects::EventList> &histogramLists);
+
   /// Examine workspace
   void examineAndSortEventWS();
 
@@ -184,7 +199,7 @@ private:
   std::set<int> m_targetWorkspaceIndexSet;
   int m_maxTargetIndex;
   Kernel::TimeSplitterType m_splitters;
-  std::map<int, DataObjects::EventWorkspace_sptr> m_outputWorkspacesMap;
+  std::map<int, API::MatrixWorkspace_sptr> m_outputWorkspacesMap;
   std::vector<std::string> m_wsNames;
 
   std::vector<double> m_detTofOffsets;
@@ -212,6 +227,9 @@ private:
   /// Flag to group workspace
   bool m_toGroupWS;
 
+  /// Flag to histogram the split events into Workspace2D outputs
+  bool m_outputHistograms;
+
   /// Vector for splitting time
   /// FIXME - shall we convert this to DateAndTime???.  Need to do speed test!
   std::vector<int64_t> m_vecSplitterTime;
@@ -7,6 +7,7 @@
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceSingleValue.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidKernel/Timer.h"
@@ -275,6 +276,7 @@ void BinaryOperation::exec() {
   }
 
   setOutputUnits(m_lhs, m_rhs, m_out);
+  propagateSinglePrecision(*m_lhs, *m_out);
 
   // Assign the result to the output workspace property
   setProperty(outputPropName(), m_out);
@@ -488,8 +490,9 @@ void BinaryOperation::doSingleValue() {
       // there would be a data race)
       MantidVec &outY = m_out->dataY(i);
       MantidVec &outE = m_out->dataE(i);
-      performBinaryOperation(m_lhs->readX(i), m_lhs->readY(i), m_lhs->readE(i),
-                             rhsY, rhsE, outY, outE);
+      const SpectrumValues lhs(m_lhs->getSpectrum(i));
+      performBinaryOperation(m_lhs->readX(i), lhs.y(), lhs.e(), rhsY, rhsE,
+                             outY, outE);
       m_progress->report(this->name());
       PARALLEL_END_INTERUPT_REGION
     }
@@ -546,8 +549,9 @@ void BinaryOperation::doSingleColumn() {
         // L->R there would be a data race)
         MantidVec &outY = m_out->dataY(i);
         MantidVec &outE = m_out->dataE(i);
-        performBinaryOperation(m_lhs->readX(i), m_lhs->readY(i),
-                               m_lhs->readE(i), rhsY, rhsE, outY, outE);
+        const SpectrumValues lhs(m_lhs->getSpectrum(i));
+        performBinaryOperation(m_lhs->readX(i), lhs.y(), lhs.e(), rhsY, rhsE,
+                               outY, outE);
       }
       m_progress->report(this->name());
       PARALLEL_END_INTERUPT_REGION
@@ -636,8 +640,9 @@ void BinaryOperation::doSingleSpectrum() {
       // there would be a data race)
       MantidVec &outY = m_out->dataY(i);
       MantidVec &outE = m_out->dataE(i);
-      performBinaryOperation(m_lhs->readX(i), m_lhs->readY(i), m_lhs->readE(i),
-                             rhsY, rhsE, outY, outE);
+      const SpectrumValues lhs(m_lhs->getSpectrum(i));
+      performBinaryOperation(m_lhs->readX(i), lhs.y(), lhs.e(), rhsY, rhsE,
+                             outY, outE);
       m_progress->report(this->name());
       PARALLEL_END_INTERUPT_REGION
     }
@@ -769,9 +774,10 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
       // there would be a data race)
       MantidVec &outY = m_out->dataY(i);
       MantidVec &outE = m_out->dataE(i);
-      performBinaryOperation(m_lhs->readX(i), m_lhs->readY(i), m_lhs->readE(i),
-                             m_rhs->readY(rhs_wi), m_rhs->readE(rhs_wi), outY,
-                             outE);
+      const SpectrumValues lhs(m_lhs->getSpectrum(i));
+      const SpectrumValues rhs(m_rhs->getSpectrum(rhs_wi));
+      performBinaryOperation(m_lhs->readX(i), lhs.y(), lhs.e(), rhs.y(),
+                             rhs.e(), outY, outE);
 
       // Free up memory on the RHS if that is possible
       if (m_ClearRHSWorkspace)
@@ -237,6 +237,11 @@ ConvertUnits::executeUnitConversion(const API::MatrixWorkspace_sptr inputWS) {
     this->putBackBinWidth(outputWS);
   }
 
+  // Spectra converted one by one get their own X vectors, share those that
+  // came out identical, e.g. for detectors at the same position
+  if (!m_inputEvents && !WorkspaceHelpers::sharedXData(*outputWS))
+    WorkspaceHelpers::shareIdenticalXData(*outputWS);
+
   return outputWS;
 }
 /** Initialise the member variables
@@ -551,12 +556,12 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
 
-      // TODO toTOF and fromTOF need to be reimplemented outside of kernel
-      localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                           emode, efixed, delta);
-      // Convert from time-of-flight to the desired unit
-      localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                               emode, efixed, delta);
+      localFromUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      localOutputUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      // Convert to the desired unit, directly or via time-of-flight
+      auto &xValues = outputWS->dataX(i);
+      localFromUnit->convertTo(*localOutputUnit, xValues.data(),
+                               xValues.data(), xValues.size());
 
       // EventWorkspace part, modifying the EventLists.
       if (m_inputEvents) {
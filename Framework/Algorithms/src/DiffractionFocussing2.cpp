@@ -7,6 +7,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventHistogrammer.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/GroupingWorkspace.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
@@ -15,6 +16,7 @@
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <iterator>
 #include <numeric>
@@ -24,11 +26,205 @@ using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 using std::vector;
 using Mantid::HistogramData::BinEdges;
+using Mantid::Types::Event::TofEvent;
 
 namespace Mantid {
 
 namespace Algorithms {
 
+namespace {
+/// Events of a sorted input list, from index begin up to end
+struct EventRange {
+  size_t input;
+  size_t begin;
+  size_t end;
+};
+
+/// The next event of a range to merge, ordered by TOF
+struct MergeCursor {
+  double tof;
+  EventRange range;
+  bool operator>(const MergeCursor &other) const { return tof > other.tof; }
+};
+
+/** Merge ranges of TOF-sorted event vectors into a sorted output, taking the
+ * event of lowest TOF among the ranges with a heap.
+ * @param inputs :: the sorted event vectors
+ * @param ranges :: the ranges of the vectors to merge
+ * @param output :: where the merged events are written
+ */
+template <class T>
+void mergeRanges(const std::vector<const std::vector<T> *> &inputs,
+                 const std::vector<EventRange> &ranges, T *output) {
+  std::vector<MergeCursor> heap;
+  heap.reserve(ranges.size());
+  for (const auto &range : ranges)
+    heap.push_back({(*inputs[range.input])[range.begin].tof(), range});
+  std::make_heap(heap.begin(), heap.end(), std::greater<MergeCursor>());
+  while (heap.size() > 1) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<MergeCursor>());
+    auto &cursor = heap.back();
+    const auto &events = *inputs[cursor.range.input];
+    *output++ = events[cursor.range.begin++];
+    if (cursor.range.begin < cursor.range.end) {
+      cursor.tof = events[cursor.range.begin].tof();
+      std::push_heap(heap.begin(), heap.end(), std::greater<MergeCursor>());
+    } else {
+      heap.pop_back();
+    }
+  }
+  // The rest of the last range is already sorted
+  if (!heap.empty()) {
+    const auto &range = heap.front().range;
+    const auto &events = *inputs[range.input];
+    std::copy(events.begin() + range.begin, events.begin() + range.end,
+              output);
+  }
+}
+} // namespace
+
+/** Merge TOF-sorted event vectors into a single sorted vector.
+ *
+ * The TOF range is split into partitions at quantiles of a regular sample of
+ * the events, and the partitions are merged in parallel, each into its own
+ * part of the output.
+ * @param inputs :: the sorted event vectors
+ * @param output :: the merged events
+ * @param numberOfPartitions :: the number of partitions to merge in parallel
+ */
+template <class T>
+void mergeSortedEvents(const std::vector<const std::vector<T> *> &inputs,
+                       std::vector<T> &output, size_t numberOfPartitions) {
+  size_t total = 0;
+  for (const auto input : inputs)
+    total += input->size();
+  output.resize(total);
+  if (total == 0)
+    return;
+  std::vector<EventRange> all;
+  for (size_t i = 0; i < inputs.size(); ++i)
+    if (!inputs[i]->empty())
+      all.push_back({i, 0, inputs[i]->size()});
+  if (numberOfPartitions <= 1) {
+    mergeRanges(inputs, all, output.data());
+    return;
+  }
+
+  // Sample every stride-th event of the concatenated inputs
+  const size_t stride = std::max(total / (256 * numberOfPartitions), size_t(1));
+  std::vector<double> samples;
+  size_t position = 0;
+  for (const auto input : inputs) {
+    for (size_t i = (stride - position % stride) % stride; i < input->size();
+         i += stride)
+      samples.push_back((*input)[i].tof());
+    position += input->size();
+  }
+  std::sort(samples.begin(), samples.end());
+  std::vector<double> splitters;
+  for (size_t p = 1; p < numberOfPartitions; ++p)
+    splitters.push_back(samples[p * samples.size() / numberOfPartitions]);
+
+  // Partition p holds the events from splitters[p - 1] up to splitters[p]
+  const auto lowerBound = [](const std::vector<T> &events, const double tof) {
+    return static_cast<size_t>(
+        std::lower_bound(events.begin(), events.end(), tof,
+                         [](const T &event, const double value) {
+                           return event.tof() < value;
+                         }) -
+        events.begin());
+  };
+  const auto nPartitions = static_cast<int>(numberOfPartitions);
+  std::vector<std::vector<EventRange>> ranges(numberOfPartitions);
+  std::vector<size_t> offsets(numberOfPartitions + 1, 0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int p = 0; p < nPartitions; ++p) {
+    for (const auto &range : all) {
+      const auto &events = *inputs[range.input];
+      const size_t begin = p == 0 ? 0 : lowerBound(events, splitters[p - 1]);
+      const size_t end = p + 1 == nPartitions ? events.size()
+                                              : lowerBound(events, splitters[p]);
+      if (begin < end) {
+        ranges[p].push_back({range.input, begin, end});
+        offsets[p + 1] += end - begin;
+      }
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int p = 0; p < nPartitions; ++p)
+    mergeRanges(inputs, ranges[p], output.data() + offsets[p]);
+}
+
+template DLLExport void
+mergeSortedEvents(const std::vector<const std::vector<TofEvent> *> &,
+                  std::vector<TofEvent> &, size_t);
+template DLLExport void
+mergeSortedEvents(const std::vector<const std::vector<WeightedEvent> *> &,
+                  std::vector<WeightedEvent> &, size_t);
+template DLLExport void
+mergeSortedEvents(const std::vector<const std::vector<WeightedEventNoTime> *> &,
+                  std::vector<WeightedEventNoTime> &, size_t);
+
+namespace {
+/// Merge the sorted events of the given spectra into an event list
+template <class T>
+void mergeSortedSpectra(const EventWorkspace &workspace,
+                       const std::vector<size_t> &indices, EventList &output,
+                       size_t numberOfPartitions) {
+  std::vector<const std::vector<T> *> inputs;
+  inputs.reserve(indices.size());
+  for (const auto wi : indices) {
+    const std::vector<T> *events;
+    getEventsFrom(workspace.getSpectrum(wi), events);
+    inputs.push_back(events);
+  }
+  std::vector<T> *events;
+  getEventsFrom(output, events);
+  mergeSortedEvents(inputs, *events, numberOfPartitions);
+}
+
+/// Per-thread partial histograms of the events of a group
+struct PartialHistogram {
+  /// Number of unweighted events, whose errors squared are the counts
+  MantidVec counts;
+  /// Weights of the weighted events
+  MantidVec weights;
+  /// Squared errors of the weighted events
+  MantidVec errorsSquared;
+
+  void addEvents(const EventList &el, const EventHistogrammer &histogrammer) {
+    if (counts.empty()) {
+      const size_t numberOfBins = histogrammer.numberOfBins();
+      counts.assign(numberOfBins, 0.0);
+      weights.assign(numberOfBins, 0.0);
+      errorsSquared.assign(numberOfBins, 0.0);
+    }
+    switch (el.getEventType()) {
+    case API::TOF:
+      histogrammer.countEvents(el.getEvents(), counts);
+      break;
+    case API::WEIGHTED:
+      histogrammer.addWeights(el.getWeightedEvents(), weights, errorsSquared);
+      break;
+    case API::WEIGHTED_NOTIME:
+      histogrammer.addWeights(el.getWeightedEventsNoTime(), weights,
+                              errorsSquared);
+      break;
+    }
+  }
+
+  /// Add the partial histogram to the total counts and squared errors
+  void addTo(MantidVec &Y, MantidVec &E) const {
+    for (size_t i = 0; i < counts.size(); ++i) {
+      Y[i] += counts[i] + weights[i];
+      E[i] += counts[i] + errorsSquared[i];
+    }
+  }
+};
+} // namespace
+
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
@@ -148,7 +344,6 @@ void DiffractionFocussing2::exec() {
       return;
     } else {
       // get the full d-spacing range
-      m_eventW->sortAll(DataObjects::TOF_SORT, nullptr);
       m_matrixInputW->getXMinMax(eventXMin, eventXMax);
     }
   }
@@ -171,7 +366,15 @@ void DiffractionFocussing2::exec() {
   // is irrelevant
   MantidVec weights_default(1, 1.0), emptyVec(1, 0.0), EOutDummy(nPoints);
 
-  Progress prog(this, 0.2, 1.0, static_cast<int>(totalHistProcess) + nGroups);
+  const int progressSteps =
+      static_cast<int>(totalHistProcess) * (m_eventW ? 2 : 1) +
+      static_cast<int>(nGroups);
+  Progress prog(this, 0.2, 1.0, progressSteps);
+
+  // The events are histogrammed directly into the bins of their group
+  std::vector<MantidVec> eventCounts, eventErrorsSquared;
+  if (m_eventW)
+    histogramEvents(eventCounts, eventErrorsSquared, prog);
 
   PARALLEL_FOR_IF(Kernel::threadSafe(*m_matrixInputW, *out))
   for (int outWorkspaceIndex = 0;
@@ -195,11 +398,18 @@ void DiffractionFocussing2::exec() {
     // TODO can only be changed once rebin implemented in HistogramData
     auto &Yout = outSpec.dataY();
     auto &Eout = outSpec.dataE();
+    if (m_eventW) {
+      Yout = std::move(eventCounts[outWorkspaceIndex]);
+      Eout = std::move(eventErrorsSquared[outWorkspaceIndex]);
+    }
 
     // Initialize the group's weight vector here and the dummy vector used for
     // accumulating errors.
     MantidVec groupWgt(nPoints, 0.0);
 
+    // Number of spectra covering the full range of the events
+    size_t fullRangeSpectra = 0;
+
     // loop through the contributing histograms
     const std::vector<size_t> &indices = m_wsIndices[outWorkspaceIndex];
     const size_t groupSize = indices.size();
@@ -207,23 +417,25 @@ void DiffractionFocussing2::exec() {
       size_t inWorkspaceIndex = indices[i];
       // This is the input spectrum
       const auto &inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
-      // Get reference to its old X,Y,and E.
+      // Get reference to its old X
       auto &Xin = inSpec.x();
-      auto &Yin = inSpec.y();
-      auto &Ein = inSpec.e();
       outSpec.addDetectorIDs(inSpec.getDetectorIDs());
 
-      try {
-        // TODO This should be implemented in Histogram as rebin
-        Mantid::Kernel::VectorHelper::rebinHistogram(
-            Xin.rawData(), Yin.rawData(), Ein.rawData(), Xout.rawData(), Yout,
-            Eout, true);
-      } catch (...) {
-        // Should never happen because Xout is constructed to envelop all of the
-        // Xin vectors
-        std::ostringstream mess;
-        mess << "Error in rebinning process for spectrum:" << inWorkspaceIndex;
-        throw std::runtime_error(mess.str());
+      // The events have been histogrammed already
+      if (!m_eventW) {
+        try {
+          // TODO This should be implemented in Histogram as rebin
+          Mantid::Kernel::VectorHelper::rebinHistogram(
+              Xin.rawData(), inSpec.y().rawData(), inSpec.e().rawData(),
+              Xout.rawData(), Yout, Eout, true);
+        } catch (...) {
+          // Should never happen because Xout is constructed to envelop all of
+          // the Xin vectors
+          std::ostringstream mess;
+          mess << "Error in rebinning process for spectrum:"
+               << inWorkspaceIndex;
+          throw std::runtime_error(mess.str());
+        }
       }
 
       // Check for masked bins in this spectrum
@@ -261,20 +473,15 @@ void DiffractionFocussing2::exec() {
         // Rebin the weights - note that this is a distribution
         VectorHelper::rebin(weight_bins, weights, zeroes, Xout.rawData(),
                             groupWgt, EOutDummy, true, true);
+      } else if (eventXMin > 0. && eventXMax > 0.) {
+        // The weights of these spectra are all the same, added once below
+        ++fullRangeSpectra;
       } else // If no masked bins we want to add 1 to the weight of the output
              // bins that this input covers
       {
         // Initialized within the loop to avoid having to wrap writing to it
         // with a PARALLEL_CRITICAL sections
-        MantidVec limits(2);
-
-        if (eventXMin > 0. && eventXMax > 0.) {
-          limits[0] = eventXMin;
-          limits[1] = eventXMax;
-        } else {
-          limits[0] = Xin.front();
-          limits[1] = Xin.back();
-        }
+        const MantidVec limits{Xin.front(), Xin.back()};
 
         // Rebin the weights - note that this is a distribution
         VectorHelper::rebin(limits, weights_default, emptyVec, Xout.rawData(),
@@ -283,6 +490,20 @@ void DiffractionFocussing2::exec() {
       prog.report();
     } // end of loop for input spectra
 
+    if (fullRangeSpectra > 0) {
+      const MantidVec limits{eventXMin, eventXMax};
+      MantidVec spectrumWgt(nPoints, 0.0);
+      // Rebin the weights - note that this is a distribution
+      VectorHelper::rebin(limits, weights_default, emptyVec, Xout.rawData(),
+                          spectrumWgt, EOutDummy, true, true);
+      const auto numberOfSpectra = static_cast<double>(fullRangeSpectra);
+      std::transform(groupWgt.begin(), groupWgt.end(), spectrumWgt.begin(),
+                     groupWgt.begin(),
+                     [numberOfSpectra](const double total, const double wgt) {
+                       return total + numberOfSpectra * wgt;
+                     });
+    }
+
     // Calculate the bin widths
     std::vector<double> widths(Xout.size());
     std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
@@ -378,71 +599,45 @@ void DiffractionFocussing2::execEvent() {
   prog.reset();
   prog = make_unique<Progress>(this, 0.3, 0.9, totalHistProcess);
 
-  if (this->m_validGroups.size() == 1) {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList &groupEL = out->getSpectrum(0);
-    const std::vector<size_t> &indices = this->m_wsIndices[0];
-
-    int chunkSize = 200;
-
-    int end = (totalHistProcess / chunkSize) + 1;
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk = 0; wiChunk < end; wiChunk++) {
-      PARALLEL_START_INTERUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk + 1) * chunkSize;
-      if (max > totalHistProcess)
-        max = totalHistProcess;
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      // chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i = wiChunk * chunkSize; i < max; i++) {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getSpectrum(wi);
-      }
-
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL(DiffractionFocussing2_JoinChunks) {
-        groupEL += chunkEL;
-      }
-
-      PARALLEL_END_INTERUPT_REGION
+  // The inputs are merged into TOF-sorted groups rather than appended
+  m_eventW->sortAll(DataObjects::TOF_SORT, nullptr);
+  auto inputW = boost::const_pointer_cast<EventWorkspace>(m_eventW);
+
+  const int nValidGroups = static_cast<int>(this->m_validGroups.size());
+  const auto nThreads = static_cast<int>(PARALLEL_GET_MAX_THREADS);
+  // Merge each group on its own thread if there are enough of them, else
+  // split the merge of each group across the threads
+  const bool parallelByGroups = nValidGroups >= nThreads;
+  if (!parallelByGroups)
+    g_log.information() << "Performing focussing on " << nValidGroups
+                        << " group(s) in parallel partitions\n";
+
+  PARALLEL_FOR_IF(parallelByGroups && Kernel::threadSafe(*m_eventW))
+  for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
+    PARALLEL_START_INTERUPT_REGION
+    const std::vector<size_t> &indices = this->m_wsIndices[iGroup];
+    EventList &groupEL = out->getSpectrum(iGroup);
+    // Splitting small groups is not worth the overhead
+    const size_t numberOfPartitions =
+        !parallelByGroups && size_required[iGroup] >= 65536
+            ? static_cast<size_t>(4 * nThreads)
+            : 1;
+    if (!mergeGroupEvents(indices, groupEL, numberOfPartitions)) {
+      // Mixed event types, append the lists one by one
+      for (auto wi : indices)
+        groupEL += m_eventW->getSpectrum(wi);
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } else {
-    // ------ PARALLELIZE BY GROUPS -------------------------
+    prog->reportIncrement(static_cast<int>(indices.size()), "Merging Lists");
 
-    int nValidGroups = static_cast<int>(this->m_validGroups.size());
-    PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
-    for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
-      PARALLEL_START_INTERUPT_REGION
-      const std::vector<size_t> &indices = this->m_wsIndices[iGroup];
-      for (auto wi : indices) {
-        // In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getSpectrum(iGroup) += m_eventW->getSpectrum(wi);
-
-        prog->reportIncrement(1, "Appending Lists");
-
-        // When focussing in place, you can clear out old memory from the input
-        // one!
-        if (inPlace) {
-          boost::const_pointer_cast<EventWorkspace>(m_eventW)
-              ->getSpectrum(wi)
-              .clear();
-        }
-      }
-      PARALLEL_END_INTERUPT_REGION
+    // When focussing in place, you can clear out old memory from the input
+    // one!
+    if (inPlace) {
+      for (auto wi : indices)
+        inputW->getSpectrum(wi).clear();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } // (done with parallel by groups)
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
 
   // Now that the data is cleaned up, go through it and set the X vectors to the
   // input workspace we first talked about.
@@ -479,6 +674,111 @@ void DiffractionFocussing2::execEvent() {
   setProperty("OutputWorkspace", std::move(out));
 }
 
+//=============================================================================
+/** Histogram the events of each group directly into the bins of the group,
+ * without histogramming each spectrum on its own bins first.
+ *
+ * If there are fewer groups than threads, the spectra of all the groups are
+ * shared out among the threads, which histogram into partial histograms of
+ * their own that are added up at the end.
+ * @param counts :: the counts of each valid group
+ * @param errorsSquared :: the squared errors of each valid group
+ * @param prog :: reports once per input spectrum
+ */
+void DiffractionFocussing2::histogramEvents(
+    std::vector<MantidVec> &counts, std::vector<MantidVec> &errorsSquared,
+    Progress &prog) {
+  const size_t nValidGroups = m_validGroups.size();
+  counts.resize(nValidGroups);
+  errorsSquared.resize(nValidGroups);
+  std::vector<EventHistogrammer> histogrammers;
+  histogrammers.reserve(nValidGroups);
+  for (size_t iGroup = 0; iGroup < nValidGroups; ++iGroup) {
+    counts[iGroup].assign(nPoints, 0.0);
+    errorsSquared[iGroup].assign(nPoints, 0.0);
+    const int group = static_cast<int>(m_validGroups[iGroup]);
+    histogrammers.emplace_back(group2xvector.at(group).rawData());
+  }
+
+  const auto nThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  if (nValidGroups >= nThreads) {
+    PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
+    for (int iGroup = 0; iGroup < static_cast<int>(nValidGroups); ++iGroup) {
+      PARALLEL_START_INTERUPT_REGION
+      PartialHistogram partial;
+      for (const auto wi : m_wsIndices[iGroup]) {
+        partial.addEvents(m_eventW->getSpectrum(wi), histogrammers[iGroup]);
+        prog.report();
+      }
+      partial.addTo(counts[iGroup], errorsSquared[iGroup]);
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+    return;
+  }
+
+  // Flatten the (group, spectrum) pairs to share them out among the threads
+  std::vector<std::pair<size_t, size_t>> work;
+  for (size_t iGroup = 0; iGroup < nValidGroups; ++iGroup)
+    for (const auto wi : m_wsIndices[iGroup])
+      work.emplace_back(iGroup, wi);
+
+  std::vector<std::vector<PartialHistogram>> partials(
+      nThreads, std::vector<PartialHistogram>(nValidGroups));
+  PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
+  for (int i = 0; i < static_cast<int>(work.size()); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t iGroup = work[i].first;
+    auto &partial = partials[PARALLEL_THREAD_NUMBER][iGroup];
+    partial.addEvents(m_eventW->getSpectrum(work[i].second),
+                      histogrammers[iGroup]);
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  for (const auto &threadPartials : partials)
+    for (size_t iGroup = 0; iGroup < nValidGroups; ++iGroup)
+      threadPartials[iGroup].addTo(counts[iGroup], errorsSquared[iGroup]);
+}
+
+//=============================================================================
+/** Merge the TOF-sorted events of the spectra of a group into a single sorted
+ * list, instead of appending and sorting them again.
+ * @param indices :: the workspace indices of the spectra of the group
+ * @param groupEL :: the empty output list, switched to the input event type
+ * @param numberOfPartitions :: the number of parallel partitions of the merge
+ * @return false, leaving groupEL untouched, if some spectra have events of
+ * another type than groupEL
+ */
+bool DiffractionFocussing2::mergeGroupEvents(
+    const std::vector<size_t> &indices, EventList &groupEL,
+    size_t numberOfPartitions) const {
+  const auto eventType = groupEL.getEventType();
+  for (const auto wi : indices)
+    if (m_eventW->getSpectrum(wi).getEventType() != eventType)
+      return false;
+
+  switch (eventType) {
+  case API::TOF:
+    mergeSortedSpectra<TofEvent>(*m_eventW, indices, groupEL,
+                                 numberOfPartitions);
+    break;
+  case API::WEIGHTED:
+    mergeSortedSpectra<WeightedEvent>(*m_eventW, indices, groupEL,
+                                      numberOfPartitions);
+    break;
+  case API::WEIGHTED_NOTIME:
+    mergeSortedSpectra<WeightedEventNoTime>(*m_eventW, indices, groupEL,
+                                            numberOfPartitions);
+    break;
+  }
+  groupEL.setSortOrder(DataObjects::TOF_SORT);
+  for (const auto wi : indices)
+    groupEL.addDetectorIDs(m_eventW->getSpectrum(wi).getDetectorIDs());
+  return true;
+}
+
 //=============================================================================
 /** Verify that all the contributing detectors to a spectrum belongs to the same
  * group
@@ -142,6 +142,9 @@ void ExtractSpectra::execHistogram() {
     propagateBinMasking(*m_inputWorkspace, i);
     prog.report();
   }
+  // Slicing gives every spectrum its own X, share the identical ones again
+  if (m_commonBoundaries)
+    WorkspaceHelpers::shareIdenticalXData(*m_inputWorkspace);
 }
 
 namespace { // anonymous namespace
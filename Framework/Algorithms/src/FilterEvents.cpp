@@ -12,6 +12,7 @@
 #include "MantidAlgorithms/TimeAtSampleStrategyIndirect.h"
 #include "MantidDataObjects/SplittersWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ArrayProperty.h"
@@ -58,6 +59,7 @@ FilterEvents::FilterEvents()
       m_wsNames(), m_detTofOffsets(), m_detTofFactors(),
       m_filterByPulseTime(false), m_informationWS(), m_hasInfoWS(),
       m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false),
+      m_outputHistograms(false),
       m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
       m_useDBSpectrum(false), m_dbWSIndex(-1), m_tofCorrType(),
       m_specSkipType(), m_vecSkip(), m_isSplittersRelativeTime(false),
@@ -101,6 +103,12 @@ void FilterEvents::init() {
                   "If selected, the minimum output workspace is indexed from 1 "
                   "and continuous. ");
 
+  declareProperty("OutputHistograms", false,
+                  "If selected, the events of each splitting target are "
+                  "histogrammed with the binning of the input workspace "
+                  "directly into an output Workspace2D.  No EventWorkspace is "
+                  "created for the targets. ");
+
   // TOF correction
   vector<string> corrtypes{"None", "Customized", "Direct", "Elastic",
                            "Indirect"};
@@ -271,7 +279,7 @@ void FilterEvents::exec() {
 
   // Form the names of output workspaces
   std::vector<std::string> outputwsnames;
-  std::map<int, DataObjects::EventWorkspace_sptr>::iterator miter;
+  std::map<int, API::MatrixWorkspace_sptr>::iterator miter;
   for (miter = m_outputWorkspacesMap.begin();
        miter != m_outputWorkspacesMap.end(); ++miter) {
     outputwsnames.push_back(miter->second->getName());
@@ -392,6 +400,7 @@ void FilterEvents::processAlgorithmProperties() {
   m_filterByPulseTime = this->getProperty("FilterByPulseTime");
 
   m_toGroupWS = this->getProperty("GroupWorkspaces");
+  m_outputHistograms = this->getProperty("OutputHistograms");
 
   if (m_toGroupWS && (m_outputWSNameBase == m_eventWS->getName())) {
     std::stringstream errss;
@@ -594,7 +603,7 @@ void FilterEvents::copyNoneSplitLogs(
     } else {
       // non time series properties
       // single value property: copy to the new workspace
-      std::map<int, DataObjects::EventWorkspace_sptr>::iterator ws_iter;
+      std::map<int, API::MatrixWorkspace_sptr>::iterator ws_iter;
       for (ws_iter = m_outputWorkspacesMap.begin();
            ws_iter != m_outputWorkspacesMap.end(); ++ws_iter) {
 
@@ -673,13 +682,13 @@ void FilterEvents::splitTimeSeriesLogs(
   // integrate proton charge
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
     // find output workspace
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
+    std::map<int, API::MatrixWorkspace_sptr>::iterator wsiter;
     wsiter = m_outputWorkspacesMap.find(tindex);
     if (wsiter == m_outputWorkspacesMap.end()) {
       g_log.information() << "Workspace target (indexed as " << tindex
                           << ") does not have workspace associated.\n";
     } else {
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
+      API::MatrixWorkspace_sptr ws_i = wsiter->second;
       ws_i->mutableRun().integrateProtonCharge();
     }
   }
@@ -720,7 +729,7 @@ void FilterEvents::splitTimeSeriesProperty(
   // assign to output workspaces
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
     // find output workspace
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
+    std::map<int, API::MatrixWorkspace_sptr>::iterator wsiter;
     wsiter = m_outputWorkspacesMap.find(tindex);
     if (wsiter == m_outputWorkspacesMap.end()) {
       // unable to find workspace associated with target index
@@ -729,7 +738,7 @@ void FilterEvents::splitTimeSeriesProperty(
                           << "\n";
     } else {
       // add property to the associated workspace
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
+      API::MatrixWorkspace_sptr ws_i = wsiter->second;
       ws_i->mutableRun().addProperty(output_vector[tindex], true);
     }
   }
@@ -1085,10 +1094,7 @@ void FilterEvents::createOutputWorkspaces() {
         add2output = false;
     }
 
-    boost::shared_ptr<EventWorkspace> optws =
-        create<EventWorkspace>(*m_eventWS);
-    // Clear Run without copying first.
-    optws->setSharedRun(Kernel::make_cow<Run>());
+    API::MatrixWorkspace_sptr optws = createTargetWorkspace();
     m_outputWorkspacesMap.emplace(wsgroup, optws);
 
     // Add information, including title and comment, to output workspace
@@ -1127,20 +1133,14 @@ void FilterEvents::createOutputWorkspaces() {
       AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
 
       // create these output properties
-      if (!this->m_toGroupWS) {
-        declareProperty(
-            Kernel::make_unique<
-                API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-                propertynamess.str(), wsname.str(), Direction::Output),
-            "Output");
-        setProperty(propertynamess.str(), optws);
-      }
+      if (!this->m_toGroupWS)
+        declareTargetWorkspaceProperty(propertynamess.str(), wsname.str(),
+                                       optws);
 
       ++numoutputws;
       g_log.debug() << "Created output Workspace of group = " << wsgroup
                     << "  Property Name = " << propertynamess.str()
                     << " Workspace name = " << wsname.str()
-                    << " with Number of events = " << optws->getNumberEvents()
                     << "\n";
 
       // Update progress report
@@ -1197,10 +1197,7 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
 
     // create new workspace from input EventWorkspace and all the sample logs
     // are copied to the new one
-    boost::shared_ptr<EventWorkspace> optws =
-        create<EventWorkspace>(*m_eventWS);
-    // Clear Run without copying first.
-    optws->setSharedRun(Kernel::make_cow<Run>());
+    API::MatrixWorkspace_sptr optws = createTargetWorkspace();
     m_outputWorkspacesMap.emplace(wsgroup, optws);
 
     // TODO/ISSUE/NOW - How about comment and info similar to
@@ -1219,18 +1216,12 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
     AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
 
     g_log.debug() << "Created output Workspace of group = " << wsgroup
-                  << " Workspace name = " << wsname.str()
-                  << " with Number of events = " << optws->getNumberEvents()
-                  << "\n";
+                  << " Workspace name = " << wsname.str() << "\n";
 
     // Set (property) to output workspace and set to ADS
     if (m_toGroupWS) {
-      declareProperty(
-          Kernel::make_unique<
-              API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-              propertynamess.str(), wsname.str(), Direction::Output),
-          "Output");
-      setProperty(propertynamess.str(), optws);
+      declareTargetWorkspaceProperty(propertynamess.str(), wsname.str(),
+                                     optws);
 
       g_log.debug() << "  Property Name = " << propertynamess.str() << "\n";
     } else {
@@ -1289,10 +1280,7 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
     }
 
     // create new workspace
-    boost::shared_ptr<EventWorkspace> optws =
-        create<EventWorkspace>(*m_eventWS);
-    // Clear Run without copying first.
-    optws->setSharedRun(Kernel::make_cow<Run>());
+    API::MatrixWorkspace_sptr optws = createTargetWorkspace();
     m_outputWorkspacesMap.emplace(wsgroup, optws);
 
     // TODO/NOW/ISSUE -- How about comment and info?
@@ -1306,9 +1294,7 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
     AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
 
     g_log.debug() << "Created output Workspace of group = " << wsgroup
-                  << " Workspace name = " << wsname.str()
-                  << " with Number of events = " << optws->getNumberEvents()
-                  << "\n";
+                  << " Workspace name = " << wsname.str() << "\n";
 
     if (this->m_toGroupWS) {
       std::stringstream propertynamess;
@@ -1317,12 +1303,8 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
       } else {
         propertynamess << "OutputWorkspace_" << wsgroup;
       }
-      declareProperty(
-          Kernel::make_unique<
-              API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-              propertynamess.str(), wsname.str(), Direction::Output),
-          "Output");
-      setProperty(propertynamess.str(), optws);
+      declareTargetWorkspaceProperty(propertynamess.str(), wsname.str(),
+                                     optws);
 
       g_log.debug() << "  Property Name = " << propertynamess.str() << "\n";
     } else {
@@ -1344,6 +1326,49 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Create the output workspace of one splitting target.  It is an
+ * EventWorkspace, or a Workspace2D with the binning of the input workspace if
+ * the split events are to be histogrammed.  The Run is not copied.
+ * @brief FilterEvents::createTargetWorkspace
+ * @return the new, empty, workspace
+ */
+API::MatrixWorkspace_sptr FilterEvents::createTargetWorkspace() const {
+  API::MatrixWorkspace_sptr optws;
+  if (m_outputHistograms)
+    optws = create<Workspace2D>(*m_eventWS);
+  else
+    optws = create<EventWorkspace>(*m_eventWS);
+  // Clear Run without copying first.
+  optws->setSharedRun(Kernel::make_cow<Run>());
+  return optws;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Declare and set the output property of a splitting target's workspace
+ * @brief FilterEvents::declareTargetWorkspaceProperty
+ * @param propertyname :: name of the output property
+ * @param wsname :: name of the output workspace
+ * @param ws :: the output workspace
+ */
+void FilterEvents::declareTargetWorkspaceProperty(
+    const std::string &propertyname, const std::string &wsname,
+    API::MatrixWorkspace_sptr ws) {
+  if (m_outputHistograms) {
+    declareProperty(Kernel::make_unique<API::WorkspaceProperty<>>(
+                        propertyname, wsname, Direction::Output),
+                    "Output");
+    setProperty(propertyname, ws);
+  } else {
+    declareProperty(
+        Kernel::make_unique<
+            API::WorkspaceProperty<DataObjects::EventWorkspace>>(
+            propertyname, wsname, Direction::Output),
+        "Output");
+    setProperty(propertyname, boost::static_pointer_cast<EventWorkspace>(ws));
+  }
+}
+
 /** Set up neutron event's TOF correction.
   * It can be (1) parsed from TOF-correction table workspace to vectors,
   * (2) created according to detector's position in instrument;
@@ -1586,14 +1611,9 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      std::map<int, DataObjects::EventList> histogramLists;
+      std::map<int, DataObjects::EventList *> outputs =
+          getSpectrumOutputs(iws, histogramLists);
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
 
@@ -1607,6 +1627,9 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       } else {
         input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
       }
+
+      if (m_outputHistograms)
+        histogramSpectrumOutputs(iws, histogramLists);
     }
 
     PARALLEL_END_INTERUPT_REGION
@@ -1619,6 +1642,47 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   return;
 }
 
+/** Get the event lists that the events of one spectrum are split into: the
+ * spectra of the output EventWorkspaces, or temporary event lists that are
+ * histogrammed afterwards if the outputs are Workspace2D
+ * @param iws :: workspace index of the spectrum
+ * @param histogramLists :: storage for the temporary event lists
+ * @return map from target (workspace group) to output event list
+ */
+std::map<int, DataObjects::EventList *> FilterEvents::getSpectrumOutputs(
+    size_t iws, std::map<int, DataObjects::EventList> &histogramLists) {
+  std::map<int, DataObjects::EventList *> outputs;
+  if (m_outputHistograms) {
+    for (const auto &ws : m_outputWorkspacesMap)
+      outputs.emplace(ws.first, &histogramLists[ws.first]);
+    return outputs;
+  }
+
+  PARALLEL_CRITICAL(build_elist) {
+    for (auto &ws : m_outputWorkspacesMap) {
+      int index = ws.first;
+      auto &output_el =
+          static_cast<EventWorkspace &>(*ws.second).getSpectrum(iws);
+      outputs.emplace(index, &output_el);
+    }
+  }
+  return outputs;
+}
+
+/** Histogram the split events of one spectrum into the output Workspace2Ds.
+ * The temporary event lists are released as soon as they are histogrammed.
+ * @param iws :: workspace index of the spectrum
+ * @param histogramLists :: the split events of each target
+ */
+void FilterEvents::histogramSpectrumOutputs(
+    size_t iws, std::map<int, DataObjects::EventList> &histogramLists) {
+  for (auto &list : histogramLists) {
+    m_outputWorkspacesMap.at(list.first)
+        ->setHistogram(iws, list.second.histogram());
+    list.second.clear();
+  }
+}
+
 /** Split events by splitters represented by vector
   */
 void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
@@ -1656,14 +1720,9 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      map<int, DataObjects::EventList> histogramLists;
+      map<int, DataObjects::EventList *> outputs =
+          getSpectrumOutputs(iws, histogramLists);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -1686,6 +1745,9 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 
       if (printdetail)
         g_log.notice(logmessage);
+
+      if (m_outputHistograms)
+        histogramSpectrumOutputs(iws, histogramLists);
     }
 
     PARALLEL_END_INTERUPT_REGION
@@ -1840,13 +1902,13 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
   if (m_useSplittersWorkspace) {
     g_log.debug() << "There are " << split_tsp_vec.size()
                   << " TimeSeriesPropeties.\n";
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator miter;
+    std::map<int, API::MatrixWorkspace_sptr>::iterator miter;
     for (miter = m_outputWorkspacesMap.begin();
          miter != m_outputWorkspacesMap.end(); ++miter) {
       g_log.debug() << "Output workspace index: " << miter->first << "\n";
       if (0 <= miter->first &&
           miter->first < static_cast<int>(split_tsp_vec.size())) {
-        DataObjects::EventWorkspace_sptr outws = miter->second;
+        API::MatrixWorkspace_sptr outws = miter->second;
         outws->mutableRun().addProperty(split_tsp_vec[miter->first], true);
       }
     }
@@ -1855,7 +1917,7 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
     for (int itarget = 0; itarget < static_cast<int>(split_tsp_vec.size());
          ++itarget) {
       // use itarget to find the workspace that is mapped
-      std::map<int, DataObjects::EventWorkspace_sptr>::iterator ws_iter;
+      std::map<int, API::MatrixWorkspace_sptr>::iterator ws_iter;
       ws_iter = m_outputWorkspacesMap.find(itarget);
 
       // skip if an itarget does not have matched workspace
@@ -1866,7 +1928,7 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
       }
 
       // get the workspace and add property
-      DataObjects::EventWorkspace_sptr outws = ws_iter->second;
+      API::MatrixWorkspace_sptr outws = ws_iter->second;
       outws->mutableRun().addProperty(split_tsp_vec[itarget], true);
     }
 
@@ -7,6 +7,7 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/VectorHelper.h"
@@ -194,8 +195,9 @@ void Integration::exec() {
 
     // Retrieve the spectrum into a vector
     const MantidVec &X = inSpec.readX();
-    const MantidVec &Y = inSpec.readY();
-    const MantidVec &E = inSpec.readE();
+    const SpectrumValues values(inSpec);
+    const MantidVec &Y = values.y();
+    const MantidVec &E = values.e();
 
     // Find the range [min,max]
     MantidVec::const_iterator lowit, highit;
@@ -332,6 +334,9 @@ void Integration::exec() {
     rebinned_output->finalize(false);
   }
 
+  MatrixWorkspace_const_sptr inputWorkspace = getProperty("InputWorkspace");
+  propagateSinglePrecision(*inputWorkspace, *outputWorkspace);
+
   // Assign it to the output workspace property
   setProperty("OutputWorkspace", outputWorkspace);
 }
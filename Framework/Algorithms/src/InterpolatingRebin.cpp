@@ -143,7 +143,9 @@ void InterpolatingRebin::outputYandEValues(
 
   const int histnumber = static_cast<int>(inputW->getNumberHistograms());
   Progress prog(this, 0.0, 1.0, histnumber);
+  PARALLEL_FOR_IF(Kernel::threadSafe(*inputW, *outputW))
   for (int hist = 0; hist < histnumber; ++hist) {
+    PARALLEL_START_INTERUPT_REGION
     // get const references to input Workspace arrays (no copying)
     const auto &XValues = inputW->binEdges(hist);
     const MantidVec &YValues = inputW->readY(hist);
@@ -166,7 +168,9 @@ void InterpolatingRebin::outputYandEValues(
     outputW->setBinEdges(hist, XValues_new);
 
     prog.report();
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
   gsl_set_error_handler(old_handler);
 }
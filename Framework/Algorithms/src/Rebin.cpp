@@ -1,12 +1,14 @@
 #include "MantidAlgorithms/Rebin.h"
 #include "MantidHistogramData/Exception.h"
 #include "MantidHistogramData/Rebin.h"
+#include "MantidHistogramData/RebinOverlaps.h"
 
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/HistoWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/RebinParamsValidator.h"
@@ -29,6 +31,7 @@ using DataObjects::EventList;
 using DataObjects::EventWorkspace;
 using DataObjects::EventWorkspace_sptr;
 using DataObjects::EventWorkspace_const_sptr;
+using DataObjects::SpectraPinScope;
 
 //---------------------------------------------------------------------------------------------
 // Public static methods
@@ -183,6 +186,8 @@ void Rebin::exec() {
       PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
       for (int i = 0; i < histnumber; ++i) {
         PARALLEL_START_INTERUPT_REGION
+        // Keeps a file-backed spectrum in memory while it is histogrammed
+        SpectraPinScope pinned(*eventInputWS);
         // Get a const event list reference. eventInputWS->dataY() doesn't work.
         const EventList &el = eventInputWS->getSpectrum(i);
         MantidVec y_data, e_data;
@@ -244,14 +249,35 @@ void Rebin::exec() {
       outputWS->replaceAxis(1, inputWS->getAxis(1)->clone(outputWS.get()));
     bool ignoreBinErrors = getProperty("IgnoreBinErrors");
 
+    // The overlaps of the bins are computed once for all the spectra having
+    // the X values of the first one, usually all of them
+    const HistogramData::HistogramX *commonX = nullptr;
+    std::unique_ptr<const HistogramData::RebinOverlaps> overlaps;
+    if (histnumber > 0) {
+      commonX = &inputWS->x(0);
+      try {
+        overlaps = Kernel::make_unique<const HistogramData::RebinOverlaps>(
+            *commonX, XValues_new);
+      } catch (InvalidBinEdgesError &) {
+        // Reported for each spectrum by HistogramData::rebin below
+      }
+    }
+
     Progress prog(this, 0.0, 1.0, histnumber);
     PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
     for (int hist = 0; hist < histnumber; ++hist) {
       PARALLEL_START_INTERUPT_REGION
 
       try {
-        outputWS->setHistogram(
-            hist, HistogramData::rebin(inputWS->histogram(hist), XValues_new));
+        const auto &XValues = inputWS->x(hist);
+        if (overlaps && (&XValues == commonX ||
+                         XValues.rawData() == commonX->rawData()))
+          outputWS->setHistogram(hist,
+                                 overlaps->rebin(inputWS->histogram(hist)));
+        else
+          outputWS->setHistogram(hist, HistogramData::rebin(
+                                           inputWS->histogram(hist),
+                                           XValues_new));
       } catch (InvalidBinEdgesError &) {
         if (ignoreBinErrors)
           outputWS->setBinEdges(hist, XValues_new);
@@ -288,6 +314,7 @@ void Rebin::exec() {
       ChildAlg->execute();
       outputWS = ChildAlg->getProperty("OutputWorkspace");
     }
+    DataObjects::propagateSinglePrecision(*inputWS, *outputWS);
 
     // Assign it to the output workspace property
     setProperty("OutputWorkspace", outputWS);
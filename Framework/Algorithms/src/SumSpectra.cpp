@@ -4,7 +4,9 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
 #include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidKernel/ArrayProperty.h"
@@ -139,7 +141,10 @@ void SumSpectra::exec() {
   MatrixWorkspace_const_sptr localworkspace = getProperty("InputWorkspace");
   m_numberOfSpectra = static_cast<int>(localworkspace->getNumberHistograms());
   determineIndices(m_numberOfSpectra);
-  m_yLength = localworkspace->y(*(m_indices.begin())).size();
+  {
+    SpectraPinScope pinned(*localworkspace);
+    m_yLength = localworkspace->histogram(*(m_indices.begin())).size();
+  }
 
   // determine the output spectrum number
   m_outSpecNum = getOutputSpecNo(localworkspace);
@@ -165,7 +170,11 @@ void SumSpectra::exec() {
       g_log.warning("Ignoring request for WeightedSum");
       m_calculateWeightedSum = false;
     }
-    outputWorkspace = create<EventWorkspace>(*eventW, 1, eventW->binEdges(0));
+    {
+      SpectraPinScope pinned(*eventW);
+      outputWorkspace =
+          create<EventWorkspace>(*eventW, 1, eventW->binEdges(0));
+    }
 
     execEvent(outputWorkspace, progress, numSpectra, numMasked, numZeros);
   } else {
@@ -201,6 +210,8 @@ void SumSpectra::exec() {
     // Gaussian errors
     std::transform(YError.begin(), YError.end(), YError.begin(),
                    (double (*)(double))std::sqrt);
+
+    propagateSinglePrecision(*localworkspace, *outputWorkspace);
   }
 
   // set up the summing statistics
@@ -247,9 +258,14 @@ void SumSpectra::determineIndices(const size_t numberOfSpectra) {
  */
 specnum_t
 SumSpectra::getOutputSpecNo(MatrixWorkspace_const_sptr localworkspace) {
+  // The spectra of a file-backed EventWorkspace are released one by one
+  auto spectrumNo = [&localworkspace](const size_t index) {
+    SpectraPinScope pinned(*localworkspace);
+    return localworkspace->getSpectrum(index).getSpectrumNo();
+  };
+
   // initial value - any included spectrum will do
-  specnum_t specId =
-      localworkspace->getSpectrum(*(m_indices.begin())).getSpectrumNo();
+  specnum_t specId = spectrumNo(*(m_indices.begin()));
 
   // the total number of spectra
   size_t totalSpec = localworkspace->getNumberHistograms();
@@ -257,7 +273,7 @@ SumSpectra::getOutputSpecNo(MatrixWorkspace_const_sptr localworkspace) {
   specnum_t temp;
   for (const auto index : m_indices) {
     if (index < totalSpec) {
-      temp = localworkspace->getSpectrum(index).getSpectrumNo();
+      temp = spectrumNo(index);
       if (temp < specId)
         specId = temp;
     }
@@ -335,8 +351,9 @@ void SumSpectra::doSimpleSum(MatrixWorkspace_sptr outputWorkspace,
     }
     numSpectra++;
 
-    const auto &YValues = localworkspace->y(wsIndex);
-    const auto &YErrors = localworkspace->e(wsIndex);
+    const SpectrumValues values(localworkspace->getSpectrum(wsIndex));
+    const auto &YValues = values.y();
+    const auto &YErrors = values.e();
 
     if (m_calculateWeightedSum) {
       // Retrieve the spectrum into a vector
@@ -352,8 +369,8 @@ void SumSpectra::doSimpleSum(MatrixWorkspace_sptr outputWorkspace,
         }
       }
     } else {
-      YSum += YValues;
       for (size_t yIndex = 0; yIndex < m_yLength; ++yIndex) {
+        YSum[yIndex] += YValues[yIndex];
         const auto yErrorsVal = YErrors[yIndex];
         YErrorSum[yIndex] += yErrorsVal * yErrorsVal;
       }
@@ -514,7 +531,9 @@ void SumSpectra::execEvent(MatrixWorkspace_sptr outputWorkspace,
     }
     numSpectra++;
 
-    // Add the event lists with the operator
+    // Add the event lists with the operator. The input spectrum is released
+    // as soon as its events are added, if the workspace is file-backed.
+    SpectraPinScope pinned(*inputWorkspace);
     const EventList &inputEL = inputWorkspace->getSpectrum(i);
     if (inputEL.empty()) {
       ++numZeros;
@@ -238,6 +238,179 @@ public:
     }
   }
 
+  void test_EventWorkspace_groups_are_merged_sorted() {
+    doTestMergedEvents(false);
+  }
+
+  void test_EventWorkspace_mixed_event_types_are_appended() {
+    doTestMergedEvents(true);
+  }
+
+  void doTestMergedEvents(bool mixedEventTypes) {
+    const std::string wsName("DiffractionFocussing2Test_merge");
+    EventWorkspace_sptr inputW =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(3, 4);
+    inputW->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+    // Interleaved unsorted TOFs in every pixel
+    const size_t eventsPerPixel = 10;
+    for (size_t pix = 0; pix < inputW->getNumberHistograms(); pix++) {
+      inputW->setHistogram(pix, BinEdges{0.0, 1e6});
+      auto &el = inputW->getSpectrum(pix);
+      for (size_t i = eventsPerPixel; i > 0; --i)
+        el.addEventQuickly(TofEvent(static_cast<double>(i * 100 + pix)));
+      if (mixedEventTypes && pix % 2 == 1)
+        el.switchTo(WEIGHTED);
+    }
+    AnalysisDataService::Instance().addOrReplace(wsName, inputW);
+    FrameworkManager::Instance().exec(
+        "CreateGroupingWorkspace", 6, "InputWorkspace", wsName.c_str(),
+        "GroupNames", "bank2,bank3", "OutputWorkspace",
+        "DiffractionFocussing2Test_merge_group");
+
+    DiffractionFocussing2 alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", wsName);
+    alg.setPropertyValue("OutputWorkspace", wsName + "_focussed");
+    alg.setPropertyValue("GroupingWorkspace",
+                         "DiffractionFocussing2Test_merge_group");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    EventWorkspace_const_sptr output;
+    TS_ASSERT_THROWS_NOTHING(
+        output = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            wsName + "_focussed"));
+    TS_ASSERT(output);
+    if (!output)
+      return;
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 2);
+    for (size_t wi = 0; wi < output->getNumberHistograms(); wi++) {
+      const auto &el = output->getSpectrum(wi);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), 16 * eventsPerPixel);
+      TS_ASSERT_EQUALS(el.getDetectorIDs().size(), 16);
+      if (mixedEventTypes) {
+        TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+        continue;
+      }
+      TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+      const auto tofs = el.getTofs();
+      TS_ASSERT(std::is_sorted(tofs.begin(), tofs.end()));
+    }
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove(wsName + "_focussed");
+    AnalysisDataService::Instance().remove(
+        "DiffractionFocussing2Test_merge_group");
+  }
+
+  void test_EventWorkspace_dontPreserveEvents_counts_events_outside_own_bins() {
+    const std::string wsName("DiffractionFocussing2Test_histogram");
+    EventWorkspace_sptr inputW =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(3, 4);
+    inputW->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+    // Every other pixel has bins ending before its second event, which is
+    // still inside the bins of its group
+    for (size_t pix = 0; pix < inputW->getNumberHistograms(); pix++) {
+      if (pix % 2 == 0)
+        inputW->setHistogram(pix, BinEdges{100.0, 150.0, 200.0});
+      else
+        inputW->setHistogram(pix, BinEdges{100.0, 550.0, 1000.0});
+      auto &el = inputW->getSpectrum(pix);
+      el.clear(false);
+      el.addEventQuickly(TofEvent(500.0));
+      el.addEventQuickly(TofEvent(150.0));
+    }
+    AnalysisDataService::Instance().addOrReplace(wsName, inputW);
+    FrameworkManager::Instance().exec(
+        "CreateGroupingWorkspace", 6, "InputWorkspace", wsName.c_str(),
+        "GroupNames", "bank2,bank3", "OutputWorkspace",
+        "DiffractionFocussing2Test_histogram_group");
+
+    DiffractionFocussing2 alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", wsName);
+    alg.setPropertyValue("OutputWorkspace", wsName + "_focussed");
+    alg.setPropertyValue("GroupingWorkspace",
+                         "DiffractionFocussing2Test_histogram_group");
+    alg.setProperty("PreserveEvents", false);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    MatrixWorkspace_const_sptr output;
+    TS_ASSERT_THROWS_NOTHING(
+        output = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(
+            wsName + "_focussed"));
+    TS_ASSERT(output);
+    if (!output)
+      return;
+    TS_ASSERT(!boost::dynamic_pointer_cast<const EventWorkspace>(output));
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 2);
+    for (size_t wi = 0; wi < output->getNumberHistograms(); wi++) {
+      // Logarithmic group bins from 100 to 1000, with the edge at 316.2
+      const auto &x = output->x(wi);
+      TS_ASSERT_EQUALS(x.size(), 3);
+      TS_ASSERT_DELTA(x[0], 100.0, 1e-6);
+      TS_ASSERT_DELTA(x[1], std::sqrt(1e5), 1e-6);
+      TS_ASSERT_DELTA(x[2], 1000.0, 1e-6);
+      // All 16 pixels of the group count both of their events
+      const auto &y = output->y(wi);
+      TS_ASSERT_DELTA(y[0], 16.0, 1e-10);
+      TS_ASSERT_DELTA(y[1], 16.0, 1e-10);
+      const auto &e = output->e(wi);
+      TS_ASSERT_DELTA(e[0], 4.0, 1e-10);
+      TS_ASSERT_DELTA(e[1], 4.0, 1e-10);
+    }
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove(wsName + "_focussed");
+    AnalysisDataService::Instance().remove(
+        "DiffractionFocussing2Test_histogram_group");
+  }
+
+  void test_mergeSortedEvents_partitions() {
+    // Few distinct TOFs, so that many splitters fall on runs of equal TOF,
+    // and some empty inputs
+    std::vector<std::vector<TofEvent>> lists(6);
+    for (int64_t i = 0; i < 2000; i++)
+      lists[1].emplace_back(static_cast<double>(i / 100), i);
+    for (int64_t i = 0; i < 1500; i++)
+      lists[3].emplace_back(static_cast<double>((i * 7) / 150), 10000 + i);
+    for (int64_t i = 0; i < 300; i++)
+      lists[4].emplace_back(5.0, 20000 + i);
+    lists[5].emplace_back(19.0, 30000);
+    std::vector<const std::vector<TofEvent> *> inputs;
+    std::vector<TofEvent> expected;
+    for (const auto &list : lists) {
+      inputs.push_back(&list);
+      expected.insert(expected.end(), list.begin(), list.end());
+    }
+    const auto byTofAndPulse = [](const TofEvent &a, const TofEvent &b) {
+      return a.tof() < b.tof() ||
+             (a.tof() == b.tof() && a.pulseTime() < b.pulseTime());
+    };
+    std::sort(expected.begin(), expected.end(), byTofAndPulse);
+
+    for (const size_t numberOfPartitions : {1, 2, 3, 8, 64}) {
+      std::vector<TofEvent> output;
+      mergeSortedEvents(inputs, output, numberOfPartitions);
+      TS_ASSERT_EQUALS(output.size(), expected.size());
+      TSM_ASSERT(std::to_string(numberOfPartitions),
+                 std::is_sorted(output.begin(), output.end(),
+                                [](const TofEvent &a, const TofEvent &b) {
+                                  return a.tof() < b.tof();
+                                }));
+      // Every event is there once
+      std::sort(output.begin(), output.end(), byTofAndPulse);
+      TSM_ASSERT(std::to_string(numberOfPartitions), output == expected);
+    }
+
+    std::vector<TofEvent> output{TofEvent(1.0)};
+    std::vector<const std::vector<TofEvent> *> emptyInputs{&lists[0],
+                                                           &lists[2]};
+    mergeSortedEvents(emptyInputs, output, 4);
+    TS_ASSERT(output.empty());
+  }
+
 private:
   DiffractionFocussing2 focus;
 };
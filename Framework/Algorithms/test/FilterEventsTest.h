@@ -12,6 +12,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidDataObjects/SplittersWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/TimeSeriesProperty.h"
@@ -261,6 +262,68 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Filter events without correction and histogram each target directly
+   * into a Workspace2D
+   */
+  void test_FilterOutputHistograms() {
+    int64_t runstart_i64 = 20000000000;
+    int64_t pulsedt = 100 * 1000 * 1000;
+    int64_t tofdt = 10 * 1000 * 1000;
+    size_t numpulses = 5;
+
+    EventWorkspace_sptr inpWS =
+        createEventWorkspace(runstart_i64, pulsedt, tofdt, numpulses);
+    inpWS->setAllX(HistogramData::BinEdges{0.0, 50000.0, 100000.0});
+    AnalysisDataService::Instance().addOrReplace("TestHist", inpWS);
+
+    SplittersWorkspace_sptr splws =
+        createSplittersWorkspace(runstart_i64, pulsedt, tofdt);
+    AnalysisDataService::Instance().addOrReplace("SplitterHist", splws);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "TestHist");
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredHist");
+    filter.setProperty("SplitterWorkspace", "SplitterHist");
+    filter.setProperty("OutputTOFCorrectionWorkspace", "CorrectionWS");
+    filter.setProperty("OutputHistograms", true);
+
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    int numsplittedws = filter.getProperty("NumberOutputWS");
+    TS_ASSERT_EQUALS(numsplittedws, 4);
+
+    // The same events as in test_FilterNoCorrection, but histogrammed
+    auto filteredws1 = AnalysisDataService::Instance().retrieveWS<Workspace2D>(
+        "FilteredHist_1");
+    TS_ASSERT(filteredws1);
+    TS_ASSERT(!AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "FilteredHist_1"));
+    TS_ASSERT_EQUALS(filteredws1->getNumberHistograms(), 10);
+    TS_ASSERT_EQUALS(filteredws1->x(1).size(), 3);
+    const auto &y1 = filteredws1->y(1);
+    TS_ASSERT_DELTA(y1[0] + y1[1], 16.0, 1.0E-10);
+    TS_ASSERT_DELTA(filteredws1->e(1)[0], std::sqrt(y1[0]), 1.0E-10);
+    TS_ASSERT_EQUALS(filteredws1->run().getProtonCharge(), 3);
+
+    auto filteredws2 = AnalysisDataService::Instance().retrieveWS<Workspace2D>(
+        "FilteredHist_2");
+    TS_ASSERT(filteredws2);
+    const auto &y2 = filteredws2->y(1);
+    TS_ASSERT_DELTA(y2[0] + y2[1], 21.0, 1.0E-10);
+
+    // Clean up
+    AnalysisDataService::Instance().remove("TestHist");
+    AnalysisDataService::Instance().remove("SplitterHist");
+    std::vector<std::string> outputwsnames =
+        filter.getProperty("OutputWorkspaceNames");
+    for (const auto &outputwsname : outputwsnames) {
+      AnalysisDataService::Instance().remove(outputwsname);
+    }
+  }
+
   //----------------------------------------------------------------------------------------------
   /**  Filter events without any correction and test for user-specified
    *workspace starting value
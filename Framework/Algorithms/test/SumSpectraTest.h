@@ -5,9 +5,11 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
+#include <Poco/TemporaryFile.h>
 #include <boost/lexical_cast.hpp>
 #include <cxxtest/TestSuite.h>
 #include <limits>
@@ -227,6 +229,33 @@ public:
     TS_ASSERT(output->run().hasProperty("NumZeroSpectra"))
   }
 
+  void testExecEvent_fileBacked_stays_within_memory_budget() {
+    const int numPixels = 100;
+    EventWorkspace_sptr input =
+        WorkspaceCreationHelper::createEventWorkspace(numPixels, 20, 20);
+    const size_t numEvents = input->getNumberEvents();
+    // Room for the events of about three spectra
+    const uint64_t memoryBudget =
+        3 * numEvents / numPixels * sizeof(Mantid::Types::Event::TofEvent);
+    input->setFileBacked(Poco::TemporaryFile::tempName(), memoryBudget);
+
+    Mantid::Algorithms::SumSpectra alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    // Every spectrum was read, and released once summed
+    MatrixWorkspace_sptr output = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(
+        boost::dynamic_pointer_cast<EventWorkspace>(output)->getNumberEvents(),
+        numEvents);
+    TS_ASSERT_LESS_THAN_EQUALS(input->getFileBacking()->getMemoryUsed(),
+                               memoryBudget);
+  }
+
   void testRebinnedOutputSum() {
     AnalysisDataService::Instance().clear();
     RebinnedOutput_sptr ws =
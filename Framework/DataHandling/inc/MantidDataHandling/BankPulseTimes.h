@@ -23,6 +23,10 @@ public:
   /// Constructor with vector of DateAndTime
   BankPulseTimes(const std::vector<Mantid::Types::Core::DateAndTime> &times);
 
+  /// Constructor with a range of the pulses of another BankPulseTimes
+  BankPulseTimes(const BankPulseTimes &other, const size_t start,
+                 const size_t stop);
+
   /// Destructor
   ~BankPulseTimes();
 
@@ -40,6 +44,9 @@ public:
 
   /// Vector of period numbers corresponding to each pulse
   std::vector<int> periodNumbers;
+
+  /// True if the pulse times never decrease
+  bool pulseTimesSorted;
 };
 
 #endif
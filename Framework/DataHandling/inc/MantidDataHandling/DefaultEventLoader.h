@@ -71,6 +71,9 @@ public:
   int firstChunkForBank;
   /// number of chunks per bank
   size_t eventsPerChunk;
+  /// Number of events of a bank read from the file at once. Each block is
+  /// processed while the next one is read.
+  size_t eventsPerBlock;
 
   LoadEventNexus *alg;
   EventWorkspaceCollection &m_ws;
@@ -98,6 +98,7 @@ public:
                                       bool dothrow) const;
   Types::Core::DateAndTime getFirstPulseTime() const;
   void setAllX(const HistogramData::BinEdges &x);
+  void setFileBacked(const uint64_t memoryBudget);
   size_t getNumberEvents() const;
   void setIndexInfo(const Indexing::IndexInfo &indexInfo);
   void setInstrument(const Geometry::Instrument_const_sptr &inst);
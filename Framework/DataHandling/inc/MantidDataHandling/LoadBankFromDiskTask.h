@@ -13,10 +13,17 @@ class BankPulseTimes;
 namespace Mantid {
 namespace DataHandling {
 class DefaultEventLoader;
+class ProcessBankDataQueue;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
   disk IO mutex
 
+  The events of the bank are read in blocks of DefaultEventLoader's
+  eventsPerBlock events. A ProcessBankData task is scheduled for each block as
+  soon as it has been read, so the event lists are filled while the next block
+  is read. The blocks touching the same pixels are processed in the order they
+  were read and at most a few of them are held in memory at once.
+
   Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
 
@@ -55,11 +62,22 @@ public:
 private:
   void loadPulseTimes(::NeXus::File &file);
   void loadEventIndex(::NeXus::File &file, std::vector<uint64_t> &event_index);
+  bool loadEventIndexInTimeWindow(::NeXus::File &file,
+                                  std::vector<uint64_t> &event_index,
+                                  size_t &start_event, size_t &stop_event);
   void prepareEventId(::NeXus::File &file, size_t &start_event,
                       size_t &stop_event, std::vector<uint64_t> &event_index);
   void loadEventId(::NeXus::File &file);
   void loadTof(::NeXus::File &file);
   void loadEventWeights(::NeXus::File &file);
+  void loadBlock(::NeXus::File &file, const size_t start_event,
+                 const size_t stop_event,
+                 const boost::shared_ptr<std::vector<uint64_t>> &event_index,
+                 const bool wholeBank);
+  bool restrictToSpectraToLoad();
+  void scheduleProcessing(
+      const boost::shared_ptr<std::vector<uint64_t>> &event_index,
+      const bool wholeBank);
   int64_t recalculateDataSize(const int64_t &size);
 
   /// Algorithm being run
@@ -96,6 +114,14 @@ private:
   float *m_event_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// Blocks waiting to be processed for pixel IDs up to m_splitId
+  boost::shared_ptr<ProcessBankDataQueue> m_lowQueue;
+  /// Blocks waiting to be processed for pixel IDs above m_splitId
+  boost::shared_ptr<ProcessBankDataQueue> m_highQueue;
+  /// Largest pixel ID processed by the tasks of m_lowQueue
+  uint32_t m_splitId;
+  /// Time spent reading from the file
+  double m_readTime;
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 } // namespace DataHandling
@@ -160,6 +160,13 @@ public:
   /// the IDF
   size_t discarded_events;
 
+  /// Time spent reading event data from the file, summed over all threads
+  double m_readEventsTime;
+  /// Time spent filling the event lists, summed over all threads
+  double m_processEventsTime;
+  /// Elapsed time to read and process all the event data
+  double m_loadEventsTime;
+
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
 
@@ -170,8 +170,9 @@ private:
 
   /// Load a block of data into the workspace where it is assumed that the x
   /// bins have already been cached
-  void loadBlock(Mantid::NeXus::NXDataSetTyped<double> &data,
-                 Mantid::NeXus::NXDataSetTyped<double> &errors,
+  template <typename T>
+  void loadBlock(Mantid::NeXus::NXDataSetTyped<T> &data,
+                 Mantid::NeXus::NXDataSetTyped<T> &errors,
                  Mantid::NeXus::NXDataSetTyped<double> &farea, bool hasFArea,
                  Mantid::NeXus::NXDouble &xErrors, bool hasXErrors,
                  int blocksize, int nchannels, int &hist,
@@ -179,21 +180,35 @@ private:
 
   /// Load a block of data into the workspace where it is assumed that the x
   /// bins have already been cached
-  void loadBlock(Mantid::NeXus::NXDataSetTyped<double> &data,
-                 Mantid::NeXus::NXDataSetTyped<double> &errors,
+  template <typename T>
+  void loadBlock(Mantid::NeXus::NXDataSetTyped<T> &data,
+                 Mantid::NeXus::NXDataSetTyped<T> &errors,
                  Mantid::NeXus::NXDataSetTyped<double> &farea, bool hasFArea,
                  Mantid::NeXus::NXDouble &xErrors, bool hasXErrors,
                  int blocksize, int nchannels, int &hist, int &wsIndex,
                  API::MatrixWorkspace_sptr local_workspace);
   /// Load a block of data into the workspace
-  void loadBlock(Mantid::NeXus::NXDataSetTyped<double> &data,
-                 Mantid::NeXus::NXDataSetTyped<double> &errors,
+  template <typename T>
+  void loadBlock(Mantid::NeXus::NXDataSetTyped<T> &data,
+                 Mantid::NeXus::NXDataSetTyped<T> &errors,
                  Mantid::NeXus::NXDataSetTyped<double> &farea, bool hasFArea,
                  Mantid::NeXus::NXDouble &xErrors, bool hasXErrors,
                  Mantid::NeXus::NXDouble &xbins, int blocksize, int nchannels,
                  int &hist, int &wsIndex,
                  API::MatrixWorkspace_sptr local_workspace);
 
+  /// Load the Y, E, fractional area and X error values of the spectra
+  template <typename T>
+  void loadNonEventData(Mantid::NeXus::NXDataSetTyped<T> &data,
+                        Mantid::NeXus::NXDataSetTyped<T> &errors,
+                        Mantid::NeXus::NXDataSetTyped<double> &fracarea,
+                        bool hasFracArea, Mantid::NeXus::NXDouble &xErrors,
+                        bool hasXErrors, Mantid::NeXus::NXDouble &xbins,
+                        size_t total_specs, int nchannels,
+                        const double &progressStart,
+                        const double &progressRange,
+                        API::MatrixWorkspace_sptr local_workspace);
+
   /// Load the data from a non-spectra axis (Numeric/Text) into the workspace
   void loadNonSpectraAxis(API::MatrixWorkspace_sptr local_workspace,
                           Mantid::NeXus::NXData &data);
@@ -234,6 +249,9 @@ private:
   /// used only when loading data into event_workspace
   std::vector<int> m_filtered_spec_idxs;
 
+  /// The value of the SinglePrecision property
+  bool m_singlePrecision;
+
   // C++ interface to the NXS file
   ::NeXus::File *m_cppFile;
 };
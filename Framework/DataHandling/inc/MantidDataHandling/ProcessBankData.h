@@ -32,6 +32,8 @@ public:
   * @param event_weight :: array with weights for events
   * @param min_event_id ;: minimum detector ID to load
   * @param max_event_id :: maximum detector ID to load
+  * @param precount :: pre-count the events of each pixel and reserve the
+  *event lists before filling them
   * @return
   */ // API::IFileLoader<Kernel::NexusDescriptor>
   ProcessBankData(DefaultEventLoader &loader, std::string entry_name,
@@ -41,7 +43,8 @@ public:
                   boost::shared_ptr<std::vector<uint64_t>> event_index,
                   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes,
                   bool have_weight, boost::shared_array<float> event_weight,
-                  detid_t min_event_id, detid_t max_event_id);
+                  detid_t min_event_id, detid_t max_event_id,
+                  bool precount);
 
   void run() override;
 
@@ -79,6 +82,8 @@ private:
   detid_t m_min_id;
   /// Maximum pixel id
   detid_t m_max_id;
+  /// Pre-count the events of each pixel before filling the event lists
+  bool m_precount;
   /// timer for performance
   Mantid::Kernel::Timer m_timer;
 }; // ENDDEF-CLASS ProcessBankData
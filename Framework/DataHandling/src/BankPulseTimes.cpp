@@ -1,5 +1,7 @@
 #include "MantidDataHandling/BankPulseTimes.h"
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 //===============================================================================================
 // BankPulseTimes
@@ -40,6 +42,7 @@ BankPulseTimes::BankPulseTimes(::NeXus::File &file,
   pulseTimes = new Mantid::Types::Core::DateAndTime[numPulses];
   for (size_t i = 0; i < numPulses; i++)
     pulseTimes[i] = start + seconds[i];
+  pulseTimesSorted = std::is_sorted(pulseTimes, pulseTimes + numPulses);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -51,6 +54,7 @@ BankPulseTimes::BankPulseTimes(
     const std::vector<Mantid::Types::Core::DateAndTime> &times) {
   numPulses = times.size();
   pulseTimes = nullptr;
+  pulseTimesSorted = std::is_sorted(times.cbegin(), times.cend());
   if (numPulses == 0)
     return;
   pulseTimes = new Mantid::Types::Core::DateAndTime[numPulses];
@@ -60,6 +64,25 @@ BankPulseTimes::BankPulseTimes(
     pulseTimes[i] = times[i];
 }
 
+//----------------------------------------------------------------------------------------------
+/** Constructor. Copy the pulses [start, stop) of another bank.
+*  @param other :: pulse times to copy from
+*  @param start :: index of the first pulse to copy
+*  @param stop :: index of the last pulse to copy + 1
+ */
+BankPulseTimes::BankPulseTimes(const BankPulseTimes &other, const size_t start,
+                               const size_t stop)
+    : startTime(other.startTime), numPulses(stop - start),
+      pulseTimes(nullptr),
+      periodNumbers(other.periodNumbers.begin() + start,
+                    other.periodNumbers.begin() + stop),
+      pulseTimesSorted(other.pulseTimesSorted) {
+  if (numPulses == 0)
+    return;
+  pulseTimes = new Mantid::Types::Core::DateAndTime[numPulses];
+  std::copy(other.pulseTimes + start, other.pulseTimes + stop, pulseTimes);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Destructor */
 BankPulseTimes::~BankPulseTimes() { delete[] this->pulseTimes; }
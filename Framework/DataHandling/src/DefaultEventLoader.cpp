@@ -8,6 +8,12 @@
 
 using namespace Mantid::Kernel;
 
+namespace {
+/// Number of events read from a bank at once. This is a power of two so that
+/// the reads line up with the chunks of datasets chunked by a power of two.
+const size_t EVENTS_PER_BLOCK = size_t(1) << 20;
+} // namespace
+
 namespace Mantid {
 namespace DataHandling {
 
@@ -30,9 +36,14 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   auto diskIOMutex = boost::make_shared<std::mutex>();
 
   // set up progress bar for the rest of the (multi-threaded) process
-  size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
-  if (loader.splitProcessing)
-    numProg += bankNames.size() * 3; // 3 = second proc task
+  // 1 = disktask, 3 = proc task for each block read, 3 = second proc task
+  const size_t procTasks = loader.splitProcessing ? 2 : 1;
+  size_t numProg = 0;
+  for (size_t i = bankRange.first; i < bankRange.second; i++) {
+    const size_t numBlocks = bankNumEvents[i] / loader.eventsPerBlock +
+                             (bankNumEvents[i] % loader.eventsPerBlock != 0);
+    numProg += 1 + 3 * procTasks * std::max(numBlocks, size_t(1));
+  }
   auto prog = Kernel::make_unique<API::Progress>(loader.alg, 0.3, 1.0, numProg);
 
   for (size_t i = bankRange.first; i < bankRange.second; i++) {
@@ -53,8 +64,8 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
                                        const bool precount, const int chunk,
                                        const int totalChunks)
     : m_haveWeights(haveWeights), event_id_is_spec(event_id_is_spec),
-      precount(precount), chunk(chunk), totalChunks(totalChunks), alg(alg),
-      m_ws(ws) {
+      precount(precount), chunk(chunk), totalChunks(totalChunks),
+      eventsPerBlock(EVENTS_PER_BLOCK), alg(alg), m_ws(ws) {
   // This map will be used to find the workspace index
   if (event_id_is_spec)
     pixelID_to_wi_vector =
@@ -77,6 +88,11 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
   // split banks up if the number of cores is more than twice the number of
   // banks
   splitProcessing = bool(numBanks * 2 < ThreadPool::getNumPhysicalCores());
+
+  // Compressing the events of a block changes the type of the event lists, so
+  // the following blocks could not be appended. Read banks in one go instead.
+  if (alg->compressTolerance >= 0)
+    eventsPerBlock = std::numeric_limits<size_t>::max();
 }
 
 std::pair<size_t, size_t>
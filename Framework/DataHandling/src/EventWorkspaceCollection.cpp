@@ -9,6 +9,8 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidIndexing/IndexInfo.h"
 
+#include <Poco/TemporaryFile.h>
+
 #include <vector>
 #include <set>
 #include <memory>
@@ -222,6 +224,18 @@ void EventWorkspaceCollection::setAllX(const HistogramData::BinEdges &x) {
     ws->setAllX(x);
   }
 }
+
+/** Keep the events of the workspaces in scratch files, sharing the memory
+ * budget between the periods.
+ * @param memoryBudget :: number of bytes of events to hold in memory
+ */
+void EventWorkspaceCollection::setFileBacked(const uint64_t memoryBudget) {
+  const uint64_t periodBudget = memoryBudget / m_WsVec.size();
+  for (auto &ws : m_WsVec) {
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), periodBudget);
+  }
+}
+
 size_t EventWorkspaceCollection::getNumberEvents() const {
   return m_WsVec[0]->getNumberEvents(); // Should be the sum across all periods?
 }
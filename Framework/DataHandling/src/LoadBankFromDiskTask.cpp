@@ -3,10 +3,119 @@
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/Timer.h"
+#include "MantidKernel/make_unique.h"
+
+#include <deque>
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Number of blocks of a bank that may wait to be processed before the reader
+/// processes one itself
+const size_t MAX_QUEUED_BLOCKS = 4;
+
+/// Unlocks a mutex held by the calling thread for its lifetime, and locks it
+/// again when destroyed.
+class ScopedUnlock {
+public:
+  explicit ScopedUnlock(std::mutex *mutex) : m_mutex(mutex) {
+    if (m_mutex)
+      m_mutex->unlock();
+  }
+  ~ScopedUnlock() {
+    if (m_mutex)
+      m_mutex->lock();
+  }
+  ScopedUnlock(const ScopedUnlock &) = delete;
+  ScopedUnlock &operator=(const ScopedUnlock &) = delete;
+
+private:
+  std::mutex *m_mutex;
+};
+} // namespace
+
+/** Blocks of a bank waiting to be processed, in the order they were read.
+ * The blocks touching the same pixels must be added to the event lists in the
+ * order of the file, so whichever thread runs the queue always processes the
+ * oldest block.
+ */
+class ProcessBankDataQueue {
+public:
+  /// Add a block to the back of the queue
+  void push(std::unique_ptr<ProcessBankData> task) {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_tasks.push_back(std::move(task));
+  }
+
+  /// @return The number of blocks waiting to be processed
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_tasks.size();
+  }
+
+  /// Process the oldest block of the queue, if any, waiting for the block
+  /// being processed by another thread to be done first
+  void runNext() {
+    std::lock_guard<std::mutex> runLock(m_runMutex);
+    if (auto task = pop())
+      task->run();
+  }
+
+  /** Process all the blocks of the queue, unless another thread is processing
+   * them already. A thread pool worker then returns straight away instead of
+   * waiting: the thread processing the blocks also processes those pushed
+   * while it runs.
+   */
+  void runPending() {
+    while (true) {
+      std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+      if (!runLock.owns_lock())
+        return;
+      while (auto task = pop())
+        task->run();
+      runLock.unlock();
+      // A block pushed after the last pop may have been skipped by a worker
+      // that found the lock taken
+      if (size() == 0)
+        return;
+    }
+  }
+
+private:
+  /// @return The oldest block of the queue, or nullptr if it is empty
+  std::unique_ptr<ProcessBankData> pop() {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (m_tasks.empty())
+      return nullptr;
+    auto task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    return task;
+  }
+
+  /// Protects m_tasks
+  mutable std::mutex m_queueMutex;
+  /// Held while a block is processed so the blocks are processed in order
+  std::mutex m_runMutex;
+  /// Blocks waiting to be processed
+  std::deque<std::unique_ptr<ProcessBankData>> m_tasks;
+};
+
+namespace {
+/// Task scheduled for each block pushed to a ProcessBankDataQueue
+class RunQueuedBlockTask : public Kernel::Task {
+public:
+  RunQueuedBlockTask(boost::shared_ptr<ProcessBankDataQueue> queue,
+                     const double cost)
+      : Task(cost), m_queue(std::move(queue)) {}
+  void run() override { m_queue->runPending(); }
+
+private:
+  boost::shared_ptr<ProcessBankDataQueue> m_queue;
+};
+} // namespace
+
 /** Constructor
 *
 * @param loader :: Handle to the main loader
@@ -29,7 +138,8 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(
       prog(prog), scheduler(scheduler), m_loadError(false),
       m_oldNexusFileNames(oldNeXusFileNames), m_event_id(nullptr),
       m_event_time_of_flight(nullptr), m_have_weight(false),
-      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
+      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers),
+      m_splitId(std::numeric_limits<uint32_t>::max()), m_readTime(0.) {
   setMutex(ioMutex);
   m_cost = static_cast<double>(numEvents);
   m_min_id = std::numeric_limits<uint32_t>::max();
@@ -105,6 +215,80 @@ void LoadBankFromDiskTask::loadEventIndex(::NeXus::File &file,
   }
 }
 
+/** Load the part of the event_index field covering the pulses within the
+* time filter, and restrict thisBankPulseTimes to those pulses. The pulses are
+* found by a binary search, so the time taken does not depend on the length
+* of the run. This requires the pulse times to be sorted.
+*
+* @param file :: File handle for the NeXus file
+* @param event_index :: set to the event_index of the pulses in the window
+* @param start_event :: set to the index of the first event
+* @param stop_event :: set to the index of the last event + 1
+* @return false if the event_index of the whole bank must be loaded instead
+*/
+bool LoadBankFromDiskTask::loadEventIndexInTimeWindow(
+    ::NeXus::File &file, std::vector<uint64_t> &event_index,
+    size_t &start_event, size_t &stop_event) {
+  if (!thisBankPulseTimes)
+    return false;
+  const auto &pulses = *thisBankPulseTimes;
+  if (!pulses.pulseTimesSorted || pulses.numPulses == 0)
+    return false;
+  const auto *pulsesBegin = pulses.pulseTimes;
+  const auto *pulsesEnd = pulses.pulseTimes + pulses.numPulses;
+  const auto firstPulse = static_cast<size_t>(
+      std::lower_bound(pulsesBegin, pulsesEnd,
+                       m_loader.alg->filter_time_start) -
+      pulsesBegin);
+  const auto stopPulse = static_cast<size_t>(
+      std::upper_bound(pulsesBegin, pulsesEnd, m_loader.alg->filter_time_stop) -
+      pulsesBegin);
+  // Keep the pulse after the window, which marks the end of its events
+  const size_t lastPulse = std::min(stopPulse + 1, pulses.numPulses);
+  // ProcessBankData needs at least two pulses to assign the pulse times
+  if (stopPulse < firstPulse || lastPulse < firstPulse + 2)
+    return false;
+
+  file.openData("event_index");
+  ::NeXus::Info index_info = file.getInfo();
+  if (index_info.type != ::NeXus::UINT64 || index_info.dims.empty() ||
+      recalculateDataSize(index_info.dims[0]) !=
+          static_cast<int64_t>(pulses.numPulses)) {
+    file.closeData();
+    return false;
+  }
+  event_index.resize(lastPulse - firstPulse);
+  std::vector<int> indexStart{static_cast<int>(firstPulse)};
+  std::vector<int> indexSize{static_cast<int>(lastPulse - firstPulse)};
+  file.getSlab(event_index.data(), indexStart, indexSize);
+  file.closeData();
+
+  if (m_oldNexusFileNames)
+    file.openData("event_pixel_id");
+  else
+    file.openData("event_id");
+  const auto dim0 =
+      static_cast<size_t>(recalculateDataSize(file.getInfo().dims[0]));
+  file.closeData();
+
+  start_event = event_index.front();
+  stop_event = stopPulse < pulses.numPulses
+                   ? event_index[stopPulse - firstPulse]
+                   : dim0;
+  if (start_event > dim0)
+    return false; // let the full loading report the invalid event_index
+  if (stop_event > dim0)
+    stop_event = dim0;
+
+  thisBankPulseTimes =
+      boost::make_shared<BankPulseTimes>(pulses, firstPulse, lastPulse);
+  m_loader.alg->getLogger().debug()
+      << entry_name << ": read event_index of pulses " << firstPulse << " to "
+      << lastPulse << ", start_event " << start_event << " stop_event "
+      << stop_event << "\n";
+  return true;
+}
+
 /** Open the event_id field and validate the contents
 *
 * @param file :: File handle for the NeXus file
@@ -175,11 +359,17 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file,
   m_loader.alg->getLogger().debug() << entry_name << ": start_event "
                                     << start_event << " stop_event "
                                     << stop_event << "\n";
+  file.closeData();
 }
 
-/** Load the event_id field, which has been open
+/** Load the event_id field and find the range of pixel IDs in it
 */
 void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
+  if (m_oldNexusFileNames)
+    file.openData("event_pixel_id");
+  else
+    file.openData("event_id");
+
   // This is the data size
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
@@ -212,6 +402,8 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
     file.closeData();
 
     // determine the range of pixel ids
+    m_min_id = std::numeric_limits<uint32_t>::max();
+    m_max_id = 0;
     for (auto i = 0; i < m_loadSize[0]; ++i) {
       uint32_t temp = m_event_id[i];
       if (temp < m_min_id)
@@ -220,12 +412,9 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
         m_max_id = temp;
     }
 
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
+    // If all the detector IDs in the block are higher than the highest 'known'
+    // (from the IDF) ID, m_min_id ends up larger than m_max_id once that is
+    // clipped below, and the block is skipped.
     // fixup the minimum pixel id in the case that it's lower than the lowest
     // 'known' id. We test this by checking that when we add the offset we
     // would not get a negative index into the vector. Note that m_min_id is
@@ -333,8 +522,7 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
 
 void LoadBankFromDiskTask::run() {
   // The vectors we will be filling
-  auto event_index_ptr = new std::vector<uint64_t>();
-  std::vector<uint64_t> &event_index = *event_index_ptr;
+  auto event_index = boost::make_shared<std::vector<uint64_t>>();
 
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
@@ -359,51 +547,59 @@ void LoadBankFromDiskTask::run() {
     // Open the bankN_event group
     file.openGroup(entry_name, entry_type);
 
+    size_t start_event = 0;
+    size_t stop_event = 0;
+    // When filtering by time only the part of event_index covering the time
+    // window is needed, if the pulse times allow finding it.
+    bool foundEventRange = false;
+    const auto *alg = m_loader.alg;
+    if (m_loader.chunk == EMPTY_INT() &&
+        (alg->filter_time_start != Types::Core::DateAndTime::minimum() ||
+         alg->filter_time_stop != Types::Core::DateAndTime::maximum())) {
+      this->loadPulseTimes(file);
+      foundEventRange = this->loadEventIndexInTimeWindow(
+          file, *event_index, start_event, stop_event);
+    }
+
     // Load the event_index field.
-    this->loadEventIndex(file, event_index);
+    if (!foundEventRange)
+      this->loadEventIndex(file, *event_index);
 
-    if (!m_loadError) {
+    if (foundEventRange) {
+      if (stop_event <= start_event)
+        m_loadError = true;
+    } else if (!m_loadError) {
       // Load and validate the pulse times
       this->loadPulseTimes(file);
 
       // The event_index should be the same length as the pulse times from DAS
       // logs.
-      if (event_index.size() != thisBankPulseTimes->numPulses)
+      if (event_index->size() != thisBankPulseTimes->numPulses)
         m_loader.alg->getLogger().warning()
             << "Bank " << entry_name
             << " has a mismatch between the number of event_index entries "
                "and the number of pulse times in event_time_zero.\n";
 
-      // Open and validate event_id field.
-      size_t start_event = 0;
-      size_t stop_event = 0;
-      this->prepareEventId(file, start_event, stop_event, event_index);
-
-      // These are the arguments to getSlab()
-      m_loadStart[0] = static_cast<int>(start_event);
-      m_loadSize[0] = static_cast<int>(stop_event - start_event);
-
-      if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
-        // Load pixel IDs
-        this->loadEventId(file);
-        if (m_loader.alg->getCancel())
-          m_loadError = true; // To allow cancelling the algorithm
-
-        // And TOF.
-        if (!m_loadError) {
-          this->loadTof(file);
-          if (m_have_weight) {
-            this->loadEventWeights(file);
-          }
-        }
-      } // Size is at least 1
-      else {
-        // Found a size that was 0 or less; stop processing
-        m_loadError = true;
-      }
+      // Validate event_id field and find the events to load.
+      this->prepareEventId(file, start_event, stop_event, *event_index);
 
+      // Found a size that was 0 or less; stop processing
+      if (stop_event <= start_event || static_cast<int>(start_event) < 0)
+        m_loadError = true;
     } // no error
 
+    // Read the events one block at a time. Each block is processed while the
+    // next one is read.
+    const size_t blockSize = m_loader.eventsPerBlock;
+    const bool wholeBank = stop_event - start_event <= blockSize;
+    while (!m_loadError && start_event < stop_event) {
+      const size_t block_stop = stop_event - start_event > blockSize
+                                    ? start_event + blockSize
+                                    : stop_event;
+      this->loadBlock(file, start_event, block_stop, event_index, wholeBank);
+      start_event = block_stop;
+    }
+
   } // try block
   catch (std::exception &e) {
     m_loader.alg->getLogger().error() << "Error while loading bank "
@@ -420,19 +616,64 @@ void LoadBankFromDiskTask::run() {
   file.closeGroup();
   file.close();
 
-  // Abort if anything failed
+  {
+    std::lock_guard<std::mutex> _lock(m_loader.alg->m_tofMutex);
+    m_loader.alg->m_readEventsTime += m_readTime;
+  }
+
+  // Free the arrays of a block that failed to load
   if (m_loadError) {
     delete[] m_event_id;
     delete[] m_event_time_of_flight;
+    delete[] m_event_weight;
+    m_event_id = nullptr;
+    m_event_time_of_flight = nullptr;
+    m_event_weight = nullptr;
+  }
+}
+
+/** Read the events [start_event, stop_event) of the bank and schedule their
+* processing.
+*
+* @param file :: File handle for the NeXus file, with the bank group open
+* @param start_event :: index of the first event of the block
+* @param stop_event :: index of the last event of the block + 1
+* @param event_index :: the event_index field of the bank
+* @param wholeBank :: true if the block holds all the events to load from the
+*bank
+*/
+void LoadBankFromDiskTask::loadBlock(
+    ::NeXus::File &file, const size_t start_event, const size_t stop_event,
+    const boost::shared_ptr<std::vector<uint64_t>> &event_index,
+    const bool wholeBank) {
+  // These are the arguments to getSlab()
+  m_loadStart[0] = static_cast<int>(start_event);
+  m_loadSize[0] = static_cast<int>(stop_event - start_event);
+
+  Kernel::Timer timer;
+  // Load pixel IDs
+  this->loadEventId(file);
+  if (m_loader.alg->getCancel())
+    m_loadError = true; // To allow cancelling the algorithm
+
+  // And TOF.
+  if (!m_loadError) {
+    this->loadTof(file);
     if (m_have_weight) {
-      delete[] m_event_weight;
+      this->loadEventWeights(file);
     }
-    delete event_index_ptr;
-
-    return;
   }
+  m_readTime += timer.elapsed();
 
-  const auto bank_size = m_max_id - m_min_id;
+  if (!m_loadError)
+    this->scheduleProcessing(event_index, wholeBank);
+}
+
+/** Restrict the range of pixel IDs of the block just read to the spectra
+* requested.
+* @return false if none of the pixel IDs of the block are to be loaded
+*/
+bool LoadBankFromDiskTask::restrictToSpectraToLoad() {
   const uint32_t minSpectraToLoad =
       static_cast<uint32_t>(m_loader.alg->m_specMin);
   const uint32_t maxSpectraToLoad =
@@ -443,7 +684,7 @@ void LoadBankFromDiskTask::run() {
   if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
     if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
                                        // than the max of this bank
-      return;
+      return false;
     }
     // the min spectra to load is higher than the min for this bank
     m_min_id = minSpectraToLoad;
@@ -451,46 +692,76 @@ void LoadBankFromDiskTask::run() {
   if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
     if (maxSpectraToLoad < m_min_id) {
       // the maximum spectra to load is less than the minimum of this bank
-      return;
+      return false;
     }
     // the max spectra to load is lower than the max for this bank
     m_max_id = maxSpectraToLoad;
   }
-  if (m_min_id > m_max_id) {
-    // the min is now larger than the max, this means the entire block of
-    // spectra to load is outside this bank
-    return;
-  }
-
-  // schedule the job to generate the event lists
-  auto mid_id = m_max_id;
-  if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
-    // only split if told to and the section to load is at least 1/4 the size
-    // of the whole bank
-    mid_id = (m_max_id + m_min_id) / 2;
-
-  // No error? Launch a new task to process that data.
-  size_t numEvents = m_loadSize[0];
-  size_t startAt = m_loadStart[0];
+  // If the min is now larger than the max, the entire block of spectra to
+  // load is outside this bank
+  return m_min_id <= m_max_id;
+}
 
+/** Hand the arrays of the block just read over to ProcessBankData tasks.
+*
+* @param event_index :: the event_index field of the bank
+* @param wholeBank :: true if the block holds all the events to load from the
+*bank
+*/
+void LoadBankFromDiskTask::scheduleProcessing(
+    const boost::shared_ptr<std::vector<uint64_t>> &event_index,
+    const bool wholeBank) {
   // convert things to shared_arrays
   boost::shared_array<uint32_t> event_id_shrd(m_event_id);
   boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
   boost::shared_array<float> event_weight_shrd(m_event_weight);
-  boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
-  ProcessBankData *newTask1 = new ProcessBankData(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-      numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
-  scheduler.push(newTask1);
-  if (m_loader.splitProcessing && (mid_id < m_max_id)) {
-    ProcessBankData *newTask2 = new ProcessBankData(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
-    scheduler.push(newTask2);
+  m_event_id = nullptr;
+  m_event_time_of_flight = nullptr;
+  m_event_weight = nullptr;
+
+  const auto bank_size = m_max_id - m_min_id;
+  if (!restrictToSpectraToLoad())
+    return;
+
+  if (!m_lowQueue) {
+    // The pixel ID range of each queue is fixed by the first block read
+    m_lowQueue = boost::make_shared<ProcessBankDataQueue>();
+    if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4))) {
+      // only split if told to and the section to load is at least 1/4 the
+      // size of the whole bank
+      m_splitId = (m_max_id + m_min_id) / 2;
+      m_highQueue = boost::make_shared<ProcessBankDataQueue>();
+    }
   }
+
+  size_t numEvents = m_loadSize[0];
+  size_t startAt = m_loadStart[0];
+  // Pre-counting only helps when the events of a pixel are all added at once
+  const bool precount = m_loader.precount && wholeBank;
+  auto schedule = [&](const boost::shared_ptr<ProcessBankDataQueue> &queue,
+                      const uint32_t min_id, const uint32_t max_id) {
+    queue->push(Kernel::make_unique<ProcessBankData>(
+        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
+        numEvents, startAt, event_index, thisBankPulseTimes, m_have_weight,
+        event_weight_shrd, min_id, max_id, precount));
+    // Limit the number of blocks held in memory by helping out when the
+    // processing falls behind. The reader may wait here for the block being
+    // processed by a worker, so the disk I/O mutex, which the thread pool
+    // holds while this task runs, is released meanwhile to let the other
+    // banks be read.
+    if (queue->size() > MAX_QUEUED_BLOCKS) {
+      ScopedUnlock unlockIO(getMutex().get());
+      while (queue->size() > MAX_QUEUED_BLOCKS)
+        queue->runNext();
+    }
+    scheduler.push(
+        new RunQueuedBlockTask(queue, static_cast<double>(numEvents)));
+  };
+
+  if (m_min_id <= m_splitId)
+    schedule(m_lowQueue, m_min_id, std::min(m_max_id, m_splitId));
+  if (m_highQueue && m_max_id > m_splitId)
+    schedule(m_highQueue, std::max(m_min_id, m_splitId + 1), m_max_id);
 }
 
 /**
@@ -78,6 +78,7 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0),
       longest_tof(0), shortest_tof(0), bad_tofs(0), discarded_events(0),
+      m_readEventsTime(0), m_processEventsTime(0), m_loadEventsTime(0),
       compressTolerance(0), m_instrument_loaded_correctly(false),
       loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
 }
@@ -302,6 +303,36 @@ void LoadEventNexus::init() {
       make_unique<PropertyWithValue<bool>>("LoadLogs", true, Direction::Input),
       "Load the Sample/DAS logs from the file (default True).");
 
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty(
+      "FileBackedMemoryBudget", 0, mustBeNonNegative,
+      "If greater than 0, the memory, in MB, to hold the events of the "
+      "output workspace in. The events are kept in a scratch file in the "
+      "temporary directory, and only the spectra in use are loaded back "
+      "into memory. The events are all read into memory first.");
+
+  declareProperty(make_unique<PropertyWithValue<double>>(
+                      "ReadEventsTime", 0.0, Direction::Output),
+                  "Time spent reading the event data from the file, in "
+                  "seconds, summed over all threads.");
+
+  declareProperty(make_unique<PropertyWithValue<double>>(
+                      "ProcessEventsTime", 0.0, Direction::Output),
+                  "Time spent filling the event lists from the data read, in "
+                  "seconds, summed over all threads.");
+
+  declareProperty(make_unique<PropertyWithValue<double>>(
+                      "LoadEventsTime", 0.0, Direction::Output),
+                  "Elapsed time to read and process all the event data, in "
+                  "seconds. If it is close to ReadEventsTime the load is "
+                  "limited by the speed of the disk.");
+
+  std::string grp5 = "Timing";
+  setPropertyGroup("ReadEventsTime", grp5);
+  setPropertyGroup("ProcessEventsTime", grp5);
+  setPropertyGroup("LoadEventsTime", grp5);
+
 #ifdef MPI_EXPERIMENTAL
   declareProperty(make_unique<PropertyWithValue<bool>>("UseParallelLoader",
                                                        true, Direction::Input),
@@ -407,6 +438,9 @@ void LoadEventNexus::exec() {
                                                          // relies on an
   // object-level workspace ptr
   loadEvents(&prog, false); // Do not load monitor blocks
+  setProperty("ReadEventsTime", m_readEventsTime);
+  setProperty("ProcessEventsTime", m_processEventsTime);
+  setProperty("LoadEventsTime", m_loadEventsTime);
 
   if (discarded_events > 0) {
     g_log.information() << discarded_events
@@ -421,6 +455,11 @@ void LoadEventNexus::exec() {
 
   // add filename
   m_ws->mutableRun().addProperty("Filename", m_filename);
+
+  const int fileBackedMemoryBudget = getProperty("FileBackedMemoryBudget");
+  if (fileBackedMemoryBudget > 0)
+    m_ws->setFileBacked(static_cast<uint64_t>(fileBackedMemoryBudget) * 1024 *
+                        1024);
   // Save output
   this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
   // Load the monitors
@@ -639,6 +678,9 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   DateAndTime run_start(0, 0);
   // Initialize the counter of bad TOFs
   bad_tofs = 0;
+  m_readEventsTime = 0.;
+  m_processEventsTime = 0.;
+  m_loadEventsTime = 0.;
   int nPeriods = 1;
   auto periodLog = make_unique<const TimeSeriesProperty<int>>("period_log");
   if (!m_logs_loaded_correctly) {
@@ -856,6 +898,7 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
+  Timer loadTimer;
   bool loaded{false};
   if (canUseParallelLoader(haveWeights, oldNeXusFileNames, classType)) {
     auto ws = m_ws->getSingleHeldWorkspace();
@@ -882,6 +925,10 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
                              bankNumEvents, oldNeXusFileNames, precount, chunk,
                              totalChunks);
   }
+  m_loadEventsTime = loadTimer.elapsed();
+  g_log.debug() << "Loaded events in " << m_loadEventsTime << " s (read "
+                << m_readEventsTime << " s, processed " << m_processEventsTime
+                << " s summed over all threads)\n";
 
   // Info reporting
   const std::size_t eventsLoaded = m_ws->getNumberEvents();
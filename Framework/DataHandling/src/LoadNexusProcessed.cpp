@@ -171,13 +171,21 @@ bool isMultiPeriodFile(int nWorkspaceEntries, Workspace_sptr sampleWS,
   }
   return isMultiPeriod;
 }
+
+/// Hold the values of a spectrum in single precision as soon as it is loaded,
+/// so that the whole workspace is never held in double precision
+void holdInSinglePrecision(MatrixWorkspace &workspace, int index) {
+  if (auto workspace2D = dynamic_cast<Workspace2D *>(&workspace))
+    workspace2D->getSpectrum(index).setSinglePrecision(true);
+}
 }
 
 /// Default constructor
 LoadNexusProcessed::LoadNexusProcessed()
     : m_shared_bins(false), m_xbins(0), m_axis1vals(), m_list(false),
       m_interval(false), m_spec_min(0), m_spec_max(Mantid::EMPTY_INT()),
-      m_spec_list(), m_filtered_spec_idxs(), m_cppFile(nullptr) {}
+      m_spec_list(), m_filtered_spec_idxs(), m_singlePrecision(false),
+      m_cppFile(nullptr) {}
 
 /// Delete NexusFileIO in destructor
 LoadNexusProcessed::~LoadNexusProcessed() { delete m_cppFile; }
@@ -238,6 +246,12 @@ void LoadNexusProcessed::init() {
       "For multiperiod workspaces. Copy instrument, parameter and x-data "
       "rather than loading it directly for each workspace. Y, E and log "
       "information is always loaded.");
+  declareProperty("SinglePrecision", false,
+                  "If true, the Y and E values of a Workspace2D are held in "
+                  "single precision, halving their memory. Algorithms that "
+                  "change the values of a spectrum widen them back to double "
+                  "precision. Values saved in single precision are otherwise "
+                  "loaded in double precision.");
 }
 
 /**
@@ -378,6 +392,7 @@ void LoadNexusProcessed::exec() {
 
   // Throws an approriate exception if there is a problem with file access
   NXRoot root(getPropertyValue("Filename"));
+  m_singlePrecision = getProperty("SinglePrecision");
 
   // "Open" the same file but with the C++ interface
   m_cppFile = new ::NeXus::File(root.m_fileID);
@@ -1290,6 +1305,51 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
                          "last value will be dropped.\n";
   }
 
+  // Values written in single precision are read as such
+  if (data.type() == NX_FLOAT32) {
+    NXFloat floatData = wksp_cls.openFloatData();
+    NXFloat floatErrors = wksp_cls.openNXFloat("errors");
+    loadNonEventData(floatData, floatErrors, fracarea, hasFracArea, xErrors,
+                     hasXErrors, xbins, total_specs, nchannels, progressStart,
+                     progressRange, local_workspace);
+  } else {
+    loadNonEventData(data, errors, fracarea, hasFracArea, xErrors, hasXErrors,
+                     xbins, total_specs, nchannels, progressStart,
+                     progressRange, local_workspace);
+  }
+  if (m_singlePrecision) {
+    if (auto workspace2D =
+            boost::dynamic_pointer_cast<Workspace2D>(local_workspace))
+      workspace2D->setSinglePrecision(true);
+  }
+  return local_workspace;
+}
+
+/**
+ * Load the Y, E and optional fractional area and X error values of the
+ * spectra, in blocks.
+ * @param data :: The Y values
+ * @param errors :: The E values
+ * @param fracarea :: The fractional areas
+ * @param hasFracArea :: Flag to signal a RebinnedOutput workspace is in use
+ * @param xErrors :: The X error values
+ * @param hasXErrors :: Flag to signal the file contains x errors
+ * @param xbins :: The X values
+ * @param total_specs :: The number of spectra to load
+ * @param nchannels :: The number of values per spectrum
+ * @param progressStart :: The percentage value to start the progress reporting
+ * for this entry
+ * @param progressRange :: The percentage range that the progress reporting
+ * should cover
+ * @param local_workspace :: The workspace to load the values into
+ */
+template <typename T>
+void LoadNexusProcessed::loadNonEventData(
+    NXDataSetTyped<T> &data, NXDataSetTyped<T> &errors,
+    NXDataSetTyped<double> &fracarea, bool hasFracArea, NXDouble &xErrors,
+    bool hasXErrors, NXDouble &xbins, size_t total_specs, int nchannels,
+    const double &progressStart, const double &progressRange,
+    API::MatrixWorkspace_sptr local_workspace) {
   int blocksize = 8;
   // const int fullblocks = nspectra / blocksize;
   // size of the workspace
@@ -1422,7 +1482,6 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
       }
     }
   }
-  return local_workspace;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1852,18 +1911,19 @@ void LoadNexusProcessed::readBinMasking(
 * @param hist :: The workspace index to start reading into
 * @param local_workspace :: A pointer to the workspace
 */
-void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
-                                   NXDataSetTyped<double> &errors,
+template <typename T>
+void LoadNexusProcessed::loadBlock(NXDataSetTyped<T> &data,
+                                   NXDataSetTyped<T> &errors,
                                    NXDataSetTyped<double> &farea, bool hasFArea,
                                    NXDouble &xErrors, bool hasXErrors,
                                    int blocksize, int nchannels, int &hist,
                                    API::MatrixWorkspace_sptr local_workspace) {
   data.load(blocksize, hist);
   errors.load(blocksize, hist);
-  double *data_start = data();
-  double *data_end = data_start + nchannels;
-  double *err_start = errors();
-  double *err_end = err_start + nchannels;
+  T *data_start = data();
+  T *data_end = data_start + nchannels;
+  T *err_start = errors();
+  T *err_end = err_start + nchannels;
   double *farea_start = nullptr;
   double *farea_end = nullptr;
   double *xErrors_start = nullptr;
@@ -1912,6 +1972,8 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
     }
 
     local_workspace->setSharedX(hist, m_xbins.cowData());
+    if (m_singlePrecision)
+      holdInSinglePrecision(*local_workspace, hist);
     ++hist;
   }
 }
@@ -1934,8 +1996,9 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
 * @param local_workspace :: A pointer to the workspace
 */
 
-void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
-                                   NXDataSetTyped<double> &errors,
+template <typename T>
+void LoadNexusProcessed::loadBlock(NXDataSetTyped<T> &data,
+                                   NXDataSetTyped<T> &errors,
                                    NXDataSetTyped<double> &farea, bool hasFArea,
                                    NXDouble &xErrors, bool hasXErrors,
                                    int blocksize, int nchannels, int &hist,
@@ -1943,10 +2006,10 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
                                    API::MatrixWorkspace_sptr local_workspace) {
   data.load(blocksize, hist);
   errors.load(blocksize, hist);
-  double *data_start = data();
-  double *data_end = data_start + nchannels;
-  double *err_start = errors();
-  double *err_end = err_start + nchannels;
+  T *data_start = data();
+  T *data_end = data_start + nchannels;
+  T *err_start = errors();
+  T *err_end = err_start + nchannels;
   double *farea_start = nullptr;
   double *farea_end = nullptr;
   double *xErrors_start = nullptr;
@@ -1994,6 +2057,8 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
       xErrors_end += dx_input_increment;
     }
     local_workspace->setSharedX(wsIndex, m_xbins.cowData());
+    if (m_singlePrecision)
+      holdInSinglePrecision(*local_workspace, wsIndex);
     ++hist;
     ++wsIndex;
   }
@@ -2017,19 +2082,20 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
 * @param wsIndex :: The workspace index to save data into
 * @param local_workspace :: A pointer to the workspace
 */
-void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
-                                   NXDataSetTyped<double> &errors,
+template <typename T>
+void LoadNexusProcessed::loadBlock(NXDataSetTyped<T> &data,
+                                   NXDataSetTyped<T> &errors,
                                    NXDataSetTyped<double> &farea, bool hasFArea,
                                    NXDouble &xErrors, bool hasXErrors,
                                    NXDouble &xbins, int blocksize,
                                    int nchannels, int &hist, int &wsIndex,
                                    API::MatrixWorkspace_sptr local_workspace) {
   data.load(blocksize, hist);
-  double *data_start = data();
-  double *data_end = data_start + nchannels;
+  T *data_start = data();
+  T *data_end = data_start + nchannels;
   errors.load(blocksize, hist);
-  double *err_start = errors();
-  double *err_end = err_start + nchannels;
+  T *err_start = errors();
+  T *err_end = err_start + nchannels;
   double *farea_start = nullptr;
   double *farea_end = nullptr;
   double *xErrors_start = nullptr;
@@ -2085,6 +2151,8 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
     X.assign(xbin_start, xbin_end);
     xbin_start += nxbins;
     xbin_end += nxbins;
+    if (m_singlePrecision)
+      holdInSinglePrecision(*local_workspace, wsIndex);
     ++hist;
     ++wsIndex;
   }
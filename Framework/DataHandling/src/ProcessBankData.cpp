@@ -14,7 +14,7 @@ ProcessBankData::ProcessBankData(
     size_t startAt, boost::shared_ptr<std::vector<uint64_t>> event_index,
     boost::shared_ptr<BankPulseTimes> thisBankPulseTimes, bool have_weight,
     boost::shared_array<float> event_weight, detid_t min_event_id,
-    detid_t max_event_id)
+    detid_t max_event_id, bool precount)
     : Task(), m_loader(m_loader), entry_name(entry_name),
       pixelID_to_wi_vector(m_loader.pixelID_to_wi_vector),
       pixelID_to_wi_offset(m_loader.pixelID_to_wi_offset), prog(prog),
@@ -22,7 +22,7 @@ ProcessBankData::ProcessBankData(
       numEvents(numEvents), startAt(startAt), event_index(event_index),
       thisBankPulseTimes(thisBankPulseTimes), have_weight(have_weight),
       event_weight(event_weight), m_min_id(min_event_id),
-      m_max_id(max_event_id) {
+      m_max_id(max_event_id), m_precount(precount) {
   // Cost is approximately proportional to the number of events to process.
   m_cost = static_cast<double>(numEvents);
 }
@@ -31,6 +31,7 @@ ProcessBankData::ProcessBankData(
  * FIXME/TODO - split run() into readable methods
  */
 void ProcessBankData::run() { // override {
+  Kernel::Timer timer;
   // Local tof limits
   double my_shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -43,7 +44,7 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+  if (m_precount) {
 
     std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
@@ -234,6 +235,7 @@ void ProcessBankData::run() { // override {
     }
     alg->bad_tofs += badTofs;
     alg->discarded_events += my_discarded_events;
+    alg->m_processEventsTime += timer.elapsed_no_reset();
   }
 
 #ifndef _WIN32
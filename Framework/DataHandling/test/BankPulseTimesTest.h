@@ -0,0 +1,58 @@
+#ifndef MANTID_DATAHANDLING_BANKPULSETIMESTEST_H_
+#define MANTID_DATAHANDLING_BANKPULSETIMESTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/BankPulseTimes.h"
+
+using Mantid::Types::Core::DateAndTime;
+
+class BankPulseTimesTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BankPulseTimesTest *createSuite() { return new BankPulseTimesTest(); }
+  static void destroySuite(BankPulseTimesTest *suite) { delete suite; }
+
+  void test_constructor_from_times_finds_sort_order() {
+    BankPulseTimes sorted(createTimes({10, 20, 20, 30}));
+    TS_ASSERT_EQUALS(sorted.numPulses, 4);
+    TS_ASSERT(sorted.pulseTimesSorted);
+
+    BankPulseTimes unsorted(createTimes({10, 30, 20}));
+    TS_ASSERT(!unsorted.pulseTimesSorted);
+
+    BankPulseTimes empty(createTimes({}));
+    TS_ASSERT_EQUALS(empty.numPulses, 0);
+    TS_ASSERT(empty.pulseTimesSorted);
+  }
+
+  void test_constructor_from_range_of_other_pulses() {
+    BankPulseTimes all(createTimes({10, 20, 30, 40, 50}));
+    all.periodNumbers = {1, 2, 1, 2, 1};
+    BankPulseTimes window(all, 1, 4);
+    TS_ASSERT_EQUALS(window.numPulses, 3);
+    TS_ASSERT_EQUALS(window.pulseTimes[0], DateAndTime(int64_t(20)));
+    TS_ASSERT_EQUALS(window.pulseTimes[2], DateAndTime(int64_t(40)));
+    TS_ASSERT_EQUALS(window.periodNumbers, std::vector<int>({2, 1, 2}));
+    TS_ASSERT(window.pulseTimesSorted);
+    TS_ASSERT_EQUALS(window.startTime, all.startTime);
+  }
+
+  void test_constructor_from_empty_range() {
+    BankPulseTimes all(createTimes({10, 20}));
+    BankPulseTimes window(all, 1, 1);
+    TS_ASSERT_EQUALS(window.numPulses, 0);
+    TS_ASSERT(window.periodNumbers.empty());
+  }
+
+private:
+  std::vector<DateAndTime> createTimes(const std::vector<int64_t> &nanoseconds) {
+    std::vector<DateAndTime> times;
+    for (const auto ns : nanoseconds)
+      times.emplace_back(ns);
+    return times;
+  }
+};
+
+#endif /* MANTID_DATAHANDLING_BANKPULSETIMESTEST_H_ */
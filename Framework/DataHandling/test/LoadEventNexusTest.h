@@ -9,6 +9,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidDataHandling/LoadEventNexus.h"
@@ -272,6 +273,53 @@ public:
     }
   }
 
+  void test_timing_output_properties() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_timing");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    const double readTime = ld.getProperty("ReadEventsTime");
+    const double processTime = ld.getProperty("ProcessEventsTime");
+    const double loadTime = ld.getProperty("LoadEventsTime");
+    TS_ASSERT_LESS_THAN(0.0, readTime);
+    TS_ASSERT_LESS_THAN(0.0, processTime);
+    TS_ASSERT_LESS_THAN(0.0, loadTime);
+    AnalysisDataService::Instance().remove("cncs_timing");
+  }
+
+  void test_file_backed_loading() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    // The 112266 events take about 1.8 MB
+    ld.setProperty("FileBackedMemoryBudget", 1);
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    Workspace_sptr output = ld.getProperty("OutputWorkspace");
+    auto WS = boost::dynamic_pointer_cast<EventWorkspace>(output);
+    TS_ASSERT(WS);
+    if (!WS)
+      return;
+    TS_ASSERT(WS->isFileBacked());
+    TS_ASSERT_EQUALS(WS->getFileBacking()->getMemoryBudget(), 1024 * 1024);
+    TS_ASSERT_LESS_THAN_EQUALS(WS->getFileBacking()->getMemoryUsed(),
+                               1024 * 1024);
+    TS_ASSERT_EQUALS(WS->getNumberEvents(), 112266);
+    SpectraPinScope pinned(*WS);
+    TS_ASSERT(WS->getSpectrum(1000).getEvents()[0].pulseTime() >
+              DateAndTime(int64_t(1e9 * 365 * 10)));
+  }
+
   void test_TOF_filtered_loading() {
     const std::string wsName = "test_filtering";
     const double filterStart = 45000;
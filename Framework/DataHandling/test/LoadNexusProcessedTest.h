@@ -12,6 +12,7 @@
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
@@ -932,6 +933,14 @@ public:
     doTestLoadAndSavePointWS(true);
   }
 
+  void test_SaveAndLoadOnSinglePrecisionWS() {
+    doTestLoadAndSaveSinglePrecisionWS(true);
+  }
+
+  void test_SinglePrecisionWSIsLoadedInDoublePrecisionByDefault() {
+    doTestLoadAndSaveSinglePrecisionWS(false);
+  }
+
   void test_that_workspace_name_is_loaded() {
     // Arrange
     LoadNexusProcessed loader;
@@ -1428,6 +1437,46 @@ private:
     Poco::File("TestSaveAndLoadNexusProcessed.nxs").remove();
   }
 
+  void doTestLoadAndSaveSinglePrecisionWS(bool singlePrecision) {
+    auto inputWs = boost::make_shared<Workspace2D>();
+    inputWs->initialize(2, 3, 2);
+    inputWs->mutableX(0) = {1, 2, 3};
+    inputWs->mutableX(1) = {1, 2, 3};
+    inputWs->mutableY(0) = {1, 2};
+    inputWs->mutableY(1) = {0.5, 0.25};
+    inputWs->mutableE(1) = {0.75, 1.5};
+    inputWs->setSinglePrecision(true);
+
+    SaveNexusProcessed save;
+    save.initialize();
+    save.setProperty("InputWorkspace",
+                     boost::dynamic_pointer_cast<Workspace>(inputWs));
+    save.setPropertyValue("Filename", "TestSaveAndLoadSinglePrecision.nxs");
+    TS_ASSERT_THROWS_NOTHING(save.execute());
+
+    LoadNexusProcessed load;
+    load.initialize();
+    load.setChild(true);
+    load.setPropertyValue("Filename", save.getPropertyValue("Filename"));
+    load.setPropertyValue("OutputWorkspace", "dummy");
+    load.setProperty("SinglePrecision", singlePrecision);
+    TS_ASSERT_THROWS_NOTHING(load.execute());
+    Workspace_sptr output = load.getProperty("OutputWorkspace");
+    auto outputWs = boost::dynamic_pointer_cast<Workspace2D>(output);
+    TS_ASSERT(outputWs);
+    if (!outputWs)
+      return;
+    TS_ASSERT_EQUALS(outputWs->isSinglePrecision(), singlePrecision);
+    TS_ASSERT_EQUALS(outputWs->getSpectrum(1).isSinglePrecision(),
+                     singlePrecision);
+    TS_ASSERT_EQUALS(inputWs->x(1), outputWs->x(1));
+    TS_ASSERT_EQUALS(inputWs->y(0), outputWs->y(0));
+    TS_ASSERT_EQUALS(inputWs->y(1), outputWs->y(1));
+    TS_ASSERT_EQUALS(inputWs->e(1), outputWs->e(1));
+
+    Poco::File(save.getPropertyValue("Filename")).remove();
+  }
+
   std::string testFile, output_ws;
   /// Saved using SaveNexusProcessed and re-used in several load event tests
   std::string m_savedTmpEventFile;
@@ -0,0 +1,301 @@
+#ifndef MANTID_DATAOBJECTS_COMPACTMDEVENTLAYOUT_H_
+#define MANTID_DATAOBJECTS_COMPACTMDEVENTLAYOUT_H_
+
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDMortonCode.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/System.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** CompactMDEventLayout : A read-only, compact copy of the events of an
+  MDEventWorkspace, made once the workspace is built.
+
+  The box tree of an MDEventWorkspace holds the children of each MDGridBox as
+  pointers and the events of each MDBox in a vector of their own, so going
+  through the boxes jumps around the heap. Here all the events are held in a
+  single contiguous array, together with a flat index of the non-empty leaf
+  boxes: their extents, the range of their events in the array and their
+  total signal.
+
+  The boxes are ordered along the Morton (Z-order) curve of their centres, and
+  the events of each box along the curve of their own positions, so that the
+  events of boxes close in space are close in memory. A query over a region,
+  such as integrateSphere(), scans the index and then reads the events of the
+  boxes it partly overlaps in sequence.
+
+  Building the layout is a freeze step for read-only algorithms that query
+  the same workspace many times, such as IntegratePeaksMD2 with
+  UseCompactLayout. SaveMD with MortonOrder writes the boxes to file in the
+  same order. The layout does not follow changes to the workspace: build it
+  again after adding events.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport CompactMDEventLayout {
+public:
+  /// Index entry of a leaf box
+  struct BoxRange {
+    /// Lower bounds of the box
+    coord_t min[nd];
+    /// Upper bounds of the box
+    coord_t max[nd];
+    /// Index of the first event of the box
+    size_t begin;
+    /// Index past the last event of the box
+    size_t end;
+    /// Total signal of the events
+    signal_t signal;
+    /// Total squared error of the events
+    signal_t errorSquared;
+    /// Morton code of the centre of the box
+    uint64_t mortonCode;
+  };
+
+  /**
+  Constructor. Copies the events of the workspace.
+  @param ws : MDEventWorkspace to copy the events of.
+  */
+  explicit CompactMDEventLayout(MDEventWorkspace<MDE, nd> &ws)
+      : m_mortonCode(*ws.getBox()) {
+    std::vector<API::IMDNode *> leaves;
+    ws.getBox()->getBoxes(leaves, 1000, true);
+    // The non-empty leaves, with the Morton codes of their centres
+    std::vector<std::pair<uint64_t, MDBox<MDE, nd> *>> boxes;
+    for (auto leaf : leaves) {
+      auto box = dynamic_cast<MDBox<MDE, nd> *>(leaf);
+      if (!box || box->getNPoints() == 0)
+        continue;
+      coord_t center[nd];
+      box->getCenter(center);
+      boxes.emplace_back(mortonCode(center), box);
+    }
+    std::sort(boxes.begin(), boxes.end(),
+              [](const std::pair<uint64_t, MDBox<MDE, nd> *> &a,
+                 const std::pair<uint64_t, MDBox<MDE, nd> *> &b) {
+                return a.first < b.first;
+              });
+
+    m_boxes.resize(boxes.size());
+    size_t numEvents = 0;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      BoxRange &range = m_boxes[i];
+      for (size_t d = 0; d < nd; ++d) {
+        range.min[d] = boxes[i].second->getExtents(d).getMin();
+        range.max[d] = boxes[i].second->getExtents(d).getMax();
+      }
+      range.begin = numEvents;
+      numEvents += boxes[i].second->getNPoints();
+      range.end = numEvents;
+      range.mortonCode = boxes[i].first;
+    }
+    m_events.resize(numEvents);
+
+    // Each box fills its own part of the array. The events of a file-backed
+    // workspace are read one box at a time.
+    const auto numBoxes = static_cast<int64_t>(boxes.size());
+    PARALLEL_FOR_IF(!ws.isFileBacked())
+    for (int64_t i = 0; i < numBoxes; ++i) {
+      copyEvents(*boxes[i].second, m_boxes[i]);
+    }
+  }
+
+  /// @return the number of non-empty leaf boxes
+  size_t numBoxes() const { return m_boxes.size(); }
+  /// @return the index entry of a box
+  const BoxRange &box(const size_t i) const { return m_boxes[i]; }
+  /// @return the number of events
+  size_t numEvents() const { return m_events.size(); }
+  /// @return all the events, box after box
+  const std::vector<MDE> &events() const { return m_events; }
+  /// @return the memory used by the layout, in bytes
+  size_t getMemorySize() const {
+    return m_events.capacity() * sizeof(MDE) +
+           m_boxes.capacity() * sizeof(BoxRange);
+  }
+
+  /**
+  Compute the Morton code of a point from its position in the workspace.
+  Points outside the workspace are given the code of the nearest point inside.
+  @param coords : coordinates of the point.
+  @return the Morton code
+  */
+  uint64_t mortonCode(const coord_t *coords) const {
+    return m_mortonCode(coords);
+  }
+
+  /**
+  Find the boxes overlapping a region.
+  @param min : lower bounds of the region.
+  @param max : upper bounds of the region.
+  @return the indices of the boxes, in increasing order
+  */
+  std::vector<size_t> findBoxes(const coord_t *min, const coord_t *max) const {
+    std::vector<size_t> found;
+    for (size_t i = 0; i < m_boxes.size(); ++i) {
+      const BoxRange &range = m_boxes[i];
+      bool overlaps = true;
+      for (size_t d = 0; d < nd && overlaps; ++d)
+        overlaps = range.min[d] <= max[d] && min[d] <= range.max[d];
+      if (overlaps)
+        found.push_back(i);
+    }
+    return found;
+  }
+
+  /**
+  Integrate the signal of the events within a sphere or a spherical shell,
+  with the same sums as MDSphereIntegrator over the box tree. Boxes entirely
+  within the volume are added from the index without reading their events.
+  @param center : centre of the sphere.
+  @param radiusSquared : square of the outer radius.
+  @param[in,out] signal : the integrated signal is added to it.
+  @param[in,out] errorSquared : the integrated squared error is added to it.
+  @param innerRadiusSquared : square of the inner radius of the shell, 0 for
+  a sphere.
+  @param useOnePercentBackgroundCorrection : for a shell, drop the strongest
+  1% of the events of each partly covered box.
+  */
+  void integrateSphere(const coord_t *center, const coord_t radiusSquared,
+                       signal_t &signal, signal_t &errorSquared,
+                       const coord_t innerRadiusSquared = 0.0,
+                       const bool useOnePercentBackgroundCorrection =
+                           true) const {
+    std::vector<std::pair<signal_t, signal_t>> vals;
+    for (const auto &range : m_boxes) {
+      // Squared distances from the centre to the nearest and farthest points
+      // of the box
+      coord_t nearest = 0;
+      coord_t farthest = 0;
+      for (size_t d = 0; d < nd; ++d) {
+        const coord_t below = range.min[d] - center[d];
+        const coord_t above = center[d] - range.max[d];
+        const coord_t outside = std::max(std::max(below, above), coord_t(0));
+        nearest += outside * outside;
+        const coord_t far = std::max(std::abs(below), std::abs(above));
+        farthest += far * far;
+      }
+      // Entirely outside the sphere, or inside the hole of the shell
+      if (nearest >= radiusSquared ||
+          (innerRadiusSquared > 0.0 && farthest <= innerRadiusSquared))
+        continue;
+      if (farthest < radiusSquared &&
+          (innerRadiusSquared == 0.0 || nearest > innerRadiusSquared)) {
+        signal += range.signal;
+        errorSquared += range.errorSquared;
+        continue;
+      }
+      if (innerRadiusSquared == 0.0) {
+        for (size_t i = range.begin; i < range.end; ++i) {
+          if (distanceSquared(m_events[i], center) < radiusSquared) {
+            signal += static_cast<signal_t>(m_events[i].getSignal());
+            errorSquared +=
+                static_cast<signal_t>(m_events[i].getErrorSquared());
+          }
+        }
+        continue;
+      }
+      vals.clear();
+      for (size_t i = range.begin; i < range.end; ++i) {
+        const coord_t dist2 = distanceSquared(m_events[i], center);
+        if (dist2 < radiusSquared && dist2 > innerRadiusSquared)
+          vals.emplace_back(
+              static_cast<signal_t>(m_events[i].getSignal()),
+              static_cast<signal_t>(m_events[i].getErrorSquared()));
+      }
+      // Sort based on signal values and remove the top 1% of background, as
+      // MDSphereIntegrator does
+      std::sort(vals.begin(), vals.end(),
+                [](const std::pair<signal_t, signal_t> &a,
+                   const std::pair<signal_t, signal_t> &b) {
+                  return a.first < b.first;
+                });
+      const size_t endIndex =
+          useOnePercentBackgroundCorrection
+              ? static_cast<size_t>(0.99 * static_cast<double>(vals.size()))
+              : vals.size();
+      for (size_t k = 0; k < endIndex; ++k) {
+        signal += vals[k].first;
+        errorSquared += vals[k].second;
+      }
+    }
+  }
+
+private:
+  /// @return the squared distance from an event to a point
+  static coord_t distanceSquared(const MDE &event, const coord_t *center) {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t delta = event.getCenter(d) - center[d];
+      distanceSquared += delta * delta;
+    }
+    return distanceSquared;
+  }
+
+  /**
+  Copy the events of a box into its part of the array, along the Morton curve,
+  and sum their signal.
+  @param box : the box.
+  @param range : the index entry of the box.
+  */
+  void copyEvents(MDBox<MDE, nd> &box, BoxRange &range) {
+    const std::vector<MDE> &events = box.getConstEvents();
+    std::vector<std::pair<uint64_t, size_t>> order(events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+      coord_t center[nd];
+      for (size_t d = 0; d < nd; ++d)
+        center[d] = events[i].getCenter(d);
+      order[i] = std::make_pair(mortonCode(center), i);
+    }
+    std::sort(order.begin(), order.end());
+    range.signal = 0;
+    range.errorSquared = 0;
+    auto out = m_events.begin() + range.begin;
+    for (const auto &entry : order) {
+      const MDE &event = events[entry.second];
+      range.signal += static_cast<signal_t>(event.getSignal());
+      range.errorSquared += static_cast<signal_t>(event.getErrorSquared());
+      *out++ = event;
+    }
+    box.releaseEvents();
+  }
+
+  /// Morton codes in the region of the workspace
+  MDMortonCode m_mortonCode;
+  /// All the events, box after box
+  std::vector<MDE> m_events;
+  /// The index of the boxes
+  std::vector<BoxRange> m_boxes;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_COMPACTMDEVENTLAYOUT_H_ */
@@ -68,6 +68,13 @@ public:
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
   Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const override;
 
+  /// @return the index of the input dimension of each output one, sized [outD]
+  const size_t *getDimensionToBinFrom() const { return m_dimensionToBinFrom; }
+  /// @return the offset of each output dimension, sized [outD]
+  const coord_t *getOrigin() const { return m_origin; }
+  /// @return the scaling of each output dimension, sized [outD]
+  const coord_t *getScaling() const { return m_scaling; }
+
 protected:
   /// For each dimension in the output, index in the input workspace of which
   /// dimension it is
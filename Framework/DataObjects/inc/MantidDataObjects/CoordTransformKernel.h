@@ -0,0 +1,163 @@
+#ifndef MANTID_DATAOBJECTS_COORDTRANSFORMKERNEL_H_
+#define MANTID_DATAOBJECTS_COORDTRANSFORMKERNEL_H_
+
+#include "MantidAPI/CoordTransform.h"
+#include "MantidDataObjects/CoordTransformAffine.h"
+#include "MantidDataObjects/CoordTransformAligned.h"
+#include "MantidKernel/System.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** CoordTransformKernel : Applies a coordinate transformation from nd
+  dimensions to many points, without a virtual call per point.
+
+  CoordTransformAligned and CoordTransformAffine are copied into plain arrays
+  and applied in loops over the nd input dimensions that the compiler unrolls.
+  The arithmetic is the same as in their apply() methods, so the points are
+  transformed to exactly the same coordinates. Any other transformation is
+  applied through its virtual apply().
+
+  applyToEvents() transforms a batch of MD events at once, in a loop that the
+  compiler can vectorize.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <size_t nd> class DLLExport CoordTransformKernel {
+public:
+  /**
+  Constructor.
+  @param transform : the transformation, with nd input dimensions. It must
+  outlive the kernel.
+  */
+  explicit CoordTransformKernel(const API::CoordTransform &transform)
+      : m_transform(transform), m_outD(transform.getOutD()), m_kind(Generic) {
+    if (transform.getInD() != nd)
+      return;
+    if (auto aligned = dynamic_cast<const CoordTransformAligned *>(&transform)) {
+      m_kind = Aligned;
+      m_dimensionToBinFrom.assign(aligned->getDimensionToBinFrom(),
+                                  aligned->getDimensionToBinFrom() + m_outD);
+      m_origin.assign(aligned->getOrigin(), aligned->getOrigin() + m_outD);
+      m_scaling.assign(aligned->getScaling(), aligned->getScaling() + m_outD);
+    } else if (auto affine =
+                   dynamic_cast<const CoordTransformAffine *>(&transform)) {
+      m_kind = Affine;
+      const auto &matrix = affine->getMatrix();
+      m_matrix.resize(m_outD * (nd + 1));
+      for (size_t out = 0; out < m_outD; ++out)
+        for (size_t in = 0; in <= nd; ++in)
+          m_matrix[out * (nd + 1) + in] = matrix[out][in];
+    }
+  }
+
+  /// @return the number of output dimensions
+  size_t getOutD() const { return m_outD; }
+
+  /// @return true if the transformation is applied without virtual calls
+  bool isDevirtualized() const { return m_kind != Generic; }
+
+  /**
+  Transform a point.
+  @param in : coordinates of the point, sized nd.
+  @param out : transformed coordinates, sized getOutD().
+  */
+  void apply(const coord_t *in, coord_t *out) const {
+    switch (m_kind) {
+    case Aligned:
+      applyAligned(in, out);
+      break;
+    case Affine:
+      applyAffine(in, out);
+      break;
+    default:
+      m_transform.apply(in, out);
+    }
+  }
+
+  /**
+  Transform the centres of a batch of events.
+  @param events : the first event.
+  @param numEvents : number of events.
+  @param out : transformed coordinates, getOutD() per event.
+  */
+  template <typename MDE>
+  void applyToEvents(const MDE *events, const size_t numEvents,
+                     coord_t *out) const {
+    switch (m_kind) {
+    case Aligned:
+      for (size_t i = 0; i < numEvents; ++i)
+        applyAligned(events[i].getCenter(), out + i * m_outD);
+      break;
+    case Affine:
+      for (size_t i = 0; i < numEvents; ++i)
+        applyAffine(events[i].getCenter(), out + i * m_outD);
+      break;
+    default:
+      for (size_t i = 0; i < numEvents; ++i)
+        m_transform.apply(events[i].getCenter(), out + i * m_outD);
+    }
+  }
+
+private:
+  /// The kinds of transformation applied without virtual calls
+  enum Kind { Aligned, Affine, Generic };
+
+  /// Same arithmetic as CoordTransformAligned::apply()
+  void applyAligned(const coord_t *in, coord_t *out) const {
+    for (size_t d = 0; d < m_outD; ++d)
+      out[d] = (in[m_dimensionToBinFrom[d]] - m_origin[d]) * m_scaling[d];
+  }
+
+  /// Same arithmetic as CoordTransformAffine::apply()
+  void applyAffine(const coord_t *in, coord_t *out) const {
+    const coord_t *row = m_matrix.data();
+    for (size_t d = 0; d < m_outD; ++d, row += nd + 1) {
+      coord_t value = 0.0;
+      for (size_t i = 0; i < nd; ++i)
+        value += row[i] * in[i];
+      out[d] = value + row[nd];
+    }
+  }
+
+  /// The transformation
+  const API::CoordTransform &m_transform;
+  /// Number of output dimensions
+  const size_t m_outD;
+  /// How the transformation is applied
+  Kind m_kind;
+  /// For an aligned transformation, the input dimension of each output one
+  std::vector<size_t> m_dimensionToBinFrom;
+  /// For an aligned transformation, the origin of each output dimension
+  std::vector<coord_t> m_origin;
+  /// For an aligned transformation, the scaling of each output dimension
+  std::vector<coord_t> m_scaling;
+  /// For an affine transformation, the rows of the matrix but the last one
+  std::vector<coord_t> m_matrix;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_COORDTRANSFORMKERNEL_H_ */
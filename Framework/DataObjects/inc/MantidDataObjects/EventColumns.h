@@ -0,0 +1,122 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class Unit;
+}
+namespace DataObjects {
+
+/** EventColumns : A structure-of-arrays (columnar) store for the events of a
+  single spectrum. Each field of the events lives in its own contiguous array
+  so that kernels touching a single field (e.g. the time-of-flight) only pull
+  that field through the cache and can be vectorized by the compiler.
+
+  The columns mirror the three event types of EventList:
+   - TOF: tof and pulse-time columns, implied weight of 1.
+   - WEIGHTED: tof, pulse-time, weight and error-squared columns.
+   - WEIGHTED_NOTIME: tof, weight and error-squared columns.
+
+  An EventList can hold its events in an EventColumns instead of its vectors
+  of events (see EventList::switchToColumns()). It then runs the kernels below
+  on the columns, and moves the events back to rows for any other operation.
+  An EventColumns can also be created from an EventList and copied back into
+  one. Pulse times are stored as nanoseconds since the GPS epoch, as returned
+  by DateAndTime::totalNanoseconds().
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventColumns {
+public:
+  explicit EventColumns(API::EventType eventType = API::TOF);
+  explicit EventColumns(const EventList &eventList);
+
+  void copyInto(EventList &eventList) const;
+  void appendTo(std::vector<Types::Event::TofEvent> &events) const;
+  void appendTo(std::vector<WeightedEvent> &events) const;
+  void appendTo(std::vector<WeightedEventNoTime> &events) const;
+
+  API::EventType getEventType() const { return m_eventType; }
+  EventSortType getSortType() const { return m_order; }
+  bool hasPulseTimes() const { return m_eventType != API::WEIGHTED_NOTIME; }
+  bool hasWeights() const { return m_eventType != API::TOF; }
+
+  size_t size() const { return m_tofs.size(); }
+  bool empty() const { return m_tofs.empty(); }
+  size_t getMemorySize() const;
+
+  void reserve(size_t num);
+  void clear();
+
+  void addEvent(const double tof, const int64_t pulseTime);
+  void addEvent(const double tof, const int64_t pulseTime, const float weight,
+                const float errorSquared);
+
+  /// Read-only access to the time-of-flight column
+  const std::vector<double> &tofs() const { return m_tofs; }
+  /// Read-only access to the pulse-time column, in nanoseconds
+  const std::vector<int64_t> &pulseTimes() const { return m_pulseTimes; }
+  /// Read-only access to the weight column. Empty for TOF events
+  const std::vector<float> &weights() const { return m_weights; }
+  /// Read-only access to the error-squared column. Empty for TOF events
+  const std::vector<float> &errorSquareds() const { return m_errorSquareds; }
+
+  std::vector<double> &mutableTofs();
+  std::vector<int64_t> &mutablePulseTimes();
+  std::vector<float> &mutableWeights();
+  std::vector<float> &mutableErrorSquareds();
+
+  void generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E,
+                         bool skipError = false) const;
+
+  void convertTof(const double factor, const double offset = 0.);
+  void scaleTof(const double factor);
+  void maskTof(const double tofMin, const double tofMax);
+  void convertUnits(const Kernel::Unit &fromUnit, const Kernel::Unit &toUnit);
+  void reverse();
+
+private:
+  /// What type of event is held in the columns.
+  API::EventType m_eventType;
+  /// Sort order of the events in the columns.
+  EventSortType m_order;
+  /// Time-of-flight of each event.
+  std::vector<double> m_tofs;
+  /// Pulse time of each event, in nanoseconds. Empty for WEIGHTED_NOTIME.
+  std::vector<int64_t> m_pulseTimes;
+  /// Weight of each event. Empty for TOF.
+  std::vector<float> m_weights;
+  /// Squared error of each event. Empty for TOF.
+  std::vector<float> m_errorSquareds;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNS_H_ */
@@ -0,0 +1,104 @@
+#ifndef MANTID_DATAOBJECTS_EVENTHISTOGRAMMER_H_
+#define MANTID_DATAOBJECTS_EVENTHISTOGRAMMER_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventHistogrammer : Histograms events by TOF without requiring them to be
+  sorted.
+
+  The bin of each event is looked up directly instead of walking the events
+  and the bins in step. For bin edges of constant width or constant ratio, as
+  produced by Rebin or HistogramData::LinearGenerator and
+  LogarithmicGenerator, the bin index is computed arithmetically and corrected
+  against the neighbouring edges, so the result is exactly the one given by
+  comparing with the edges. Any other bin edges are searched with a two-level
+  binary search: a coarse table of every BLOCK_SIZE-th edge, small enough to
+  stay in cache, locates the block holding the bin, which is then searched.
+
+  The events are processed in batches: the bin indices of a batch are computed
+  in a tight loop that the compiler can vectorize, before the counts are
+  added to the histogram.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventHistogrammer {
+public:
+  /// How the bin index of a TOF is found
+  enum class BinningType { Linear, Logarithmic, Arbitrary };
+
+  /// Number of edges in a block of the binary search
+  static const size_t BLOCK_SIZE = 16;
+
+  explicit EventHistogrammer(const MantidVec &X);
+
+  /// @return how the bin index of a TOF is found
+  BinningType binningType() const { return m_binningType; }
+  /// @return the number of bins
+  size_t numberOfBins() const { return m_numBins; }
+
+  /// @return the bin of a TOF, or numberOfBins() if outside the edges
+  size_t findBin(const double tof) const;
+  /// Find the bins of a range of TOFs
+  void findBins(const double *first, const double *last, size_t *bins) const;
+
+  /// Add the number of events in each bin to Y
+  template <class T>
+  void countEvents(const std::vector<T> &events, MantidVec &Y) const;
+  /// Add the weights of the events to Y and their squared errors to E
+  template <class T>
+  void addWeights(const std::vector<T> &events, MantidVec &Y,
+                  MantidVec &E) const;
+
+private:
+  void detectBinning();
+  size_t estimateBin(const double tof) const;
+  size_t searchBin(const double tof) const;
+  size_t correctBin(const double tof, size_t bin) const;
+
+  /// The bin edges
+  const MantidVec &m_edges;
+  /// Number of bins
+  size_t m_numBins;
+  /// How the bin index is found
+  BinningType m_binningType;
+  /// Lowest edge
+  double m_min;
+  /// Highest edge
+  double m_max;
+  /// Offset of the first edge in the arithmetic estimate (X[0] or log(X[0]))
+  double m_offset;
+  /// Inverse of the bin width (or of the log of the bin ratio)
+  double m_inverseStep;
+  /// Every BLOCK_SIZE-th edge, for the binary search
+  std::vector<double> m_blockEdges;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTHISTOGRAMMER_H_ */
@@ -6,7 +6,9 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <algorithm>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -21,6 +23,7 @@ using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class EventColumns;
 class EventWorkspaceMRU;
 
 /// How the event list is sorted.
@@ -45,6 +48,11 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can also be held in columns (see EventColumns), one array per
+    field, after a call to switchToColumns(). Histogramming and the
+    time-of-flight conversions then only go through the time-of-flight
+    column; any other operation moves the events back to rows first.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 
@@ -106,6 +114,12 @@ public:
 
   EventList &operator-=(const EventList &more_events);
 
+  void addEventsSortedByTof(
+      const std::vector<Types::Event::TofEvent> &more_events);
+  void addEventsSortedByTof(const std::vector<WeightedEvent> &more_events);
+  void
+  addEventsSortedByTof(const std::vector<WeightedEventNoTime> &more_events);
+
   bool operator==(const EventList &rhs) const;
   bool operator!=(const EventList &rhs) const;
   bool equals(const EventList &rhs, const double tolTof, const double tolWeight,
@@ -119,6 +133,7 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    ensureRows();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -129,6 +144,7 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    ensureRows();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -139,14 +155,51 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    ensureRows();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
 
+  // --------------------------------------------------------------------------
+  /** Append a batch of events sharing a pulse time, without clearing the
+   * cache, to make it faster. The time-of-flight of each event is given by
+   * tofs[i] * tofFactor, so raw times can be converted as they are appended.
+   * The capacity of the list grows geometrically so repeated small batches do
+   * not cause a reallocation each time.
+   * NOTE: Only call this on a un-weighted event list!
+   *
+   * @param tofs :: Array of nEvents raw times-of-flight.
+   * @param nEvents :: Number of events to append.
+   * @param tofFactor :: Factor converting a raw tof to the list's tof unit.
+   * @param pulseTime :: Pulse time of all the events.
+   * */
+  template <typename T>
+  inline void addEventsQuickly(const T *tofs, const size_t nEvents,
+                               const double tofFactor,
+                               const Types::Core::DateAndTime pulseTime) {
+    ensureRows();
+    const size_t oldSize = this->events.size();
+    const size_t newSize = oldSize + nEvents;
+    if (newSize > this->events.capacity())
+      this->events.reserve(std::max(newSize, 2 * this->events.capacity()));
+    this->events.resize(newSize);
+    Types::Event::TofEvent *out = this->events.data() + oldSize;
+    for (size_t i = 0; i < nEvents; ++i)
+      out[i] = Types::Event::TofEvent(static_cast<double>(tofs[i]) * tofFactor,
+                                      pulseTime);
+    this->order = UNSORTED;
+  }
+
   Mantid::API::EventType getEventType() const override;
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void switchToColumns();
+  void switchToRows();
+  bool hasColumns() const;
+  const EventColumns &columns() const;
+  EventColumns &mutableColumns();
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -395,6 +448,14 @@ private:
   /// Last sorting order
   mutable EventSortType order;
 
+  /// The events, when they are held in columns rather than in the vectors
+  /// above. Null otherwise.
+  mutable std::unique_ptr<EventColumns> m_columns;
+
+  /// Ends of the runs of TOF-sorted events that an UNSORTED list starts with.
+  /// The events after the last run are in no known order.
+  mutable std::vector<size_t> m_tofSortedRunEnds;
+
   /// MRU lists of the parent EventWorkspace
   mutable EventWorkspaceMRU *mru;
 
@@ -422,6 +483,9 @@ private:
 
   void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
 
+  void generateHistogramUnsorted(const MantidVec &X, MantidVec &Y,
+                                 MantidVec &E, bool skipError) const;
+
   void generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const;
 
   void generateCountsHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
@@ -430,6 +494,16 @@ private:
 
   void generateErrorsHistogram(const MantidVec &Y, MantidVec &E) const;
 
+  /// Move the events back to the vectors if they are held in columns
+  void ensureRows() const {
+    if (m_columns)
+      moveColumnsToRows();
+  }
+  void moveColumnsToRows() const;
+
+  void updateSortOrderAfterAppend(const size_t previousSize);
+  void addTofSortedRun(const size_t previousSize);
+
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
   // should not be called externally
@@ -455,6 +529,9 @@ private:
       const double seconds);
 
   template <class T>
+  static void sortTofHelper(std::vector<T> &events,
+                            std::vector<size_t> sortedRunEnds);
+  template <class T>
   static void histogramForWeightsHelper(const std::vector<T> &events,
                                         const MantidVec &X, MantidVec &Y,
                                         MantidVec &E);
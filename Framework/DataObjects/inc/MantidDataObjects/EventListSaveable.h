@@ -0,0 +1,93 @@
+#ifndef MANTID_DATAOBJECTS_EVENTLISTSAVEABLE_H_
+#define MANTID_DATAOBJECTS_EVENTLISTSAVEABLE_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/ISaveable.h"
+
+#include <mutex>
+
+namespace Mantid {
+namespace DataObjects {
+class EventWorkspaceFileBacking;
+
+/** EventListSaveable : Saves and loads the events of one EventList to and from
+  the scratch file of a file-backed EventWorkspace, in conjunction with the
+  DiskBuffer of the EventWorkspaceFileBacking. The sizes reported to the
+  DiskBuffer are in bytes, so that its write buffer size is a memory budget.
+
+  Only the event vector is written out; the detector IDs, histogram and event
+  type of the EventList stay in memory. The sort order of the events written
+  out is restored when they are read back, and the list is marked unsorted
+  while its events are out of memory. While an EventList is pinned (in use by
+  a thread) it is marked busy and is never removed from memory.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventListSaveable : public Kernel::ISaveable {
+public:
+  EventListSaveable(EventList &eventList,
+                    const EventWorkspaceFileBacking &fileBacking);
+
+  /// Save the events at the file position given by the DiskBuffer
+  void save() const override;
+  /// Load the events from the file if they are not in memory
+  void load() override;
+  /// Flush the scratch file
+  void flushData() const override;
+  /// Remove the events from memory unless the list is pinned
+  void clearDataFromMemory() override;
+
+  /// @return the size of the events in bytes, in memory or on file
+  uint64_t getTotalDataSize() const override;
+  /// @return the size of the events held in memory, in bytes
+  size_t getDataMemorySize() const override;
+
+  /// Keep the events in memory (loading them if needed)
+  void pin(bool modify);
+  /// Allow the events to be removed from memory again
+  void unpin();
+  /// @return the number of events, in memory or on file
+  size_t getNumberEvents() const;
+
+private:
+  /// Read the events from the file; m_mutex must be held
+  void loadEvents();
+
+  /// The event list whose events are saved
+  EventList &m_eventList;
+  /// The file backing owning the scratch file
+  const EventWorkspaceFileBacking &m_fileBacking;
+  /// Number of events held in the file
+  mutable size_t m_numEventsOnFile;
+  /// Sort order of the events held in the file
+  mutable EventSortType m_sortOrderOnFile;
+  /// Number of times the list is pinned
+  size_t m_pinCount;
+  /// Protects the events against simultaneous save/load/pin
+  mutable std::mutex m_mutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTLISTSAVEABLE_H_ */
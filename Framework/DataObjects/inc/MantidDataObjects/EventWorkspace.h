@@ -6,6 +6,7 @@
 #include "MantidDataObjects/EventList.h"
 #include "MantidKernel/System.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <memory>
 #include <string>
 
 namespace Mantid {
@@ -14,6 +15,7 @@ class Progress;
 }
 
 namespace DataObjects {
+class EventWorkspaceFileBacking;
 class EventWorkspaceMRU;
 
 /** \class EventWorkspace
@@ -127,6 +129,8 @@ public:
   // data
   bool isHistogramData() const override;
 
+  bool isCommonBins() const override;
+
   std::size_t MRUSize() const;
 
   void clearMRU() const override;
@@ -142,15 +146,24 @@ public:
                             const bool entireRange) const override;
   EventWorkspace &operator=(const EventWorkspace &other) = delete;
 
+  // Keep the events in a scratch file, holding only part of them in memory
+  void setFileBacked(const std::string &fileName,
+                     const uint64_t memoryBudget);
+  bool isFileBacked() const;
+  const EventWorkspaceFileBacking *getFileBacking() const;
+
 protected:
   /// Protected copy constructor. May be used by childs for cloning.
   EventWorkspace(const EventWorkspace &other);
 
+  void updateCachedDetectorGrouping(const size_t index) const override;
+
 private:
   EventWorkspace *doClone() const override { return new EventWorkspace(*this); }
   EventWorkspace *doCloneEmpty() const override {
     return new EventWorkspace(storageMode());
   }
+  void throwIfFileBacked() const;
 
   /** A vector that holds the event list for each spectrum; the key is
    * the workspace index, which is not necessarily the pixelid.
@@ -159,6 +172,9 @@ private:
 
   /// Container for the MRU lists of the event lists contained.
   mutable EventWorkspaceMRU *mru;
+
+  /// The scratch file holding the events, if the workspace is file-backed.
+  std::unique_ptr<EventWorkspaceFileBacking> m_fileBacking;
 };
 
 /// shared pointer to the EventWorkspace class
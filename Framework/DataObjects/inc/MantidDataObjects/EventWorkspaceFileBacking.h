@@ -0,0 +1,151 @@
+#ifndef MANTID_DATAOBJECTS_EVENTWORKSPACEFILEBACKING_H_
+#define MANTID_DATAOBJECTS_EVENTWORKSPACEFILEBACKING_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidKernel/DiskBuffer.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class MatrixWorkspace;
+}
+namespace DataObjects {
+class EventList;
+class EventListSaveable;
+class EventWorkspace;
+
+/** EventWorkspaceFileBacking : Keeps the events of a file-backed
+  EventWorkspace in a scratch file, holding only a bounded set of the event
+  lists in memory.
+
+  The resident event lists are tracked by a Kernel::DiskBuffer, as for
+  file-backed MDEventWorkspaces, with its write buffer measured in bytes: once
+  the events in memory exceed the memory budget, the event lists that are not
+  in use are written to the scratch file and released from memory.
+
+  A spectrum is loaded and pinned when it is accessed through
+  EventWorkspace::getSpectrum(). The pin is held by the innermost
+  SpectraPinScope of the calling thread and released when the scope ends, so
+  the references to the spectrum stay valid for the lifetime of the scope. An
+  algorithm that opens a scope for each spectrum (or a few) streams through
+  the workspace without ever holding it in memory as a whole. The spectra
+  accessed outside any scope stay pinned until releaseSpectra() is called.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventWorkspaceFileBacking {
+public:
+  EventWorkspaceFileBacking(const std::string &fileName,
+                            const uint64_t memoryBudget);
+  EventWorkspaceFileBacking(const EventWorkspaceFileBacking &) = delete;
+  EventWorkspaceFileBacking &
+  operator=(const EventWorkspaceFileBacking &) = delete;
+  ~EventWorkspaceFileBacking();
+
+  /// Put the next spectrum under the control of the file backing
+  void addSpectrum(EventList &eventList);
+  /// Make sure the events of a spectrum are in memory and pin them
+  void loadSpectrum(const size_t index);
+  /// Mark a spectrum as modified so that it is written out again
+  void setSpectrumChanged(const size_t index) const;
+  /// Open a pin scope for the calling thread
+  void beginScope() const;
+  /// Unpin the spectra pinned in the innermost scope of the calling thread
+  void endScope() const;
+  /// Unpin the spectra pinned outside any scope, by all the threads
+  void releaseSpectra() const;
+  /// Write all the event lists that are not pinned out of memory
+  void flushCache();
+
+  /// @return the number of events of a spectrum, in memory or on file
+  size_t getNumberEvents(const size_t index) const;
+  /// @return the number of spectra
+  size_t getNumberSpectra() const { return m_saveables.size(); }
+  /// @return the name of the scratch file
+  const std::string &getFileName() const { return m_fileName; }
+  /// @return the memory budget in bytes
+  uint64_t getMemoryBudget() const {
+    return m_diskBuffer.getWriteBufferSize();
+  }
+  /// @return the bytes of events held in memory by the buffer
+  uint64_t getMemoryUsed() const { return m_diskBuffer.getWriteBufferUsed(); }
+
+  /// Write raw bytes to the scratch file
+  void writeData(const uint64_t position, const char *data,
+                 const uint64_t size) const;
+  /// Read raw bytes from the scratch file
+  void readData(const uint64_t position, char *data,
+                const uint64_t size) const;
+  /// Flush the writes to the scratch file
+  void flushData() const;
+
+private:
+  /// Unpin a spectrum and count its current size against the budget
+  void unpinSpectrum(const size_t index) const;
+
+  /// Name of the scratch file
+  std::string m_fileName;
+  /// The scratch file
+  mutable std::fstream m_file;
+  /// Protects the scratch file
+  mutable std::mutex m_fileMutex;
+  /// Tracks the event lists in memory and their place in the file
+  mutable Kernel::DiskBuffer m_diskBuffer;
+  /// The saveable of each spectrum, by workspace index
+  std::vector<std::unique_ptr<EventListSaveable>> m_saveables;
+  /// The spectra pinned by each thread, in its open scopes. The first entry
+  /// holds the spectra pinned outside any scope.
+  mutable std::map<std::thread::id, std::vector<std::set<size_t>>> m_pinned;
+  /// Protects m_pinned
+  mutable std::mutex m_pinMutex;
+};
+
+/** SpectraPinScope : Keeps the spectra of a file-backed EventWorkspace that
+  the calling thread accesses in memory for the lifetime of the scope. The
+  references returned by EventWorkspace::getSpectrum() must not outlive it.
+  Does nothing if the workspace is not a file-backed EventWorkspace, so that
+  algorithms taking any MatrixWorkspace can open one for each spectrum.
+*/
+class MANTID_DATAOBJECTS_DLL SpectraPinScope {
+public:
+  explicit SpectraPinScope(const API::MatrixWorkspace &workspace);
+  SpectraPinScope(const SpectraPinScope &) = delete;
+  SpectraPinScope &operator=(const SpectraPinScope &) = delete;
+  ~SpectraPinScope();
+
+private:
+  const EventWorkspaceFileBacking *m_fileBacking;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTWORKSPACEFILEBACKING_H_ */
@@ -5,6 +5,11 @@
 #include "MantidKernel/cow_ptr.h"
 #include "MantidKernel/System.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace Mantid {
 namespace DataObjects {
 /**
@@ -33,19 +38,30 @@ namespace DataObjects {
 */
 class DLLExport Histogram1D : public Mantid::API::ISpectrum {
 private:
-  /// Histogram object holding the histogram data.
-  HistogramData::Histogram m_histogram;
+  /// Histogram object holding the histogram data. Mutable since the Y and E
+  /// data of a spectrum held in single precision are widened on first access.
+  mutable HistogramData::Histogram m_histogram;
+
+  /// Y and E values held in single precision
+  struct SinglePrecisionData {
+    std::vector<float> y;
+    std::vector<float> e;
+  };
+  /// The Y and E values while the spectrum is held in single precision
+  mutable std::unique_ptr<SinglePrecisionData> m_singlePrecision;
+  /// True while the Y and E values are held in m_singlePrecision
+  mutable std::atomic<bool> m_isSinglePrecision{false};
 
 public:
   Histogram1D(HistogramData::Histogram::XMode xmode,
               HistogramData::Histogram::YMode ymode);
 
-  Histogram1D(const Histogram1D &) = default;
-  Histogram1D(Histogram1D &&) = default;
+  Histogram1D(const Histogram1D &other);
+  Histogram1D(Histogram1D &&other);
   Histogram1D(const ISpectrum &other);
 
-  Histogram1D &operator=(const Histogram1D &) = default;
-  Histogram1D &operator=(Histogram1D &&) = default;
+  Histogram1D &operator=(const Histogram1D &other);
+  Histogram1D &operator=(Histogram1D &&other);
   Histogram1D &operator=(const ISpectrum &rhs);
 
   void copyDataFrom(const ISpectrum &source) override;
@@ -64,17 +80,29 @@ public:
   void clearData() override;
 
   /// Deprecated, use y() instead. Returns the y data const
-  const MantidVec &dataY() const override { return m_histogram.dataY(); }
+  const MantidVec &dataY() const override {
+    widenIfSinglePrecision();
+    return m_histogram.dataY();
+  }
   /// Deprecated, use e() instead. Returns the error data const
-  const MantidVec &dataE() const override { return m_histogram.dataE(); }
+  const MantidVec &dataE() const override {
+    widenIfSinglePrecision();
+    return m_histogram.dataE();
+  }
 
   /// Deprecated, use mutableY() instead. Returns the y data
-  MantidVec &dataY() override { return m_histogram.dataY(); }
+  MantidVec &dataY() override {
+    widenIfSinglePrecision();
+    return m_histogram.dataY();
+  }
   /// Deprecated, use mutableE() instead. Returns the error data
-  MantidVec &dataE() override { return m_histogram.dataE(); }
+  MantidVec &dataE() override {
+    widenIfSinglePrecision();
+    return m_histogram.dataE();
+  }
 
   virtual std::size_t size() const {
-    return m_histogram.readY().size();
+    return m_histogram.size();
   } ///< get pseudo size
 
   /// Checks for errors
@@ -82,15 +110,62 @@ public:
 
   /// Gets the memory size of the histogram
   size_t getMemorySize() const override {
-    return ((readX().size() + readY().size() + readE().size()) *
-            sizeof(double));
+    const size_t valueSize =
+        m_isSinglePrecision ? sizeof(float) : sizeof(double);
+    return readX().size() * sizeof(double) + 2 * size() * valueSize;
+  }
+
+  HistogramData::Histogram histogram() const override;
+  HistogramData::Counts counts() const override;
+  HistogramData::CountVariances countVariances() const override;
+  HistogramData::CountStandardDeviations
+  countStandardDeviations() const override;
+  HistogramData::Frequencies frequencies() const override;
+  HistogramData::FrequencyVariances frequencyVariances() const override;
+  HistogramData::FrequencyStandardDeviations
+  frequencyStandardDeviations() const override;
+  const HistogramData::HistogramY &y() const override {
+    widenIfSinglePrecision();
+    return m_histogram.y();
+  }
+  const HistogramData::HistogramE &e() const override {
+    widenIfSinglePrecision();
+    return m_histogram.e();
+  }
+  Kernel::cow_ptr<HistogramData::HistogramY> sharedY() const override {
+    widenIfSinglePrecision();
+    return m_histogram.sharedY();
+  }
+  Kernel::cow_ptr<HistogramData::HistogramE> sharedE() const override {
+    widenIfSinglePrecision();
+    return m_histogram.sharedE();
   }
 
+  // Hold the Y and E values in single precision, or back in double precision
+  void setSinglePrecision(const bool singlePrecision);
+  /// @return true while the Y and E values are held in single precision
+  bool isSinglePrecision() const { return m_isSinglePrecision; }
+  void copySinglePrecisionY(std::vector<float> &y) const;
+  void copySinglePrecisionE(std::vector<float> &e) const;
+
 private:
+  Histogram1D(const Histogram1D &other, std::unique_lock<std::mutex> lock);
+  static std::mutex &valuesMutex(const Histogram1D &spectrum);
+  void copyValuesFrom(const Histogram1D &other);
+  /// Widens the Y and E values back to double precision, on first access to
+  /// them after setSinglePrecision(true)
+  void widenIfSinglePrecision() const {
+    if (m_isSinglePrecision)
+      widen();
+  }
+  void widen() const;
+
   using ISpectrum::copyDataInto;
   void copyDataInto(Histogram1D &sink) const override;
 
   void checkAndSanitizeHistogram(HistogramData::Histogram &histogram) override;
+  /// The Y and E values are about to be modified, widen them if need be
+  void checkIsYAndEWritable() const override { widenIfSinglePrecision(); }
   const HistogramData::Histogram &histogramRef() const override {
     return m_histogram;
   }
@@ -99,6 +174,26 @@ private:
   }
 };
 
+/** Read-only access to the Y and E values of a spectrum. The values of a
+  Histogram1D held in single precision are widened into a copy owned by this
+  object rather than in place, so reading them leaves the spectrum in single
+  precision.
+*/
+class DLLExport SpectrumValues {
+public:
+  explicit SpectrumValues(const API::ISpectrum &spectrum);
+  SpectrumValues(const SpectrumValues &) = delete;
+  SpectrumValues &operator=(const SpectrumValues &) = delete;
+
+  const MantidVec &y() const;
+  const MantidVec &e() const;
+
+private:
+  const API::ISpectrum &m_spectrum;
+  /// The widened copy of a spectrum held in single precision
+  std::unique_ptr<HistogramData::Histogram> m_widened;
+};
+
 } // namespace DataObjects
 } // Namespace Mantid
 #endif /*MANTID_DATAOBJECTS_HISTOGRAM1D_H_*/
@@ -72,7 +72,7 @@ public:
   /*** this function tries to set file positions of the boxes to
         make data physically located close to each other to be as close as
      possible on the HDD */
-  void setBoxesFilePositions(bool setFileBacked);
+  void setBoxesFilePositions(bool setFileBacked, bool mortonOrder = false);
 
   /**Save flat box structure into a file, defined by the file name*/
   void saveBoxStructure(const std::string &fileName);
@@ -0,0 +1,247 @@
+#ifndef MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_
+#define MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_
+
+#include "MantidAPI/BoxController.h"
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidKernel/ISaveable.h"
+#include "MantidKernel/System.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxPrefetcher : Reads the events of file-backed boxes in a background
+  thread ahead of an algorithm going through the boxes.
+
+  Without it, each box the algorithm reaches is read from the file on its own,
+  by a call to getConstEvents(), and the algorithm waits for the read. The
+  prefetcher is given the list of boxes the algorithm is about to go through,
+  in order, and reads their events ahead: consecutive boxes stored next to
+  each other in the file are read with a single call to loadBlock(), and the
+  next boxes are read while the algorithm works on the boxes already in
+  memory. The amount of events read ahead of the algorithm is bounded: the
+  next read starts once half of them were handed out.
+
+  Boxes are best given sorted by file position, so that the reads are both
+  large and sequential. Only the boxes with no events in memory and events on
+  file are read: the others are handed out as they are and load their events
+  as usual.
+
+  Usage: construct from the list of boxes and call next() until it returns
+  nullptr. The events of a box handed out by next() are in memory;
+  getConstEvents() and releaseEvents() are used on it as usual.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport MDBoxPrefetcher {
+public:
+  /// Default number of events read ahead of the algorithm
+  static const uint64_t DEFAULT_EVENTS_AHEAD = 4000000;
+
+  /**
+  Constructor. Starts reading the boxes.
+  @param boxes : the boxes to go through, in order. Those that are not MDBoxes
+  are skipped.
+  @param maxEventsAhead : most events to read ahead of the algorithm. A box
+  with more events than that is still read on its own.
+  */
+  MDBoxPrefetcher(const std::vector<API::IMDNode *> &boxes,
+                  const uint64_t maxEventsAhead = DEFAULT_EVENTS_AHEAD)
+      : m_maxEventsAhead(maxEventsAhead), m_next(0), m_ready(0),
+        m_eventsAhead(0), m_stop(false) {
+    for (auto node : boxes) {
+      auto box = dynamic_cast<MDBox<MDE, nd> *>(node);
+      if (!box)
+        continue;
+      m_boxes.push_back(box);
+      // Decided here, before the algorithm touches any box, so that the
+      // reading thread never looks at the state of the other boxes
+      const Kernel::ISaveable *saveable = box->getISaveable();
+      const bool toRead = saveable && saveable->wasSaved() &&
+                          !saveable->isLoaded() &&
+                          box->getDataInMemorySize() == 0;
+      m_eventsToRead.push_back(toRead ? saveable->getFileSize() : 0);
+    }
+    m_thread = std::thread(&MDBoxPrefetcher::readAhead, this);
+  }
+
+  /// Destructor. Stops reading and drops the events read ahead of next().
+  ~MDBoxPrefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_changed.notify_all();
+    m_thread.join();
+    for (size_t i = m_next; i < m_ready; ++i) {
+      if (m_eventsToRead[i] > 0)
+        m_boxes[i]->clearDataFromMemory();
+    }
+  }
+
+  MDBoxPrefetcher(const MDBoxPrefetcher &) = delete;
+  MDBoxPrefetcher &operator=(const MDBoxPrefetcher &) = delete;
+
+  /**
+  Wait for the events of the next box to be read.
+  @return the next box, or nullptr when all the boxes were handed out
+  */
+  MDBox<MDE, nd> *next() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this] {
+      return m_ready > m_next || m_next == m_boxes.size() || m_error;
+    });
+    if (m_next == m_ready && m_error)
+      std::rethrow_exception(m_error);
+    if (m_next == m_boxes.size())
+      return nullptr;
+    m_eventsAhead -= m_eventsToRead[m_next];
+    MDBox<MDE, nd> *box = m_boxes[m_next++];
+    lock.unlock();
+    m_changed.notify_all();
+    return box;
+  }
+
+private:
+  /// Body of the reading thread
+  void readAhead() {
+    try {
+      while (true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Wait for half the events read ahead to be handed out, so that the
+        // next read is a large one
+        m_changed.wait(lock, [this] {
+          return m_stop || m_eventsAhead <= m_maxEventsAhead / 2;
+        });
+        if (m_stop || m_ready == m_boxes.size())
+          break;
+        // Boxes that are not to be read are ready as they are
+        size_t first = m_ready;
+        while (first < m_boxes.size() && m_eventsToRead[first] == 0)
+          ++first;
+        // The run of boxes stored one after the other in the file
+        size_t last = first;
+        uint64_t numEvents = 0;
+        while (last < m_boxes.size() && m_eventsToRead[last] > 0 &&
+               (last == first ||
+                (isNextInFile(last - 1, last) &&
+                 m_eventsAhead + numEvents + m_eventsToRead[last] <=
+                     m_maxEventsAhead))) {
+          numEvents += m_eventsToRead[last];
+          ++last;
+        }
+        if (first > m_ready) {
+          m_ready = first;
+          m_changed.notify_all();
+        }
+        lock.unlock();
+
+        readRun(first, last, numEvents);
+
+        lock.lock();
+        m_ready = last;
+        m_eventsAhead += numEvents;
+        lock.unlock();
+        m_changed.notify_all();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_error = std::current_exception();
+    }
+    // Wake up next() when done, in any case
+    m_changed.notify_all();
+  }
+
+  /**
+  @return true if box second is stored right after box first in the file
+  */
+  bool isNextInFile(const size_t first, const size_t second) const {
+    return m_boxes[first]->getISaveable()->getFilePosition() +
+               m_eventsToRead[first] ==
+           m_boxes[second]->getISaveable()->getFilePosition();
+  }
+
+  /**
+  Read the events of a run of boxes stored one after the other in the file
+  with a single read, and hand them to the boxes.
+  @param first : index of the first box of the run.
+  @param last : index past the last box of the run.
+  @param numEvents : total number of events of the boxes.
+  */
+  void readRun(const size_t first, const size_t last,
+               const uint64_t numEvents) {
+    if (first == last)
+      return;
+    API::IBoxControllerIO *fileIO =
+        m_boxes[first]->getBoxController()->getFileIO();
+    std::vector<coord_t> table;
+    fileIO->loadBlock(table, m_boxes[first]->getISaveable()->getFilePosition(),
+                      numEvents);
+    const size_t numColumns = table.size() / numEvents;
+    std::vector<coord_t> boxTable;
+    auto begin = table.cbegin();
+    for (size_t i = first; i < last; ++i) {
+      const auto end = begin + m_eventsToRead[i] * numColumns;
+      boxTable.assign(begin, end);
+      begin = end;
+      m_boxes[i]->setEventsData(boxTable);
+      m_boxes[i]->getISaveable()->setLoaded(true);
+    }
+  }
+
+  /// The boxes, in the order they are handed out
+  std::vector<MDBox<MDE, nd> *> m_boxes;
+  /// Number of events to read for each box, 0 for those not read here
+  std::vector<uint64_t> m_eventsToRead;
+  /// Most events to read ahead of the algorithm
+  const uint64_t m_maxEventsAhead;
+  /// Index of the next box to hand out
+  size_t m_next;
+  /// Index past the last box that is ready to hand out
+  size_t m_ready;
+  /// Number of events read and not handed out yet
+  uint64_t m_eventsAhead;
+  /// Set to stop the reading thread
+  bool m_stop;
+  /// The exception thrown by the reading thread, if any
+  std::exception_ptr m_error;
+  /// Protects the indices and counters above
+  std::mutex m_mutex;
+  /// Notified when a box was read or handed out
+  std::condition_variable m_changed;
+  /// The reading thread
+  std::thread m_thread;
+};
+
+template <typename MDE, size_t nd>
+const uint64_t MDBoxPrefetcher<MDE, nd>::DEFAULT_EVENTS_AHEAD;
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_ */
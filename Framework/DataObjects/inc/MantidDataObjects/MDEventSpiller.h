@@ -0,0 +1,276 @@
+#ifndef MANTID_DATAOBJECTS_MDEVENTSPILLER_H_
+#define MANTID_DATAOBJECTS_MDEVENTSPILLER_H_
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/System.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDEventSpiller : Adds events to an MDEventWorkspace within a bounded
+  amount of memory, by spilling them to a scratch file sorted by top-level box
+  and building the box tree one top-level box at a time.
+
+  The events are first buffered by the top-level box (child of the top
+  MDGridBox) they fall in. Whenever the buffered events use up the memory
+  budget, all the buffers are appended, as one chunk per top-level box, to the
+  spill file. finish() then takes the top-level boxes one by one: it reads
+  back the chunks of the box, adds the events to it, splits it as needed and,
+  if the workspace is file-backed, writes its leaf boxes to the back-end file
+  and drops them from memory before going on to the next top-level box.
+
+  The budget covers the memory reserved by the buffers, not just the events
+  in them: a full buffer is grown by the spiller itself, and the buffers are
+  spilled first if the growth would take them past the budget. The peak
+  memory is thus the budget while adding, then the events of the largest
+  top-level box while finishing, instead of all the events of the workspace.
+  The spill file is removed by the destructor.
+
+  Usage: construct, call addEvent() for each event from a single thread, then
+  finish() and refreshCache() on the workspace.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport MDEventSpiller {
+public:
+  /// Smallest number of events by which a full buffer grows
+  static const size_t MIN_BUFFER_GROWTH = 16;
+
+  /**
+  Constructor. Splits the top box of the workspace if it is not split yet and
+  creates the spill file.
+  @param ws : MDEventWorkspace to add to.
+  @param memoryBudget : bytes the buffered events may take before they are
+  spilled.
+  @param spillFilename : path of the spill file, overwritten if it exists.
+  */
+  MDEventSpiller(MDEventWorkspace<MDE, nd> &ws, const size_t memoryBudget,
+                 const std::string &spillFilename)
+      : m_boxController(ws.getBoxController()),
+        m_maxBuffered(std::max(memoryBudget / sizeof(MDE), size_t(1))),
+        m_numReserved(0), m_numSpilled(0), m_numSpills(0),
+        m_spillFilename(spillFilename), m_fileEnd(0) {
+    ws.splitBox();
+    m_root = dynamic_cast<MDGridBox<MDE, nd> *>(ws.getBox());
+    for (size_t d = 0; d < nd; ++d) {
+      m_min[d] = m_root->getExtents(d).getMin();
+      m_max[d] = m_root->getExtents(d).getMax();
+    }
+    const size_t numCells = m_root->getNumChildren();
+    m_buffers.resize(numCells);
+    m_chunks.resize(numCells);
+    m_file.open(spillFilename, std::ios::in | std::ios::out |
+                                   std::ios::binary | std::ios::trunc);
+    if (!m_file)
+      throw std::runtime_error("MDEventSpiller: cannot create the spill file " +
+                               spillFilename);
+  }
+
+  MDEventSpiller(const MDEventSpiller &) = delete;
+  MDEventSpiller &operator=(const MDEventSpiller &) = delete;
+
+  /// Destructor. Removes the spill file, dropping the events not inserted.
+  ~MDEventSpiller() {
+    m_file.close();
+    std::remove(m_spillFilename.c_str());
+  }
+
+  /**
+  Buffer an event, and spill all the buffered events if they use up the
+  memory budget.
+  @param event : the event.
+  @return true if the event was accepted, false if it is outside the workspace
+  */
+  bool addEvent(const MDE &event) {
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t x = event.getCenter(d);
+      // The comparison is false for NaN, which is rejected too
+      if (!(x >= m_min[d] && x <= m_max[d]))
+        return false;
+    }
+    auto &buffer = m_buffers[m_root->getChildIndexFromEvent(event)];
+    if (buffer.size() == buffer.capacity()) {
+      // Spill rather than let the buffer grow past the budget
+      if (m_numReserved + growth(buffer) > m_maxBuffered)
+        spill();
+      const size_t extra = growth(buffer);
+      buffer.reserve(buffer.capacity() + extra);
+      m_numReserved += extra;
+    }
+    buffer.push_back(event);
+    return true;
+  }
+
+  /**
+  Insert all the events, one top-level box at a time. The cached signals and
+  number of points of the boxes are not updated: call refreshCache() on the
+  workspace afterwards.
+  */
+  void finish() {
+    std::vector<MDE> events;
+    for (size_t cell = 0; cell < m_buffers.size(); ++cell) {
+      size_t numEvents = m_buffers[cell].size();
+      for (const auto &chunk : m_chunks[cell])
+        numEvents += chunk.numEvents;
+      if (numEvents == 0)
+        continue;
+
+      events.resize(numEvents);
+      MDE *next = events.data();
+      for (const auto &chunk : m_chunks[cell]) {
+        m_file.seekg(chunk.offset);
+        m_file.read(reinterpret_cast<char *>(next),
+                    chunk.numEvents * sizeof(MDE));
+        next += chunk.numEvents;
+      }
+      if (!m_file)
+        throw std::runtime_error("MDEventSpiller: cannot read back the spill "
+                                 "file " +
+                                 m_spillFilename);
+      std::copy(m_buffers[cell].begin(), m_buffers[cell].end(), next);
+      std::vector<MDE>().swap(m_buffers[cell]);
+      m_chunks[cell].clear();
+
+      insert(cell, events);
+      std::vector<MDE>().swap(events);
+    }
+    m_numReserved = 0;
+  }
+
+  /// @return the bytes reserved by the buffers
+  size_t getBufferedMemorySize() const { return m_numReserved * sizeof(MDE); }
+  /// @return the number of events written to the spill file
+  size_t getNumSpilledEvents() const { return m_numSpilled; }
+  /// @return the number of times the buffered events were spilled
+  size_t getNumSpills() const { return m_numSpills; }
+
+private:
+  /// The events of a top-level box appended to the spill file at once
+  struct Chunk {
+    std::streamoff offset;
+    size_t numEvents;
+  };
+
+  /**
+  @param buffer : a full buffer.
+  @return the number of events to grow the buffer by, within the budget if
+  the buffers are empty
+  */
+  size_t growth(const std::vector<MDE> &buffer) const {
+    const size_t wanted = std::max(buffer.capacity(), MIN_BUFFER_GROWTH);
+    const size_t left =
+        m_maxBuffered > m_numReserved ? m_maxBuffered - m_numReserved : 0;
+    return std::min(wanted, std::max(left, size_t(1)));
+  }
+
+  /// Append all the buffered events to the spill file and empty the buffers
+  void spill() {
+    m_file.seekp(m_fileEnd);
+    for (size_t cell = 0; cell < m_buffers.size(); ++cell) {
+      auto &buffer = m_buffers[cell];
+      if (buffer.empty())
+        continue;
+      const auto numBytes =
+          static_cast<std::streamoff>(buffer.size() * sizeof(MDE));
+      m_file.write(reinterpret_cast<const char *>(buffer.data()), numBytes);
+      m_chunks[cell].push_back({m_fileEnd, buffer.size()});
+      m_fileEnd += numBytes;
+      m_numSpilled += buffer.size();
+      std::vector<MDE>().swap(buffer);
+    }
+    if (!m_file)
+      throw std::runtime_error("MDEventSpiller: cannot write to the spill "
+                               "file " +
+                               m_spillFilename);
+    m_numReserved = 0;
+    ++m_numSpills;
+  }
+
+  /**
+  Add the events of a top-level box, split the box as needed and, if the
+  workspace is file-backed, write its leaf boxes to disk.
+  @param cell : index of the top-level box.
+  @param events : all the events of the top-level box.
+  */
+  void insert(const size_t cell, const std::vector<MDE> &events) {
+    MDBoxBase<MDE, nd> *box = m_root->getBoxes()[cell];
+    box->addEventsUnsafe(events);
+    if (!box->isBox()) {
+      static_cast<MDGridBox<MDE, nd> *>(box)->splitAllIfNeeded(nullptr);
+    } else if (m_boxController->willSplit(box->getNPoints(),
+                                          box->getDepth())) {
+      // The new grid box is split recursively
+      m_root->splitContents(cell, nullptr);
+    } else {
+      Kernel::ISaveable *const saver = box->getISaveable();
+      if (saver && box->getDataInMemorySize() > 0)
+        m_boxController->getFileIO()->toWrite(saver);
+    }
+    if (m_boxController->isFileBacked())
+      m_boxController->getFileIO()->flushCache();
+  }
+
+  /// The box controller of the workspace
+  API::BoxController_sptr m_boxController;
+  /// The top box of the workspace
+  MDGridBox<MDE, nd> *m_root;
+  /// Lower bounds of the workspace
+  coord_t m_min[nd];
+  /// Upper bounds of the workspace
+  coord_t m_max[nd];
+  /// Number of events the buffers may have room for before they are spilled
+  const size_t m_maxBuffered;
+  /// Number of events the buffers have room for
+  size_t m_numReserved;
+  /// Number of events written to the spill file
+  size_t m_numSpilled;
+  /// Number of times the buffered events were spilled
+  size_t m_numSpills;
+  /// The buffered events of each top-level box
+  std::vector<std::vector<MDE>> m_buffers;
+  /// The chunks of the spill file holding the events of each top-level box
+  std::vector<std::vector<Chunk>> m_chunks;
+  /// Path of the spill file
+  const std::string m_spillFilename;
+  /// The spill file
+  std::fstream m_file;
+  /// Size of the spill file
+  std::streamoff m_fileEnd;
+};
+
+template <typename MDE, size_t nd>
+const size_t MDEventSpiller<MDE, nd>::MIN_BUFFER_GROWTH;
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDEVENTSPILLER_H_ */
@@ -106,6 +106,7 @@ public:
   bool isBox() const override { return false; }
 
   size_t getChildIndexFromID(size_t childId) const;
+  size_t getChildIndexFromEvent(const MDE &event) const;
   API::IMDNode *getChild(size_t index) override;
   void setChild(size_t index, MDGridBox<MDE, nd> *newChild);
 
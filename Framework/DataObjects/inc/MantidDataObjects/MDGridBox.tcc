@@ -683,6 +683,30 @@ TMDE(size_t MDGridBox)::getChildIndexFromID(size_t childId) const {
   return UNDEF_SIZET;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Get the index of the child holding an event. Unlike addEvent, an event on
+ * the upper boundary of a child in any dimension is given to that child, and
+ * an event just outside the box, e.g. after rounding, to the nearest child.
+ *
+ * @param event :: an event within the bounds of this box
+ * @return the index into the children of this grid box
+ */
+TMDE(size_t MDGridBox)::getChildIndexFromEvent(const MDE &event) const {
+  size_t cindex(0);
+  for (size_t d = 0; d < nd; d++) {
+    const double position =
+        (event.getCenter(d) - this->extents[d].getMin()) / m_SubBoxSize[d];
+    // The comparison is false for NaN, which goes into the first child
+    size_t index(0);
+    if (position > 0.)
+      index = position < static_cast<double>(split[d])
+                  ? static_cast<size_t>(position)
+                  : split[d] - 1;
+    cindex += index * splitCumul[d];
+  }
+  return cindex;
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Goes through all the sub-boxes and splits them if they contain
  * enough events to be worth it.
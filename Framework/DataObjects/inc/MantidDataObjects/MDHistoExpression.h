@@ -0,0 +1,124 @@
+#ifndef MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_
+#define MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_
+
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/System.h"
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDHistoExpression : An arithmetic expression over MDHistoWorkspaces and
+  scalars, evaluated in a single pass over the bins.
+
+  Chaining the arithmetic of MDHistoWorkspace (add(), multiply(), log(), ...)
+  makes one full pass over the signal and error arrays per operation, and each
+  intermediate result is a workspace of its own. An expression is built first
+  as a graph of operations, then evaluate() computes the result in blocks of
+  bins small enough to stay in the cache: for each block, every operation of
+  the graph is applied in turn to block-sized buffers, and only the final
+  result is written to the output workspace. No intermediate workspace is
+  allocated.
+
+  Signals, errors and numbers of events are propagated exactly as by the
+  corresponding methods of MDHistoWorkspace, so that
+
+    MDHistoExpression::multiply(MDHistoExpression::workspace(a),
+                                MDHistoExpression::scalar(2.0, 0.0))
+
+  gives the same result as a.multiply(2.0, 0.0). The masks of the output
+  workspace are left untouched.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MDHistoExpression {
+public:
+  using sptr = boost::shared_ptr<const MDHistoExpression>;
+
+  /// The operations of the nodes of an expression
+  enum class Operation {
+    Workspace,
+    Scalar,
+    Plus,
+    Minus,
+    Multiply,
+    Divide,
+    Log,
+    Log10,
+    Exp,
+    Power
+  };
+
+  /// Number of bins evaluated at once
+  static const size_t BLOCK_SIZE = 2048;
+
+  static sptr workspace(MDHistoWorkspace_const_sptr ws);
+  static sptr scalar(const signal_t signal, const signal_t error);
+  static sptr plus(sptr lhs, sptr rhs);
+  static sptr minus(sptr lhs, sptr rhs);
+  static sptr multiply(sptr lhs, sptr rhs);
+  static sptr divide(sptr lhs, sptr rhs);
+  static sptr log(sptr operand, const double filler = 0.0);
+  static sptr log10(sptr operand, const double filler = 0.0);
+  static sptr exp(sptr operand);
+  static sptr power(sptr operand, const double exponent);
+
+  /// @return the operation of this node
+  Operation getOperation() const { return m_operation; }
+
+  void evaluate(MDHistoWorkspace &out) const;
+
+private:
+  MDHistoExpression(const Operation operation, sptr lhs, sptr rhs);
+
+  /// Values of a node over a block of bins
+  struct Block;
+  /// The nodes of an expression, each after its operands
+  using Nodes = std::vector<const MDHistoExpression *>;
+
+  void collectNodes(Nodes &nodes) const;
+  void checkSize(const size_t numPoints) const;
+  Block evaluateBlock(const Block &lhs, const Block &rhs, const size_t begin,
+                      const size_t size, signal_t *buffer) const;
+
+  /// What this node computes
+  const Operation m_operation;
+  /// The left-hand side, or only, operand of an operation
+  const sptr m_lhs;
+  /// The right-hand side operand of a binary operation
+  const sptr m_rhs;
+  /// For a Workspace node, the workspace
+  MDHistoWorkspace_const_sptr m_workspace;
+  /// For a Scalar node, the signal
+  signal_t m_signal;
+  /// For a Scalar node, the squared error
+  signal_t m_errorSquared;
+  /// Filler of the logarithms, or exponent of a power
+  double m_parameter;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_ */
@@ -0,0 +1,76 @@
+#ifndef MANTID_DATAOBJECTS_MDMORTONCODE_H_
+#define MANTID_DATAOBJECTS_MDMORTONCODE_H_
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/System.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class IMDNode;
+}
+namespace DataObjects {
+
+/// Number of bits of a Morton code taken by each of nd dimensions
+constexpr size_t mortonBitsPerDimension(const size_t nd) {
+  return 64 / nd < 32 ? 64 / nd : 32;
+}
+
+DLLExport uint64_t interleaveBits(const uint64_t *cells, const size_t nd);
+
+/** MDMortonCode : Computes the Morton (Z-order) codes of the points of the
+  region of an MD box, usually the top box of a workspace.
+
+  The region is cut into 2^mortonBitsPerDimension(nd) cells along each
+  dimension, and the code of a point interleaves the bits of the indices of
+  its cell. Points close in space have close codes, so that sorting boxes or
+  events by their codes keeps neighbours next to each other in memory or on
+  file.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MDMortonCode {
+public:
+  /// Largest number of dimensions: each takes at least one bit of a code
+  static const size_t MAX_DIMENSIONS = 64;
+
+  explicit MDMortonCode(API::IMDNode &box);
+
+  /// @return the number of dimensions
+  size_t getNumDims() const { return m_min.size(); }
+  uint64_t operator()(const coord_t *coords) const;
+
+private:
+  /// Lower bounds of the region
+  std::vector<coord_t> m_min;
+  /// Cells per unit of each dimension
+  std::vector<coord_t> m_cellsPerUnit;
+  /// Largest cell index along a dimension
+  uint64_t m_maxCell;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDMORTONCODE_H_ */
@@ -0,0 +1,192 @@
+#ifndef MANTID_DATAOBJECTS_MDSPHEREINTEGRATOR_H_
+#define MANTID_DATAOBJECTS_MDSPHEREINTEGRATOR_H_
+
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/System.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDSphereIntegrator : Integrates the signal of an MDEventWorkspace within a
+  sphere or a spherical shell, with the event type and the number of
+  dimensions known at compile time.
+
+  This computes the same sums as MDBoxBase::integrateSphere() with a
+  CoordTransformDistance, without its virtual calls: the distance to the
+  centre is computed inline over statically-sized coordinate arrays, and the
+  box tree is walked by casting each box to MDGridBox or MDBox. It is meant to
+  be instantiated from a function that CALL_MDEVENT_FUNCTION has already
+  dispatched on the workspace type.
+
+  The boxes are sorted out with the distances from the centre to their nearest
+  and farthest points: the boxes lying entirely within the volume contribute
+  their cached signal, those lying partly within it are looked into, down to
+  their events. Call refreshCache() on the workspace beforehand.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport MDSphereIntegrator {
+public:
+  /**
+  Constructor.
+  @param center : centre of the sphere, sized nd.
+  @param dimensionsUsed : the dimensions the distance is computed in, sized nd.
+  */
+  MDSphereIntegrator(const coord_t *center, const bool *dimensionsUsed) {
+    for (size_t d = 0; d < nd; ++d) {
+      m_center[d] = center[d];
+      m_dimensionsUsed[d] = dimensionsUsed[d];
+    }
+  }
+
+  /**
+  Integrate the signal within a sphere or a spherical shell.
+  @param box : the box to integrate, usually the top box of the workspace.
+  @param radiusSquared : square of the outer radius.
+  @param[in,out] signal : the integrated signal is added to it.
+  @param[in,out] errorSquared : the integrated error squared is added to it.
+  @param innerRadiusSquared : square of the inner radius of the shell, 0 for
+  a sphere.
+  @param useOnePercentBackgroundCorrection : for a shell, drop the strongest
+  1% of the events of each box, as MDBox::integrateSphere() does.
+  */
+  void integrate(MDBoxBase<MDE, nd> *box, const coord_t radiusSquared,
+                 signal_t &signal, signal_t &errorSquared,
+                 const coord_t innerRadiusSquared = 0.0,
+                 const bool useOnePercentBackgroundCorrection = true) const {
+    if (box->isBox()) {
+      integrateEvents(static_cast<MDBox<MDE, nd> *>(box), radiusSquared,
+                      signal, errorSquared, innerRadiusSquared,
+                      useOnePercentBackgroundCorrection);
+      return;
+    }
+    for (auto child : static_cast<MDGridBox<MDE, nd> *>(box)->getBoxes()) {
+      coord_t nearest, farthest;
+      getDistancesSquared(*child, nearest, farthest);
+      // Entirely outside the sphere, or inside the hole of the shell
+      if (nearest >= radiusSquared ||
+          (innerRadiusSquared > 0.0 && farthest <= innerRadiusSquared))
+        continue;
+      if (farthest < radiusSquared &&
+          (innerRadiusSquared == 0.0 || nearest > innerRadiusSquared)) {
+        signal += child->getSignal();
+        errorSquared += child->getErrorSquared();
+      } else {
+        integrate(child, radiusSquared, signal, errorSquared,
+                  innerRadiusSquared, useOnePercentBackgroundCorrection);
+      }
+    }
+  }
+
+  /**
+  @param coords : coordinates of a point, sized nd.
+  @return the squared distance from the point to the centre
+  */
+  coord_t distanceSquared(const coord_t *coords) const {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      if (m_dimensionsUsed[d]) {
+        const coord_t dist = coords[d] - m_center[d];
+        distanceSquared += dist * dist;
+      }
+    }
+    return distanceSquared;
+  }
+
+private:
+  /// Squared distances from the centre to the nearest and farthest points of
+  /// a box
+  void getDistancesSquared(MDBoxBase<MDE, nd> &box, coord_t &nearest,
+                           coord_t &farthest) const {
+    nearest = 0;
+    farthest = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      if (!m_dimensionsUsed[d])
+        continue;
+      const auto &extents = box.getExtents(d);
+      const coord_t toMin = m_center[d] - extents.getMin();
+      const coord_t toMax = extents.getMax() - m_center[d];
+      if (toMin < 0)
+        nearest += toMin * toMin;
+      else if (toMax < 0)
+        nearest += toMax * toMax;
+      const coord_t far = std::max(std::abs(toMin), std::abs(toMax));
+      farthest += far * far;
+    }
+  }
+
+  /// Integrate the events of a leaf box, as MDBox::integrateSphere() does
+  void integrateEvents(MDBox<MDE, nd> *box, const coord_t radiusSquared,
+                       signal_t &signal, signal_t &errorSquared,
+                       const coord_t innerRadiusSquared,
+                       const bool useOnePercentBackgroundCorrection) const {
+    const std::vector<MDE> &events = box->getConstEvents();
+    if (innerRadiusSquared == 0.0) {
+      for (const auto &event : events) {
+        if (distanceSquared(event.getCenter()) < radiusSquared) {
+          signal += static_cast<signal_t>(event.getSignal());
+          errorSquared += static_cast<signal_t>(event.getErrorSquared());
+        }
+      }
+    } else {
+      std::vector<std::pair<signal_t, signal_t>> vals;
+      for (const auto &event : events) {
+        const coord_t dist2 = distanceSquared(event.getCenter());
+        if (dist2 < radiusSquared && dist2 > innerRadiusSquared)
+          vals.emplace_back(static_cast<signal_t>(event.getSignal()),
+                            static_cast<signal_t>(event.getErrorSquared()));
+      }
+      // Sort based on signal values and remove the top 1% of background
+      std::sort(vals.begin(), vals.end(),
+                [](const std::pair<signal_t, signal_t> &a,
+                   const std::pair<signal_t, signal_t> &b) {
+                  return a.first < b.first;
+                });
+      const size_t endIndex =
+          useOnePercentBackgroundCorrection
+              ? static_cast<size_t>(0.99 * static_cast<double>(vals.size()))
+              : vals.size();
+      for (size_t k = 0; k < endIndex; ++k) {
+        signal += vals[k].first;
+        errorSquared += vals[k].second;
+      }
+    }
+    box->releaseEvents();
+  }
+
+  /// Centre of the sphere
+  coord_t m_center[nd];
+  /// The dimensions the distance is computed in
+  bool m_dimensionsUsed[nd];
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDSPHEREINTEGRATOR_H_ */
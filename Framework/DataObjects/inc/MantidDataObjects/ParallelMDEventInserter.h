@@ -0,0 +1,263 @@
+#ifndef MANTID_DATAOBJECTS_PARALLELMDEVENTINSERTER_H_
+#define MANTID_DATAOBJECTS_PARALLELMDEVENTINSERTER_H_
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/System.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** ParallelMDEventInserter : Adds events to an MDEventWorkspace from many
+  threads at once, without locking the box tree and without stopping all the
+  threads to split boxes.
+
+  Each adding thread has a slot with its own staging buffers, one per top-level
+  box (child of the top MDGridBox). Staged events are handed over in batches to
+  the top-level box they fall in. Only one thread at a time inserts into a
+  top-level box and the boxes below it: a thread handing over a batch queues it
+  and, unless another thread already owns the box, takes ownership and inserts
+  all the queued batches. Ownership is only ever tried, never waited for, so
+  the threads keep converting events while another one is inserting. As each
+  top-level box has a single writer, the events are appended to the leaf boxes
+  without locks, and the leaf boxes that a batch filled up are split right
+  away.
+
+  Usage: construct with the number of adding threads, call addEvent() from
+  each thread with its own slot number, then finish() from a single thread
+  once they are done and refreshCache() on the workspace. The workspace must
+  not be file-backed.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport ParallelMDEventInserter {
+public:
+  /// Number of events staged for a top-level box before handing them over
+  static const size_t BATCH_SIZE = 512;
+  /// Number of events a thread stages in all before handing them all over
+  static const size_t MAX_STAGED_EVENTS = 65536;
+
+  /**
+  Constructor. Splits the top box of the workspace if it is not split yet.
+  @param ws : MDEventWorkspace to add to.
+  @param numThreads : number of thread slots.
+  */
+  ParallelMDEventInserter(MDEventWorkspace<MDE, nd> &ws,
+                          const size_t numThreads)
+      : m_boxController(ws.getBoxController()) {
+    ws.splitBox();
+    m_root = dynamic_cast<MDGridBox<MDE, nd> *>(ws.getBox());
+    for (size_t d = 0; d < nd; ++d) {
+      m_min[d] = m_root->getExtents(d).getMin();
+      m_max[d] = m_root->getExtents(d).getMax();
+    }
+    m_numCells = m_root->getNumChildren();
+    m_cells.reset(new Cell[m_numCells]);
+    m_slots.resize(numThreads);
+    for (auto &slot : m_slots)
+      slot.staging.resize(m_numCells);
+  }
+
+  /// Destructor. Drops the events that were not inserted.
+  ~ParallelMDEventInserter() {
+    for (size_t cell = 0; cell < m_numCells; ++cell) {
+      Batch *batch = m_cells[cell].pending.exchange(nullptr);
+      while (batch) {
+        Batch *next = batch->next;
+        delete batch;
+        batch = next;
+      }
+    }
+  }
+
+  /// @return the number of thread slots
+  size_t numThreads() const { return m_slots.size(); }
+
+  /**
+  Stage an event for adding. Thread-safe as long as each thread uses its own
+  slot.
+  @param thread : slot of the calling thread.
+  @param event : the event.
+  @return true if the event was accepted, false if it is outside the workspace
+  */
+  bool addEvent(const size_t thread, const MDE &event) {
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t x = event.getCenter(d);
+      // The comparison is false for NaN, which is rejected too
+      if (!(x >= m_min[d] && x <= m_max[d]))
+        return false;
+    }
+    Slot &slot = m_slots[thread];
+    const size_t cell = m_root->getChildIndexFromEvent(event);
+    auto &staging = slot.staging[cell];
+    staging.push_back(event);
+    ++slot.numStaged;
+    if (staging.size() >= BATCH_SIZE) {
+      slot.numStaged -= staging.size();
+      handOver(cell, staging);
+    } else if (slot.numStaged >= MAX_STAGED_EVENTS) {
+      flush(thread);
+    }
+    return true;
+  }
+
+  /**
+  Hand over all the events staged by a thread. Thread-safe as long as each
+  thread uses its own slot.
+  @param thread : slot of the thread.
+  */
+  void flush(const size_t thread) {
+    Slot &slot = m_slots[thread];
+    for (size_t cell = 0; cell < m_numCells; ++cell) {
+      if (!slot.staging[cell].empty())
+        handOver(cell, slot.staging[cell]);
+    }
+    slot.numStaged = 0;
+  }
+
+  /**
+  Insert all the staged events. To be called from a single thread once the
+  adding threads are done. The cached signals and number of points of the
+  boxes are not updated: call refreshCache() on the workspace afterwards.
+  */
+  void finish() {
+    for (size_t thread = 0; thread < m_slots.size(); ++thread)
+      flush(thread);
+  }
+
+private:
+  /// Events handed over for a top-level box, in a singly linked list
+  struct Batch {
+    std::vector<MDE> events;
+    Batch *next;
+  };
+
+  /// A top-level box
+  struct Cell {
+    /// Lock-free stack of the batches waiting to be inserted
+    std::atomic<Batch *> pending{nullptr};
+    /// Set while a thread is inserting into the box
+    std::atomic_flag owned = ATOMIC_FLAG_INIT;
+  };
+
+  /// The staging buffers of an adding thread
+  struct Slot {
+    /// Events staged for each top-level box
+    std::vector<std::vector<MDE>> staging;
+    /// Number of events staged in all
+    size_t numStaged = 0;
+  };
+
+  /**
+  Queue a batch of events for a top-level box and, unless another thread is
+  inserting into that box, insert the queued batches.
+  @param cell : index of the top-level box.
+  @param events : the events, left empty.
+  */
+  void handOver(const size_t cell, std::vector<MDE> &events) {
+    Cell &target = m_cells[cell];
+    auto batch = new Batch;
+    batch->events.swap(events);
+    batch->next = target.pending.load();
+    while (!target.pending.compare_exchange_weak(batch->next, batch)) {
+    }
+    // The owner checks for batches again after releasing the box, so a batch
+    // pushed while it was inserting is never left behind.
+    while (target.pending.load()) {
+      if (target.owned.test_and_set())
+        return;
+      batch = target.pending.exchange(nullptr);
+      while (batch) {
+        insert(cell, batch->events);
+        Batch *next = batch->next;
+        delete batch;
+        batch = next;
+      }
+      target.owned.clear();
+    }
+  }
+
+  /**
+  Insert a batch of events into a top-level box and split the leaf boxes that
+  the batch filled up. Only called by the thread owning the top-level box.
+  @param cell : index of the top-level box.
+  @param events : the events.
+  */
+  void insert(const size_t cell, const std::vector<MDE> &events) {
+    // Leaf boxes touched by the batch, as parent and index
+    std::vector<std::pair<MDGridBox<MDE, nd> *, size_t>> touched;
+    for (const auto &event : events) {
+      MDGridBox<MDE, nd> *parent = m_root;
+      size_t index = cell;
+      MDBoxBase<MDE, nd> *box = m_root->getBoxes()[cell];
+      while (!box->isBox()) {
+        parent = static_cast<MDGridBox<MDE, nd> *>(box);
+        index = parent->getChildIndexFromEvent(event);
+        box = parent->getBoxes()[index];
+      }
+      static_cast<MDBox<MDE, nd> *>(box)->addEventUnsafe(event);
+      if (touched.empty() || touched.back() != std::make_pair(parent, index))
+        touched.emplace_back(parent, index);
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (const auto &leaf : touched) {
+      MDBoxBase<MDE, nd> *box = leaf.first->getBoxes()[leaf.second];
+      if (m_boxController->willSplit(box->getNPoints(), box->getDepth()))
+        leaf.first->splitContents(leaf.second, nullptr);
+    }
+  }
+
+  /// The box controller of the workspace
+  API::BoxController_sptr m_boxController;
+  /// The top box of the workspace
+  MDGridBox<MDE, nd> *m_root;
+  /// Lower bounds of the workspace
+  coord_t m_min[nd];
+  /// Upper bounds of the workspace
+  coord_t m_max[nd];
+  /// Number of top-level boxes
+  size_t m_numCells;
+  /// The top-level boxes
+  std::unique_ptr<Cell[]> m_cells;
+  /// The thread slots
+  std::vector<Slot> m_slots;
+};
+
+template <typename MDE, size_t nd>
+const size_t ParallelMDEventInserter<MDE, nd>::BATCH_SIZE;
+
+template <typename MDE, size_t nd>
+const size_t ParallelMDEventInserter<MDE, nd>::MAX_STAGED_EVENTS;
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_PARALLELMDEVENTINSERTER_H_ */
@@ -0,0 +1,109 @@
+#ifndef MANTID_DATAOBJECTS_SPARSEMDHISTOGRID_H_
+#define MANTID_DATAOBJECTS_SPARSEMDHISTOGRID_H_
+
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/System.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** SparseMDHistoGrid : A scratch accumulator for the signals of the bins of
+  an MDHistoWorkspace, stored in bricks that are allocated only once a signal
+  is added to one of their bins.
+
+  The grid is not a workspace: the accumulated signals are written to the
+  signal array of a dense MDHistoWorkspace with copyTo() or addTo() once they
+  are complete. It saves the memory of a temporary array the size of the
+  output, not that of the output itself, which MDNormSCD and MDNormDirectSC
+  needed to sum their normalization from several threads.
+
+  The bins are numbered by the linear index of MDHistoWorkspace and grouped
+  into bricks of consecutive bins. A bin of a brick that was never allocated
+  is 0. Grids of reciprocal space from single-crystal normalization are mostly
+  empty: their bricks take a fraction of the memory of a dense array of the
+  same size.
+
+  Signals can be added to the grid from several threads at once. The other
+  methods must not run at the same time as additions.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport SparseMDHistoGrid {
+public:
+  /// Default number of bins of a brick
+  static const size_t DEFAULT_BRICK_SIZE = 4096;
+
+  SparseMDHistoGrid(const size_t numPoints,
+                    const size_t brickSize = DEFAULT_BRICK_SIZE);
+  ~SparseMDHistoGrid();
+  SparseMDHistoGrid(const SparseMDHistoGrid &) = delete;
+  SparseMDHistoGrid &operator=(const SparseMDHistoGrid &) = delete;
+
+  /// @return the number of bins
+  size_t getNPoints() const { return m_numPoints; }
+  /// @return the number of bins of a brick
+  size_t getBrickSize() const { return m_brickSize; }
+  /// @return the number of bricks, allocated or not
+  size_t getNumBricks() const { return m_numBricks; }
+  size_t getNumAllocatedBricks() const;
+  /// @return true if the brick was allocated
+  bool isBrickAllocated(const size_t brick) const {
+    return this->brick(brick) != nullptr;
+  }
+  size_t getMemorySize() const;
+
+  void addSignal(const size_t index, const signal_t signal);
+  /// @return the signal of a bin
+  signal_t getSignalAt(const size_t index) const {
+    const auto signals = brick(index / m_brickSize);
+    return signals ? signals[index % m_brickSize].load() : 0;
+  }
+
+  void copyTo(MDHistoWorkspace &ws) const;
+  void addTo(MDHistoWorkspace &ws) const;
+
+private:
+  /// @return a brick, nullptr if not allocated
+  const std::atomic<signal_t> *brick(const size_t brick) const {
+    return m_bricks[brick].load(std::memory_order_acquire);
+  }
+  std::atomic<signal_t> *allocate(const size_t brick);
+  void checkSize(const size_t numPoints) const;
+  void toArray(signal_t *signals, const bool add) const;
+
+  /// Number of bins
+  const size_t m_numPoints;
+  /// Number of bins of a brick
+  const size_t m_brickSize;
+  /// Number of bricks
+  const size_t m_numBricks;
+  /// The bricks of signals, nullptr until a signal is added to them
+  std::unique_ptr<std::atomic<std::atomic<signal_t> *>[]> m_bricks;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_SPARSEMDHISTOGRID_H_ */
@@ -95,6 +95,11 @@ public:
                      bool loadAsRectImg = false, double scale_1 = 1.0,
                      bool parallelExecution = true);
 
+  // Hold the Y and E values of the spectra in single precision
+  void setSinglePrecision(const bool singlePrecision);
+  bool isSinglePrecision() const;
+  size_t getMemorySize() const override;
+
 protected:
   /// Protected copy constructor. May be used by childs for cloning.
   Workspace2D(const Workspace2D &other);
@@ -110,6 +115,9 @@ protected:
   /// A vector that holds the 1D histograms
   std::vector<Histogram1D *> data;
 
+  /// True if the Y and E values are held in single precision
+  bool m_singlePrecision{false};
+
 private:
   Workspace2D *doClone() const override;
   Workspace2D *doCloneEmpty() const override;
@@ -117,6 +125,10 @@ private:
   virtual std::size_t getHistogramNumberHelper() const;
 };
 
+// Hold the Y and E values of output in single precision if input holds them so
+DLLExport void propagateSinglePrecision(const API::MatrixWorkspace &input,
+                                        API::MatrixWorkspace &output);
+
 /// shared pointer to the Workspace2D class
 using Workspace2D_sptr = boost::shared_ptr<Workspace2D>;
 /// shared pointer to a const Workspace2D
@@ -0,0 +1,374 @@
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidKernel/Unit.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+using namespace Mantid::API;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of events whose bin indices are computed in one block when
+/// histogramming. Small enough for the index block to stay in L1 cache.
+constexpr size_t HISTOGRAM_BLOCK_SIZE = 1024;
+
+/// Remove the entries of column for which keep is false, preserving order.
+template <typename T>
+void compactColumn(std::vector<T> &column, const std::vector<char> &keep) {
+  if (column.empty())
+    return;
+  size_t out = 0;
+  for (size_t i = 0; i < column.size(); ++i) {
+    column[out] = column[i];
+    out += static_cast<size_t>(keep[i]);
+  }
+  column.resize(out);
+}
+} // namespace
+
+/** Constructor
+ * @param eventType :: type of events that will be held in the columns
+ */
+EventColumns::EventColumns(EventType eventType)
+    : m_eventType(eventType), m_order(UNSORTED) {}
+
+/** Constructor copying the events of an EventList into columns.
+ * The sort order of the list is preserved.
+ * @param eventList :: EventList to copy
+ */
+EventColumns::EventColumns(const EventList &eventList)
+    : m_eventType(eventList.getEventType()),
+      m_order(eventList.getSortType()) {
+  if (eventList.hasColumns()) {
+    *this = eventList.columns();
+    return;
+  }
+  const size_t numEvents = eventList.getNumberEvents();
+  reserve(numEvents);
+  switch (m_eventType) {
+  case TOF:
+    for (const auto &event : eventList.getEvents()) {
+      m_tofs.push_back(event.tof());
+      m_pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+    }
+    break;
+  case WEIGHTED:
+    for (const auto &event : eventList.getWeightedEvents()) {
+      m_tofs.push_back(event.tof());
+      m_pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+      m_weights.push_back(event.m_weight);
+      m_errorSquareds.push_back(event.m_errorSquared);
+    }
+    break;
+  case WEIGHTED_NOTIME:
+    for (const auto &event : eventList.getWeightedEventsNoTime()) {
+      m_tofs.push_back(event.tof());
+      m_weights.push_back(event.m_weight);
+      m_errorSquareds.push_back(event.m_errorSquared);
+    }
+    break;
+  }
+}
+
+/** Replace the events of an EventList with the events held in the columns.
+ * The detector IDs and X values of the list are left untouched. The list is
+ * switched to the event type of the columns if that is possible; if the list
+ * already holds a more general type the events are converted to it. A list
+ * holding WeightedEventNoTime keeps that type and the pulse times of the
+ * columns are dropped.
+ * @param eventList :: EventList to fill
+ */
+void EventColumns::copyInto(EventList &eventList) const {
+  eventList.clear(false);
+  if (m_eventType != TOF && eventList.getEventType() != WEIGHTED_NOTIME)
+    eventList.switchTo(m_eventType);
+
+  switch (eventList.getEventType()) {
+  case TOF:
+    appendTo(eventList.getEvents());
+    break;
+  case WEIGHTED:
+    appendTo(eventList.getWeightedEvents());
+    break;
+  case WEIGHTED_NOTIME:
+    appendTo(eventList.getWeightedEventsNoTime());
+    break;
+  }
+  eventList.setSortOrder(m_order);
+}
+
+/** Append the events held in the columns to a vector of TofEvent.
+ * @param events :: vector to append to
+ * @throw std::runtime_error if the columns hold weighted events
+ */
+void EventColumns::appendTo(std::vector<TofEvent> &events) const {
+  if (m_eventType != TOF)
+    throw std::runtime_error("EventColumns::appendTo() called with TofEvent's "
+                             "on columns holding weighted events.");
+  const size_t numEvents = size();
+  events.reserve(events.size() + numEvents);
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(m_tofs[i], DateAndTime(m_pulseTimes[i]));
+}
+
+/** Append the events held in the columns to a vector of WeightedEvent.
+ * Unweighted events get a weight and error of 1.
+ * @param events :: vector to append to
+ * @throw std::runtime_error if the columns hold no pulse times
+ */
+void EventColumns::appendTo(std::vector<WeightedEvent> &events) const {
+  if (!hasPulseTimes())
+    throw std::runtime_error("EventColumns::appendTo() called with "
+                             "WeightedEvent's on columns without pulse times.");
+  const size_t numEvents = size();
+  events.reserve(events.size() + numEvents);
+  for (size_t i = 0; i < numEvents; ++i) {
+    if (hasWeights())
+      events.emplace_back(m_tofs[i], DateAndTime(m_pulseTimes[i]),
+                          m_weights[i], m_errorSquareds[i]);
+    else
+      events.emplace_back(TofEvent(m_tofs[i], DateAndTime(m_pulseTimes[i])));
+  }
+}
+
+/** Append the events held in the columns to a vector of WeightedEventNoTime.
+ * Any pulse times are dropped and unweighted events get a weight and error
+ * of 1.
+ * @param events :: vector to append to
+ */
+void EventColumns::appendTo(std::vector<WeightedEventNoTime> &events) const {
+  const size_t numEvents = size();
+  events.reserve(events.size() + numEvents);
+  for (size_t i = 0; i < numEvents; ++i) {
+    if (hasWeights())
+      events.emplace_back(m_tofs[i], m_weights[i], m_errorSquareds[i]);
+    else
+      events.emplace_back(m_tofs[i], 1.0f, 1.0f);
+  }
+}
+
+/// @return the memory used by the columns, in bytes
+size_t EventColumns::getMemorySize() const {
+  return m_tofs.capacity() * sizeof(double) +
+         m_pulseTimes.capacity() * sizeof(int64_t) +
+         m_weights.capacity() * sizeof(float) +
+         m_errorSquareds.capacity() * sizeof(float) + sizeof(EventColumns);
+}
+
+/** Reserve space for a number of events in every column in use.
+ * @param num :: number of events that will be held
+ */
+void EventColumns::reserve(size_t num) {
+  m_tofs.reserve(num);
+  if (hasPulseTimes())
+    m_pulseTimes.reserve(num);
+  if (hasWeights()) {
+    m_weights.reserve(num);
+    m_errorSquareds.reserve(num);
+  }
+}
+
+/// Remove all events and release the memory of the columns.
+void EventColumns::clear() {
+  std::vector<double>().swap(m_tofs);
+  std::vector<int64_t>().swap(m_pulseTimes);
+  std::vector<float>().swap(m_weights);
+  std::vector<float>().swap(m_errorSquareds);
+  m_order = UNSORTED;
+}
+
+/** Append an unweighted event.
+ * @param tof :: time-of-flight of the event
+ * @param pulseTime :: pulse time of the event in nanoseconds
+ * @throw std::runtime_error if the columns hold weighted events
+ */
+void EventColumns::addEvent(const double tof, const int64_t pulseTime) {
+  if (m_eventType != TOF)
+    throw std::runtime_error("EventColumns::addEvent() called without a "
+                             "weight on columns holding weighted events.");
+  m_tofs.push_back(tof);
+  m_pulseTimes.push_back(pulseTime);
+  m_order = UNSORTED;
+}
+
+/** Append a weighted event. The pulse time is ignored if the columns hold
+ * WeightedEventNoTime.
+ * @param tof :: time-of-flight of the event
+ * @param pulseTime :: pulse time of the event in nanoseconds
+ * @param weight :: weight of the event
+ * @param errorSquared :: square of the error of the event
+ * @throw std::runtime_error if the columns hold unweighted events
+ */
+void EventColumns::addEvent(const double tof, const int64_t pulseTime,
+                            const float weight, const float errorSquared) {
+  if (m_eventType == TOF)
+    throw std::runtime_error("EventColumns::addEvent() called with a weight "
+                             "on columns holding unweighted events.");
+  m_tofs.push_back(tof);
+  if (hasPulseTimes())
+    m_pulseTimes.push_back(pulseTime);
+  m_weights.push_back(weight);
+  m_errorSquareds.push_back(errorSquared);
+  m_order = UNSORTED;
+}
+
+/** Mutable access to the time-of-flight column. Any sort order is cleared
+ * because the caller may change the values.
+ */
+std::vector<double> &EventColumns::mutableTofs() {
+  m_order = UNSORTED;
+  return m_tofs;
+}
+
+/** Mutable access to the pulse-time column. Any sort order is cleared
+ * because the caller may change the values.
+ */
+std::vector<int64_t> &EventColumns::mutablePulseTimes() {
+  m_order = UNSORTED;
+  return m_pulseTimes;
+}
+
+/// Mutable access to the weight column.
+std::vector<float> &EventColumns::mutableWeights() { return m_weights; }
+
+/// Mutable access to the error-squared column.
+std::vector<float> &EventColumns::mutableErrorSquareds() {
+  return m_errorSquareds;
+}
+
+/** Generate the Y and E histograms w.r.t TOF. The events do not need to be
+ * sorted: the bin index of each event is computed independently, in blocks,
+ * and the counts are then accumulated in a second pass.
+ *
+ * @param X: x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error. This has no effect for weighted
+ *        events; you can just ignore the returned E vector.
+ */
+void EventColumns::generateHistogram(const MantidVec &X, MantidVec &Y,
+                                     MantidVec &E, bool skipError) const {
+  const size_t x_size = X.size();
+  if (x_size <= 1) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    E.resize(0, 0);
+    return;
+  }
+
+  // One extra entry collects the events outside of the binning range, which
+  // saves a branch in the accumulation loops.
+  Y.assign(x_size, 0.0);
+  E.assign(x_size, 0.0);
+
+  const EventHistogrammer histogrammer(X);
+  std::array<size_t, HISTOGRAM_BLOCK_SIZE> bins;
+  const size_t numEvents = size();
+  for (size_t start = 0; start < numEvents; start += HISTOGRAM_BLOCK_SIZE) {
+    const size_t stop = std::min(numEvents, start + HISTOGRAM_BLOCK_SIZE);
+    const size_t blockSize = stop - start;
+    histogrammer.findBins(m_tofs.data() + start, m_tofs.data() + stop,
+                          bins.data());
+    if (hasWeights()) {
+      const float *weights = m_weights.data() + start;
+      const float *errorSquareds = m_errorSquareds.data() + start;
+      for (size_t i = 0; i < blockSize; ++i) {
+        Y[bins[i]] += double(weights[i]);
+        E[bins[i]] += double(errorSquareds[i]);
+      }
+    } else {
+      for (size_t i = 0; i < blockSize; ++i)
+        Y[bins[i]] += 1.0;
+    }
+  }
+
+  Y.resize(x_size - 1);
+  E.resize(x_size - 1);
+  if (hasWeights()) {
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  } else if (!skipError) {
+    std::transform(Y.begin(), Y.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  }
+}
+
+/**
+ * Convert the time of flight by tof'=tof*factor+offset
+ * @param factor :: The value to scale the time-of-flight by
+ * @param offset :: The value to shift the time-of-flight by
+ */
+void EventColumns::convertTof(const double factor, const double offset) {
+  double *tofs = m_tofs.data();
+  const size_t numEvents = m_tofs.size();
+  for (size_t i = 0; i < numEvents; ++i)
+    tofs[i] = tofs[i] * factor + offset;
+
+  if ((factor < 0.) && (m_order == TOF_SORT))
+    this->reverse();
+  else if (factor < 0.)
+    m_order = UNSORTED;
+}
+
+/**
+ * Convert the time of flight by scaling by a multiplier.
+ * @param factor :: conversion factor (e.g. multiply TOF by this to get
+ * d-spacing)
+ */
+void EventColumns::scaleTof(const double factor) {
+  this->convertTof(factor, 0.0);
+}
+
+/**
+ * Mask out events that have a tof between tofMin and tofMax (inclusively).
+ * Events are removed from the columns and the relative order of the
+ * remaining events is preserved, so the events do not need to be sorted.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ */
+void EventColumns::maskTof(const double tofMin, const double tofMax) {
+  if (tofMax <= tofMin)
+    throw std::runtime_error("EventColumns::maskTof: tofMax must be > tofMin");
+
+  const size_t numEvents = m_tofs.size();
+  std::vector<char> keep(numEvents);
+  const double *tofs = m_tofs.data();
+  for (size_t i = 0; i < numEvents; ++i)
+    keep[i] = static_cast<char>(tofs[i] < tofMin || tofs[i] > tofMax);
+
+  compactColumn(m_tofs, keep);
+  compactColumn(m_pulseTimes, keep);
+  compactColumn(m_weights, keep);
+  compactColumn(m_errorSquareds, keep);
+}
+
+/**
+ * Convert the time-of-flight column from one unit to another, converting all
+ * the values in a single call to the units. The sort order is left as it is:
+ * if the conversion reverses the order, use the EventList to reverse it back.
+ * @param fromUnit :: the unit the values are in. Must be initialized.
+ * @param toUnit :: the unit to convert to. Must be initialized.
+ */
+void EventColumns::convertUnits(const Kernel::Unit &fromUnit,
+                                const Kernel::Unit &toUnit) {
+  fromUnit.convertTo(toUnit, m_tofs.data(), m_tofs.data(), m_tofs.size());
+}
+
+/// Reverse the order of the events in all columns. The sort order is kept,
+/// as for a list sorted by TOF whose bin boundaries are reversed as well.
+void EventColumns::reverse() {
+  std::reverse(m_tofs.begin(), m_tofs.end());
+  std::reverse(m_pulseTimes.begin(), m_pulseTimes.end());
+  std::reverse(m_weights.begin(), m_weights.end());
+  std::reverse(m_errorSquareds.begin(), m_errorSquareds.end());
+}
+
+} // namespace DataObjects
+} // namespace Mantid
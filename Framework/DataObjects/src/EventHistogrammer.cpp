@@ -0,0 +1,266 @@
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidDataObjects/Events.h"
+
+#include <algorithm>
+#include <cmath>
+
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of events whose bins are computed in one batch. Small enough for
+/// the TOFs and bins of a batch to stay in L1 cache.
+const size_t BATCH_SIZE = 512;
+/// Largest deviation of an edge from a constant binning, in bin widths
+const double BINNING_TOLERANCE = 1e-3;
+
+/** Branch-free binary search.
+ * @param first :: start of a sorted range
+ * @param count :: length of the range, at least 1
+ * @param x :: value to search
+ * @return the index of the last element not greater than x, or 0 if all
+ * the elements are greater than x
+ */
+size_t lastNotGreater(const double *first, size_t count, const double x) {
+  const double *base = first;
+  while (count > 1) {
+    const size_t half = count / 2;
+    base = (base[half] <= x) ? base + half : base;
+    count -= half;
+  }
+  return static_cast<size_t>(base - first);
+}
+
+/** Check if values are equally spaced
+ * @param values :: the values to check
+ * @param count :: number of values to check from the start
+ * @param step :: returns the spacing
+ * @return true if the values are equally spaced within BINNING_TOLERANCE
+ */
+bool isEquallySpaced(const std::vector<double> &values, const size_t count,
+                     double &step) {
+  step = (values[count - 1] - values[0]) / static_cast<double>(count - 1);
+  if (!(step > 0.) || !std::isfinite(step))
+    return false;
+  for (size_t i = 1; i < count; ++i) {
+    const double expected = values[0] + static_cast<double>(i) * step;
+    if (std::abs(values[i] - expected) > BINNING_TOLERANCE * step)
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+const size_t EventHistogrammer::BLOCK_SIZE;
+
+/** Constructor. Works out how to find the bin of a TOF.
+ * @param X :: the bin edges, sorted in ascending order. The reference must
+ * stay valid while the histogrammer is used.
+ */
+EventHistogrammer::EventHistogrammer(const MantidVec &X)
+    : m_edges(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0),
+      m_binningType(BinningType::Arbitrary), m_min(0.), m_max(0.),
+      m_offset(0.), m_inverseStep(0.) {
+  if (m_numBins == 0)
+    return;
+  m_min = X.front();
+  m_max = X.back();
+  detectBinning();
+  if (m_binningType == BinningType::Arbitrary) {
+    m_blockEdges.reserve(X.size() / BLOCK_SIZE + 1);
+    for (size_t i = 0; i < X.size(); i += BLOCK_SIZE)
+      m_blockEdges.push_back(X[i]);
+  }
+}
+
+/** Detect linear or logarithmic binning. The last bin may have any width, as
+ * Rebin may make it up to 25% narrower or wider than the others.
+ */
+void EventHistogrammer::detectBinning() {
+  if (m_numBins < 2)
+    return;
+  // Edges to check: all but the last one
+  const size_t count = m_numBins;
+  double step;
+  if (isEquallySpaced(m_edges, count, step)) {
+    m_binningType = BinningType::Linear;
+    m_offset = m_min;
+    m_inverseStep = 1. / step;
+    return;
+  }
+  if (m_min > 0.) {
+    std::vector<double> logEdges(count);
+    std::transform(m_edges.begin(), m_edges.begin() + count, logEdges.begin(),
+                   static_cast<double (*)(double)>(std::log));
+    if (isEquallySpaced(logEdges, count, step)) {
+      m_binningType = BinningType::Logarithmic;
+      m_offset = logEdges.front();
+      m_inverseStep = 1. / step;
+    }
+  }
+}
+
+/** Find the bin of a TOF
+ * @param tof :: the TOF
+ * @return the index of the bin holding tof, or numberOfBins() if tof is
+ * outside the edges
+ */
+size_t EventHistogrammer::findBin(const double tof) const {
+  if (m_numBins == 0 || !(tof >= m_min && tof < m_max))
+    return m_numBins;
+  if (m_binningType == BinningType::Arbitrary)
+    return searchBin(tof);
+  return correctBin(tof, estimateBin(tof));
+}
+
+/** Estimate the bin of a TOF arithmetically, for linear or logarithmic
+ * binning. The estimate is within [0, numberOfBins()) even for a TOF outside
+ * the edges.
+ */
+size_t EventHistogrammer::estimateBin(const double tof) const {
+  const double x =
+      (m_binningType == BinningType::Logarithmic) ? std::log(tof) : tof;
+  // NaN and -inf end up in the first bin
+  const double position = std::min(
+      static_cast<double>(m_numBins - 1),
+      std::max(0., (x - m_offset) * m_inverseStep));
+  return static_cast<size_t>(position);
+}
+
+/** Search the bin of a TOF inside the edges, in the block table first and
+ * then in the block. */
+size_t EventHistogrammer::searchBin(const double tof) const {
+  const size_t block =
+      lastNotGreater(m_blockEdges.data(), m_blockEdges.size(), tof);
+  const size_t start = block * BLOCK_SIZE;
+  const size_t count = std::min(BLOCK_SIZE, m_edges.size() - start);
+  const size_t bin = start + lastNotGreater(m_edges.data() + start, count, tof);
+  return std::min(bin, m_numBins - 1);
+}
+
+/** Move an estimated bin to the one holding a TOF inside the edges, by
+ * comparing with the edges. */
+size_t EventHistogrammer::correctBin(const double tof, size_t bin) const {
+  while (tof < m_edges[bin])
+    --bin;
+  while (tof >= m_edges[bin + 1])
+    ++bin;
+  return bin;
+}
+
+/** Find the bins of a range of TOFs. The bins are first estimated for the
+ * whole range, in a loop free of branches, and then corrected.
+ * @param first :: start of the TOFs
+ * @param last :: end of the TOFs
+ * @param bins :: returns the bin of each TOF, or numberOfBins() for the TOFs
+ * outside the edges
+ */
+void EventHistogrammer::findBins(const double *first, const double *last,
+                                 size_t *bins) const {
+  const size_t count = static_cast<size_t>(last - first);
+  if (m_numBins == 0) {
+    std::fill(bins, bins + count, m_numBins);
+    return;
+  }
+  const double maxPosition = static_cast<double>(m_numBins - 1);
+  switch (m_binningType) {
+  case BinningType::Linear:
+    for (size_t i = 0; i < count; ++i) {
+      const double position = (first[i] - m_offset) * m_inverseStep;
+      bins[i] = static_cast<size_t>(
+          std::min(maxPosition, std::max(0., position)));
+    }
+    break;
+  case BinningType::Logarithmic:
+    for (size_t i = 0; i < count; ++i) {
+      const double position = (std::log(first[i]) - m_offset) * m_inverseStep;
+      bins[i] = static_cast<size_t>(
+          std::min(maxPosition, std::max(0., position)));
+    }
+    break;
+  case BinningType::Arbitrary:
+    break;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    const double tof = first[i];
+    if (!(tof >= m_min && tof < m_max))
+      bins[i] = m_numBins;
+    else if (m_binningType == BinningType::Arbitrary)
+      bins[i] = searchBin(tof);
+    else
+      bins[i] = correctBin(tof, bins[i]);
+  }
+}
+
+/** Add the number of events in each bin to the counts. Events outside the
+ * edges are ignored.
+ * @param events :: the events, in any order
+ * @param Y :: the counts, of size numberOfBins()
+ */
+template <class T>
+void EventHistogrammer::countEvents(const std::vector<T> &events,
+                                    MantidVec &Y) const {
+  double tofs[BATCH_SIZE];
+  size_t bins[BATCH_SIZE];
+  for (size_t start = 0; start < events.size(); start += BATCH_SIZE) {
+    const size_t count = std::min(BATCH_SIZE, events.size() - start);
+    const T *batch = events.data() + start;
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = batch[i].tof();
+    findBins(tofs, tofs + count, bins);
+    for (size_t i = 0; i < count; ++i) {
+      if (bins[i] != m_numBins)
+        Y[bins[i]] += 1.0;
+    }
+  }
+}
+
+/** Add the weights of the events to the counts and their squared errors to
+ * the errors. Events outside the edges are ignored.
+ * @param events :: the weighted events, in any order
+ * @param Y :: the counts, of size numberOfBins()
+ * @param E :: the squared errors, of size numberOfBins()
+ */
+template <class T>
+void EventHistogrammer::addWeights(const std::vector<T> &events, MantidVec &Y,
+                                   MantidVec &E) const {
+  double tofs[BATCH_SIZE];
+  size_t bins[BATCH_SIZE];
+  for (size_t start = 0; start < events.size(); start += BATCH_SIZE) {
+    const size_t count = std::min(BATCH_SIZE, events.size() - start);
+    const T *batch = events.data() + start;
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = batch[i].tof();
+    findBins(tofs, tofs + count, bins);
+    for (size_t i = 0; i < count; ++i) {
+      if (bins[i] != m_numBins) {
+        Y[bins[i]] += batch[i].weight();
+        E[bins[i]] += batch[i].errorSquared();
+      }
+    }
+  }
+}
+
+/// @cond
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::countEvents(const std::vector<TofEvent> &, MantidVec &)
+    const;
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::countEvents(const std::vector<WeightedEvent> &,
+                               MantidVec &) const;
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::countEvents(const std::vector<WeightedEventNoTime> &,
+                               MantidVec &) const;
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::addWeights(const std::vector<WeightedEvent> &, MantidVec &,
+                              MantidVec &) const;
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::addWeights(const std::vector<WeightedEventNoTime> &,
+                              MantidVec &, MantidVec &) const;
+/// @endcond
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -1,4 +1,6 @@
 #include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventHistogrammer.h"
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
@@ -6,21 +8,25 @@
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidKernel/Unit.h"
 
 #ifdef _MSC_VER
 // qualifier applied to function type has no meaning; ignored
 #pragma warning(disable : 4180)
 #endif
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_sort.h"
 #ifdef _MSC_VER
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <map>
 #include <stdexcept>
 
 using std::ostream;
@@ -85,6 +91,71 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Output slot of an event that is not copied to any output list
+const uint32_t NO_OUTPUT_SLOT = std::numeric_limits<uint32_t>::max();
+/// Output slot of an event whose group has no (or a NULL) output list
+const uint32_t NULL_OUTPUT_SLOT = NO_OUTPUT_SLOT - 1;
+
+/**
+ * Flatten the split outputs keyed by group into a vector so that each event
+ * can record its destination as a compact slot index
+ * @param outputs : output event lists keyed by group
+ * @param outputLists : [output] the output event lists, indexed by slot
+ * @return map from group to slot
+ */
+std::map<int, uint32_t>
+makeOutputSlots(const std::map<int, EventList *> &outputs,
+                std::vector<EventList *> &outputLists) {
+  std::map<int, uint32_t> slots;
+  outputLists.clear();
+  outputLists.reserve(outputs.size());
+  for (const auto &output : outputs) {
+    if (!output.second)
+      continue;
+    slots.emplace(output.first, static_cast<uint32_t>(outputLists.size()));
+    outputLists.push_back(output.second);
+  }
+  return slots;
+}
+
+/**
+ * Get the output slot of a group
+ * @param slots : map from group to slot made by makeOutputSlots()
+ * @param group : group (target) index
+ * @return the slot or NULL_OUTPUT_SLOT if the group has no output list
+ */
+uint32_t getOutputSlot(const std::map<int, uint32_t> &slots, const int group) {
+  const auto slot = slots.find(group);
+  return slot == slots.end() ? NULL_OUTPUT_SLOT : slot->second;
+}
+
+/**
+ * Copy the events to the output lists given by their slots. The events bound
+ * for each output are counted first so that every output list is grown only
+ * once, to its exact final size.
+ * @param events : the events to copy
+ * @param eventSlots : output slot of each event
+ * @param outputLists : the output event lists, indexed by slot
+ */
+template <class T>
+void copyEventsToOutputSlots(const std::vector<T> &events,
+                             const std::vector<uint32_t> &eventSlots,
+                             const std::vector<EventList *> &outputLists) {
+  std::vector<size_t> counts(outputLists.size(), 0);
+  for (const auto slot : eventSlots) {
+    if (slot < NULL_OUTPUT_SLOT)
+      ++counts[slot];
+  }
+  for (size_t i = 0; i < outputLists.size(); ++i) {
+    if (counts[i] > 0)
+      outputLists[i]->reserve(outputLists[i]->getNumberEvents() + counts[i]);
+  }
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (eventSlots[i] < NULL_OUTPUT_SLOT)
+      outputLists[eventSlots[i]]->addEventQuickly(events[i]);
+  }
+}
 }
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -234,6 +305,9 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.weightedEventsNoTime = weightedEventsNoTime;
   sink.eventType = eventType;
   sink.order = order;
+  sink.m_tofSortedRunEnds = m_tofSortedRunEnds;
+  sink.m_columns =
+      m_columns ? Kernel::make_unique<EventColumns>(*m_columns) : nullptr;
 }
 
 /// Used by Histogram1D::copyDataFrom for dynamic dispatch for `other`.
@@ -344,6 +418,9 @@ EventList &EventList::operator=(const EventList &rhs) {
   weightedEventsNoTime = rhs.weightedEventsNoTime;
   eventType = rhs.eventType;
   order = rhs.order;
+  m_tofSortedRunEnds = rhs.m_tofSortedRunEnds;
+  m_columns = rhs.m_columns ? Kernel::make_unique<EventColumns>(*rhs.m_columns)
+                            : nullptr;
   return *this;
 }
 
@@ -353,6 +430,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  this->ensureRows();
 
   switch (this->eventType) {
   case TOF:
@@ -381,6 +459,8 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->ensureRows();
+  const size_t previousSize = this->getNumberEvents();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -408,7 +488,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
     break;
   }
 
-  this->order = UNSORTED;
+  this->updateSortOrderAfterAppend(previousSize);
   return *this;
 }
 
@@ -421,6 +501,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  this->ensureRows();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -437,6 +518,8 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->ensureRows();
+  const size_t previousSize = this->getNumberEvents();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -460,7 +543,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
     break;
   }
 
-  this->order = UNSORTED;
+  this->updateSortOrderAfterAppend(previousSize);
   return *this;
 }
 
@@ -474,6 +557,8 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->ensureRows();
+  const size_t previousSize = this->getNumberEvents();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -488,7 +573,7 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
     break;
   }
 
-  this->order = UNSORTED;
+  this->updateSortOrderAfterAppend(previousSize);
   return *this;
 }
 
@@ -502,6 +587,10 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  this->ensureRows();
+  more_events.ensureRows();
+  const size_t previousSize = this->getNumberEvents();
+  const bool moreSortedByTof = more_events.isSortedByTof();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -517,8 +606,9 @@ EventList &EventList::operator+=(const EventList &more_events) {
     break;
   }
 
-  // No guaranteed order
-  this->order = UNSORTED;
+  // Events sorted by TOF are kept as a run, to be merged rather than sorted
+  if (moreSortedByTof)
+    this->addTofSortedRun(previousSize);
   // Do a union between the detector IDs of both lists
   addDetectorIDs(more_events.getDetectorIDs());
 
@@ -563,6 +653,8 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  this->ensureRows();
+  more_events.ensureRows();
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -571,6 +663,7 @@ EventList &EventList::operator-=(const EventList &more_events) {
     return *this;
   }
 
+  const size_t previousSize = this->getNumberEvents();
   // We'll let the -= operator for the given vector of event lists handle it
   switch (this->getEventType()) {
   case TOF:
@@ -607,19 +700,124 @@ EventList &EventList::operator-=(const EventList &more_events) {
     break;
   }
 
-  // No guaranteed order
-  this->order = UNSORTED;
+  // No guaranteed order for the subtracted events
+  this->updateSortOrderAfterAppend(previousSize);
 
   // NOTE: What to do about detector ID's?
   return *this;
 }
 
+// --------------------------------------------------------------------------
+/** Append a batch of events that are sorted by TOF. The sort order of the list
+ * is kept track of, so that sorting the list later only needs to merge the
+ * batch with the events already in the list rather than to sort them all.
+ *
+ * @param more_events :: A vector of events sorted by TOF.
+ * */
+void EventList::addEventsSortedByTof(const std::vector<TofEvent> &more_events) {
+  const size_t previousSize = this->getNumberEvents();
+  this->operator+=(more_events);
+  this->addTofSortedRun(previousSize);
+}
+
+/** Append a batch of events that are sorted by TOF.
+ * Note: The whole list will switch to weights (a possibly lengthy operation)
+ *  if it did not have weights before.
+ *
+ * @param more_events :: A vector of events sorted by TOF.
+ * */
+void EventList::addEventsSortedByTof(
+    const std::vector<WeightedEvent> &more_events) {
+  const size_t previousSize = this->getNumberEvents();
+  this->operator+=(more_events);
+  this->addTofSortedRun(previousSize);
+}
+
+/** Append a batch of events that are sorted by TOF.
+ * Note: The whole list will switch to weights (a possibly lengthy operation)
+ *  if it did not have weights before.
+ *
+ * @param more_events :: A vector of events sorted by TOF.
+ * */
+void EventList::addEventsSortedByTof(
+    const std::vector<WeightedEventNoTime> &more_events) {
+  const size_t previousSize = this->getNumberEvents();
+  this->operator+=(more_events);
+  this->addTofSortedRun(previousSize);
+}
+
+// --------------------------------------------------------------------------
+/** Update the sort order after events in no known order were appended. If the
+ * list was sorted by TOF, its previous events become the first sorted run.
+ *
+ * @param previousSize :: number of events before the append
+ * */
+void EventList::updateSortOrderAfterAppend(const size_t previousSize) {
+  if (this->getNumberEvents() == previousSize)
+    return; // nothing appended
+  if (this->order == TOF_SORT) {
+    m_tofSortedRunEnds.clear();
+    if (previousSize > 0)
+      m_tofSortedRunEnds.push_back(previousSize);
+  } else if (this->order != UNSORTED) {
+    m_tofSortedRunEnds.clear();
+  }
+  this->order = UNSORTED;
+}
+
+/** Record that the events appended after previousSize are sorted by TOF. They
+ * become a new sorted run if they directly follow the known runs, or extend
+ * the last run if they continue its order.
+ *
+ * @param previousSize :: number of events before the append
+ * */
+void EventList::addTofSortedRun(const size_t previousSize) {
+  const size_t size = this->getNumberEvents();
+  if (size == previousSize || this->order != UNSORTED)
+    return;
+  // Events in no known order before the new ones
+  if ((m_tofSortedRunEnds.empty() && previousSize != 0) ||
+      (!m_tofSortedRunEnds.empty() &&
+       m_tofSortedRunEnds.back() != previousSize))
+    return;
+
+  bool continuesRun = false;
+  if (previousSize > 0) {
+    switch (eventType) {
+    case TOF:
+      continuesRun = !compareEventTof(events[previousSize],
+                                      events[previousSize - 1]);
+      break;
+    case WEIGHTED:
+      continuesRun = !compareEventTof(weightedEvents[previousSize],
+                                      weightedEvents[previousSize - 1]);
+      break;
+    case WEIGHTED_NOTIME:
+      continuesRun = !compareEventTof(weightedEventsNoTime[previousSize],
+                                      weightedEventsNoTime[previousSize - 1]);
+      break;
+    }
+  }
+  if (continuesRun)
+    m_tofSortedRunEnds.back() = size;
+  else
+    m_tofSortedRunEnds.push_back(size);
+
+  // A single run covering all the events
+  if (m_tofSortedRunEnds.size() == 1) {
+    m_tofSortedRunEnds.clear();
+    this->order = TOF_SORT;
+  }
+}
+
 // --------------------------------------------------------------------------
 /** Equality operator between EventList's
  * @param rhs :: other EventList to compare
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  this->ensureRows();
+  rhs.ensureRows();
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -644,6 +842,8 @@ bool EventList::operator!=(const EventList &rhs) const {
 
 bool EventList::equals(const EventList &rhs, const double tolTof,
                        const double tolWeight, const int64_t tolPulse) const {
+  this->ensureRows();
+  rhs.ensureRows();
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -692,6 +892,7 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  this->ensureRows();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -772,6 +973,82 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Move the events into columns, one array per field of the events (see
+ * EventColumns). Histogramming and the conversions of the time-of-flight then
+ * work on the time-of-flight column only. Any other operation moves the events
+ * back to the vectors of events first.
+ */
+void EventList::switchToColumns() {
+  if (m_columns)
+    return;
+  auto columns = Kernel::make_unique<EventColumns>(*this);
+  // Release the memory of the vectors of events
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+  m_tofSortedRunEnds.clear();
+  m_columns = std::move(columns);
+}
+
+/** Move the events held in columns back to the vectors of events. Does
+ * nothing if they already are there.
+ */
+void EventList::switchToRows() { this->ensureRows(); }
+
+/// @return true if the events are held in columns
+bool EventList::hasColumns() const { return static_cast<bool>(m_columns); }
+
+/** Return the columns holding the events.
+ * @return a const reference to the columns
+ * @throw std::runtime_error if the events are not held in columns
+ */
+const EventColumns &EventList::columns() const {
+  if (!m_columns)
+    throw std::runtime_error("EventList::columns() called for an EventList "
+                             "that does not hold its events in columns. Use "
+                             "switchToColumns() first.");
+  return *m_columns;
+}
+
+/** Return the columns holding the events, to be modified. The caller must
+ * keep all the columns the same length.
+ * @return a reference to the columns
+ * @throw std::runtime_error if the events are not held in columns
+ */
+EventColumns &EventList::mutableColumns() {
+  if (!m_columns)
+    throw std::runtime_error("EventList::mutableColumns() called for an "
+                             "EventList that does not hold its events in "
+                             "columns. Use switchToColumns() first.");
+  if (mru)
+    mru->deleteIndex(this);
+  return *m_columns;
+}
+
+/** Move the events held in columns back to the vectors of events. The lock
+ * keeps other threads from reading the columns meanwhile.
+ */
+void EventList::moveColumnsToRows() const {
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  if (!m_columns)
+    return;
+  switch (eventType) {
+  case TOF:
+    m_columns->appendTo(this->events);
+    break;
+  case WEIGHTED:
+    m_columns->appendTo(this->weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns->appendTo(this->weightedEventsNoTime);
+    break;
+  }
+  this->order = m_columns->getSortType();
+  m_tofSortedRunEnds.clear();
+  m_columns.reset();
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -784,6 +1061,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->ensureRows();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -810,6 +1088,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  this->ensureRows();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -825,10 +1104,13 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  this->ensureRows();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  // The caller may rewrite the events, so the sorted runs are unknown
+  m_tofSortedRunEnds.clear();
   return this->events;
 }
 
@@ -840,10 +1122,12 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  this->ensureRows();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
                              "getEvents() or getWeightedEventsNoTime().");
+  m_tofSortedRunEnds.clear();
   return this->weightedEvents;
 }
 
@@ -855,6 +1139,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  this->ensureRows();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -868,10 +1153,12 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  this->ensureRows();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
                              "getEvents() or getWeightedEvents().");
+  m_tofSortedRunEnds.clear();
   return this->weightedEventsNoTime;
 }
 
@@ -882,6 +1169,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * */
 const std::vector<WeightedEventNoTime> &
 EventList::getWeightedEventsNoTime() const {
+  this->ensureRows();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -895,6 +1183,8 @@ EventList::getWeightedEventsNoTime() const {
 void EventList::clear(const bool removeDetIDs) {
   if (mru)
     mru->deleteIndex(this);
+  m_columns.reset();
+  m_tofSortedRunEnds.clear();
   this->events.clear();
   std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
   this->weightedEvents.clear();
@@ -937,16 +1227,31 @@ void EventList::clearData() { this->clear(false); }
  */
 void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
 
-/** Reserve a certain number of entries in the (NOT-WEIGHTED) event list. Do NOT
- *call
- * on weighted events!
+/** Reserve a certain number of entries in the event list of the current
+ *event type.
  *
  * Calls std::vector<>::reserve() in order to pre-allocate the length of the
  *event list vector.
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  if (m_columns) {
+    m_columns->reserve(num);
+    return;
+  }
+  switch (eventType) {
+  case TOF:
+    this->events.reserve(num);
+    break;
+  case WEIGHTED:
+    this->weightedEvents.reserve(num);
+    break;
+  case WEIGHTED_NOTIME:
+    this->weightedEventsNoTime.reserve(num);
+    break;
+  }
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -983,7 +1288,9 @@ void EventList::sort(const EventSortType order) const {
  * @param order :: sort order to set.
  */
 void EventList::setSortOrder(const EventSortType order) const {
+  this->ensureRows();
   this->order = order;
+  m_tofSortedRunEnds.clear();
 }
 
 //  // MergeSort from:
@@ -1025,6 +1332,7 @@ void EventList::setSortOrder(const EventSortType order) const {
 // --------------------------------------------------------------------------
 /** Sort events by TOF in one thread */
 void EventList::sortTof() const {
+  this->ensureRows();
   if (this->order == TOF_SORT)
     return; // nothing to do
 
@@ -1036,19 +1344,63 @@ void EventList::sortTof() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<TofEvent>);
+    sortTofHelper(events, m_tofSortedRunEnds);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventTof<WeightedEvent>);
+    sortTofHelper(weightedEvents, m_tofSortedRunEnds);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       compareEventTof<WeightedEventNoTime>);
+    sortTofHelper(weightedEventsNoTime, m_tofSortedRunEnds);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TOF_SORT;
+  m_tofSortedRunEnds.clear();
+}
+
+// --------------------------------------------------------------------------
+/** Sort events by TOF. Runs of events already sorted are merged instead of
+ * being sorted again: the events after the runs are sorted, and then
+ * neighbouring runs are merged pairwise until a single one is left, which
+ * costs O(n log k) for k runs.
+ *
+ * @param events :: the events to sort
+ * @param sortedRunEnds :: ends of the runs of sorted events the events start
+ * with; empty if they are in no known order
+ */
+template <class T>
+void EventList::sortTofHelper(std::vector<T> &events,
+                              std::vector<size_t> sortedRunEnds) {
+  // No known runs, or runs recorded for events that have since changed
+  if (sortedRunEnds.empty() || sortedRunEnds.back() > events.size()) {
+    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<T>);
+    return;
+  }
+  // The events after the runs become one more run
+  if (sortedRunEnds.back() < events.size()) {
+    tbb::parallel_sort(events.begin() + sortedRunEnds.back(), events.end(),
+                       compareEventTof<T>);
+    sortedRunEnds.push_back(events.size());
+  }
+
+  while (sortedRunEnds.size() > 1) {
+    const size_t numMerges = sortedRunEnds.size() / 2;
+    // The merges of one pass are independent of each other
+    tbb::parallel_for(size_t(0), numMerges, [&](const size_t merge) {
+      const size_t begin = merge == 0 ? 0 : sortedRunEnds[2 * merge - 1];
+      std::inplace_merge(events.begin() + begin,
+                         events.begin() + sortedRunEnds[2 * merge],
+                         events.begin() + sortedRunEnds[2 * merge + 1],
+                         compareEventTof<T>);
+    });
+    std::vector<size_t> merged;
+    merged.reserve(numMerges + 1);
+    for (size_t i = 1; i < sortedRunEnds.size(); i += 2)
+      merged.push_back(sortedRunEnds[i]);
+    if (sortedRunEnds.size() % 2 == 1)
+      merged.push_back(sortedRunEnds.back());
+    sortedRunEnds.swap(merged);
+  }
 }
 
 // --------------------------------------------------------------------------
@@ -1063,6 +1415,7 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  this->ensureRows();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1092,11 +1445,13 @@ void EventList::sortTimeAtSample(const double &tofFactor,
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TIMEATSAMPLE_SORT;
+  m_tofSortedRunEnds.clear();
 }
 
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
+  this->ensureRows();
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1121,6 +1476,7 @@ void EventList::sortPulseTime() const {
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = PULSETIME_SORT;
+  m_tofSortedRunEnds.clear();
 }
 
 /*
@@ -1128,6 +1484,7 @@ void EventList::sortPulseTime() const {
  * (the absolute time)
  */
 void EventList::sortPulseTimeTOF() const {
+  this->ensureRows();
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1152,6 +1509,7 @@ void EventList::sortPulseTimeTOF() const {
 
   // Save
   this->order = PULSETIMETOF_SORT;
+  m_tofSortedRunEnds.clear();
 }
 
 /**
@@ -1163,6 +1521,7 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  this->ensureRows();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1183,15 +1542,22 @@ void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
   }
 
   this->order = UNSORTED; // so the function always re-runs
+  m_tofSortedRunEnds.clear();
 }
 
 // --------------------------------------------------------------------------
 /** Return true if the event list is sorted by TOF */
-bool EventList::isSortedByTof() const { return (this->order == TOF_SORT); }
+bool EventList::isSortedByTof() const {
+  return (this->getSortType() == TOF_SORT);
+}
 
 // --------------------------------------------------------------------------
 /** Return the type of sorting used in this event list */
-EventSortType EventList::getSortType() const { return this->order; }
+EventSortType EventList::getSortType() const {
+  if (m_columns)
+    return m_columns->getSortType();
+  return this->order;
+}
 
 // --------------------------------------------------------------------------
 /** Reverse the histogram boundaries and the associated events if they are
@@ -1205,7 +1571,10 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (m_columns) {
+    if (m_columns->getSortType() == TOF_SORT)
+      m_columns->reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1232,6 +1601,8 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (m_columns)
+    return m_columns->size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1247,6 +1618,8 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (m_columns)
+    return m_columns->empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1266,6 +1639,8 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  if (m_columns)
+    return m_columns->getMemorySize() + sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1748,6 +2123,8 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  this->ensureRows();
+  destination->ensureRows();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1797,6 +2174,7 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
   destination->eventType = WEIGHTED_NOTIME;
   // The sort is still valid!
   destination->order = TOF_SORT;
+  destination->m_tofSortedRunEnds.clear();
   // Empty out storage for vectors that are now unused.
   destination->clearUnused();
 }
@@ -1804,6 +2182,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  this->ensureRows();
+  destination->ensureRows();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1837,6 +2217,7 @@ void EventList::compressFatEvents(
   destination->eventType = WEIGHTED;
   // The sort order is pulsetimetof as we've compressed out the tolerance
   destination->order = PULSETIMETOF_SORT;
+  destination->m_tofSortedRunEnds.clear();
   // Empty out storage for vectors that are now unused.
   destination->clearUnused();
 }
@@ -2052,6 +2433,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
  */
 void EventList::generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                            MantidVec &E, bool skipError) const {
+  this->ensureRows();
   // All types of weights need to be sorted by Pulse Time
   this->sortPulseTime();
 
@@ -2089,6 +2471,7 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  this->ensureRows();
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -2122,8 +2505,28 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Columns are histogrammed in place, whatever the order of the events. The
+  // lock keeps other threads from moving them back to rows meanwhile.
+  if (m_columns) {
+    std::lock_guard<std::mutex> _lock(m_sortMutex);
+    if (m_columns) {
+      m_columns->generateHistogram(X, Y, E, skipError);
+      return;
+    }
+  }
 
+  // Unsorted events are histogrammed as they are: looking up the bin of each
+  // event is cheaper than sorting them. The lock keeps other threads from
+  // sorting the events meanwhile.
+  if (this->order != TOF_SORT) {
+    std::lock_guard<std::mutex> _lock(m_sortMutex);
+    if (this->order != TOF_SORT) {
+      generateHistogramUnsorted(X, Y, E, skipError);
+      return;
+    }
+  }
+
+  // All types of weights need to be sorted by TOF
   this->sortTof();
 
   switch (eventType) {
@@ -2144,6 +2547,48 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
   }
 }
 
+// --------------------------------------------------------------------------
+/** Generates both the Y and E (error) histograms w.r.t TOF without sorting the
+ * events, with the same result as for sorted events.
+ *
+ * @param X: x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error of unweighted events.
+ */
+void EventList::generateHistogramUnsorted(const MantidVec &X, MantidVec &Y,
+                                          MantidVec &E, bool skipError) const {
+  if (X.size() <= 1) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+  const size_t numBins = X.size() - 1;
+  EventHistogrammer histogrammer(X);
+
+  switch (eventType) {
+  case TOF:
+    Y.assign(numBins, 0.0);
+    histogrammer.countEvents(this->events, Y);
+    if (!skipError)
+      this->generateErrorsHistogram(Y, E);
+    break;
+
+  case WEIGHTED:
+  case WEIGHTED_NOTIME:
+    // Errors are squared until the last step
+    Y.assign(numBins, 0.0);
+    E.assign(numBins, 0.0);
+    if (eventType == WEIGHTED)
+      histogrammer.addWeights(this->weightedEvents, Y, E);
+    else
+      histogrammer.addWeights(this->weightedEventsNoTime, Y, E);
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+    break;
+  }
+}
+
 // --------------------------------------------------------------------------
 /** With respect to PulseTime Fill a histogram given specified histogram bounds.
  * Does not modify
@@ -2232,6 +2677,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  this->ensureRows();
 
   if (this->events.empty())
     return;
@@ -2493,6 +2939,7 @@ void EventList::integrateHelper(std::vector<T> &events, const double minX,
  */
 double EventList::integrate(const double minX, const double maxX,
                             const bool entireRange) const {
+  this->ensureRows();
   double sum(0), error(0);
   integrate(minX, maxX, entireRange, sum, error);
   return sum;
@@ -2511,6 +2958,7 @@ double EventList::integrate(const double minX, const double maxX,
 void EventList::integrate(const double minX, const double maxX,
                           const bool entireRange, double &sum,
                           double &error) const {
+  this->ensureRows();
   sum = 0;
   error = 0;
   if (!entireRange) {
@@ -2548,6 +2996,7 @@ void EventList::integrate(const double minX, const double maxX,
  */
 void EventList::convertTof(std::function<double(double)> func,
                            const int sorting) {
+  this->ensureRows();
   // fix the histogram parameter
   MantidVec &x = dataX();
   transform(x.begin(), x.end(), x.begin(), func);
@@ -2557,6 +3006,9 @@ void EventList::convertTof(std::function<double(double)> func,
     this->setSortOrder(UNSORTED);
   } else if ((sorting < 0) && (this->getSortType() == TOF_SORT)) {
     this->reverse();
+  } else if (sorting < 0) {
+    // Reversed runs of sorted events are of no use
+    m_tofSortedRunEnds.clear();
   }
 
   if (this->getNumberEvents() <= 0)
@@ -2600,8 +3052,18 @@ void EventList::convertTof(const double factor, const double offset) {
   for (double &iter : x)
     iter = iter * factor + offset;
 
+  if (m_columns) {
+    // The columns reverse the events themselves
+    if ((factor < 0.) && (m_columns->getSortType() == TOF_SORT))
+      std::reverse(x.begin(), x.end());
+    m_columns->convertTof(factor, offset);
+    return;
+  }
+
   if ((factor < 0.) && (this->getSortType() == TOF_SORT))
     this->reverse();
+  else if (factor < 0.)
+    m_tofSortedRunEnds.clear();
 
   if (this->getNumberEvents() <= 0)
     return;
@@ -2675,6 +3137,7 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  this->ensureRows();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2751,6 +3214,14 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   if (this->getNumberEvents() == 0)
     return;
 
+  // The columns are masked without sorting them
+  if (m_columns) {
+    m_columns->maskTof(tofMin, tofMax);
+    if (m_columns->empty())
+      this->clear(false);
+    return;
+  }
+
   // Start by sorting by tof
   this->sortTof();
 
@@ -2794,6 +3265,11 @@ void EventList::getTofsHelper(const std::vector<T> &events,
  *  @param tofs :: A reference to the vector to be filled
  */
 void EventList::getTofs(std::vector<double> &tofs) const {
+  if (m_columns) {
+    tofs.assign(m_columns->tofs().cbegin(), m_columns->tofs().cend());
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
@@ -2840,6 +3316,7 @@ void EventList::getWeightsHelper(const std::vector<T> &events,
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  this->ensureRows();
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2887,6 +3364,7 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events,
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  this->ensureRows();
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2936,6 +3414,7 @@ void EventList::getPulseTimesHelper(
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  this->ensureRows();
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -2960,6 +3439,7 @@ std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
  * @return The minimum tof value for the list of the events.
  */
 double EventList::getTofMin() const {
+  this->ensureRows();
   // set up as the maximum available double
   double tMin = std::numeric_limits<double>::max();
 
@@ -3004,6 +3484,7 @@ double EventList::getTofMin() const {
  * @return The maximum tof value for the list of events.
  */
 double EventList::getTofMax() const {
+  this->ensureRows();
   // set up as the minimum available double
   double tMax =
       -1. *
@@ -3051,6 +3532,7 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  this->ensureRows();
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3095,6 +3577,7 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  this->ensureRows();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3138,6 +3621,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 void EventList::getPulseTimeMinMax(
     Mantid::Types::Core::DateAndTime &tMin,
     Mantid::Types::Core::DateAndTime &tMax) const {
+  this->ensureRows();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3188,6 +3672,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->ensureRows();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3235,6 +3720,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->ensureRows();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3307,7 +3793,9 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  this->ensureRows();
   this->order = UNSORTED;
+  m_tofSortedRunEnds.clear();
 
   // Convert the list
   switch (eventType) {
@@ -3375,6 +3863,7 @@ void EventList::multiplyHelper(std::vector<T> &events, const double value,
  * @return reference to this
  */
 EventList &EventList::operator*=(const double value) {
+  this->ensureRows();
   this->multiply(value);
   return *this;
 }
@@ -3409,6 +3898,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  this->ensureRows();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3532,6 +4022,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  this->ensureRows();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3669,6 +4160,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  this->ensureRows();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3699,6 +4191,7 @@ void EventList::divide(const MantidVec &X, const MantidVec &Y,
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 EventList &EventList::operator/=(const double value) {
+  this->ensureRows();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3717,6 +4210,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  this->ensureRows();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3802,6 +4296,7 @@ void EventList::filterByTimeAtSampleHelper(std::vector<T> &events,
  */
 void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
                                   EventList &output) const {
+  this->ensureRows();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3836,6 +4331,7 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
                                      Types::Core::DateAndTime stop,
                                      double tofFactor, double tofOffset,
                                      EventList &output) const {
+  this->ensureRows();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3951,6 +4447,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  this->ensureRows();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4042,6 +4539,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  this->ensureRows();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4097,58 +4595,61 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
                                       typename std::vector<T> &events,
                                       bool docorrection, double toffactor,
                                       double tofshift) const {
-  // 1. Prepare to Iterate through the splitter at the same time
+  // 1. Map each destination to a slot so that every event can be assigned to
+  //    its output list before any event is copied
+  std::vector<EventList *> outputLists;
+  const auto slots = makeOutputSlots(outputs, outputLists);
+  const uint32_t unfilteredSlot = getOutputSlot(slots, -1);
+  std::vector<uint32_t> eventSlots(events.size(), NO_OUTPUT_SLOT);
+
+  // 2. Prepare to Iterate through the splitter at the same time
   auto itspl = splitter.begin();
   auto itspl_end = splitter.end();
 
-  // 2. Prepare to Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+  // 3. Prepare to Iterate through all events (sorted by tof)
+  size_t iev = 0;
+  const size_t numEvents = events.size();
 
-  // 3. This is the time of the first section. Anything before is thrown out.
+  // 4. This is the time of the first section. Anything before is thrown out.
   while (itspl != itspl_end) {
     // Get the splitting interval times and destination
     int64_t start = itspl->start().totalNanoseconds();
     int64_t stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
+    const uint32_t slot = getOutputSlot(slots, itspl->index());
 
     // a) Skip the events before the start of the time
-    // TODO This step can be
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
+    while (iev < numEvents) {
+      const T &event = events[iev];
       int64_t fulltime;
       if (docorrection)
-        fulltime = calculateCorrectedFullTime(*itev, toffactor, tofshift);
+        fulltime = calculateCorrectedFullTime(event, toffactor, tofshift);
       else
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(itev->m_tof * 1000);
+        fulltime = event.m_pulsetime.totalNanoseconds() +
+                   static_cast<int64_t>(event.m_tof * 1000);
       if (fulltime < start) {
         // a1) Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        itev++;
+        eventSlots[iev] = unfilteredSlot;
+        ++iev;
       } else {
         break;
       }
     }
 
     // b) Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
+    while (iev < numEvents) {
+      const T &event = events[iev];
       int64_t fulltime;
       if (docorrection)
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(toffactor * itev->m_tof * 1000 +
+        fulltime = event.m_pulsetime.totalNanoseconds() +
+                   static_cast<int64_t>(toffactor * event.m_tof * 1000 +
                                         tofshift * 1.0E9);
       else
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(itev->m_tof * 1000);
+        fulltime = event.m_pulsetime.totalNanoseconds() +
+                   static_cast<int64_t>(event.m_tof * 1000);
       if (fulltime < stop) {
-        // b1) Copy the event into another
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
+        // b1) Record to the destination of the interval
+        eventSlots[iev] = slot;
+        ++iev;
       } else {
         break;
       }
@@ -4161,9 +4662,12 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
       break;
 
     // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
+    if (iev == numEvents)
       break;
   } // END-WHILE Splitter
+
+  // 5. Copy the events to their (exactly pre-allocated) outputs
+  copyEventsToOutputSlots(events, eventSlots, outputLists);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4182,6 +4686,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
                                 std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  this->ensureRows();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4247,50 +4752,59 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
     std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
   std::stringstream msgss;
 
-  // Loop through events
-  for (eviter = vecEvents.begin(); eviter != vecEvents.end(); ++eviter) {
+  // Resolve the output of every splitter once rather than once per event
+  std::vector<EventList *> outputLists;
+  const auto slots = makeOutputSlots(outputs, outputLists);
+  const uint32_t unfilteredSlot = getOutputSlot(slots, -1);
+  std::vector<uint32_t> splitterSlots(vecgroups.size());
+  for (size_t i = 0; i < vecgroups.size(); ++i)
+    splitterSlots[i] = getOutputSlot(slots, vecgroups[i]);
+
+  // Loop through events to find their destinations
+  std::vector<uint32_t> eventSlots(vecEvents.size());
+  for (size_t iev = 0; iev < vecEvents.size(); ++iev) {
+    const T &event = vecEvents[iev];
     // Obtain time of event
     int64_t evabstimens;
     if (docorrection)
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(toffactor * eviter->m_tof * 1000 +
+      evabstimens = event.m_pulsetime.totalNanoseconds() +
+                    static_cast<int64_t>(toffactor * event.m_tof * 1000 +
                                          tofshift * 1.0E9);
     else
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(eviter->m_tof * 1000);
+      evabstimens = event.m_pulsetime.totalNanoseconds() +
+                    static_cast<int64_t>(event.m_tof * 1000);
 
     // Search in vector
     int index = static_cast<int>(
         lower_bound(vectimes.begin(), vectimes.end(), evabstimens) -
         vectimes.begin());
     int group;
+    uint32_t slot;
     // FIXME - whether lower_bound() equal to vectimes.size()-1 should be
     // filtered out?
     if (index == 0 || index > static_cast<int>(vectimes.size() - 1)) {
       // Event is before first splitter or after last splitter.  Put to -1
       group = -1;
+      slot = unfilteredSlot;
     } else {
       group = vecgroups[index - 1];
+      slot = splitterSlots[index - 1];
     }
 
-    // Copy event to the proper group
-    EventList *myOutput = outputs[group];
-    if (!myOutput) {
+    if (slot == NULL_OUTPUT_SLOT) {
       std::stringstream errss;
       errss << "Group " << group << " has a NULL output EventList. "
             << "\n";
       msgss << errss.str();
-    } else {
-      const T eventCopy(*eviter);
-      myOutput->addEventQuickly(eventCopy);
     }
+    eventSlots[iev] = slot;
   }
 
+  // Copy events to the proper groups
+  copyEventsToOutputSlots(vecEvents, eventSlots, outputLists);
+
   return (msgss.str());
 }
 
@@ -4319,55 +4833,47 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
     std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  // typename std::vector<T>::iterator eviter;
   std::stringstream msgss;
 
+  std::vector<EventList *> outputLists;
+  const auto slots = makeOutputSlots(outputs, outputLists);
+  // events before the first or after the last splitter are not copied
+  std::vector<uint32_t> eventSlots(vecEvents.size(), NO_OUTPUT_SLOT);
+
   size_t num_splitters = vecgroups.size();
   // prepare to Iterate through all events (sorted by tof)
-  auto iter_events = vecEvents.begin();
-  auto iter_events_end = vecEvents.end();
-
-  // std::stringstream debug_ss;
-  // debug_ss << "\nFilter events...:\n";
+  size_t iev = 0;
+  const size_t numEvents = vecEvents.size();
 
   for (size_t i = 0; i < num_splitters; ++i) {
     // get one splitter
     int64_t start_i64 = vectimes[i];
     int64_t stop_i64 = vectimes[i + 1];
     int group = vecgroups[i];
-    // debug_ss << "working on splitter: " << i << " from " << start_i64 << " to
-    // " << stop_i64 << "\n";
+    const uint32_t slot = getOutputSlot(slots, group);
 
     // go over events
-    while (iter_events != iter_events_end) {
+    while (iev < numEvents) {
+      const T &event = vecEvents[iev];
       int64_t absolute_time;
       if (docorrection)
-        absolute_time =
-            iter_events->m_pulsetime.totalNanoseconds() +
-            static_cast<int64_t>(toffactor * iter_events->m_tof * 1000 +
-                                 tofshift * 1.0E9);
+        absolute_time = event.m_pulsetime.totalNanoseconds() +
+                        static_cast<int64_t>(toffactor * event.m_tof * 1000 +
+                                             tofshift * 1.0E9);
       else
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() +
-                        static_cast<int64_t>(iter_events->m_tof * 1000);
-
-      // debug_ss << "  event " << iter_events - vecEvents.begin() << " abs.time
-      // = " << absolute_time << "\n";
+        absolute_time = event.m_pulsetime.totalNanoseconds() +
+                        static_cast<int64_t>(event.m_tof * 1000);
 
       if (absolute_time < start_i64) {
         // event occurs before the splitter. only can happen with first
         // splitter. Then ignore and move to next
-        ++iter_events;
+        ++iev;
         continue;
       }
 
       if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
+        // in the splitter, then record the group of the event
+        if (slot == NULL_OUTPUT_SLOT) {
           // there is no such group defined. quit for this group
           std::stringstream errss;
           errss << "Group " << group << " has a NULL output EventList. "
@@ -4375,9 +4881,8 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
           msgss << errss.str();
           throw std::runtime_error(errss.str());
         }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++iter_events;
+        eventSlots[iev] = slot;
+        ++iev;
       } else {
         // event occurs after the stop time, it should belonged to the next
         // splitter
@@ -4386,11 +4891,12 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     } // while
 
     // quit the loop if there is no more event left
-    if (iter_events == iter_events_end)
+    if (iev == numEvents)
       break;
   } // for splitter
 
-  // std::cout << debug_ss.str();
+  // Copy events to the proper groups
+  copyEventsToOutputSlots(vecEvents, eventSlots, outputLists);
 
   return (msgss.str());
 }
@@ -4413,6 +4919,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  this->ensureRows();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4550,6 +5057,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  this->ensureRows();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4595,6 +5103,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  this->ensureRows();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4758,13 +5267,17 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Convert the events in blocks, calling the units once per block
+  const size_t blockSize = 1024;
+  double values[blockSize];
+  const size_t numEvents = events.size();
+  for (size_t start = 0; start < numEvents; start += blockSize) {
+    const size_t count = std::min(blockSize, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      values[i] = events[start + i].m_tof;
+    fromUnit->convertTo(*toUnit, values, values, count);
+    for (size_t i = 0; i < count; ++i)
+      events[start + i].m_tof = values[i];
   }
 }
 
@@ -4789,6 +5302,14 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
     throw std::runtime_error(
         "EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  // The time-of-flight column is converted in one call to the units
+  if (m_columns) {
+    m_columns->convertUnits(*fromUnit, *toUnit);
+    return;
+  }
+
+  // The conversion may reverse the runs of sorted events
+  m_tofSortedRunEnds.clear();
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4826,6 +5347,9 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  this->ensureRows();
+  // The conversion may reverse the runs of sorted events
+  m_tofSortedRunEnds.clear();
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -0,0 +1,170 @@
+#include "MantidDataObjects/EventListSaveable.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// @return the size in bytes of one event of the given type
+size_t eventSize(const API::EventType type) {
+  switch (type) {
+  case API::TOF:
+    return sizeof(Types::Event::TofEvent);
+  case API::WEIGHTED:
+    return sizeof(WeightedEvent);
+  case API::WEIGHTED_NOTIME:
+    return sizeof(WeightedEventNoTime);
+  }
+  return 0;
+}
+} // namespace
+
+/** Constructor. The events of the list are in memory.
+ * @param eventList :: the event list to save and load
+ * @param fileBacking :: the file backing owning the scratch file
+ */
+EventListSaveable::EventListSaveable(
+    EventList &eventList, const EventWorkspaceFileBacking &fileBacking)
+    : m_eventList(eventList), m_fileBacking(fileBacking), m_numEventsOnFile(0),
+      m_sortOrderOnFile(UNSORTED), m_pinCount(0) {
+  setLoaded(true);
+}
+
+/** Save the events at the position set by the DiskBuffer.
+ * Private function called from the DiskBuffer (via ISaveable::saveAt).
+ */
+void EventListSaveable::save() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const size_t numEvents = m_eventList.getNumberEvents();
+  const char *buffer = nullptr;
+  switch (m_eventList.getEventType()) {
+  case API::TOF:
+    buffer = reinterpret_cast<const char *>(m_eventList.getEvents().data());
+    break;
+  case API::WEIGHTED:
+    buffer =
+        reinterpret_cast<const char *>(m_eventList.getWeightedEvents().data());
+    break;
+  case API::WEIGHTED_NOTIME:
+    buffer = reinterpret_cast<const char *>(
+        m_eventList.getWeightedEventsNoTime().data());
+    break;
+  }
+  m_fileBacking.writeData(this->getFilePosition(), buffer,
+                          numEvents * eventSize(m_eventList.getEventType()));
+  m_numEventsOnFile = numEvents;
+  m_sortOrderOnFile = m_eventList.getSortType();
+  this->m_wasSaved = true;
+  // A pinned list may be changed after it was written, so it must be written
+  // again before it is released from memory.
+  if (m_pinCount > 0)
+    const_cast<EventListSaveable *>(this)->m_dataChanged = true;
+}
+
+/** Load the events from the file if they are not in memory.
+ * Private function called from the DiskBuffer.
+ */
+void EventListSaveable::load() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  loadEvents();
+}
+
+/// Flush the writes to the scratch file
+void EventListSaveable::flushData() const { m_fileBacking.flushData(); }
+
+/** Remove the events from memory, keeping the rest of the event list. Pinned
+ * event lists stay in memory.
+ */
+void EventListSaveable::clearDataFromMemory() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_pinCount > 0)
+    return;
+  m_eventList.clear(false);
+  // Nothing can be assumed about the order of the events added before they
+  // are loaded back
+  m_eventList.setSortOrder(UNSORTED);
+  this->setLoaded(false);
+  this->clearDataChanged();
+}
+
+/** @return the size of the events in bytes: of those in memory if they are
+ * loaded, of those on file otherwise */
+uint64_t EventListSaveable::getTotalDataSize() const {
+  if (this->isLoaded())
+    return getDataMemorySize();
+  return this->getFileSize();
+}
+
+/// @return the size in bytes of the events held in memory
+size_t EventListSaveable::getDataMemorySize() const {
+  if (!this->isLoaded())
+    return 0;
+  return m_eventList.getNumberEvents() *
+         eventSize(m_eventList.getEventType());
+}
+
+/** Keep the events in memory until unpin() is called, loading them if needed
+ * @param modify :: true if the events will be changed
+ */
+void EventListSaveable::pin(bool modify) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_pinCount;
+  this->setBusy(true);
+  loadEvents();
+  if (modify)
+    this->setDataChanged();
+}
+
+/// Allow the events to be removed from memory once no longer pinned
+void EventListSaveable::unpin() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_pinCount > 0)
+    --m_pinCount;
+  this->setBusy(m_pinCount > 0);
+}
+
+/// @return the number of events, in memory or on file
+size_t EventListSaveable::getNumberEvents() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (this->isLoaded())
+    return m_eventList.getNumberEvents();
+  return m_numEventsOnFile;
+}
+
+/// Read the events from the file if they are not in memory
+void EventListSaveable::loadEvents() {
+  if (this->isLoaded())
+    return;
+  if (this->wasSaved()) {
+    char *buffer = nullptr;
+    switch (m_eventList.getEventType()) {
+    case API::TOF: {
+      auto &events = m_eventList.getEvents();
+      events.resize(m_numEventsOnFile);
+      buffer = reinterpret_cast<char *>(events.data());
+      break;
+    }
+    case API::WEIGHTED: {
+      auto &events = m_eventList.getWeightedEvents();
+      events.resize(m_numEventsOnFile);
+      buffer = reinterpret_cast<char *>(events.data());
+      break;
+    }
+    case API::WEIGHTED_NOTIME: {
+      auto &events = m_eventList.getWeightedEventsNoTime();
+      events.resize(m_numEventsOnFile);
+      buffer = reinterpret_cast<char *>(events.data());
+      break;
+    }
+    }
+    m_fileBacking.readData(this->getFilePosition(), buffer,
+                           m_numEventsOnFile *
+                               eventSize(m_eventList.getEventType()));
+    m_eventList.setSortOrder(m_sortOrderOnFile);
+  }
+  this->setLoaded(true);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -7,6 +7,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
@@ -17,8 +18,13 @@
 #include "MantidKernel/IPropertyManager.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/make_unique.h"
 
 #include "tbb/parallel_for.h"
+#include <Poco/Path.h>
+#include <Poco/TemporaryFile.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <numeric>
 
@@ -43,16 +49,30 @@ EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
 
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
     : IEventWorkspace(other), mru(new EventWorkspaceMRU) {
-  for (const auto &el : other.data) {
+  // A copy of a file-backed workspace gets its own scratch file next to the
+  // one of the original
+  if (other.m_fileBacking) {
+    const auto &otherFileName = other.m_fileBacking->getFileName();
+    m_fileBacking = Kernel::make_unique<EventWorkspaceFileBacking>(
+        Poco::TemporaryFile::tempName(
+            Poco::Path(otherFileName).parent().toString()),
+        other.m_fileBacking->getMemoryBudget());
+  }
+  for (size_t i = 0; i < other.data.size(); ++i) {
+    SpectraPinScope pinned(other);
     // Create a new event list, copying over the events
-    auto newel = new EventList(*el);
+    auto newel = new EventList(other.getSpectrum(i));
     // Make sure to update the MRU to point to THIS event workspace.
     newel->setMRU(this->mru);
     this->data.push_back(newel);
+    if (m_fileBacking)
+      m_fileBacking->addSpectrum(*newel);
   }
 }
 
 EventWorkspace::~EventWorkspace() {
+  // The file backing refers to the event lists
+  m_fileBacking.reset();
   for (auto &eventList : data)
     delete eventList;
   delete mru;
@@ -75,6 +95,7 @@ bool EventWorkspace::threadSafe() const {
  *  @param XLength :: The number of X data points/bin boundaries in each vector
  * (ignored)
  *  @param YLength :: The number of data/error points in each vector (ignored)
+ *  @throw std::runtime_error if the workspace is already file-backed
  */
 void EventWorkspace::init(const std::size_t &NVectors,
                           const std::size_t &XLength,
@@ -87,6 +108,7 @@ void EventWorkspace::init(const std::size_t &NVectors,
     throw std::out_of_range(
         "Negative or 0 Number of Pixels specified to EventWorkspace::init");
   }
+  throwIfFileBacked();
 
   // Set each X vector to have one bin of 0 & extremely close to zero
   // Move the rhs very,very slightly just incase something doesn't like them
@@ -118,6 +140,7 @@ void EventWorkspace::init(const HistogramData::Histogram &histogram) {
   if (histogram.sharedY() || histogram.sharedE())
     throw std::runtime_error(
         "EventWorkspace cannot be initialized non-NULL Y or E data");
+  throwIfFileBacked();
 
   data.resize(numberOfDetectorGroups(), nullptr);
   EventList el;
@@ -169,6 +192,9 @@ EventList &EventWorkspace::getSpectrum(const size_t index) {
   invalidateCommonBinsFlag();
   auto &spec = const_cast<EventList &>(
       static_cast<const EventWorkspace &>(*this).getSpectrum(index));
+  // The events may be changed through the reference: write them out again
+  if (m_fileBacking)
+    m_fileBacking->setSpectrumChanged(index);
   spec.setMatrixWorkspace(this, index);
   return spec;
 }
@@ -178,6 +204,8 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::getSpectrum, workspace index out of range");
+  if (m_fileBacking)
+    m_fileBacking->loadSpectrum(index);
   return *data[index];
 }
 
@@ -196,6 +224,7 @@ DateAndTime EventWorkspace::getPulseTimeMin() const {
   DateAndTime temp;
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
+    SpectraPinScope pinned(*this);
     const EventList &evList = this->getSpectrum(workspaceIndex);
     temp = evList.getPulseTimeMin();
     if (temp < tMin)
@@ -215,6 +244,7 @@ DateAndTime EventWorkspace::getPulseTimeMax() const {
   DateAndTime temp;
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
+    SpectraPinScope pinned(*this);
     const EventList &evList = this->getSpectrum(workspaceIndex);
     temp = evList.getPulseTimeMax();
     if (temp > tMax)
@@ -242,6 +272,7 @@ void EventWorkspace::getPulseTimeMinMax(
 #pragma omp for nowait
     for (int64_t workspaceIndex = 0; workspaceIndex < numWorkspace;
          workspaceIndex++) {
+      SpectraPinScope pinned(*this);
       const EventList &evList = this->getSpectrum(workspaceIndex);
       DateAndTime tempMin, tempMax;
       evList.getPulseTimeMinMax(tempMin, tempMax);
@@ -275,6 +306,7 @@ DateAndTime EventWorkspace::getTimeAtSampleMin(double tofOffset) const {
     const auto L2 = specInfo.l2(workspaceIndex);
     const double tofFactor = L1 / (L1 + L2);
 
+    SpectraPinScope pinned(*this);
     const EventList &evList = this->getSpectrum(workspaceIndex);
     temp = evList.getTimeAtSampleMin(tofFactor, tofOffset);
     if (temp < tMin)
@@ -301,6 +333,7 @@ DateAndTime EventWorkspace::getTimeAtSampleMax(double tofOffset) const {
     const auto L2 = specInfo.l2(workspaceIndex);
     const double tofFactor = L1 / (L1 + L2);
 
+    SpectraPinScope pinned(*this);
     const EventList &evList = this->getSpectrum(workspaceIndex);
     temp = evList.getTimeAtSampleMax(tofFactor, tofOffset);
     if (temp > tMax)
@@ -325,6 +358,7 @@ double EventWorkspace::getEventXMin() const {
   size_t numWorkspace = this->data.size();
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
+    SpectraPinScope pinned(*this);
     const EventList &evList = this->getSpectrum(workspaceIndex);
     const double temp = evList.getTofMin();
     if (temp < xmin)
@@ -349,6 +383,7 @@ double EventWorkspace::getEventXMax() const {
   size_t numWorkspace = this->data.size();
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
+    SpectraPinScope pinned(*this);
     const EventList &evList = this->getSpectrum(workspaceIndex);
     const double temp = evList.getTofMax();
     if (temp > xmax)
@@ -375,6 +410,7 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 #pragma omp for nowait
     for (int64_t workspaceIndex = 0; workspaceIndex < numWorkspace;
          workspaceIndex++) {
+      SpectraPinScope pinned(*this);
       const EventList &evList = this->getSpectrum(workspaceIndex);
       double temp = evList.getTofMin();
       tXmin = std::min(temp, tXmin);
@@ -392,6 +428,13 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 /// The total number of events across all of the spectra.
 /// @returns The total number of events
 size_t EventWorkspace::getNumberEvents() const {
+  // Count the events on file without loading them
+  if (m_fileBacking) {
+    size_t total = 0;
+    for (size_t i = 0; i < m_fileBacking->getNumberSpectra(); ++i)
+      total += m_fileBacking->getNumberEvents(i);
+    return total;
+  }
   return std::accumulate(data.begin(), data.end(), size_t{0},
                          [](size_t total, EventList *list) {
                            return total + list->getNumberEvents();
@@ -404,8 +447,9 @@ size_t EventWorkspace::getNumberEvents() const {
  */
 Mantid::API::EventType EventWorkspace::getEventType() const {
   Mantid::API::EventType out = Mantid::API::TOF;
-  for (auto list : this->data) {
-    Mantid::API::EventType thisType = list->getEventType();
+  for (size_t i = 0; i < data.size(); ++i) {
+    SpectraPinScope pinned(*this);
+    Mantid::API::EventType thisType = getSpectrum(i).getEventType();
     if (static_cast<int>(out) < static_cast<int>(thisType)) {
       out = thisType;
       // This is the most-specialized it can get.
@@ -421,8 +465,10 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
  * @param type :: EventType to switch to
  */
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
-  for (auto &eventList : this->data)
-    eventList->switchTo(type);
+  for (size_t i = 0; i < data.size(); ++i) {
+    SpectraPinScope pinned(*this);
+    getSpectrum(i).switchTo(type);
+  }
 }
 
 /// Returns true always - an EventWorkspace always represents histogramm-able
@@ -444,10 +490,11 @@ size_t EventWorkspace::getMemorySize() const {
   // TODO: Add the MRU buffer
 
   // Add the memory from all the event lists
-  size_t total = std::accumulate(data.begin(), data.end(), size_t{0},
-                                 [](size_t total, EventList *list) {
-                                   return total + list->getMemorySize();
-                                 });
+  size_t total = 0;
+  for (size_t i = 0; i < data.size(); ++i) {
+    SpectraPinScope pinned(*this);
+    total += getSpectrum(i).getMemorySize();
+  }
 
   total += run().getMemorySize();
 
@@ -462,6 +509,7 @@ size_t EventWorkspace::getMemorySize() const {
 /// @param index :: the workspace index to return
 /// @returns A reference to the vector of binned X values
 MantidVec &EventWorkspace::dataX(const std::size_t index) {
+  SpectraPinScope pinned(*this);
   return getSpectrum(index).dataX();
 }
 
@@ -470,6 +518,7 @@ MantidVec &EventWorkspace::dataX(const std::size_t index) {
 /// @param index :: the workspace index to return
 /// @returns A reference to the vector of binned error values
 MantidVec &EventWorkspace::dataDx(const std::size_t index) {
+  SpectraPinScope pinned(*this);
   return getSpectrum(index).dataDx();
 }
 
@@ -495,6 +544,7 @@ MantidVec &EventWorkspace::dataE(const std::size_t) {
  * @return the const data X vector at a given workspace index
  * @param index :: workspace index   */
 const MantidVec &EventWorkspace::dataX(const std::size_t index) const {
+  SpectraPinScope pinned(*this);
   return getSpectrum(index).readX();
 }
 
@@ -502,6 +552,7 @@ const MantidVec &EventWorkspace::dataX(const std::size_t index) const {
  * @return the const data X error vector at a given workspace index
  * @param index :: workspace index   */
 const MantidVec &EventWorkspace::dataDx(const std::size_t index) const {
+  SpectraPinScope pinned(*this);
   return getSpectrum(index).readDx();
 }
 
@@ -524,6 +575,7 @@ const MantidVec &EventWorkspace::dataE(const std::size_t index) const {
  * @param index :: workspace index   */
 Kernel::cow_ptr<HistogramData::HistogramX>
 EventWorkspace::refX(const std::size_t index) const {
+  SpectraPinScope pinned(*this);
   return getSpectrum(index).ptrX();
 }
 
@@ -543,7 +595,8 @@ void EventWorkspace::generateHistogram(const std::size_t index,
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::generateHistogram, histogram number out of range");
-  this->data[index]->generateHistogram(X, Y, E, skipError);
+  SpectraPinScope pinned(*this);
+  this->getSpectrum(index).generateHistogram(X, Y, E, skipError);
 }
 
 /** Using the event data in the event list, generate a histogram of it w.r.t
@@ -563,7 +616,8 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   if (index >= data.size())
     throw std::range_error("EventWorkspace::generateHistogramPulseTime, "
                            "histogram number out of range");
-  this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
+  SpectraPinScope pinned(*this);
+  this->getSpectrum(index).generateHistogramPulseTime(X, Y, E, skipError);
 }
 
 /*** Set all histogram X vectors.
@@ -573,8 +627,13 @@ void EventWorkspace::setAllX(const HistogramData::BinEdges &x) {
   // This is an EventWorkspace, so changing X size is ok as long as we clear
   // the MRU below, i.e., we avoid the size check of Histogram::setBinEdges and
   // just reset the whole Histogram.
-  for (auto &eventList : this->data)
-    eventList->setHistogram(x);
+  const auto &constThis = static_cast<const EventWorkspace &>(*this);
+  for (size_t i = 0; i < data.size(); ++i) {
+    SpectraPinScope pinned(*this);
+    // Only the histogram changes, the events need not be written out again
+    constThis.getSpectrum(i);
+    data[i]->setHistogram(x);
+  }
 
   // Clear MRU lists now, free up memory
   this->clearMRU();
@@ -590,8 +649,16 @@ public:
 
   // Execute the sort as specified.
   void operator()(const tbb::blocked_range<size_t> &range) const {
+    const auto fileBacking = m_WS->getFileBacking();
     for (size_t wi = range.begin(); wi < range.end(); ++wi) {
-      m_WS->getSpectrum(wi).sort(m_sortType);
+      SpectraPinScope pinned(*m_WS);
+      const auto &eventList = m_WS->getSpectrum(wi);
+      if (eventList.getSortType() == m_sortType)
+        continue;
+      eventList.sort(m_sortType);
+      // The sorted events must be written out before they are evicted
+      if (fileBacking)
+        fileBacking->setSpectrumChanged(wi);
     }
     // Report progress
     if (prog)
@@ -613,9 +680,14 @@ private:
  */
 EventSortType EventWorkspace::getSortType() const {
   size_t size = this->data.size();
-  EventSortType order = data[0]->getSortType();
+  EventSortType order;
+  {
+    SpectraPinScope pinned(*this);
+    order = getSpectrum(0).getSortType();
+  }
   for (size_t i = 1; i < size; i++) {
-    if (order != data[i]->getSortType())
+    SpectraPinScope pinned(*this);
+    if (order != getSpectrum(i).getSortType())
       return UNSORTED;
   }
   return order;
@@ -663,13 +735,93 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
        wksp_index++) {
     // Get Handle to data
-    EventList *el = this->data[wksp_index];
+    SpectraPinScope pinned(*this);
+    const EventList &el = this->getSpectrum(wksp_index);
 
     // Let the eventList do the integration
-    out[wksp_index] = el->integrate(minX, maxX, entireRange);
+    out[wksp_index] = el.integrate(minX, maxX, entireRange);
   }
 }
 
+/** Make the workspace file-backed: the events of all the spectra are kept in
+ * a scratch file and only the spectra in use are held in memory. The spectra
+ * are loaded on demand by getSpectrum() and stay in memory while the
+ * SpectraPinScope they were accessed in is open (see EventWorkspaceFileBacking).
+ * The scratch file is removed when the workspace is deleted.
+ *
+ * @param fileName :: path of the scratch file to create
+ * @param memoryBudget :: number of bytes of events to hold in memory
+ * @throw std::runtime_error if the workspace is already file-backed
+ */
+void EventWorkspace::setFileBacked(const std::string &fileName,
+                                   const uint64_t memoryBudget) {
+  if (m_fileBacking)
+    throw std::runtime_error(
+        "EventWorkspace::setFileBacked, the workspace is already file-backed");
+  m_fileBacking =
+      Kernel::make_unique<EventWorkspaceFileBacking>(fileName, memoryBudget);
+  for (auto eventList : data)
+    m_fileBacking->addSpectrum(*eventList);
+}
+
+/** Whether the workspace contains common X bins. The bin edges of a
+ * file-backed workspace are compared as in MatrixWorkspace::isCommonBins(),
+ * but straight from the event lists, without loading their events.
+ * @return whether the workspace contains common X bins
+ */
+bool EventWorkspace::isCommonBins() const {
+  if (!m_fileBacking)
+    return MatrixWorkspace::isCommonBins();
+
+  if (data.size() < 2)
+    return true;
+  const auto &first = data.front()->x();
+  const auto &last = data.back()->x();
+  const size_t numBins = first.size();
+  if (std::any_of(data.begin(), data.end(), [numBins](const EventList *el) {
+        return el->x().size() != numBins;
+      }))
+    return false;
+  // Quickest check is to see if they are actually the same vector
+  if (&first[0] == &last[0])
+    return true;
+  // Otherwise compare the first and the last numerically
+  const double firstSum = std::accumulate(first.begin(), first.end(), 0.);
+  const double lastSum = std::accumulate(last.begin(), last.end(), 0.);
+  if (std::abs(firstSum - lastSum) / std::abs(firstSum + lastSum) > 1.0E-9)
+    return false;
+  return std::isinf(firstSum) == std::isinf(lastSum) &&
+         std::isnan(firstSum) == std::isnan(lastSum);
+}
+
+/** The detector IDs are held by the event list itself: they are read without
+ * loading the events of a file-backed workspace.
+ * @param index :: workspace index of the spectrum
+ */
+void EventWorkspace::updateCachedDetectorGrouping(const size_t index) const {
+  setDetectorGrouping(index, data[index]->getDetectorIDs());
+}
+
+/// @return true if the events are kept in a scratch file
+bool EventWorkspace::isFileBacked() const {
+  return static_cast<bool>(m_fileBacking);
+}
+
+/// @return the file backing of the workspace, or nullptr if not file-backed
+const EventWorkspaceFileBacking *EventWorkspace::getFileBacking() const {
+  return m_fileBacking.get();
+}
+
+/** The file backing holds on to the event lists: they cannot be replaced by
+ * init() once the workspace is file-backed.
+ * @throw std::runtime_error if the workspace is file-backed
+ */
+void EventWorkspace::throwIfFileBacked() const {
+  if (m_fileBacking)
+    throw std::runtime_error("EventWorkspace::init, a file-backed workspace "
+                             "cannot be initialized again");
+}
+
 } // namespace DataObjects
 } // namespace Mantid
 
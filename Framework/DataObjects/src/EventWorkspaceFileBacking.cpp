@@ -0,0 +1,209 @@
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventListSaveable.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/make_unique.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Constructor. Creates (or truncates) the scratch file.
+ * @param fileName :: path of the scratch file
+ * @param memoryBudget :: number of bytes of events to hold in memory
+ */
+EventWorkspaceFileBacking::EventWorkspaceFileBacking(
+    const std::string &fileName, const uint64_t memoryBudget)
+    : m_fileName(fileName),
+      m_file(fileName, std::ios::in | std::ios::out | std::ios::binary |
+                           std::ios::trunc),
+      m_diskBuffer(memoryBudget) {
+  if (!m_file.is_open())
+    throw std::runtime_error("EventWorkspaceFileBacking: cannot create the "
+                             "scratch file " +
+                             fileName);
+}
+
+/// Destructor. Closes and removes the scratch file.
+EventWorkspaceFileBacking::~EventWorkspaceFileBacking() {
+  m_file.close();
+  std::remove(m_fileName.c_str());
+}
+
+/** Put the next spectrum under the control of the file backing. Its events
+ * are written out as soon as the memory budget is exceeded.
+ * @param eventList :: the event list of the next workspace index
+ */
+void EventWorkspaceFileBacking::addSpectrum(EventList &eventList) {
+  m_saveables.push_back(
+      Kernel::make_unique<EventListSaveable>(eventList, *this));
+  m_diskBuffer.toWrite(m_saveables.back().get());
+}
+
+/** Make sure that the events of a spectrum are in memory and pin them in the
+ * innermost scope of the calling thread, or until releaseSpectra() if the
+ * thread has no scope open. A spectrum already pinned by the thread is left
+ * as it is.
+ * @param index :: workspace index of the spectrum
+ */
+void EventWorkspaceFileBacking::loadSpectrum(const size_t index) {
+  {
+    std::lock_guard<std::mutex> lock(m_pinMutex);
+    auto &scopes = m_pinned[std::this_thread::get_id()];
+    if (scopes.empty())
+      scopes.emplace_back();
+    for (const auto &scope : scopes)
+      if (scope.count(index) > 0)
+        return;
+    scopes.back().insert(index);
+  }
+
+  EventListSaveable *saveable = m_saveables[index].get();
+  saveable->pin(false);
+  // may write out the lists that are not pinned if over budget
+  m_diskBuffer.toWrite(saveable);
+}
+
+/** Mark a spectrum as modified so that its events are written out again
+ * before they are released from memory.
+ * @param index :: workspace index of the spectrum
+ */
+void EventWorkspaceFileBacking::setSpectrumChanged(const size_t index) const {
+  m_saveables[index]->setDataChanged();
+}
+
+/// Open a scope: the spectra loaded by the calling thread from now on stay
+/// pinned until the matching endScope()
+void EventWorkspaceFileBacking::beginScope() const {
+  std::lock_guard<std::mutex> lock(m_pinMutex);
+  auto &scopes = m_pinned[std::this_thread::get_id()];
+  if (scopes.empty())
+    scopes.emplace_back();
+  scopes.emplace_back();
+}
+
+/// Close the innermost scope of the calling thread, unpinning its spectra
+void EventWorkspaceFileBacking::endScope() const {
+  std::set<size_t> pinned;
+  {
+    std::lock_guard<std::mutex> lock(m_pinMutex);
+    auto it = m_pinned.find(std::this_thread::get_id());
+    if (it == m_pinned.end() || it->second.size() < 2)
+      return;
+    pinned.swap(it->second.back());
+    it->second.pop_back();
+    if (it->second.size() == 1 && it->second.front().empty())
+      m_pinned.erase(it);
+  }
+  for (const auto index : pinned)
+    unpinSpectrum(index);
+}
+
+/** Unpin the spectra accessed outside any scope, by all the threads. No
+ * reference to them may be used afterwards.
+ */
+void EventWorkspaceFileBacking::releaseSpectra() const {
+  // A spectrum is pinned once by each thread that accessed it
+  std::vector<size_t> pinned;
+  {
+    std::lock_guard<std::mutex> lock(m_pinMutex);
+    for (auto it = m_pinned.begin(); it != m_pinned.end();) {
+      auto &unscoped = it->second.front();
+      pinned.insert(pinned.end(), unscoped.begin(), unscoped.end());
+      unscoped.clear();
+      if (it->second.size() == 1)
+        it = m_pinned.erase(it);
+      else
+        ++it;
+    }
+  }
+  for (const auto index : pinned)
+    unpinSpectrum(index);
+}
+
+/** Unpin a spectrum. Its events may have grown while it was pinned, so their
+ * size is counted again against the memory budget.
+ * @param index :: workspace index of the spectrum
+ */
+void EventWorkspaceFileBacking::unpinSpectrum(const size_t index) const {
+  EventListSaveable *saveable = m_saveables[index].get();
+  saveable->unpin();
+  m_diskBuffer.toWrite(saveable);
+}
+
+/// Write out and release from memory all the event lists that are not pinned
+void EventWorkspaceFileBacking::flushCache() { m_diskBuffer.flushCache(); }
+
+/** @param index :: workspace index of the spectrum
+ * @return the number of events of the spectrum, without loading them
+ */
+size_t EventWorkspaceFileBacking::getNumberEvents(const size_t index) const {
+  return m_saveables[index]->getNumberEvents();
+}
+
+/** Write raw bytes to the scratch file
+ * @param position :: byte offset in the file
+ * @param data :: the bytes to write
+ * @param size :: number of bytes to write
+ */
+void EventWorkspaceFileBacking::writeData(const uint64_t position,
+                                          const char *data,
+                                          const uint64_t size) const {
+  if (size == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  m_file.seekp(static_cast<std::streamoff>(position));
+  m_file.write(data, static_cast<std::streamsize>(size));
+  if (!m_file)
+    throw std::runtime_error(
+        "EventWorkspaceFileBacking: failed to write to the scratch file " +
+        m_fileName);
+}
+
+/** Read raw bytes from the scratch file
+ * @param position :: byte offset in the file
+ * @param data :: buffer for the bytes read
+ * @param size :: number of bytes to read
+ */
+void EventWorkspaceFileBacking::readData(const uint64_t position, char *data,
+                                         const uint64_t size) const {
+  if (size == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  m_file.seekg(static_cast<std::streamoff>(position));
+  m_file.read(data, static_cast<std::streamsize>(size));
+  if (!m_file)
+    throw std::runtime_error(
+        "EventWorkspaceFileBacking: failed to read from the scratch file " +
+        m_fileName);
+}
+
+/// Flush the writes to the scratch file
+void EventWorkspaceFileBacking::flushData() const {
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  m_file.flush();
+}
+
+/** Constructor. Opens a pin scope for the calling thread if the workspace is
+ * a file-backed EventWorkspace.
+ * @param workspace :: the workspace whose spectra are pinned
+ */
+SpectraPinScope::SpectraPinScope(const API::MatrixWorkspace &workspace)
+    : m_fileBacking(nullptr) {
+  if (const auto eventWorkspace =
+          dynamic_cast<const EventWorkspace *>(&workspace))
+    m_fileBacking = eventWorkspace->getFileBacking();
+  if (m_fileBacking)
+    m_fileBacking->beginScope();
+}
+
+/// Destructor. Unpins the spectra accessed within the scope.
+SpectraPinScope::~SpectraPinScope() {
+  if (m_fileBacking)
+    m_fileBacking->endScope();
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -1,6 +1,11 @@
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidKernel/Exception.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/make_cow.h"
+#include "MantidKernel/make_unique.h"
+
+#include <array>
+#include <cstdint>
 
 namespace Mantid {
 namespace DataObjects {
@@ -20,14 +25,59 @@ Histogram1D::Histogram1D(HistogramData::Histogram::XMode xmode,
   }
 }
 
+/// Copy constructor.
+Histogram1D::Histogram1D(const Histogram1D &other)
+    : Histogram1D(other,
+                  std::unique_lock<std::mutex>(valuesMutex(other))) {}
+
+/// Copy other while holding lock, so that its values are not widened while
+/// they are being copied.
+Histogram1D::Histogram1D(const Histogram1D &other,
+                         std::unique_lock<std::mutex> lock)
+    : ISpectrum(other), m_histogram(other.m_histogram),
+      m_singlePrecision(other.m_singlePrecision
+                            ? Kernel::make_unique<SinglePrecisionData>(
+                                  *other.m_singlePrecision)
+                            : nullptr),
+      m_isSinglePrecision(static_cast<bool>(m_singlePrecision)) {
+  (void)lock;
+}
+
+/// Move constructor.
+Histogram1D::Histogram1D(Histogram1D &&other)
+    : ISpectrum(std::move(other)), m_histogram(std::move(other.m_histogram)),
+      m_singlePrecision(std::move(other.m_singlePrecision)),
+      m_isSinglePrecision(static_cast<bool>(m_singlePrecision)) {
+  other.m_isSinglePrecision = false;
+}
+
 /// Construct from ISpectrum.
 Histogram1D::Histogram1D(const ISpectrum &other)
     : ISpectrum(other), m_histogram(other.histogram()) {}
 
+/// Copy assignment.
+Histogram1D &Histogram1D::operator=(const Histogram1D &other) {
+  ISpectrum::operator=(other);
+  copyValuesFrom(other);
+  return *this;
+}
+
+/// Move assignment.
+Histogram1D &Histogram1D::operator=(Histogram1D &&other) {
+  ISpectrum::operator=(std::move(other));
+  m_histogram = std::move(other.m_histogram);
+  m_singlePrecision = std::move(other.m_singlePrecision);
+  m_isSinglePrecision = static_cast<bool>(m_singlePrecision);
+  other.m_isSinglePrecision = false;
+  return *this;
+}
+
 /// Assignment from ISpectrum.
 Histogram1D &Histogram1D::operator=(const ISpectrum &rhs) {
   ISpectrum::operator=(rhs);
   m_histogram = rhs.histogram();
+  m_singlePrecision.reset();
+  m_isSinglePrecision = false;
   return *this;
 }
 
@@ -38,7 +88,147 @@ void Histogram1D::copyDataFrom(const ISpectrum &source) {
 
 /// Used by copyDataFrom for dynamic dispatch for its `source`.
 void Histogram1D::copyDataInto(Histogram1D &sink) const {
-  sink.m_histogram = m_histogram;
+  sink.copyValuesFrom(*this);
+}
+
+/// Copy the histogram of other, in single precision if other is.
+void Histogram1D::copyValuesFrom(const Histogram1D &other) {
+  std::lock_guard<std::mutex> lock(valuesMutex(other));
+  m_histogram = other.m_histogram;
+  m_singlePrecision =
+      other.m_singlePrecision
+          ? Kernel::make_unique<SinglePrecisionData>(*other.m_singlePrecision)
+          : nullptr;
+  m_isSinglePrecision = static_cast<bool>(m_singlePrecision);
+}
+
+/** Returns the mutex guarding the widening of the values of a spectrum. The
+ * spectra share a fixed set of mutexes, so that holding one costs no memory.
+ * @param spectrum :: The spectrum to get the mutex of
+ * @return The mutex guarding the values of the spectrum
+ */
+std::mutex &Histogram1D::valuesMutex(const Histogram1D &spectrum) {
+  static std::array<std::mutex, 64> mutexes;
+  const auto address = reinterpret_cast<std::uintptr_t>(&spectrum);
+  return mutexes[(address / sizeof(Histogram1D)) % mutexes.size()];
+}
+
+/** Hold the Y and E values in single precision, which halves their memory, or
+ * back in double precision. In single precision, the accessors returning the
+ * values by reference widen them back to double precision on first use, the
+ * accessors returning them by value widen a copy.
+ * @param singlePrecision :: true for single precision, false for double
+ */
+void Histogram1D::setSinglePrecision(const bool singlePrecision) {
+  if (!singlePrecision) {
+    widenIfSinglePrecision();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(valuesMutex(*this));
+  if (m_singlePrecision)
+    return;
+  auto data = Kernel::make_unique<SinglePrecisionData>();
+  const auto &y = m_histogram.y();
+  data->y.assign(y.begin(), y.end());
+  const auto &e = m_histogram.e();
+  data->e.assign(e.begin(), e.end());
+  m_histogram.setSharedY(nullptr);
+  m_histogram.setSharedE(nullptr);
+  m_singlePrecision = std::move(data);
+  m_isSinglePrecision = true;
+}
+
+/// Widen the Y and E values back to double precision
+void Histogram1D::widen() const {
+  std::lock_guard<std::mutex> lock(valuesMutex(*this));
+  if (!m_singlePrecision)
+    return;
+  const auto &data = *m_singlePrecision;
+  m_histogram.setSharedY(
+      Kernel::make_cow<HistogramData::HistogramY>(data.y.begin(), data.y.end()));
+  m_histogram.setSharedE(
+      Kernel::make_cow<HistogramData::HistogramE>(data.e.begin(), data.e.end()));
+  m_singlePrecision.reset();
+  m_isSinglePrecision = false;
+}
+
+/** Copy the Y values in single precision, without widening them if the
+ * spectrum is held in single precision.
+ * @param y :: Set to the Y values
+ */
+void Histogram1D::copySinglePrecisionY(std::vector<float> &y) const {
+  std::lock_guard<std::mutex> lock(valuesMutex(*this));
+  if (m_singlePrecision)
+    y = m_singlePrecision->y;
+  else
+    y.assign(m_histogram.y().begin(), m_histogram.y().end());
+}
+
+/** Copy the E values in single precision, without widening them if the
+ * spectrum is held in single precision.
+ * @param e :: Set to the E values
+ */
+void Histogram1D::copySinglePrecisionE(std::vector<float> &e) const {
+  std::lock_guard<std::mutex> lock(valuesMutex(*this));
+  if (m_singlePrecision)
+    e = m_singlePrecision->e;
+  else
+    e.assign(m_histogram.e().begin(), m_histogram.e().end());
+}
+
+/// Returns the Histogram, with a widened copy of the Y and E values if the
+/// spectrum is held in single precision.
+HistogramData::Histogram Histogram1D::histogram() const {
+  if (!m_isSinglePrecision)
+    return m_histogram;
+  std::lock_guard<std::mutex> lock(valuesMutex(*this));
+  HistogramData::Histogram histogram(m_histogram);
+  if (m_singlePrecision) {
+    const auto &data = *m_singlePrecision;
+    histogram.setSharedY(Kernel::make_cow<HistogramData::HistogramY>(
+        data.y.begin(), data.y.end()));
+    histogram.setSharedE(Kernel::make_cow<HistogramData::HistogramE>(
+        data.e.begin(), data.e.end()));
+  }
+  return histogram;
+}
+
+HistogramData::Counts Histogram1D::counts() const {
+  if (!m_isSinglePrecision)
+    return ISpectrum::counts();
+  return histogram().counts();
+}
+
+HistogramData::CountVariances Histogram1D::countVariances() const {
+  if (!m_isSinglePrecision)
+    return ISpectrum::countVariances();
+  return histogram().countVariances();
+}
+
+HistogramData::CountStandardDeviations
+Histogram1D::countStandardDeviations() const {
+  if (!m_isSinglePrecision)
+    return ISpectrum::countStandardDeviations();
+  return histogram().countStandardDeviations();
+}
+
+HistogramData::Frequencies Histogram1D::frequencies() const {
+  if (!m_isSinglePrecision)
+    return ISpectrum::frequencies();
+  return histogram().frequencies();
+}
+
+HistogramData::FrequencyVariances Histogram1D::frequencyVariances() const {
+  if (!m_isSinglePrecision)
+    return ISpectrum::frequencyVariances();
+  return histogram().frequencyVariances();
+}
+
+HistogramData::FrequencyStandardDeviations
+Histogram1D::frequencyStandardDeviations() const {
+  if (!m_isSinglePrecision)
+    return ISpectrum::frequencyStandardDeviations();
+  return histogram().frequencyStandardDeviations();
 }
 
 void Histogram1D::clearData() {
@@ -90,6 +280,31 @@ void Histogram1D::checkAndSanitizeHistogram(
     throw std::invalid_argument(
         "Histogram1D: invalid input: E data set to nullptr");
   }
+  // The histogram replaces the values held in single precision
+  m_singlePrecision.reset();
+  m_isSinglePrecision = false;
+}
+
+/** Constructor
+ * @param spectrum :: The spectrum to read the values of, which must outlive
+ * this object
+ */
+SpectrumValues::SpectrumValues(const API::ISpectrum &spectrum)
+    : m_spectrum(spectrum) {
+  const auto histogram1D = dynamic_cast<const Histogram1D *>(&spectrum);
+  if (histogram1D && histogram1D->isSinglePrecision())
+    m_widened =
+        Kernel::make_unique<HistogramData::Histogram>(histogram1D->histogram());
+}
+
+/// @return The Y values of the spectrum
+const MantidVec &SpectrumValues::y() const {
+  return m_widened ? m_widened->y().rawData() : m_spectrum.readY();
+}
+
+/// @return The E values of the spectrum
+const MantidVec &SpectrumValues::e() const {
+  return m_widened ? m_widened->e().rawData() : m_spectrum.readE();
 }
 
 } // namespace DataObjects
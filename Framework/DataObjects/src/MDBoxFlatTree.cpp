@@ -1,5 +1,6 @@
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDMortonCode.h"
 #include "MantidAPI/BoxController.h"
 #include "MantidAPI/FileBackedExperimentInfo.h"
 #include "MantidAPI/WorkspaceHistory.h"
@@ -8,6 +9,8 @@
 #include "MantidKernel/Strings.h"
 #include <Poco/File.h>
 
+#include <algorithm>
+
 using file_holder_type = std::unique_ptr<::NeXus::File>;
 
 namespace Mantid {
@@ -131,23 +134,48 @@ void MDBoxFlatTree::initFlatStructure(API::IMDEventWorkspace_sptr pws,
    on the HDD
      @param setFileBacked  -- initiate the boxes to be fileBacked. The boxes
    assumed not to be saved before.
+     @param mortonOrder -- place the events of the boxes on file along the
+   Morton (Z-order) curve of the box centres, so that boxes close in space are
+   close on file, rather than in the order of the box IDs.
 */
-void MDBoxFlatTree::setBoxesFilePositions(bool setFileBacked) {
+void MDBoxFlatTree::setBoxesFilePositions(bool setFileBacked,
+                                          bool mortonOrder) {
   // this will preserve file-backed workspace and information in it as we are
   // not loading old box data and not?
   // this would be right for binary access but questionable for Nexus --TODO:
   // needs testing
   // Done in INIT--> need check if ID and index in the tree are always the same.
   // Kernel::ISaveable::sortObjByFilePos(m_Boxes);
+  // the boxes with events (avoid grid boxes), in their order on file
+  std::vector<API::IMDNode *> leaves;
+  leaves.reserve(m_Boxes.size());
+  for (auto mdBox : m_Boxes) {
+    if (m_BoxType[mdBox->getID()] != 2)
+      leaves.push_back(mdBox);
+  }
+  if (mortonOrder && !m_Boxes.empty()) {
+    // Box of ID 0 is the head box
+    MDMortonCode mortonCode(*m_Boxes[0]);
+    std::vector<coord_t> center(mortonCode.getNumDims());
+    std::vector<std::pair<uint64_t, API::IMDNode *>> codes;
+    codes.reserve(leaves.size());
+    for (auto leaf : leaves) {
+      leaf->getCenter(center.data());
+      codes.emplace_back(mortonCode(center.data()), leaf);
+    }
+    std::stable_sort(codes.begin(), codes.end(),
+                     [](const std::pair<uint64_t, API::IMDNode *> &a,
+                        const std::pair<uint64_t, API::IMDNode *> &b) {
+                       return a.first < b.first;
+                     });
+    for (size_t i = 0; i < codes.size(); ++i)
+      leaves[i] = codes[i].second;
+  }
+
   // calculate the box positions in the resulting file and save it on place
   uint64_t eventsStart = 0;
-  for (auto mdBox : m_Boxes) {
+  for (auto mdBox : leaves) {
     size_t ID = mdBox->getID();
-
-    // avoid grid boxes;
-    if (m_BoxType[ID] == 2)
-      continue;
-
     size_t nEvents = mdBox->getTotalDataSize();
     m_BoxEventIndex[ID * 2] = eventsStart;
     m_BoxEventIndex[ID * 2 + 1] = nEvents;
@@ -0,0 +1,427 @@
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+// The operations, on a signal a with squared error da2 and a signal b with
+// squared error db2, written as in the methods of MDHistoWorkspace.
+
+void plusBin(const signal_t a, const signal_t da2, const signal_t b,
+             const signal_t db2, signal_t &f, signal_t &df2) {
+  f = a + b;
+  df2 = da2 + db2;
+}
+
+void minusBin(const signal_t a, const signal_t da2, const signal_t b,
+              const signal_t db2, signal_t &f, signal_t &df2) {
+  f = a - b;
+  df2 = da2 + db2;
+}
+
+void multiplyBin(const signal_t a, const signal_t da2, const signal_t b,
+                 const signal_t db2, signal_t &f, signal_t &df2) {
+  f = a * b;
+  df2 = da2 * b * b + db2 * a * a;
+}
+
+void divideBin(const signal_t a, const signal_t da2, const signal_t b,
+               const signal_t db2, signal_t &f, signal_t &df2) {
+  f = a / b;
+  df2 = da2 / (b * b) + db2 * f * f / (b * b);
+}
+
+/** Apply a binary operation to a block of bins.
+ * @param lhs :: signals and squared errors of the left-hand side
+ * @param rhs :: signals and squared errors of the right-hand side
+ * @param size :: number of bins of the block
+ * @param signals :: output signals
+ * @param errorsSquared :: output squared errors
+ * @param op :: the operation on a single bin
+ */
+template <typename Block, typename Operation>
+void applyBinary(const Block &lhs, const Block &rhs, const size_t size,
+                 signal_t *signals, signal_t *errorsSquared,
+                 const Operation &op) {
+  if (lhs.isScalar && rhs.isScalar) {
+    op(lhs.signal, lhs.errorSquared, rhs.signal, rhs.errorSquared, signals[0],
+       errorsSquared[0]);
+  } else if (lhs.isScalar) {
+    for (size_t i = 0; i < size; ++i)
+      op(lhs.signal, lhs.errorSquared, rhs.signals[i], rhs.errorsSquared[i],
+         signals[i], errorsSquared[i]);
+  } else if (rhs.isScalar) {
+    for (size_t i = 0; i < size; ++i)
+      op(lhs.signals[i], lhs.errorsSquared[i], rhs.signal, rhs.errorSquared,
+         signals[i], errorsSquared[i]);
+  } else {
+    for (size_t i = 0; i < size; ++i)
+      op(lhs.signals[i], lhs.errorsSquared[i], rhs.signals[i],
+         rhs.errorsSquared[i], signals[i], errorsSquared[i]);
+  }
+}
+
+/** Apply a unary operation to a block of bins.
+ * @param operand :: signals and squared errors of the operand
+ * @param size :: number of bins of the block
+ * @param signals :: output signals
+ * @param errorsSquared :: output squared errors
+ * @param op :: the operation on a single bin
+ */
+template <typename Block, typename Operation>
+void applyUnary(const Block &operand, const size_t size, signal_t *signals,
+                signal_t *errorsSquared, const Operation &op) {
+  for (size_t i = 0; i < size; ++i)
+    op(operand.signals[i], operand.errorsSquared[i], signals[i],
+       errorsSquared[i]);
+}
+} // namespace
+
+/// Values of a node over a block of bins, or a single value for all the bins
+struct MDHistoExpression::Block {
+  /// Signal of each bin
+  const signal_t *signals = nullptr;
+  /// Squared error of each bin
+  const signal_t *errorsSquared = nullptr;
+  /// Number of events of each bin, nullptr if the node has none
+  const signal_t *numEvents = nullptr;
+  /// True if the node has the same value for all the bins
+  bool isScalar = false;
+  /// Signal of all the bins of a scalar node
+  signal_t signal = 0;
+  /// Squared error of all the bins of a scalar node
+  signal_t errorSquared = 0;
+};
+
+const size_t MDHistoExpression::BLOCK_SIZE;
+
+//----------------------------------------------------------------------------------------------
+/** Constructor
+ * @param operation :: what the node computes
+ * @param lhs :: left-hand side, or only, operand
+ * @param rhs :: right-hand side operand of a binary operation
+ */
+MDHistoExpression::MDHistoExpression(const Operation operation, sptr lhs,
+                                     sptr rhs)
+    : m_operation(operation), m_lhs(lhs), m_rhs(rhs), m_signal(0),
+      m_errorSquared(0), m_parameter(0) {
+  const bool isLeaf =
+      operation == Operation::Workspace || operation == Operation::Scalar;
+  const bool isBinary = operation == Operation::Plus ||
+                        operation == Operation::Minus ||
+                        operation == Operation::Multiply ||
+                        operation == Operation::Divide;
+  if ((!isLeaf && !m_lhs) || (isBinary && !m_rhs))
+    throw std::invalid_argument("MDHistoExpression: missing operand.");
+}
+
+//----------------------------------------------------------------------------------------------
+/** @return an expression for the bins of a workspace
+ * @param ws :: the workspace. It must not change until the expression is
+ * evaluated.
+ */
+MDHistoExpression::sptr
+MDHistoExpression::workspace(MDHistoWorkspace_const_sptr ws) {
+  if (!ws)
+    throw std::invalid_argument("MDHistoExpression: null workspace.");
+  auto node = new MDHistoExpression(Operation::Workspace, sptr(), sptr());
+  node->m_workspace = ws;
+  return sptr(node);
+}
+
+/** @return an expression with the same value for all the bins
+ * @param signal :: signal of the bins
+ * @param error :: error (not squared) of the bins
+ */
+MDHistoExpression::sptr MDHistoExpression::scalar(const signal_t signal,
+                                                  const signal_t error) {
+  auto node = new MDHistoExpression(Operation::Scalar, sptr(), sptr());
+  node->m_signal = signal;
+  node->m_errorSquared = error * error;
+  return sptr(node);
+}
+
+/// @return lhs + rhs, propagated as by MDHistoWorkspace::add()
+MDHistoExpression::sptr MDHistoExpression::plus(sptr lhs, sptr rhs) {
+  return sptr(new MDHistoExpression(Operation::Plus, lhs, rhs));
+}
+
+/// @return lhs - rhs, propagated as by MDHistoWorkspace::subtract()
+MDHistoExpression::sptr MDHistoExpression::minus(sptr lhs, sptr rhs) {
+  return sptr(new MDHistoExpression(Operation::Minus, lhs, rhs));
+}
+
+/// @return lhs * rhs, propagated as by MDHistoWorkspace::multiply()
+MDHistoExpression::sptr MDHistoExpression::multiply(sptr lhs, sptr rhs) {
+  return sptr(new MDHistoExpression(Operation::Multiply, lhs, rhs));
+}
+
+/// @return lhs / rhs, propagated as by MDHistoWorkspace::divide()
+MDHistoExpression::sptr MDHistoExpression::divide(sptr lhs, sptr rhs) {
+  return sptr(new MDHistoExpression(Operation::Divide, lhs, rhs));
+}
+
+/// @return ln(operand), propagated as by MDHistoWorkspace::log()
+MDHistoExpression::sptr MDHistoExpression::log(sptr operand,
+                                               const double filler) {
+  auto node = new MDHistoExpression(Operation::Log, operand, sptr());
+  node->m_parameter = filler;
+  return sptr(node);
+}
+
+/// @return log10(operand), propagated as by MDHistoWorkspace::log10()
+MDHistoExpression::sptr MDHistoExpression::log10(sptr operand,
+                                                 const double filler) {
+  auto node = new MDHistoExpression(Operation::Log10, operand, sptr());
+  node->m_parameter = filler;
+  return sptr(node);
+}
+
+/// @return exp(operand), propagated as by MDHistoWorkspace::exp()
+MDHistoExpression::sptr MDHistoExpression::exp(sptr operand) {
+  return sptr(new MDHistoExpression(Operation::Exp, operand, sptr()));
+}
+
+/// @return operand^exponent, propagated as by MDHistoWorkspace::power()
+MDHistoExpression::sptr MDHistoExpression::power(sptr operand,
+                                                 const double exponent) {
+  auto node = new MDHistoExpression(Operation::Power, operand, sptr());
+  node->m_parameter = exponent;
+  return sptr(node);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Evaluate the expression and write the signals, errors and numbers of
+ * events of the result to a workspace. The workspace may be one of those in
+ * the expression.
+ *
+ * @param out :: the output workspace, with as many bins as the workspaces of
+ * the expression
+ * @throw std::invalid_argument if a workspace has a different number of bins
+ */
+void MDHistoExpression::evaluate(MDHistoWorkspace &out) const {
+  Nodes nodes;
+  collectNodes(nodes);
+  const size_t numPoints = out.getNPoints();
+  for (auto node : nodes)
+    node->checkSize(numPoints);
+
+  // Position of the operands of each node in the list
+  const size_t noOperand = nodes.size();
+  std::vector<size_t> lhsIndex(nodes.size(), noOperand);
+  std::vector<size_t> rhsIndex(nodes.size(), noOperand);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i]->m_lhs)
+      lhsIndex[i] =
+          std::find(nodes.begin(), nodes.end(), nodes[i]->m_lhs.get()) -
+          nodes.begin();
+    if (nodes[i]->m_rhs)
+      rhsIndex[i] =
+          std::find(nodes.begin(), nodes.end(), nodes[i]->m_rhs.get()) -
+          nodes.begin();
+  }
+
+  signal_t *outSignals = out.getSignalArray();
+  signal_t *outErrorsSquared = out.getErrorSquaredArray();
+  signal_t *outNumEvents = out.getNumEventsArray();
+
+  // Buffers of each node for a block, for each thread
+  const size_t bufferSize = 3 * BLOCK_SIZE * nodes.size();
+  std::vector<std::vector<signal_t>> buffers(PARALLEL_GET_MAX_THREADS);
+  const auto numBlocks =
+      static_cast<int64_t>((numPoints + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t b = 0; b < numBlocks; ++b) {
+    auto &buffer = buffers[PARALLEL_THREAD_NUMBER];
+    if (buffer.empty())
+      buffer.resize(bufferSize);
+    const size_t begin = static_cast<size_t>(b) * BLOCK_SIZE;
+    const size_t size = std::min(BLOCK_SIZE, numPoints - begin);
+
+    // Each node after its operands, into its part of the buffer
+    std::vector<Block> blocks(nodes.size() + 1);
+    for (size_t i = 0; i < nodes.size(); ++i)
+      blocks[i] = nodes[i]->evaluateBlock(blocks[lhsIndex[i]],
+                                          blocks[rhsIndex[i]], begin, size,
+                                          &buffer[3 * BLOCK_SIZE * i]);
+
+    // The root is the last node
+    const Block &result = blocks[nodes.size() - 1];
+    if (result.isScalar) {
+      std::fill_n(outSignals + begin, size, result.signal);
+      std::fill_n(outErrorsSquared + begin, size, result.errorSquared);
+    } else if (result.signals != outSignals + begin) {
+      std::copy_n(result.signals, size, outSignals + begin);
+      std::copy_n(result.errorsSquared, size, outErrorsSquared + begin);
+    }
+    if (!result.numEvents)
+      std::fill_n(outNumEvents + begin, size, 0.);
+    else if (result.numEvents != outNumEvents + begin)
+      std::copy_n(result.numEvents, size, outNumEvents + begin);
+  }
+  out.updateSum();
+}
+
+//----------------------------------------------------------------------------------------------
+/** Add the nodes of the expression to a list, each after its operands and
+ * only once.
+ * @param nodes :: the list of nodes
+ */
+void MDHistoExpression::collectNodes(Nodes &nodes) const {
+  if (std::find(nodes.begin(), nodes.end(), this) != nodes.end())
+    return;
+  if (m_lhs)
+    m_lhs->collectNodes(nodes);
+  if (m_rhs)
+    m_rhs->collectNodes(nodes);
+  nodes.push_back(this);
+}
+
+/** Check that the workspace of a node has the number of bins of the output
+ * @param numPoints :: number of bins of the output
+ * @throw std::invalid_argument if not
+ */
+void MDHistoExpression::checkSize(const size_t numPoints) const {
+  if (m_workspace && m_workspace->getNPoints() != numPoints)
+    throw std::invalid_argument(
+        "MDHistoExpression: a workspace has " +
+        std::to_string(m_workspace->getNPoints()) +
+        " bins instead of the " + std::to_string(numPoints) +
+        " bins of the output.");
+}
+
+/** Compute the values of this node over a block of bins.
+ * @param lhs :: values of the left-hand side, or only, operand
+ * @param rhs :: values of the right-hand side operand
+ * @param begin :: index of the first bin of the block
+ * @param size :: number of bins of the block
+ * @param buffer :: room for 3 * BLOCK_SIZE values, owned by this node
+ * @return the values, in the buffer or in the arrays of a workspace
+ */
+MDHistoExpression::Block
+MDHistoExpression::evaluateBlock(const Block &lhs, const Block &rhs,
+                                 const size_t begin, const size_t size,
+                                 signal_t *buffer) const {
+  Block result;
+  signal_t *signals = buffer;
+  signal_t *errorsSquared = buffer + BLOCK_SIZE;
+  signal_t *numEvents = buffer + 2 * BLOCK_SIZE;
+  result.signals = signals;
+  result.errorsSquared = errorsSquared;
+  result.numEvents = lhs.numEvents ? lhs.numEvents : rhs.numEvents;
+
+  // An operation on scalars only gives a scalar
+  const bool scalarOperands = lhs.isScalar && (!m_rhs || rhs.isScalar);
+  Block scalarLhs;
+  if (scalarOperands && m_operation != Operation::Workspace &&
+      m_operation != Operation::Scalar) {
+    scalarLhs.signals = &lhs.signal;
+    scalarLhs.errorsSquared = &lhs.errorSquared;
+  }
+  const Block &operand = scalarOperands ? scalarLhs : lhs;
+  const size_t numValues = scalarOperands ? 1 : size;
+
+  switch (m_operation) {
+  case Operation::Workspace:
+    result.signals = m_workspace->getSignalArray() + begin;
+    result.errorsSquared = m_workspace->getErrorSquaredArray() + begin;
+    result.numEvents = m_workspace->getNumEventsArray() + begin;
+    return result;
+  case Operation::Scalar:
+    result.isScalar = true;
+    result.signal = m_signal;
+    result.errorSquared = m_errorSquared;
+    result.numEvents = nullptr;
+    return result;
+  case Operation::Plus:
+  case Operation::Minus:
+    if (m_operation == Operation::Plus)
+      applyBinary(lhs, rhs, numValues, signals, errorsSquared, plusBin);
+    else
+      applyBinary(lhs, rhs, numValues, signals, errorsSquared, minusBin);
+    // Events are added up as by MDHistoWorkspace::add() and subtract()
+    if (lhs.numEvents && rhs.numEvents) {
+      for (size_t i = 0; i < size; ++i)
+        numEvents[i] = lhs.numEvents[i] + rhs.numEvents[i];
+      result.numEvents = numEvents;
+    }
+    break;
+  case Operation::Multiply:
+    applyBinary(lhs, rhs, numValues, signals, errorsSquared, multiplyBin);
+    break;
+  case Operation::Divide:
+    if (rhs.isScalar) {
+      // As MDHistoWorkspace::divide(signal, error)
+      const signal_t b = rhs.signal;
+      const signal_t db2_relative = rhs.errorSquared / (b * b);
+      const signal_t *a = lhs.isScalar ? &lhs.signal : lhs.signals;
+      const signal_t *da2 =
+          lhs.isScalar ? &lhs.errorSquared : lhs.errorsSquared;
+      for (size_t i = 0; i < numValues; ++i) {
+        const signal_t f = a[i] / b;
+        signals[i] = f;
+        errorsSquared[i] = da2[i] / (b * b) + db2_relative * f * f;
+      }
+    } else {
+      applyBinary(lhs, rhs, numValues, signals, errorsSquared, divideBin);
+    }
+    break;
+  case Operation::Log:
+  case Operation::Log10: {
+    const double filler = m_parameter;
+    const bool natural = m_operation == Operation::Log;
+    applyUnary(operand, numValues, signals, errorsSquared,
+               [filler, natural](const signal_t a, const signal_t da2,
+                                 signal_t &f, signal_t &df2) {
+                 if (a <= 0) {
+                   f = filler;
+                   df2 = 0;
+                 } else if (natural) {
+                   f = std::log(a);
+                   df2 = da2 / (a * a);
+                 } else {
+                   f = std::log10(a);
+                   df2 = 0.1886117 * da2 / (a * a); // ln(10)^-2
+                 }
+               });
+    break;
+  }
+  case Operation::Exp:
+    applyUnary(operand, numValues, signals, errorsSquared,
+               [](const signal_t a, const signal_t da2, signal_t &f,
+                  signal_t &df2) {
+                 f = std::exp(a);
+                 df2 = f * f * da2;
+               });
+    break;
+  case Operation::Power: {
+    const double exponent = m_parameter;
+    const double exponent_squared = exponent * exponent;
+    applyUnary(operand, numValues, signals, errorsSquared,
+               [exponent, exponent_squared](const signal_t a,
+                                            const signal_t da2, signal_t &f,
+                                            signal_t &df2) {
+                 f = std::pow(a, exponent);
+                 df2 = f * f * exponent_squared * da2 / (a * a);
+               });
+    break;
+  }
+  }
+
+  if (scalarOperands) {
+    result.isScalar = true;
+    result.signal = signals[0];
+    result.errorSquared = errorsSquared[0];
+  }
+  return result;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
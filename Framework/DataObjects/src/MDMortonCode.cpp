@@ -0,0 +1,70 @@
+#include "MantidDataObjects/MDMortonCode.h"
+#include "MantidAPI/IMDNode.h"
+#include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace DataObjects {
+
+const size_t MDMortonCode::MAX_DIMENSIONS;
+
+/** Interleave the bits of the cell indices of a point along each dimension
+ * into its Morton (Z-order) code.
+ * @param cells :: cell index of the point along each dimension, each taking at
+ * most mortonBitsPerDimension(nd) bits
+ * @param nd :: number of dimensions
+ * @return the Morton code
+ */
+uint64_t interleaveBits(const uint64_t *cells, const size_t nd) {
+  uint64_t code = 0;
+  for (size_t b = mortonBitsPerDimension(nd); b-- > 0;) {
+    for (size_t d = nd; d-- > 0;)
+      code = (code << 1) | ((cells[d] >> b) & 1);
+  }
+  return code;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Constructor
+ * @param box :: the box whose extents are the region to compute codes in
+ */
+MDMortonCode::MDMortonCode(API::IMDNode &box)
+    : m_min(box.getNumDims()), m_cellsPerUnit(box.getNumDims()), m_maxCell(0) {
+  if (m_min.empty() || m_min.size() > MAX_DIMENSIONS)
+    throw std::invalid_argument("MDMortonCode: cannot compute the codes of " +
+                                std::to_string(m_min.size()) + " dimensions.");
+  m_maxCell = (uint64_t(1) << mortonBitsPerDimension(m_min.size())) - 1;
+  for (size_t d = 0; d < m_min.size(); ++d) {
+    m_min[d] = box.getExtents(d).getMin();
+    const coord_t width = box.getExtents(d).getSize();
+    m_cellsPerUnit[d] =
+        width > 0 ? static_cast<coord_t>(m_maxCell) / width : 0;
+  }
+}
+
+/** Compute the Morton code of a point. Points outside the region are given the
+ * code of the nearest point inside.
+ * @param coords :: coordinates of the point
+ * @return the Morton code
+ */
+uint64_t MDMortonCode::operator()(const coord_t *coords) const {
+  const size_t nd = m_min.size();
+  uint64_t cells[MAX_DIMENSIONS];
+  for (size_t d = 0; d < nd; ++d) {
+    const coord_t cell = (coords[d] - m_min[d]) * m_cellsPerUnit[d];
+    // The comparisons are false for NaN, which goes into the first cell
+    if (!(cell > 0))
+      cells[d] = 0;
+    else if (cell >= static_cast<coord_t>(m_maxCell))
+      cells[d] = m_maxCell;
+    else
+      cells[d] = std::min(static_cast<uint64_t>(cell), m_maxCell);
+  }
+  return interleaveBits(cells, nd);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
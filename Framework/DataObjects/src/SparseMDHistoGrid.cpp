@@ -0,0 +1,137 @@
+#include "MantidDataObjects/SparseMDHistoGrid.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace DataObjects {
+
+const size_t SparseMDHistoGrid::DEFAULT_BRICK_SIZE;
+
+//----------------------------------------------------------------------------------------------
+/** Constructor. No brick is allocated.
+ * @param numPoints :: number of bins
+ * @param brickSize :: number of bins of a brick
+ */
+SparseMDHistoGrid::SparseMDHistoGrid(const size_t numPoints,
+                                     const size_t brickSize)
+    : m_numPoints(numPoints), m_brickSize(brickSize),
+      m_numBricks(brickSize > 0 ? (numPoints + brickSize - 1) / brickSize : 0),
+      m_bricks(new std::atomic<std::atomic<signal_t> *>[m_numBricks]) {
+  if (brickSize == 0)
+    throw std::invalid_argument(
+        "SparseMDHistoGrid: the size of the bricks must be positive.");
+  for (size_t brick = 0; brick < m_numBricks; ++brick)
+    m_bricks[brick].store(nullptr);
+}
+
+/// Destructor
+SparseMDHistoGrid::~SparseMDHistoGrid() {
+  for (size_t brick = 0; brick < m_numBricks; ++brick)
+    delete[] m_bricks[brick].load();
+}
+
+/// @return the number of allocated bricks
+size_t SparseMDHistoGrid::getNumAllocatedBricks() const {
+  size_t numAllocated = 0;
+  for (size_t brick = 0; brick < m_numBricks; ++brick) {
+    if (isBrickAllocated(brick))
+      ++numAllocated;
+  }
+  return numAllocated;
+}
+
+/// @return the memory used by the grid, in bytes
+size_t SparseMDHistoGrid::getMemorySize() const {
+  return m_numBricks * sizeof(std::atomic<signal_t> *) +
+         getNumAllocatedBricks() * m_brickSize * sizeof(std::atomic<signal_t>);
+}
+
+/** Add a signal to a bin, allocating its brick if needed. Thread-safe.
+ * @param index :: linear index of the bin
+ * @param signal :: signal to add
+ */
+void SparseMDHistoGrid::addSignal(const size_t index, const signal_t signal) {
+  auto signals = allocate(index / m_brickSize);
+  Kernel::AtomicOp(signals[index % m_brickSize], signal,
+                   std::plus<signal_t>());
+}
+
+/** Copy the grid to the signals of a workspace. The bins of the bricks that
+ * are not allocated are set to 0. The errors and numbers of events of the
+ * workspace are left as they are.
+ * @param ws :: a workspace with the bins of the grid
+ */
+void SparseMDHistoGrid::copyTo(MDHistoWorkspace &ws) const {
+  checkSize(ws.getNPoints());
+  toArray(ws.getSignalArray(), false);
+}
+
+/** Add the grid to the signals of a workspace. Only the allocated bricks are
+ * gone through.
+ * @param ws :: a workspace with the bins of the grid
+ */
+void SparseMDHistoGrid::addTo(MDHistoWorkspace &ws) const {
+  checkSize(ws.getNPoints());
+  toArray(ws.getSignalArray(), true);
+}
+
+/** Allocate a brick, filled with 0, if it is not yet. Thread-safe: if two
+ * threads allocate the same brick, one of the allocations is kept.
+ * @param brick :: index of the brick
+ * @return the brick
+ */
+std::atomic<signal_t> *SparseMDHistoGrid::allocate(const size_t brick) {
+  std::atomic<signal_t> *signals =
+      m_bricks[brick].load(std::memory_order_acquire);
+  if (signals)
+    return signals;
+  auto created = new std::atomic<signal_t>[m_brickSize];
+  for (size_t i = 0; i < m_brickSize; ++i)
+    created[i].store(0, std::memory_order_relaxed);
+  if (m_bricks[brick].compare_exchange_strong(signals, created,
+                                              std::memory_order_acq_rel))
+    return created;
+  // Another thread allocated it first
+  delete[] created;
+  return signals;
+}
+
+/** Check that a number of bins is that of the grid.
+ * @throw std::invalid_argument if not
+ */
+void SparseMDHistoGrid::checkSize(const size_t numPoints) const {
+  if (numPoints != m_numPoints)
+    throw std::invalid_argument(
+        "SparseMDHistoGrid: " + std::to_string(numPoints) +
+        " bins do not match the " + std::to_string(m_numPoints) +
+        " bins of the grid.");
+}
+
+/** Write or add the grid to an array with a signal for each bin
+ * @param signals :: the array
+ * @param add :: true to add the grid to the array, false to copy it
+ */
+void SparseMDHistoGrid::toArray(signal_t *signals, const bool add) const {
+  for (size_t brick = 0; brick < m_numBricks; ++brick) {
+    const size_t begin = brick * m_brickSize;
+    const size_t size = std::min(m_brickSize, m_numPoints - begin);
+    const auto brickSignals = this->brick(brick);
+    if (!brickSignals) {
+      if (!add)
+        std::fill_n(signals + begin, size, 0.);
+    } else if (add) {
+      for (size_t i = 0; i < size; ++i)
+        signals[begin + i] += brickSignals[i].load();
+    } else {
+      for (size_t i = 0; i < size; ++i)
+        signals[begin + i] = brickSignals[i].load();
+    }
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
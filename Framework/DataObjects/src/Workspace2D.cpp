@@ -1,6 +1,7 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidAPI/ISpectrum.h"
 #include "MantidAPI/RefAxis.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidHistogramData/LinearGenerator.h"
@@ -24,7 +25,8 @@ Workspace2D::Workspace2D(const Parallel::StorageMode storageMode)
     : HistoWorkspace(storageMode) {}
 
 Workspace2D::Workspace2D(const Workspace2D &other)
-    : HistoWorkspace(other), m_monitorList(other.m_monitorList) {
+    : HistoWorkspace(other), m_monitorList(other.m_monitorList),
+      m_singlePrecision(other.m_singlePrecision) {
   data.resize(other.data.size());
   for (size_t i = 0; i < data.size(); ++i) {
     data[i] = new Histogram1D(*(other.data[i]));
@@ -352,6 +354,49 @@ void Workspace2D::generateHistogram(const std::size_t index, const MantidVec &X,
   }
 }
 
+/** Hold the Y and E values of the spectra in single precision, which halves
+ * their memory, or back in double precision. Spectra whose values were accessed
+ * by reference in the meantime, and so widened back to double precision, are
+ * narrowed again by calling this with true. The X values are left in double
+ * precision.
+ * @param singlePrecision :: true for single precision, false for double
+ */
+void Workspace2D::setSinglePrecision(const bool singlePrecision) {
+  m_singlePrecision = singlePrecision;
+  const int64_t numberOfSpectra = static_cast<int64_t>(data.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfSpectra; ++i)
+    data[i]->setSinglePrecision(singlePrecision);
+}
+
+/// @return true if the Y and E values are held in single precision
+bool Workspace2D::isSinglePrecision() const { return m_singlePrecision; }
+
+/// @return The memory used by the workspace, in bytes
+size_t Workspace2D::getMemorySize() const {
+  if (!m_singlePrecision)
+    return HistoWorkspace::getMemorySize();
+  size_t total = run().getMemorySize();
+  for (const auto spectrum : data)
+    total += spectrum->getMemorySize();
+  return total;
+}
+
+/** Hold the Y and E values of a workspace in single precision if those of
+ * another one are. Algorithms call this on their output to keep the precision
+ * of their input.
+ * @param input :: The workspace to take the precision from
+ * @param output :: The workspace to set the precision of
+ */
+void propagateSinglePrecision(const API::MatrixWorkspace &input,
+                              API::MatrixWorkspace &output) {
+  const auto input2D = dynamic_cast<const Workspace2D *>(&input);
+  auto output2D = dynamic_cast<Workspace2D *>(&output);
+  if (input2D && output2D &&
+      (input2D->isSinglePrecision() || output2D->isSinglePrecision()))
+    output2D->setSinglePrecision(true);
+}
+
 Workspace2D *Workspace2D::doClone() const { return new Workspace2D(*this); }
 
 Workspace2D *Workspace2D::doCloneEmpty() const {
@@ -0,0 +1,254 @@
+#ifndef MANTID_DATAOBJECTS_COMPACTMDEVENTLAYOUTTEST_H_
+#define MANTID_DATAOBJECTS_COMPACTMDEVENTLAYOUTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CompactMDEventLayout.h"
+#include "MantidDataObjects/CoordTransformDistance.h"
+#include "MantidDataObjects/FakeMD.h"
+#include "MantidDataObjects/MDSphereIntegrator.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::API::IMDNode;
+using Mantid::coord_t;
+using Mantid::signal_t;
+
+namespace {
+using MDE = MDLeanEvent<3>;
+using MDEW = MDEventWorkspace<MDE, 3>;
+using Layout = CompactMDEventLayout<MDE, 3>;
+
+/// A workspace in (0, 10)^3 with a peak on top of a uniform background
+MDEW::sptr createWorkspace(const size_t numEvents) {
+  auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+  ws->splitBox();
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<coord_t> uniform(0.f, 10.f);
+  std::normal_distribution<coord_t> peak(4.f, 0.5f);
+  std::uniform_real_distribution<float> weight(0.5f, 1.5f);
+  for (size_t i = 0; i < numEvents; ++i) {
+    coord_t centers[3];
+    for (auto &center : centers)
+      center = i % 3 == 0 ? std::min(9.9f, std::max(0.1f, peak(generator)))
+                          : uniform(generator);
+    const float signal = weight(generator);
+    ws->addEvent(MDE(signal, signal * signal, centers));
+  }
+  ws->splitAllIfNeeded(nullptr);
+  ws->refreshCache();
+  return ws;
+}
+
+/// Integrate a sphere by going through all the events of a workspace
+void bruteForceSphere(MDEW &ws, const coord_t *center,
+                      const coord_t radiusSquared, signal_t &signal,
+                      signal_t &errorSquared) {
+  std::vector<IMDNode *> leaves;
+  ws.getBox()->getBoxes(leaves, 1000, true);
+  for (auto leaf : leaves) {
+    auto box = dynamic_cast<MDBox<MDE, 3> *>(leaf);
+    for (const auto &event : box->getConstEvents()) {
+      coord_t distanceSquared = 0;
+      for (size_t d = 0; d < 3; ++d) {
+        const coord_t delta = event.getCenter(d) - center[d];
+        distanceSquared += delta * delta;
+      }
+      if (distanceSquared < radiusSquared) {
+        signal += event.getSignal();
+        errorSquared += event.getErrorSquared();
+      }
+    }
+  }
+}
+} // namespace
+
+class CompactMDEventLayoutTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompactMDEventLayoutTest *createSuite() {
+    return new CompactMDEventLayoutTest();
+  }
+  static void destroySuite(CompactMDEventLayoutTest *suite) { delete suite; }
+
+  void test_empty_workspace() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    Layout layout(*ws);
+    TS_ASSERT_EQUALS(layout.numBoxes(), 0);
+    TS_ASSERT_EQUALS(layout.numEvents(), 0);
+    const coord_t center[3] = {5.f, 5.f, 5.f};
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    layout.integrateSphere(center, 4.f, signal, errorSquared);
+    TS_ASSERT_EQUALS(signal, 0.);
+  }
+
+  void test_events_and_signal_are_kept() {
+    auto ws = createWorkspace(20000);
+    Layout layout(*ws);
+    TS_ASSERT_EQUALS(layout.numEvents(), ws->getNPoints());
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    for (size_t i = 0; i < layout.numBoxes(); ++i) {
+      TS_ASSERT_LESS_THAN(layout.box(i).begin, layout.box(i).end);
+      signal += layout.box(i).signal;
+      errorSquared += layout.box(i).errorSquared;
+    }
+    TS_ASSERT_DELTA(signal, ws->getBox()->getSignal(), 1e-3);
+    TS_ASSERT_DELTA(errorSquared, ws->getBox()->getErrorSquared(), 1e-3);
+  }
+
+  void test_boxes_and_events_are_in_Morton_order() {
+    auto ws = createWorkspace(20000);
+    Layout layout(*ws);
+    TS_ASSERT_EQUALS(layout.box(0).begin, 0);
+    for (size_t i = 0; i < layout.numBoxes(); ++i) {
+      const auto &box = layout.box(i);
+      if (i > 0) {
+        TS_ASSERT_LESS_THAN(layout.box(i - 1).mortonCode, box.mortonCode);
+        TS_ASSERT_EQUALS(layout.box(i - 1).end, box.begin);
+      }
+      uint64_t previous = 0;
+      for (size_t j = box.begin; j < box.end; ++j) {
+        const auto &event = layout.events()[j];
+        coord_t center[3];
+        for (size_t d = 0; d < 3; ++d) {
+          center[d] = event.getCenter(d);
+          TS_ASSERT_LESS_THAN_EQUALS(box.min[d], center[d]);
+          TS_ASSERT_LESS_THAN_EQUALS(center[d], box.max[d]);
+        }
+        const uint64_t code = layout.mortonCode(center);
+        TS_ASSERT_LESS_THAN_EQUALS(previous, code);
+        previous = code;
+      }
+    }
+    TS_ASSERT_EQUALS(layout.box(layout.numBoxes() - 1).end,
+                     layout.numEvents());
+  }
+
+  void test_findBoxes() {
+    auto ws = createWorkspace(20000);
+    Layout layout(*ws);
+    const coord_t min[3] = {2.f, 3.f, 4.f};
+    const coord_t max[3] = {3.f, 3.5f, 8.f};
+    const auto found = layout.findBoxes(min, max);
+    TS_ASSERT(!found.empty());
+    size_t next = 0;
+    for (size_t i = 0; i < layout.numBoxes(); ++i) {
+      bool overlaps = true;
+      for (size_t d = 0; d < 3; ++d)
+        overlaps = overlaps && layout.box(i).max[d] >= min[d] &&
+                   layout.box(i).min[d] <= max[d];
+      if (overlaps) {
+        TS_ASSERT_LESS_THAN(next, found.size());
+        if (next < found.size())
+          TS_ASSERT_EQUALS(found[next++], i);
+      }
+    }
+    TS_ASSERT_EQUALS(next, found.size());
+  }
+
+  void test_integrateSphere_matches_all_events() {
+    auto ws = createWorkspace(50000);
+    Layout layout(*ws);
+    const std::vector<std::vector<coord_t>> centers{
+        {4.f, 4.f, 4.f}, {1.3f, 7.2f, 5.5f}, {0.f, 0.f, 0.f}, {9.f, 2.f, 5.f}};
+    for (const auto &center : centers) {
+      for (coord_t radius : {0.3f, 1.f, 2.5f, 20.f}) {
+        signal_t expectedSignal = 0;
+        signal_t expectedError = 0;
+        bruteForceSphere(*ws, center.data(), radius * radius, expectedSignal,
+                         expectedError);
+        signal_t signal = 0;
+        signal_t errorSquared = 0;
+        layout.integrateSphere(center.data(), radius * radius, signal,
+                               errorSquared);
+        TS_ASSERT_DELTA(signal, expectedSignal, 1e-6 * expectedSignal + 1e-6);
+        TS_ASSERT_DELTA(errorSquared, expectedError,
+                        1e-6 * expectedError + 1e-6);
+      }
+    }
+  }
+  void test_integrateSphere_matches_box_tree() {
+    auto ws = createWorkspace(50000);
+    Layout layout(*ws);
+    const bool dimensionsUsed[3] = {true, true, true};
+    const std::vector<std::vector<coord_t>> centers{
+        {4.f, 4.f, 4.f}, {1.3f, 7.2f, 5.5f}, {9.f, 2.f, 5.f}};
+    for (const auto &center : centers) {
+      MDSphereIntegrator<MDE, 3> sphere(center.data(), dimensionsUsed);
+      for (const bool correction : {true, false}) {
+        for (coord_t inner : {0.f, 0.5f, 1.5f}) {
+          const coord_t outer = 2.5f;
+          signal_t expectedSignal = 0;
+          signal_t expectedError = 0;
+          sphere.integrate(ws->getBox(), outer * outer, expectedSignal,
+                           expectedError, inner * inner, correction);
+          signal_t signal = 0;
+          signal_t errorSquared = 0;
+          layout.integrateSphere(center.data(), outer * outer, signal,
+                                 errorSquared, inner * inner, correction);
+          TS_ASSERT_DELTA(signal, expectedSignal, 1e-6 * expectedSignal + 1e-6);
+          TS_ASSERT_DELTA(errorSquared, expectedError,
+                          1e-6 * expectedError + 1e-6);
+        }
+      }
+    }
+  }
+};
+
+/** Sphere integration over the box tree against the compact layout, for a
+ * workspace of 4 million events from FakeMD. */
+class CompactMDEventLayoutTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompactMDEventLayoutTestPerformance *createSuite() {
+    return new CompactMDEventLayoutTestPerformance();
+  }
+  static void destroySuite(CompactMDEventLayoutTestPerformance *suite) {
+    delete suite;
+  }
+
+  CompactMDEventLayoutTestPerformance() {
+    m_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 0);
+    m_ws->getBoxController()->setSplitThreshold(1000);
+    FakeMD faker({3e6}, {1e6, 5.0, 5.0, 5.0, 1.0}, 0, false);
+    faker.fill(m_ws);
+    m_layout.reset(new Layout(*m_ws));
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<coord_t> uniform(1.f, 9.f);
+    for (size_t i = 0; i < 300; ++i)
+      m_centers.push_back({uniform(generator), uniform(generator),
+                           uniform(generator)});
+  }
+
+  void test_build_layout() { Layout layout(*m_ws); }
+
+  void test_integrateSphere_box_tree() {
+    const bool dimensionsUsed[3] = {true, true, true};
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    for (const auto &center : m_centers) {
+      CoordTransformDistance sphere(3, center.data(), dimensionsUsed);
+      m_ws->getBox()->integrateSphere(sphere, 0.25f, signal, errorSquared);
+    }
+  }
+
+  void test_integrateSphere_compact_layout() {
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    for (const auto &center : m_centers)
+      m_layout->integrateSphere(center.data(), 0.25f, signal, errorSquared);
+  }
+
+private:
+  MDEW::sptr m_ws;
+  std::unique_ptr<Layout> m_layout;
+  std::vector<std::vector<coord_t>> m_centers;
+};
+
+#endif /* MANTID_DATAOBJECTS_COMPACTMDEVENTLAYOUTTEST_H_ */
@@ -0,0 +1,152 @@
+#ifndef MANTID_DATAOBJECTS_COORDTRANSFORMKERNELTEST_H_
+#define MANTID_DATAOBJECTS_COORDTRANSFORMKERNELTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CoordTransformDistance.h"
+#include "MantidDataObjects/CoordTransformKernel.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidKernel/Matrix.h"
+
+#include <cmath>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::API::CoordTransform;
+using Mantid::Kernel::Matrix;
+using Mantid::coord_t;
+
+namespace {
+/// Random points in (-10, 10)^3
+std::vector<coord_t> createPoints(const size_t numPoints) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<coord_t> uniform(-10.f, 10.f);
+  std::vector<coord_t> points(3 * numPoints);
+  for (auto &x : points)
+    x = uniform(generator);
+  return points;
+}
+
+/// Set a 3D to 2D transformation to a rotation about z with a translation and
+/// a scaling
+void setRotation(CoordTransformAffine &affine) {
+  Matrix<coord_t> matrix(3, 4);
+  const coord_t angle = 0.3f;
+  matrix[0][0] = 2.f * std::cos(angle);
+  matrix[0][1] = -2.f * std::sin(angle);
+  matrix[0][3] = 1.5f;
+  matrix[1][0] = 0.5f * std::sin(angle);
+  matrix[1][1] = 0.5f * std::cos(angle);
+  matrix[1][2] = 0.1f;
+  matrix[1][3] = -3.f;
+  matrix[2][3] = 1.f;
+  affine.setMatrix(matrix);
+}
+
+/// Check that the kernel transforms points exactly as the transformation
+void checkSameAsTransform(const CoordTransform &transform) {
+  CoordTransformKernel<3> kernel(transform);
+  const size_t outD = transform.getOutD();
+  TS_ASSERT_EQUALS(kernel.getOutD(), outD);
+  const auto points = createPoints(1000);
+  std::vector<coord_t> expected(outD);
+  std::vector<coord_t> out(outD);
+  for (size_t i = 0; i < 1000; ++i) {
+    transform.apply(&points[3 * i], expected.data());
+    kernel.apply(&points[3 * i], out.data());
+    TS_ASSERT_EQUALS(out, expected);
+  }
+
+  std::vector<MDLeanEvent<3>> events;
+  for (size_t i = 0; i < 1000; ++i)
+    events.emplace_back(1.f, 1.f, &points[3 * i]);
+  std::vector<coord_t> batch(1000 * outD);
+  kernel.applyToEvents(events.data(), events.size(), batch.data());
+  for (size_t i = 0; i < 1000; ++i) {
+    transform.apply(&points[3 * i], expected.data());
+    for (size_t d = 0; d < outD; ++d)
+      TS_ASSERT_EQUALS(batch[i * outD + d], expected[d]);
+  }
+}
+} // namespace
+
+class CoordTransformKernelTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CoordTransformKernelTest *createSuite() {
+    return new CoordTransformKernelTest();
+  }
+  static void destroySuite(CoordTransformKernelTest *suite) { delete suite; }
+
+  void test_aligned() {
+    const size_t dimensionToBinFrom[2] = {2, 0};
+    const coord_t origin[2] = {-1.25f, 3.f};
+    const coord_t scaling[2] = {3.3f, 0.7f};
+    CoordTransformAligned aligned(3, 2, dimensionToBinFrom, origin, scaling);
+    TS_ASSERT(CoordTransformKernel<3>(aligned).isDevirtualized());
+    checkSameAsTransform(aligned);
+  }
+
+  void test_affine() {
+    CoordTransformAffine affine(3, 2);
+    setRotation(affine);
+    TS_ASSERT(CoordTransformKernel<3>(affine).isDevirtualized());
+    checkSameAsTransform(affine);
+  }
+
+  void test_other_transforms_are_applied_through_apply() {
+    const coord_t center[3] = {1.f, 2.f, 3.f};
+    const bool dimensionsUsed[3] = {true, false, true};
+    CoordTransformDistance distance(3, center, dimensionsUsed);
+    TS_ASSERT(!CoordTransformKernel<3>(distance).isDevirtualized());
+    checkSameAsTransform(distance);
+  }
+
+  void test_wrong_number_of_dimensions_is_not_devirtualized() {
+    CoordTransformAffine affine(3, 2);
+    TS_ASSERT(!CoordTransformKernel<4>(affine).isDevirtualized());
+  }
+};
+
+/** Transformation of 10 million events, through the virtual apply() and the
+ * kernel. */
+class CoordTransformKernelTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CoordTransformKernelTestPerformance *createSuite() {
+    return new CoordTransformKernelTestPerformance();
+  }
+  static void destroySuite(CoordTransformKernelTestPerformance *suite) {
+    delete suite;
+  }
+
+  CoordTransformKernelTestPerformance()
+      : m_affine(3, 2), m_out(2 * NUM_EVENTS) {
+    setRotation(m_affine);
+    const auto points = createPoints(NUM_EVENTS);
+    m_events.reserve(NUM_EVENTS);
+    for (size_t i = 0; i < NUM_EVENTS; ++i)
+      m_events.emplace_back(1.f, 1.f, &points[3 * i]);
+  }
+
+  void test_affine_virtual_apply() {
+    const CoordTransform &transform = m_affine;
+    for (size_t i = 0; i < NUM_EVENTS; ++i)
+      transform.apply(m_events[i].getCenter(), &m_out[2 * i]);
+  }
+
+  void test_affine_kernel() {
+    CoordTransformKernel<3> kernel(m_affine);
+    kernel.applyToEvents(m_events.data(), NUM_EVENTS, m_out.data());
+  }
+
+private:
+  static const size_t NUM_EVENTS = 10000000;
+  CoordTransformAffine m_affine;
+  std::vector<MDLeanEvent<3>> m_events;
+  std::vector<coord_t> m_out;
+};
+
+#endif /* MANTID_DATAOBJECTS_COORDTRANSFORMKERNELTEST_H_ */
@@ -0,0 +1,294 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/Unit.h"
+#include "MantidKernel/UnitFactory.h"
+
+#include <cmath>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_construct_from_tof_event_list() {
+    EventList el = createEventList();
+    EventColumns columns(el);
+    TS_ASSERT_EQUALS(columns.getEventType(), TOF);
+    TS_ASSERT_EQUALS(columns.size(), 4);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(!columns.hasWeights());
+    TS_ASSERT(columns.weights().empty());
+    TS_ASSERT_EQUALS(columns.tofs()[1], 3.5);
+    TS_ASSERT_EQUALS(columns.pulseTimes()[1], 400);
+  }
+
+  void test_construct_from_weighted_event_list() {
+    EventList el = createEventList();
+    el.switchTo(WEIGHTED);
+    el *= 2.0;
+    EventColumns columns(el);
+    TS_ASSERT_EQUALS(columns.getEventType(), WEIGHTED);
+    TS_ASSERT_EQUALS(columns.size(), 4);
+    TS_ASSERT_EQUALS(columns.weights()[0], 2.0f);
+    TS_ASSERT_EQUALS(columns.errorSquareds()[0], 4.0f);
+    TS_ASSERT_EQUALS(columns.pulseTimes()[2], 60);
+  }
+
+  void test_copyInto_round_trips() {
+    EventList el = createEventList();
+    el.switchTo(WEIGHTED);
+    el.sortTof();
+    EventColumns columns(el);
+    EventList copy;
+    columns.copyInto(copy);
+    TS_ASSERT_EQUALS(copy.getEventType(), WEIGHTED);
+    TS_ASSERT_EQUALS(copy.getSortType(), TOF_SORT);
+    TS_ASSERT(copy == el);
+  }
+
+  void test_copyInto_notime_list_drops_pulse_times() {
+    EventColumns columns(createEventList());
+    EventList target;
+    target.switchTo(WEIGHTED_NOTIME);
+    columns.copyInto(target);
+    TS_ASSERT_EQUALS(target.getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT_EQUALS(target.getNumberEvents(), 4);
+    TS_ASSERT_EQUALS(target.getWeightedEventsNoTime()[1].tof(), 3.5);
+    TS_ASSERT_EQUALS(target.getWeightedEventsNoTime()[1].weight(), 1.0);
+  }
+
+  void test_appendTo_checks_event_type() {
+    EventColumns columns(createEventList());
+    std::vector<WeightedEvent> weighted;
+    columns.appendTo(weighted);
+    TS_ASSERT_EQUALS(weighted.size(), 4);
+    TS_ASSERT_EQUALS(weighted[1].pulseTime().totalNanoseconds(), 400);
+
+    EventColumns noTimeColumns(WEIGHTED_NOTIME);
+    noTimeColumns.addEvent(1.0, 0, 2.f, 4.f);
+    std::vector<TofEvent> tofEvents;
+    TS_ASSERT_THROWS(noTimeColumns.appendTo(tofEvents), std::runtime_error);
+    TS_ASSERT_THROWS(noTimeColumns.appendTo(weighted), std::runtime_error);
+  }
+
+  void test_addEvent_checks_event_type() {
+    EventColumns tofColumns(TOF);
+    TS_ASSERT_THROWS_NOTHING(tofColumns.addEvent(1.0, 10));
+    TS_ASSERT_THROWS(tofColumns.addEvent(1.0, 10, 1.f, 1.f),
+                     std::runtime_error);
+
+    EventColumns noTimeColumns(WEIGHTED_NOTIME);
+    TS_ASSERT_THROWS(noTimeColumns.addEvent(1.0, 10), std::runtime_error);
+    TS_ASSERT_THROWS_NOTHING(noTimeColumns.addEvent(1.0, 10, 2.f, 4.f));
+    TS_ASSERT(noTimeColumns.pulseTimes().empty());
+    TS_ASSERT_EQUALS(noTimeColumns.weights().size(), 1);
+  }
+
+  void test_generateHistogram_matches_EventList_for_unsorted_events() {
+    EventList el = createEventList();
+    EventColumns columns(el);
+    const MantidVec X{0.0, 10.0, 50.0, 100.0, 1000.0};
+    MantidVec Y, E;
+    columns.generateHistogram(X, Y, E);
+    MantidVec expectedY, expectedE;
+    el.generateHistogram(X, expectedY, expectedE);
+    TS_ASSERT_EQUALS(Y, expectedY);
+    TS_ASSERT_EQUALS(E, expectedE);
+    TS_ASSERT_EQUALS(Y, MantidVec({1.0, 0.0, 1.0, 2.0}));
+  }
+
+  void test_generateHistogram_weighted() {
+    EventColumns columns(WEIGHTED_NOTIME);
+    columns.addEvent(5.0, 0, 2.f, 4.f);
+    columns.addEvent(15.0, 0, 1.f, 9.f);
+    columns.addEvent(6.0, 0, 3.f, 12.f);
+    columns.addEvent(-1.0, 0, 3.f, 12.f);
+    const MantidVec X{0.0, 10.0, 20.0};
+    MantidVec Y, E;
+    columns.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y, MantidVec({5.0, 1.0}));
+    TS_ASSERT_DELTA(E[0], 4.0, 1e-12);
+    TS_ASSERT_DELTA(E[1], 3.0, 1e-12);
+  }
+
+  void test_generateHistogram_with_more_events_than_a_block() {
+    EventColumns columns(TOF);
+    const size_t numEvents = 5000;
+    for (size_t i = 0; i < numEvents; ++i)
+      columns.addEvent(static_cast<double>((i * 7919) % numEvents), 0);
+    const MantidVec X{0.0, 1000.0, 2500.0, 5000.0};
+    MantidVec Y, E;
+    columns.generateHistogram(X, Y, E, true);
+    TS_ASSERT_EQUALS(Y, MantidVec({1000.0, 1500.0, 2500.0}));
+  }
+
+  void test_generateHistogram_empty_X() {
+    EventColumns columns(createEventList());
+    MantidVec Y{1.0}, E{1.0};
+    columns.generateHistogram(MantidVec(), Y, E);
+    TS_ASSERT(Y.empty());
+    TS_ASSERT(E.empty());
+  }
+
+  void test_convertTof() {
+    EventColumns columns(createEventList());
+    columns.convertTof(2.0, 1.0);
+    TS_ASSERT_EQUALS(columns.tofs()[0], 201.0);
+    TS_ASSERT_EQUALS(columns.tofs()[1], 8.0);
+    columns.scaleTof(0.5);
+    TS_ASSERT_EQUALS(columns.tofs()[0], 100.5);
+  }
+
+  void test_convertTof_negative_factor_keeps_sort_order() {
+    EventList el = createEventList();
+    el.sortTof();
+    EventColumns columns(el);
+    columns.scaleTof(-1.0);
+    TS_ASSERT_EQUALS(columns.getSortType(), TOF_SORT);
+    TS_ASSERT_EQUALS(columns.tofs().front(), -150.0);
+    TS_ASSERT_EQUALS(columns.tofs().back(), -3.5);
+    TS_ASSERT_EQUALS(columns.pulseTimes().front(), 80);
+  }
+
+  void test_maskTof_does_not_need_sorting() {
+    EventColumns columns(createEventList());
+    columns.maskTof(40.0, 100.0);
+    TS_ASSERT_EQUALS(columns.size(), 2);
+    TS_ASSERT_EQUALS(columns.tofs()[0], 3.5);
+    TS_ASSERT_EQUALS(columns.tofs()[1], 150.0);
+    TS_ASSERT_EQUALS(columns.pulseTimes()[0], 400);
+    TS_ASSERT_EQUALS(columns.pulseTimes()[1], 80);
+    TS_ASSERT_THROWS(columns.maskTof(10.0, 5.0), std::runtime_error);
+  }
+
+  void test_clear() {
+    EventColumns columns(createEventList());
+    columns.clear();
+    TS_ASSERT(columns.empty());
+    TS_ASSERT(columns.pulseTimes().empty());
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  // EventList holding its events in columns
+  //-----------------------------------------------------------------------------------------------
+  void test_EventList_switchToColumns_round_trips() {
+    EventList el = createEventList();
+    el.switchTo(WEIGHTED);
+    el *= 2.0;
+    el.sortTof();
+    const EventList original(el);
+
+    el.switchToColumns();
+    TS_ASSERT(el.hasColumns());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 4);
+    TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+    TS_ASSERT(el.isSortedByTof());
+    TS_ASSERT_EQUALS(el.columns().tofs()[0], 3.5);
+    TS_ASSERT_EQUALS(el.columns().weights()[0], 2.0f);
+
+    el.switchToRows();
+    TS_ASSERT(!el.hasColumns());
+    TS_ASSERT_THROWS(el.columns(), std::runtime_error);
+    TS_ASSERT(el == original);
+  }
+
+  void test_EventList_histogram_from_columns_matches_rows() {
+    EventList rows = createEventList();
+    EventList columns = createEventList();
+    columns.switchToColumns();
+    const MantidVec X{0.0, 10.0, 50.0, 100.0, 1000.0};
+    MantidVec Y, E, expectedY, expectedE;
+    columns.generateHistogram(X, Y, E);
+    rows.generateHistogram(X, expectedY, expectedE);
+    TS_ASSERT_EQUALS(Y, expectedY);
+    TS_ASSERT_EQUALS(E, expectedE);
+    // Histogramming does not sort the columns nor move them back to rows
+    TS_ASSERT(columns.hasColumns());
+    TS_ASSERT_EQUALS(columns.getSortType(), UNSORTED);
+  }
+
+  void test_EventList_convertUnitsViaTof_on_columns_matches_rows() {
+    auto fromUnit = Kernel::UnitFactory::Instance().create("TOF");
+    auto toUnit = Kernel::UnitFactory::Instance().create("Wavelength");
+    fromUnit->initialize(10.0, 2.0, 0.5, 0, 0.0, 0.0);
+    toUnit->initialize(10.0, 2.0, 0.5, 0, 0.0, 0.0);
+    EventList rows = createEventList();
+    EventList columns = createEventList();
+    columns.switchToColumns();
+    rows.convertUnitsViaTof(fromUnit.get(), toUnit.get());
+    columns.convertUnitsViaTof(fromUnit.get(), toUnit.get());
+    TS_ASSERT(columns.hasColumns());
+    const auto expected = rows.getTofs();
+    const auto &tofs = columns.columns().tofs();
+    TS_ASSERT_EQUALS(tofs.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+      TS_ASSERT_DELTA(tofs[i], expected[i], 1e-12);
+  }
+
+  void test_EventList_negative_scaleTof_on_columns_reverses_X_and_events() {
+    EventList el = createEventList();
+    el.setHistogram(HistogramData::BinEdges{0.0, 100.0, 200.0});
+    el.sortTof();
+    el.switchToColumns();
+    el.scaleTof(-1.0);
+    TS_ASSERT(el.hasColumns());
+    TS_ASSERT(el.isSortedByTof());
+    TS_ASSERT_EQUALS(el.x().rawData(), MantidVec({-200.0, -100.0, 0.0}));
+    TS_ASSERT_EQUALS(el.columns().tofs().front(), -150.0);
+    TS_ASSERT_EQUALS(el.columns().tofs().back(), -3.5);
+  }
+
+  void test_EventList_maskTof_on_columns() {
+    EventList el = createEventList();
+    el.switchToColumns();
+    el.maskTof(40.0, 100.0);
+    TS_ASSERT(el.hasColumns());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    el.maskTof(0.0, 200.0);
+    TS_ASSERT(el.empty());
+    TS_ASSERT(!el.hasColumns());
+  }
+
+  void test_EventList_other_operations_move_columns_back_to_rows() {
+    EventList el = createEventList();
+    el.switchToColumns();
+    const EventList copy(el);
+    TS_ASSERT(copy.hasColumns());
+
+    TS_ASSERT_EQUALS(el.getPulseTimeMin().totalNanoseconds(), 60);
+    TS_ASSERT(!el.hasColumns());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 4);
+
+    // Appending goes through the rows as well
+    EventList appended(copy);
+    appended += TofEvent(1.0, 10);
+    TS_ASSERT(!appended.hasColumns());
+    TS_ASSERT_EQUALS(appended.getNumberEvents(), 5);
+    TS_ASSERT_EQUALS(appended.getEvents()[1].tof(), 3.5);
+  }
+
+private:
+  EventList createEventList() {
+    EventList el;
+    el += TofEvent(100, 200);
+    el += TofEvent(3.5, 400);
+    el += TofEvent(50, 60);
+    el += TofEvent(150, 80);
+    return el;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_ */
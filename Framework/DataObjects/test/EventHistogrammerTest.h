@@ -0,0 +1,228 @@
+#ifndef MANTID_DATAOBJECTS_EVENTHISTOGRAMMERTEST_H_
+#define MANTID_DATAOBJECTS_EVENTHISTOGRAMMERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidHistogramData/LinearGenerator.h"
+#include "MantidHistogramData/LogarithmicGenerator.h"
+
+#include <random>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::LinearGenerator;
+using Mantid::HistogramData::LogarithmicGenerator;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+/// Histogram sorted events with the sorted walk of EventList
+void sortedHistogram(EventList el, const MantidVec &X, MantidVec &Y,
+                     MantidVec &E) {
+  el.sortTof();
+  el.generateHistogram(X, Y, E);
+}
+
+EventList createRandomEventList(const size_t numEvents, const double tofMin,
+                                const double tofMax) {
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<double> tofs(tofMin, tofMax);
+  EventList el;
+  for (size_t i = 0; i < numEvents; ++i)
+    el += TofEvent(tofs(generator), 0);
+  return el;
+}
+} // namespace
+
+class EventHistogrammerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventHistogrammerTest *createSuite() {
+    return new EventHistogrammerTest();
+  }
+  static void destroySuite(EventHistogrammerTest *suite) { delete suite; }
+
+  void test_detects_linear_binning() {
+    const BinEdges edges(101, LinearGenerator(10.0, 0.5));
+    EventHistogrammer histogrammer(edges.rawData());
+    TS_ASSERT(histogrammer.binningType() ==
+              EventHistogrammer::BinningType::Linear);
+    TS_ASSERT_EQUALS(histogrammer.numberOfBins(), 100);
+  }
+
+  void test_detects_linear_binning_with_wider_last_bin() {
+    MantidVec X{0.0, 1.0, 2.0, 3.0, 4.0, 5.2};
+    EventHistogrammer histogrammer(X);
+    TS_ASSERT(histogrammer.binningType() ==
+              EventHistogrammer::BinningType::Linear);
+    TS_ASSERT_EQUALS(histogrammer.findBin(5.1), 4);
+  }
+
+  void test_detects_logarithmic_binning() {
+    const BinEdges edges(101, LogarithmicGenerator(10.0, 0.01));
+    EventHistogrammer histogrammer(edges.rawData());
+    TS_ASSERT(histogrammer.binningType() ==
+              EventHistogrammer::BinningType::Logarithmic);
+  }
+
+  void test_detects_arbitrary_binning() {
+    MantidVec X{0.0, 1.0, 5.0, 6.0, 20.0, 21.0};
+    EventHistogrammer histogrammer(X);
+    TS_ASSERT(histogrammer.binningType() ==
+              EventHistogrammer::BinningType::Arbitrary);
+  }
+
+  void test_findBin_on_edges() {
+    MantidVec X{0.0, 1.0, 5.0, 6.0, 20.0, 21.0};
+    EventHistogrammer arbitrary(X);
+    TS_ASSERT_EQUALS(arbitrary.findBin(0.0), 0);
+    TS_ASSERT_EQUALS(arbitrary.findBin(1.0), 1);
+    TS_ASSERT_EQUALS(arbitrary.findBin(4.99), 1);
+    TS_ASSERT_EQUALS(arbitrary.findBin(20.5), 4);
+    const BinEdges edges(11, LinearGenerator(0.0, 0.1));
+    EventHistogrammer linear(edges.rawData());
+    for (size_t i = 0; i < 10; ++i)
+      TS_ASSERT_EQUALS(linear.findBin(edges[i]), i);
+  }
+
+  void test_findBin_outside_edges() {
+    MantidVec X{1.0, 2.0, 3.0};
+    EventHistogrammer histogrammer(X);
+    TS_ASSERT_EQUALS(histogrammer.findBin(0.5), 2);
+    TS_ASSERT_EQUALS(histogrammer.findBin(3.0), 2);
+    TS_ASSERT_EQUALS(histogrammer.findBin(-1.0), 2);
+    TS_ASSERT_EQUALS(histogrammer.findBin(std::nan("")), 2);
+  }
+
+  void test_empty_edges() {
+    MantidVec X{1.0};
+    EventHistogrammer histogrammer(X);
+    TS_ASSERT_EQUALS(histogrammer.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(histogrammer.findBin(1.0), 0);
+  }
+
+  void test_unsorted_matches_sorted_linear() {
+    const BinEdges edges(1001, LinearGenerator(100.0, 10.0));
+    checkUnsortedMatchesSorted(edges.rawData());
+  }
+
+  void test_unsorted_matches_sorted_logarithmic() {
+    const BinEdges edges(501, LogarithmicGenerator(100.0, 0.005));
+    checkUnsortedMatchesSorted(edges.rawData());
+  }
+
+  void test_unsorted_matches_sorted_arbitrary() {
+    MantidVec X{100.0};
+    std::mt19937 generator(54321);
+    std::uniform_real_distribution<double> widths(0.1, 50.0);
+    while (X.back() < 12000.0)
+      X.push_back(X.back() + widths(generator));
+    checkUnsortedMatchesSorted(X);
+  }
+
+  void test_unsorted_weighted_matches_sorted() {
+    const BinEdges edges(1001, LinearGenerator(100.0, 10.0));
+    EventList el = createRandomEventList(10000, 0.0, 12000.0);
+    el.switchTo(API::WEIGHTED);
+    el *= 2.5;
+    MantidVec Y, E, sortedY, sortedE;
+    el.generateHistogram(edges.rawData(), Y, E);
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    sortedHistogram(el, edges.rawData(), sortedY, sortedE);
+    TS_ASSERT_EQUALS(Y.size(), sortedY.size());
+    for (size_t i = 0; i < Y.size(); ++i) {
+      TS_ASSERT_DELTA(Y[i], sortedY[i], 1e-9);
+      TS_ASSERT_DELTA(E[i], sortedE[i], 1e-9);
+    }
+  }
+
+private:
+  void checkUnsortedMatchesSorted(const MantidVec &X) {
+    EventList el = createRandomEventList(10000, 0.0, 12000.0);
+    // Events exactly on the edges
+    for (size_t i = 0; i < X.size(); i += 7)
+      el += TofEvent(X[i], 0);
+    MantidVec Y, E, sortedY, sortedE;
+    el.generateHistogram(X, Y, E);
+    // The events were histogrammed without sorting them
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    sortedHistogram(el, X, sortedY, sortedE);
+    TS_ASSERT_EQUALS(Y, sortedY);
+    TS_ASSERT_EQUALS(E, sortedE);
+  }
+};
+
+/** Microbenchmarks of histogramming unsorted events, against sorting them
+ * first. */
+class EventHistogrammerTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventHistogrammerTestPerformance *createSuite() {
+    return new EventHistogrammerTestPerformance();
+  }
+  static void destroySuite(EventHistogrammerTestPerformance *suite) {
+    delete suite;
+  }
+
+  EventHistogrammerTestPerformance()
+      : m_source(createRandomEventList(5000000, 0.0, 1e5)),
+        m_linearX(BinEdges(100001, LinearGenerator(0.0, 1.0)).rawData()),
+        m_logX(BinEdges(5000, LogarithmicGenerator(10.0, 0.0015)).rawData()) {
+    m_arbitraryX = m_linearX;
+    // Perturb the edges so that the binning is not linear
+    for (size_t i = 1; i + 1 < m_arbitraryX.size(); i += 2)
+      m_arbitraryX[i] += 0.25;
+  }
+
+  void setUp() override { m_events = m_source; }
+
+  void test_histogram_unsorted_linear() {
+    m_events.generateHistogram(m_linearX, m_Y, m_E);
+  }
+
+  void test_histogram_unsorted_logarithmic() {
+    m_events.generateHistogram(m_logX, m_Y, m_E);
+  }
+
+  void test_histogram_unsorted_arbitrary() {
+    m_events.generateHistogram(m_arbitraryX, m_Y, m_E);
+  }
+
+  void test_histogram_sort_then_linear() {
+    m_events.sortTof();
+    m_events.generateHistogram(m_linearX, m_Y, m_E);
+  }
+
+  void test_findBins_linear() {
+    EventHistogrammer histogrammer(m_linearX);
+    findAllBins(histogrammer);
+  }
+
+  void test_findBins_arbitrary() {
+    EventHistogrammer histogrammer(m_arbitraryX);
+    findAllBins(histogrammer);
+  }
+
+private:
+  void findAllBins(const EventHistogrammer &histogrammer) {
+    std::vector<double> tofs;
+    m_events.getTofs(tofs);
+    std::vector<size_t> bins(tofs.size());
+    histogrammer.findBins(tofs.data(), tofs.data() + tofs.size(),
+                          bins.data());
+  }
+
+  EventList m_source;
+  EventList m_events;
+  MantidVec m_linearX;
+  MantidVec m_logX;
+  MantidVec m_arbitraryX;
+  MantidVec m_Y;
+  MantidVec m_E;
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTHISTOGRAMMERTEST_H_ */
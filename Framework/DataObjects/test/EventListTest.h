@@ -335,6 +335,27 @@ public:
     TS_ASSERT_EQUALS(el.getEvent(NUMEVENTS + 1).weight(), 1.0);
   }
 
+  //----------------------------------
+  void test_addEventsQuickly() {
+    fake_data();
+    el.sortTof();
+    const uint32_t rawTofs[3] = {1000, 2500, 500};
+    const DateAndTime pulse(1234);
+    el.addEventsQuickly(rawTofs, 3, 1e-3, pulse);
+    TS_ASSERT_EQUALS(el.getEventType(), TOF);
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS + 3);
+    const auto &events = el.getEvents();
+    TS_ASSERT_DELTA(events[NUMEVENTS].tof(), 1.0, 1e-12);
+    TS_ASSERT_DELTA(events[NUMEVENTS + 1].tof(), 2.5, 1e-12);
+    TS_ASSERT_DELTA(events[NUMEVENTS + 2].tof(), 0.5, 1e-12);
+    TS_ASSERT_EQUALS(events[NUMEVENTS + 2].pulseTime(), pulse);
+
+    // An empty batch leaves the events untouched
+    el.addEventsQuickly(rawTofs, 0, 1e-3, pulse);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS + 3);
+  }
+
   //----------------------------------
   /** Nine possibilies of adding event lists together
    * (3 lhs x 3 rhs types).
@@ -787,6 +808,93 @@ public:
     }
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_addEventsSortedByTof_merges_sorted_batches() {
+    EventList sorted;
+    EventList reference;
+    for (int batch = 0; batch < 7; ++batch) {
+      const auto events = sortedBatch(batch, 50);
+      sorted.addEventsSortedByTof(events);
+      reference += events;
+    }
+    TS_ASSERT_EQUALS(sorted.getSortType(), UNSORTED);
+    sorted.sortTof();
+    reference.sortTof();
+    TS_ASSERT(sorted.isSortedByTof());
+    TS_ASSERT_EQUALS(sorted.getNumberEvents(), 7 * 50);
+    for (size_t i = 0; i < reference.getNumberEvents(); ++i)
+      TS_ASSERT_EQUALS(sorted.getEvent(i).tof(), reference.getEvent(i).tof());
+  }
+
+  void test_addEventsSortedByTof_continuing_batch_stays_sorted() {
+    EventList list;
+    vector<TofEvent> first{TofEvent(1.0, 0), TofEvent(2.0, 0)};
+    vector<TofEvent> second{TofEvent(2.0, 0), TofEvent(5.0, 0)};
+    list.addEventsSortedByTof(first);
+    TS_ASSERT(list.isSortedByTof());
+    list.addEventsSortedByTof(second);
+    TS_ASSERT(list.isSortedByTof());
+    TS_ASSERT_EQUALS(list.getNumberEvents(), 4);
+  }
+
+  void test_addEventsSortedByTof_with_unsorted_tail() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventList list;
+      list.addEventsSortedByTof(sortedBatch(0, 40));
+      list.addEventsSortedByTof(sortedBatch(1, 40));
+      list.switchTo(static_cast<EventType>(this_type));
+      // Events in no particular order after the sorted ones
+      list += TofEvent(500.0, 0);
+      list += TofEvent(-5.0, 0);
+      list += TofEvent(20.5, 0);
+      list.sortTof();
+      TS_ASSERT_EQUALS(list.getNumberEvents(), 83);
+      for (size_t i = 1; i < list.getNumberEvents(); i++) {
+        TSM_ASSERT_LESS_THAN_EQUALS(this_type, list.getEvent(i - 1).tof(),
+                                    list.getEvent(i).tof());
+      }
+    }
+  }
+
+  void test_plusEquals_sorted_EventList_is_merged() {
+    this->fake_data();
+    el.sortTof();
+    EventList other;
+    other.addEventsSortedByTof(sortedBatch(3, 100));
+    el += other;
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    el.sortTof();
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 200);
+    for (size_t i = 1; i < el.getNumberEvents(); i++)
+      TS_ASSERT_LESS_THAN_EQUALS(el.getEvent(i - 1).tof(), el.getEvent(i).tof());
+
+    // Adding a sorted list to an empty one keeps it sorted
+    EventList empty;
+    empty += other;
+    TS_ASSERT(empty.isSortedByTof());
+  }
+
+  void test_sortTof_after_events_rewritten_through_getEvents() {
+    EventList list;
+    list.addEventsSortedByTof(sortedBatch(0, 100));
+    list.addEventsSortedByTof(sortedBatch(1, 100));
+    list += TofEvent(7.5, 0);
+    TS_ASSERT_EQUALS(list.getSortType(), UNSORTED);
+
+    // Fewer events, in a different order, than the recorded runs describe
+    auto &events = list.getEvents();
+    events.clear();
+    for (int i = 0; i < 50; ++i)
+      events.emplace_back(static_cast<double>((i * 37) % 50), 0);
+
+    list.sortTof();
+    TS_ASSERT(list.isSortedByTof());
+    TS_ASSERT_EQUALS(list.getNumberEvents(), 50);
+    for (size_t i = 1; i < list.getNumberEvents(); i++)
+      TS_ASSERT_LESS_THAN_EQUALS(list.getEvent(i - 1).tof(),
+                                 list.getEvent(i).tof());
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_reverse_allTypes() {
     // Go through each possible EventType as the input
@@ -1880,6 +1988,58 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** The split outputs are allocated once, to their exact size, for both the
+   * sparse and the dense vector splitter
+   */
+  void test_splitByFullTimeVectorSplitter_allocates_exact_outputs() {
+    fake_uniform_time_sns_data();
+    el.switchTo(WEIGHTED);
+
+    std::vector<int64_t> vec_splitTimes{1000000, 2000000, 3000000, 4000000,
+                                        5000000, 6000000, 7000000, 8000000,
+                                        9000000, 10000000};
+    std::vector<int> vec_splitGroup{-1, 2, -1, 4, -1, 6, -1, 8, -1};
+    std::vector<int64_t> dense_splitTimes(vec_splitTimes);
+    std::vector<int> dense_splitGroup(vec_splitGroup);
+    // more splitters than events selects the dense splitter
+    for (int64_t i = 1; i <= static_cast<int64_t>(el.getNumberEvents()); ++i) {
+      dense_splitTimes.push_back(10000000 + i * 1000);
+      dense_splitGroup.push_back(-1);
+    }
+
+    for (const bool dense : {false, true}) {
+      std::map<int, EventList *> outputs;
+      for (int i = 0; i < 10; i++)
+        outputs.emplace(i, new EventList());
+      outputs.emplace(-1, new EventList());
+
+      el.splitByFullTimeMatrixSplitter(dense ? dense_splitTimes
+                                             : vec_splitTimes,
+                                       dense ? dense_splitGroup
+                                             : vec_splitGroup,
+                                       outputs, false, 1.0, 0.0);
+
+      size_t total = 0;
+      for (auto &output : outputs) {
+        const EventList *myOut = output.second;
+        TS_ASSERT_EQUALS(myOut->getEventType(), WEIGHTED);
+        TS_ASSERT_EQUALS(myOut->getWeightedEvents().capacity(),
+                         myOut->getNumberEvents());
+        total += myOut->getNumberEvents();
+      }
+      TS_ASSERT_EQUALS(outputs[2]->getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(outputs[3]->getNumberEvents(), 0);
+      if (dense) {
+        // events outside of the splitters go to -1
+        TS_ASSERT_EQUALS(total, el.getNumberEvents());
+      }
+
+      for (auto &output : outputs)
+        delete output.second;
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2555,6 +2715,15 @@ public:
     el += TofEvent(rand() % 1000, time2);
   }
 
+  /** Make a batch of events sorted by TOF, overlapping with the other batches
+   */
+  vector<TofEvent> sortedBatch(int batch, int numEvents) {
+    vector<TofEvent> events;
+    for (int i = 0; i < numEvents; i++)
+      events.emplace_back(batch * 3.5 + i * 1.25, batch * 100 + i);
+    return events;
+  }
+
   /** Make a X-vector for histogramming, starting at step and going up in step
    */
   MantidVec makeX(double step, int numbins = 10) {
@@ -2788,6 +2957,22 @@ public:
 
   void test_sort_tof() { el_random.sortTof(); }
 
+  void test_sort_tof_after_adding_sorted_batches() {
+    EventList list;
+    for (int batch = 0; batch < 20; ++batch) {
+      std::vector<TofEvent> events;
+      for (size_t i = 0; i < 100000; i++)
+        events.emplace_back(static_cast<double>(rand() % 200000) * 0.05,
+                            batch);
+      std::sort(events.begin(), events.end(),
+                [](const TofEvent &e1, const TofEvent &e2) {
+                  return e1.tof() < e2.tof();
+                });
+      list.addEventsSortedByTof(events);
+    }
+    list.sortTof();
+  }
+
   void test_compressEvents() {
     EventList out_el;
     el_sorted.compressEvents(10.0, &out_el);
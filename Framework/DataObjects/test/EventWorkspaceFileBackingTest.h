@@ -0,0 +1,272 @@
+#ifndef MANTID_DATAOBJECTS_EVENTWORKSPACEFILEBACKINGTEST_H_
+#define MANTID_DATAOBJECTS_EVENTWORKSPACEFILEBACKINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <algorithm>
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+const size_t NUMPIXELS = 20;
+const size_t NUMEVENTS = 100;
+/// Room for about three spectra of TofEvents
+const uint64_t MEMORY_BUDGET = 5000;
+} // namespace
+
+class EventWorkspaceFileBackingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventWorkspaceFileBackingTest *createSuite() {
+    return new EventWorkspaceFileBackingTest();
+  }
+  static void destroySuite(EventWorkspaceFileBackingTest *suite) {
+    delete suite;
+  }
+
+  void test_setFileBacked() {
+    auto ws = createEventWorkspace();
+    const std::string fileName = Poco::TemporaryFile::tempName();
+    TS_ASSERT(!ws->isFileBacked());
+    TS_ASSERT_THROWS_NOTHING(ws->setFileBacked(fileName, MEMORY_BUDGET));
+    TS_ASSERT(ws->isFileBacked());
+    TS_ASSERT(Poco::File(fileName).exists());
+    TS_ASSERT_EQUALS(ws->getFileBacking()->getFileName(), fileName);
+    TS_ASSERT_EQUALS(ws->getFileBacking()->getNumberSpectra(), NUMPIXELS);
+    TS_ASSERT_THROWS(ws->setFileBacked(fileName, MEMORY_BUDGET),
+                     std::runtime_error);
+
+    // The scratch file goes away with the workspace
+    ws.reset();
+    TS_ASSERT(!Poco::File(fileName).exists());
+  }
+
+  void test_init_throws_once_file_backed() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    TS_ASSERT_THROWS(ws->initialize(NUMPIXELS, 1, 1), std::runtime_error);
+  }
+
+  void test_events_survive_eviction() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), NUMPIXELS * NUMEVENTS);
+
+    // Read the spectra twice, so that each one is loaded back from the file
+    for (int pass = 0; pass < 2; ++pass) {
+      for (size_t pix = 0; pix < NUMPIXELS; ++pix) {
+        SpectraPinScope pinned(*ws);
+        const auto &el =
+            static_cast<const EventWorkspace &>(*ws).getSpectrum(pix);
+        TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS);
+        const auto &events = el.getEvents();
+        TS_ASSERT_DELTA(events.front().tof(), expectedTof(pix, 0), 1e-9);
+        TS_ASSERT_DELTA(events.back().tof(), expectedTof(pix, NUMEVENTS - 1),
+                        1e-9);
+        TS_ASSERT_EQUALS(el.getSpectrumNo(), static_cast<int>(pix));
+      }
+    }
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), NUMPIXELS * NUMEVENTS);
+  }
+
+  void test_memory_stays_within_budget() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    const uint64_t spectrumSize = NUMEVENTS * sizeof(TofEvent);
+
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*ws);
+      constWs.getSpectrum(pix);
+      TS_ASSERT_LESS_THAN_EQUALS(ws->getFileBacking()->getMemoryUsed(),
+                                 MEMORY_BUDGET + spectrumSize);
+    }
+    TS_ASSERT_LESS_THAN_EQUALS(ws->getFileBacking()->getMemoryUsed(),
+                               MEMORY_BUDGET);
+  }
+
+  void test_spectra_stay_pinned_for_the_scope() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+
+    SpectraPinScope outer(*ws);
+    const auto &first = constWs.getSpectrum(0);
+    // Going through all the other spectra does not evict the first one
+    for (size_t pix = 1; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*ws);
+      constWs.getSpectrum(pix);
+    }
+    TS_ASSERT_EQUALS(first.getNumberEvents(), NUMEVENTS);
+    TS_ASSERT_DELTA(first.getEvents().back().tof(),
+                    expectedTof(0, NUMEVENTS - 1), 1e-9);
+  }
+
+  void test_spectra_accessed_outside_a_scope_stay_pinned_until_released() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix)
+      constWs.getSpectrum(pix);
+    const uint64_t spectrumSize = NUMEVENTS * sizeof(TofEvent);
+    TS_ASSERT_EQUALS(ws->getFileBacking()->getMemoryUsed(),
+                     NUMPIXELS * spectrumSize);
+
+    ws->getFileBacking()->releaseSpectra();
+    TS_ASSERT_LESS_THAN_EQUALS(ws->getFileBacking()->getMemoryUsed(),
+                               MEMORY_BUDGET);
+  }
+
+  void test_growth_of_a_pinned_spectrum_counts_against_the_budget() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    {
+      SpectraPinScope pinned(*ws);
+      auto &el = ws->getSpectrum(0);
+      for (size_t i = 0; i < 4 * NUMEVENTS; ++i)
+        el += TofEvent(1.0e6 + static_cast<double>(i), 0);
+    }
+    // The grown spectrum is written out once it is unpinned
+    TS_ASSERT_LESS_THAN_EQUALS(ws->getFileBacking()->getMemoryUsed(),
+                               MEMORY_BUDGET);
+    SpectraPinScope pinned(*ws);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getNumberEvents(), 5 * NUMEVENTS);
+  }
+
+  void test_modified_spectra_are_written_again() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+
+    {
+      SpectraPinScope pinned(*ws);
+      ws->getSpectrum(3) += TofEvent(12345.0, 0);
+      ws->getSpectrum(5).clear(false);
+    }
+    // Read all the other spectra to evict the modified ones
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+    for (size_t pix = 6; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*ws);
+      constWs.getSpectrum(pix);
+    }
+
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), (NUMPIXELS - 1) * NUMEVENTS + 1);
+    SpectraPinScope pinned(*ws);
+    const auto &el = constWs.getSpectrum(3);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS + 1);
+    TS_ASSERT_DELTA(el.getEvents().back().tof(), 12345.0, 1e-9);
+    TS_ASSERT_EQUALS(constWs.getSpectrum(5).getNumberEvents(), 0);
+  }
+
+  void test_sorted_spectra_stay_sorted_after_eviction() {
+    auto ws = createEventWorkspace();
+    // Unsorted events
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix)
+      ws->getSpectrum(pix) += TofEvent(0.5, 0);
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+
+    ws->sortAll(TOF_SORT, nullptr);
+    TS_ASSERT_EQUALS(ws->getSortType(), TOF_SORT);
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*ws);
+      const auto &el = constWs.getSpectrum(pix);
+      TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+      TS_ASSERT_DELTA(el.getEvents().front().tof(), 0.5, 1e-9);
+      const auto tofs = el.getTofs();
+      TS_ASSERT(std::is_sorted(tofs.begin(), tofs.end()));
+    }
+  }
+
+  void test_evicted_spectra_are_marked_unsorted_until_reloaded() {
+    auto ws = createEventWorkspace();
+    ws->sortAll(TOF_SORT, nullptr);
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    ws->getFileBacking()->releaseSpectra();
+    const EventList *first;
+    {
+      SpectraPinScope pinned(*ws);
+      first = &static_cast<const EventWorkspace &>(*ws).getSpectrum(0);
+    }
+    const_cast<EventWorkspaceFileBacking *>(ws->getFileBacking())
+        ->flushCache();
+    TS_ASSERT_EQUALS(first->getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(ws->getSortType(), TOF_SORT);
+  }
+
+  void test_weighted_events() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    ws->switchEventType(WEIGHTED);
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*ws);
+      ws->getSpectrum(pix) *= 2.0;
+    }
+
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*ws);
+      const auto &el = constWs.getSpectrum(pix);
+      TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+      const auto &events = el.getWeightedEvents();
+      TS_ASSERT_EQUALS(events.size(), NUMEVENTS);
+      TS_ASSERT_DELTA(events.back().tof(), expectedTof(pix, NUMEVENTS - 1),
+                      1e-9);
+      TS_ASSERT_DELTA(events.back().weight(), 2.0, 1e-9);
+    }
+  }
+
+  void test_clone() {
+    auto ws = createEventWorkspace();
+    ws->setFileBacked(Poco::TemporaryFile::tempName(), MEMORY_BUDGET);
+    auto copy = ws->clone();
+
+    TS_ASSERT(copy->isFileBacked());
+    TS_ASSERT_DIFFERS(copy->getFileBacking()->getFileName(),
+                      ws->getFileBacking()->getFileName());
+    TS_ASSERT_EQUALS(copy->getFileBacking()->getMemoryBudget(), MEMORY_BUDGET);
+    TS_ASSERT_EQUALS(copy->getNumberEvents(), NUMPIXELS * NUMEVENTS);
+
+    // Changing the copy leaves the original alone
+    {
+      SpectraPinScope pinned(*copy);
+      copy->getSpectrum(0).clear(false);
+    }
+    const auto &constCopy = static_cast<const EventWorkspace &>(*copy);
+    for (size_t pix = 1; pix < NUMPIXELS; ++pix) {
+      SpectraPinScope pinned(*copy);
+      const auto &el = constCopy.getSpectrum(pix);
+      TS_ASSERT_DELTA(el.getEvents().back().tof(),
+                      expectedTof(pix, NUMEVENTS - 1), 1e-9);
+    }
+    TS_ASSERT_EQUALS(copy->getSpectrum(0).getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getNumberEvents(), NUMEVENTS);
+  }
+
+private:
+  static double expectedTof(const size_t pix, const size_t i) {
+    return static_cast<double>(pix * 1000 + i);
+  }
+
+  EventWorkspace_sptr createEventWorkspace() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->initialize(NUMPIXELS, 1, 1);
+    for (size_t pix = 0; pix < NUMPIXELS; ++pix) {
+      auto &el = ws->getSpectrum(pix);
+      for (size_t i = 0; i < NUMEVENTS; ++i)
+        el += TofEvent(expectedTof(pix, i), 0);
+      el.setSpectrumNo(static_cast<int>(pix));
+    }
+    return ws;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTWORKSPACEFILEBACKINGTEST_H_ */
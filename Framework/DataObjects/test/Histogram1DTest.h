@@ -259,5 +259,93 @@ public:
     TS_ASSERT_EQUALS(clone.readY()[0], 0.2);
     TS_ASSERT_EQUALS(clone.readE()[0], 0.3);
   }
+
+  void test_setSinglePrecision() {
+    Histogram1D spectrum(Histogram::XMode::Points, Histogram::YMode::Counts);
+    spectrum.setHistogram(Points{1.0, 2.0, 3.0}, Counts{0.1, 1e6, 7.0},
+                          CountStandardDeviations{0.5, 1000.0, 2.0});
+    const size_t doubleSize = spectrum.getMemorySize();
+    spectrum.setSinglePrecision(true);
+    TS_ASSERT(spectrum.isSinglePrecision());
+    TS_ASSERT_EQUALS(spectrum.size(), 3);
+    TS_ASSERT_EQUALS(spectrum.getMemorySize(),
+                     doubleSize - 6 * (sizeof(double) - sizeof(float)));
+    // X is left in double precision
+    TS_ASSERT_EQUALS(spectrum.x()[1], 2.0);
+    TS_ASSERT(spectrum.isSinglePrecision());
+
+    // Accessing the values by reference widens them
+    TS_ASSERT_EQUALS(spectrum.y()[0], static_cast<double>(0.1f));
+    TS_ASSERT_EQUALS(spectrum.y()[1], 1e6);
+    TS_ASSERT_EQUALS(spectrum.e()[2], 2.0);
+    TS_ASSERT(!spectrum.isSinglePrecision());
+    TS_ASSERT_EQUALS(spectrum.getMemorySize(), doubleSize);
+  }
+
+  void test_single_precision_values_by_value_are_widened_copies() {
+    Histogram1D spectrum(Histogram::XMode::Points, Histogram::YMode::Counts);
+    spectrum.setHistogram(Points{1.0, 2.0}, Counts{4.0, 9.0},
+                          CountStandardDeviations{2.0, 3.0});
+    spectrum.setSinglePrecision(true);
+    TS_ASSERT_EQUALS(spectrum.histogram().y()[1], 9.0);
+    TS_ASSERT_EQUALS(spectrum.counts()[0], 4.0);
+    TS_ASSERT_EQUALS(spectrum.countVariances()[1], 9.0);
+    SpectrumValues values(spectrum);
+    TS_ASSERT_EQUALS(values.y()[0], 4.0);
+    TS_ASSERT_EQUALS(values.e()[1], 3.0);
+    std::vector<float> y, e;
+    spectrum.copySinglePrecisionY(y);
+    spectrum.copySinglePrecisionE(e);
+    TS_ASSERT_EQUALS(y, std::vector<float>({4.0f, 9.0f}));
+    TS_ASSERT_EQUALS(e, std::vector<float>({2.0f, 3.0f}));
+    TS_ASSERT(spectrum.isSinglePrecision());
+  }
+
+  void test_copy_single_precision() {
+    Histogram1D source(Histogram::XMode::Points, Histogram::YMode::Counts);
+    source.setHistogram(Points{1.0}, Counts{4.0});
+    source.setSinglePrecision(true);
+    Histogram1D copy(source);
+    TS_ASSERT(copy.isSinglePrecision());
+    Histogram1D assigned(Histogram::XMode::Points, Histogram::YMode::Counts);
+    assigned = source;
+    TS_ASSERT(assigned.isSinglePrecision());
+    Histogram1D moved(std::move(copy));
+    TS_ASSERT(moved.isSinglePrecision());
+    TS_ASSERT_EQUALS(moved.y()[0], 4.0);
+    TS_ASSERT_EQUALS(assigned.y()[0], 4.0);
+    // The source is not widened by the copies
+    TS_ASSERT(source.isSinglePrecision());
+  }
+
+  void test_setting_values_of_single_precision_spectrum() {
+    Histogram1D spectrum(Histogram::XMode::Points, Histogram::YMode::Counts);
+    spectrum.setHistogram(Points{1.0, 2.0}, Counts{4.0, 9.0});
+    spectrum.setSinglePrecision(true);
+    spectrum.mutableY()[0] = 0.1;
+    TS_ASSERT(!spectrum.isSinglePrecision());
+    TS_ASSERT_EQUALS(spectrum.y()[0], 0.1);
+    TS_ASSERT_EQUALS(spectrum.y()[1], 9.0);
+    spectrum.setSinglePrecision(true);
+    spectrum.setCounts(2, 5.0);
+    TS_ASSERT(!spectrum.isSinglePrecision());
+    TS_ASSERT_EQUALS(spectrum.y()[1], 5.0);
+    spectrum.setSinglePrecision(true);
+    spectrum.setHistogram(Points{1.0, 2.0}, Counts{1.0, 2.0});
+    TS_ASSERT(!spectrum.isSinglePrecision());
+    TS_ASSERT_EQUALS(spectrum.y()[1], 2.0);
+  }
+
+  void test_setting_x_of_single_precision_spectrum_keeps_it_packed() {
+    Histogram1D spectrum(Histogram::XMode::Points, Histogram::YMode::Counts);
+    spectrum.setHistogram(Points{1.0, 2.0}, Counts{4.0, 9.0});
+    spectrum.setSinglePrecision(true);
+    spectrum.setPoints(Points{3.0, 4.0});
+    spectrum.mutableX()[0] = 5.0;
+    TS_ASSERT(spectrum.isSinglePrecision());
+    TS_ASSERT_EQUALS(spectrum.x()[0], 5.0);
+    TS_ASSERT_EQUALS(spectrum.x()[1], 4.0);
+    TS_ASSERT_EQUALS(spectrum.readY()[1], 9.0);
+  }
 };
 #endif /*TESTHISTOGRAM1D_*/
@@ -4,11 +4,14 @@
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
 #include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidDataObjects/MDMortonCode.h"
 
 #include <boost/make_shared.hpp>
 #include <cxxtest/TestSuite.h>
 #include <Poco/File.h>
 
+#include <algorithm>
+
 using Mantid::DataObjects::MDBoxFlatTree;
 
 class MDBoxFlatTreeTest : public CxxTest::TestSuite {
@@ -102,6 +105,39 @@ public:
       testFile.remove();
   }
 
+  void testMortonOrderFilePositions() {
+    MDBoxFlatTree BoxTree;
+    TS_ASSERT_THROWS_NOTHING((BoxTree.initFlatStructure(spEw3, "aFile")));
+    TS_ASSERT_THROWS_NOTHING(BoxTree.setBoxesFilePositions(false, true));
+
+    const auto &boxes = BoxTree.getBoxes();
+    const auto &boxType = BoxTree.getBoxType();
+    const auto &eventIndex = BoxTree.getEventIndex();
+    std::vector<size_t> leaves;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      if (boxType[i] != 2)
+        leaves.push_back(i);
+    }
+    std::sort(leaves.begin(), leaves.end(), [&](size_t a, size_t b) {
+      return eventIndex[2 * a] < eventIndex[2 * b];
+    });
+
+    // The boxes are packed one after the other along the Morton curve
+    Mantid::DataObjects::MDMortonCode mortonCode(*boxes[0]);
+    std::vector<Mantid::coord_t> center(3);
+    uint64_t position = 0;
+    uint64_t previousCode = 0;
+    for (const size_t i : leaves) {
+      TS_ASSERT_EQUALS(eventIndex[2 * i], position);
+      position += eventIndex[2 * i + 1];
+      boxes[i]->getCenter(center.data());
+      const uint64_t code = mortonCode(center.data());
+      TS_ASSERT_LESS_THAN_EQUALS(previousCode, code);
+      previousCode = code;
+    }
+    TS_ASSERT_EQUALS(position, spEw3->getNPoints());
+  }
+
 private:
   Mantid::API::IMDEventWorkspace_sptr spEw3;
 };
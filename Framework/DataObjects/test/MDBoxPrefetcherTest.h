@@ -0,0 +1,156 @@
+#ifndef MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_
+#define MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDBoxPrefetcher.h"
+#include "MantidKernel/Exception.h"
+#include "MantidTestHelpers/BoxControllerDummyIO.h"
+
+#include <boost/make_shared.hpp>
+#include <memory>
+
+using namespace Mantid::DataObjects;
+using Mantid::API::BoxController;
+using Mantid::API::BoxController_sptr;
+using Mantid::API::IMDNode;
+using MantidTestHelpers::BoxControllerDummyIO;
+
+namespace {
+using MDE = MDLeanEvent<3>;
+using Box = MDBox<MDE, 3>;
+}
+
+class MDBoxPrefetcherTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDBoxPrefetcherTest *createSuite() {
+    return new MDBoxPrefetcherTest();
+  }
+  static void destroySuite(MDBoxPrefetcherTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_bc = BoxController_sptr(new BoxController(3));
+    m_io = boost::make_shared<BoxControllerDummyIO>(m_bc.get());
+    m_io->setDataType(sizeof(Mantid::coord_t), "MDLeanEvent");
+    // The dummy file holds 1000 events, event i with a signal of i
+    m_bc->setFileBacked(m_io, "existingDummy");
+    m_boxes.clear();
+  }
+
+  void tearDown() override {
+    m_boxes.clear();
+    m_bc.reset();
+  }
+
+  void test_contiguous_boxes_are_read_at_once() {
+    for (uint64_t i = 0; i < 10; ++i)
+      addFileBackedBox(50 * i, 50);
+    MDBoxPrefetcher<MDE, 3> prefetcher(getNodes());
+    for (size_t i = 0; i < 10; ++i) {
+      Box *box = prefetcher.next();
+      TS_ASSERT_EQUALS(box, m_boxes[i].get());
+      checkEvents(*box, 50 * i, 50);
+    }
+    TS_ASSERT(!prefetcher.next());
+    TS_ASSERT_EQUALS(m_io->getNumBlocksLoaded(), 1);
+  }
+
+  void test_gap_in_file_starts_a_new_read() {
+    addFileBackedBox(0, 50);
+    addFileBackedBox(50, 100);
+    addFileBackedBox(500, 20);
+    MDBoxPrefetcher<MDE, 3> prefetcher(getNodes());
+    checkEvents(*prefetcher.next(), 0, 50);
+    checkEvents(*prefetcher.next(), 50, 100);
+    checkEvents(*prefetcher.next(), 500, 20);
+    TS_ASSERT(!prefetcher.next());
+    TS_ASSERT_EQUALS(m_io->getNumBlocksLoaded(), 2);
+  }
+
+  void test_reads_are_bounded() {
+    for (uint64_t i = 0; i < 10; ++i)
+      addFileBackedBox(50 * i, 50);
+    MDBoxPrefetcher<MDE, 3> prefetcher(getNodes(), 100);
+    for (size_t i = 0; i < 10; ++i)
+      checkEvents(*prefetcher.next(), 50 * i, 50);
+    TS_ASSERT(!prefetcher.next());
+    // No read of more than 100 events
+    TS_ASSERT_LESS_THAN_EQUALS(5, m_io->getNumBlocksLoaded());
+  }
+
+  void test_boxes_in_memory_are_handed_out_as_they_are() {
+    addFileBackedBox(0, 50);
+    m_boxes.emplace_back(new Box(m_bc.get()));
+    const Mantid::coord_t centers[3] = {1.f, 2.f, 3.f};
+    m_boxes.back()->addEvent(MDE(5.f, 1.f, centers));
+    addFileBackedBox(50, 50);
+    MDBoxPrefetcher<MDE, 3> prefetcher(getNodes());
+    checkEvents(*prefetcher.next(), 0, 50);
+    Box *box = prefetcher.next();
+    TS_ASSERT_EQUALS(box, m_boxes[1].get());
+    TS_ASSERT_EQUALS(box->getDataInMemorySize(), 1);
+    checkEvents(*prefetcher.next(), 50, 50);
+    TS_ASSERT(!prefetcher.next());
+  }
+
+  void test_events_read_ahead_are_dropped_on_destruction() {
+    for (uint64_t i = 0; i < 10; ++i)
+      addFileBackedBox(50 * i, 50);
+    {
+      MDBoxPrefetcher<MDE, 3> prefetcher(getNodes());
+      checkEvents(*prefetcher.next(), 0, 50);
+    }
+    for (size_t i = 1; i < 10; ++i) {
+      TS_ASSERT_EQUALS(m_boxes[i]->getDataInMemorySize(), 0);
+      TS_ASSERT(!m_boxes[i]->getISaveable()->isLoaded());
+    }
+    // They are read as usual later
+    checkEvents(*m_boxes[3], 150, 50);
+  }
+
+  void test_read_errors_are_passed_on() {
+    addFileBackedBox(0, 50);
+    // Behind the end of the file
+    addFileBackedBox(2000, 50);
+    MDBoxPrefetcher<MDE, 3> prefetcher(getNodes());
+    checkEvents(*prefetcher.next(), 0, 50);
+    TS_ASSERT_THROWS(prefetcher.next(),
+                     Mantid::Kernel::Exception::FileError);
+  }
+
+private:
+  /// Add a box with events on file only
+  void addFileBackedBox(const uint64_t position, const size_t numEvents) {
+    m_boxes.emplace_back(new Box(m_bc.get()));
+    m_boxes.back()->setFileBacked(position, numEvents, true);
+  }
+
+  /// @return the boxes, as IMDNodes
+  std::vector<IMDNode *> getNodes() const {
+    std::vector<IMDNode *> nodes;
+    for (const auto &box : m_boxes)
+      nodes.push_back(box.get());
+    return nodes;
+  }
+
+  /// Check that a box holds the events of the dummy file from a position
+  void checkEvents(Box &box, const uint64_t position, const size_t numEvents) {
+    const auto &events = box.getConstEvents();
+    TS_ASSERT_EQUALS(events.size(), numEvents);
+    if (events.size() == numEvents) {
+      const auto first = static_cast<float>(position);
+      TS_ASSERT_DELTA(events.front().getSignal(), first, 1e-5);
+      TS_ASSERT_DELTA(events.back().getSignal(),
+                      first + static_cast<float>(numEvents - 1), 1e-5);
+    }
+    box.releaseEvents();
+  }
+
+  BoxController_sptr m_bc;
+  boost::shared_ptr<BoxControllerDummyIO> m_io;
+  std::vector<std::unique_ptr<Box>> m_boxes;
+};
+
+#endif /* MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_ */
@@ -0,0 +1,200 @@
+#ifndef MANTID_DATAOBJECTS_MDEVENTSPILLERTEST_H_
+#define MANTID_DATAOBJECTS_MDEVENTSPILLERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/BoxControllerNeXusIO.h"
+#include "MantidDataObjects/MDEventSpiller.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <Poco/File.h>
+
+#include <cmath>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::API::IMDNode;
+using Mantid::coord_t;
+
+namespace {
+using MDE = MDLeanEvent<3>;
+using MDEW = MDEventWorkspace<MDE, 3>;
+
+const std::string SPILL_FILE("MDEventSpillerTest.spill");
+const std::string BACKING_FILE("MDEventSpillerTest.nxs");
+
+/// Events around a few peaks on top of a uniform background in (0, 10)^3
+std::vector<MDE> createEvents(const size_t numEvents) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<coord_t> uniform(0.f, 10.f);
+  std::normal_distribution<coord_t> peak(0.f, 0.2f);
+  std::vector<MDE> events;
+  events.reserve(numEvents);
+  for (size_t i = 0; i < numEvents; ++i) {
+    coord_t centers[3];
+    const coord_t peakCenter = static_cast<coord_t>(i % 4) * 2.f + 2.f;
+    for (auto &center : centers)
+      center = i % 2 == 0 ? uniform(generator)
+                          : std::min(9.9f, std::max(0.1f, peakCenter +
+                                                              peak(generator)));
+    events.emplace_back(static_cast<float>(i % 3 + 1), 1.f, centers);
+  }
+  return events;
+}
+
+/// Add events to a workspace one by one, then split the boxes
+void addSerially(MDEW &ws, const std::vector<MDE> &events) {
+  ws.splitBox();
+  for (const auto &event : events)
+    ws.addEvent(event);
+  ws.splitAllIfNeeded(nullptr);
+  ws.refreshCache();
+}
+
+/// @return the leaf boxes of a workspace
+std::vector<IMDNode *> getLeaves(MDEW &ws) {
+  std::vector<IMDNode *> leaves;
+  ws.getBox()->getBoxes(leaves, 1000, true);
+  return leaves;
+}
+} // namespace
+
+class MDEventSpillerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDEventSpillerTest *createSuite() { return new MDEventSpillerTest(); }
+  static void destroySuite(MDEventSpillerTest *suite) { delete suite; }
+
+  void test_spill_file_lives_with_the_spiller() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    TS_ASSERT(ws->getBox()->isBox());
+    {
+      MDEventSpiller<MDE, 3> spiller(*ws, 1000, SPILL_FILE);
+      TS_ASSERT(!ws->getBox()->isBox());
+      TS_ASSERT_EQUALS(ws->getBox()->getNumChildren(), 125);
+      TS_ASSERT(Poco::File(SPILL_FILE).exists());
+    }
+    TS_ASSERT(!Poco::File(SPILL_FILE).exists());
+  }
+
+  void test_bad_spill_file_throws() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    using Spiller = MDEventSpiller<MDE, 3>;
+    TS_ASSERT_THROWS(Spiller(*ws, 1000, "no_such_directory/spill"),
+                     std::runtime_error);
+  }
+
+  void test_events_outside_are_rejected() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    MDEventSpiller<MDE, 3> spiller(*ws, 1000, SPILL_FILE);
+    coord_t outside[3] = {5.f, 10.5f, 5.f};
+    TS_ASSERT(!spiller.addEvent(MDE(1.f, 1.f, outside)));
+    coord_t nan[3] = {5.f, 5.f, std::nanf("")};
+    TS_ASSERT(!spiller.addEvent(MDE(1.f, 1.f, nan)));
+    coord_t corner[3] = {10.f, 10.f, 10.f};
+    TS_ASSERT(spiller.addEvent(MDE(2.f, 1.f, corner)));
+    spiller.finish();
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 1);
+    TS_ASSERT_DELTA(ws->getBox()->getSignal(), 2.0, 1e-6);
+  }
+
+  void test_events_are_spilled_once_the_budget_is_used_up() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    const size_t budget = 100 * sizeof(MDE);
+    MDEventSpiller<MDE, 3> spiller(*ws, budget, SPILL_FILE);
+    const auto events = createEvents(1050);
+    size_t numOverBudget = 0;
+    for (const auto &event : events) {
+      spiller.addEvent(event);
+      if (spiller.getBufferedMemorySize() > budget)
+        ++numOverBudget;
+    }
+    // The room reserved by the buffers counts, not just the events in them
+    TS_ASSERT_EQUALS(numOverBudget, 0);
+    TS_ASSERT_LESS_THAN(10, spiller.getNumSpills());
+    TS_ASSERT_LESS_THAN(events.size() - 100, spiller.getNumSpilledEvents());
+    // Nothing is in the workspace before finishing
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 0);
+    spiller.finish();
+    TS_ASSERT_EQUALS(spiller.getBufferedMemorySize(), 0);
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), events.size());
+  }
+
+  void test_file_backed_workspace_is_written_one_top_level_box_at_a_time() {
+    const auto events = createEvents(20000);
+    auto serial = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    addSerially(*serial, events);
+
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    auto bc = ws->getBoxController();
+    auto fileIO = boost::make_shared<BoxControllerNeXusIO>(bc.get());
+    fileIO->setDataType(sizeof(coord_t), "MDLeanEvent");
+    bc->setFileBacked(fileIO, BACKING_FILE);
+    ws->setFileBacked();
+    bc->getFileIO()->setWriteBufferSize(1000);
+    {
+      MDEventSpiller<MDE, 3> spiller(*ws, 1000 * sizeof(MDE), SPILL_FILE);
+      for (const auto &event : events)
+        spiller.addEvent(event);
+      TS_ASSERT_LESS_THAN(0, spiller.getNumSpilledEvents());
+      spiller.finish();
+    }
+
+    // Every leaf holding events was written out and dropped from memory
+    const auto leaves = getLeaves(*ws);
+    size_t numInMemory = 0;
+    for (auto leaf : leaves) {
+      if (leaf->getNPoints() == 0)
+        continue;
+      TS_ASSERT(leaf->getISaveable()->wasSaved());
+      if (leaf->getDataInMemorySize() > 0)
+        ++numInMemory;
+    }
+    TS_ASSERT_EQUALS(numInMemory, 0);
+    TS_ASSERT_EQUALS(leaves.size(), getLeaves(*serial).size());
+
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), events.size());
+    TS_ASSERT_DELTA(ws->getBox()->getSignal(), serial->getBox()->getSignal(),
+                    1e-3);
+
+    bc->getFileIO()->closeFile();
+    Poco::File backingFile(fileIO->getFileName());
+    if (backingFile.exists())
+      backingFile.remove();
+  }
+
+  void test_matches_serial_adding() {
+    const auto events = createEvents(100000);
+    auto serial = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    addSerially(*serial, events);
+    auto spilled = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    {
+      MDEventSpiller<MDE, 3> spiller(*spilled, 5000 * sizeof(MDE), SPILL_FILE);
+      for (const auto &event : events)
+        spiller.addEvent(event);
+      TS_ASSERT_LESS_THAN(0, spiller.getNumSpilledEvents());
+      spiller.finish();
+    }
+    spilled->refreshCache();
+
+    TS_ASSERT_EQUALS(spilled->getNPoints(), events.size());
+    TS_ASSERT_DELTA(spilled->getBox()->getSignal(),
+                    serial->getBox()->getSignal(), 1e-3);
+    TS_ASSERT_DELTA(spilled->getBox()->getErrorSquared(),
+                    serial->getBox()->getErrorSquared(), 1e-3);
+    const auto serialLeaves = getLeaves(*serial);
+    const auto spilledLeaves = getLeaves(*spilled);
+    TS_ASSERT_EQUALS(spilledLeaves.size(), serialLeaves.size());
+    auto bc = spilled->getBoxController();
+    for (auto leaf : spilledLeaves) {
+      TS_ASSERT(!bc->willSplit(leaf->getNPoints(), leaf->getDepth()));
+    }
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDEVENTSPILLERTEST_H_ */
@@ -316,6 +316,28 @@ public:
     delete bcc;
   }
 
+  void test_getChildIndexFromEvent() {
+    // 10 boxes along x, 5 along y
+    MDGridBox<MDLeanEvent<2>, 2> *g =
+        MDEventsTestHelper::makeMDGridBox<2>(10, 5, 0.0, 10.0);
+    auto index = [g](coord_t x, coord_t y) {
+      coord_t centers[2] = {x, y};
+      return g->getChildIndexFromEvent(MDLeanEvent<2>(1.0, 1.0, centers));
+    };
+    TS_ASSERT_EQUALS(index(0.5, 0.5), 0);
+    TS_ASSERT_EQUALS(index(3.5, 4.5), 3 + 10 * 2);
+    TS_ASSERT_EQUALS(index(2.0, 2.0), 2 + 10 * 1);
+    // The upper boundary goes to the last box in that dimension
+    TS_ASSERT_EQUALS(index(10.0, 0.5), 9);
+    TS_ASSERT_EQUALS(index(0.5, 10.0), 10 * 4);
+    TS_ASSERT_EQUALS(index(10.0, 10.0), 49);
+    // Just outside goes to the nearest box
+    TS_ASSERT_EQUALS(index(-0.001f, 10.001f), 10 * 4);
+    BoxController *const bcc = g->getBoxController();
+    delete g;
+    delete bcc;
+  }
+
   //-------------------------------------------------------------------------------------
   /** Build a 3D MDGridBox and check that the boxes created within are where you
    * expect */
@@ -0,0 +1,253 @@
+#ifndef MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_
+#define MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <cmath>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::signal_t;
+using Expr = MDHistoExpression;
+
+namespace {
+/// A workspace of numBins^3 bins with random signals, errors and events
+MDHistoWorkspace_sptr createWorkspace(const size_t numBins,
+                                      const unsigned int seed) {
+  auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 3, numBins);
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<signal_t> uniform(0.5, 4.0);
+  for (size_t i = 0; i < ws->getNPoints(); ++i) {
+    ws->setSignalAt(i, uniform(generator));
+    ws->setErrorSquaredAt(i, uniform(generator));
+    ws->setNumEventsAt(i, std::floor(10 * uniform(generator)));
+  }
+  return ws;
+}
+
+/// @return true if two values are equal, but for rounding
+bool isClose(const signal_t value, const signal_t other) {
+  return std::abs(value - other) <= 1e-12 * std::abs(other);
+}
+
+/// Check that two workspaces have the same bins
+void checkSameBins(const MDHistoWorkspace &ws, const MDHistoWorkspace &other) {
+  TS_ASSERT_EQUALS(ws.getNPoints(), other.getNPoints());
+  size_t numDifferent = 0;
+  for (size_t i = 0; i < ws.getNPoints(); ++i) {
+    if (!isClose(ws.getSignalAt(i), other.getSignalAt(i)) ||
+        !isClose(ws.getErrorAt(i), other.getErrorAt(i)) ||
+        ws.getNumEventsAt(i) != other.getNumEventsAt(i))
+      ++numDifferent;
+  }
+  TS_ASSERT_EQUALS(numDifferent, 0);
+}
+} // namespace
+
+class MDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoExpressionTest *createSuite() {
+    return new MDHistoExpressionTest();
+  }
+  static void destroySuite(MDHistoExpressionTest *suite) { delete suite; }
+
+  void setUp() override {
+    // Not a multiple of the block size
+    m_a = createWorkspace(17, 1);
+    m_b = createWorkspace(17, 2);
+    m_c = createWorkspace(17, 3);
+  }
+
+  void test_binary_operations_match_MDHistoWorkspace() {
+    auto expected = m_a->clone();
+    expected->add(*m_b);
+    checkEvaluate(Expr::plus(Expr::workspace(m_a), Expr::workspace(m_b)),
+                  *expected);
+
+    expected = m_a->clone();
+    expected->subtract(*m_b);
+    checkEvaluate(Expr::minus(Expr::workspace(m_a), Expr::workspace(m_b)),
+                  *expected);
+
+    expected = m_a->clone();
+    expected->multiply(*m_b);
+    checkEvaluate(Expr::multiply(Expr::workspace(m_a), Expr::workspace(m_b)),
+                  *expected);
+
+    expected = m_a->clone();
+    expected->divide(*m_b);
+    checkEvaluate(Expr::divide(Expr::workspace(m_a), Expr::workspace(m_b)),
+                  *expected);
+  }
+
+  void test_operations_with_scalars_match_MDHistoWorkspace() {
+    auto expected = m_a->clone();
+    expected->add(2.5, 0.5);
+    checkEvaluate(Expr::plus(Expr::workspace(m_a), Expr::scalar(2.5, 0.5)),
+                  *expected);
+
+    expected = m_a->clone();
+    expected->subtract(2.5, 0.5);
+    checkEvaluate(Expr::minus(Expr::workspace(m_a), Expr::scalar(2.5, 0.5)),
+                  *expected);
+
+    expected = m_a->clone();
+    expected->multiply(2.5, 0.5);
+    checkEvaluate(Expr::multiply(Expr::workspace(m_a), Expr::scalar(2.5, 0.5)),
+                  *expected);
+
+    expected = m_a->clone();
+    expected->divide(2.5, 0.5);
+    checkEvaluate(Expr::divide(Expr::workspace(m_a), Expr::scalar(2.5, 0.5)),
+                  *expected);
+  }
+
+  void test_unary_operations_match_MDHistoWorkspace() {
+    // With bins <= 0 for the filler of the logarithms
+    m_a->setSignalAt(3, 0.);
+    m_a->setSignalAt(7, -1.);
+    auto expected = m_a->clone();
+    expected->log(-3.0);
+    checkEvaluate(Expr::log(Expr::workspace(m_a), -3.0), *expected);
+
+    expected = m_a->clone();
+    expected->log10(2.0);
+    checkEvaluate(Expr::log10(Expr::workspace(m_a), 2.0), *expected);
+
+    expected = m_a->clone();
+    expected->exp();
+    checkEvaluate(Expr::exp(Expr::workspace(m_a)), *expected);
+
+    expected = m_b->clone();
+    expected->power(1.7);
+    checkEvaluate(Expr::power(Expr::workspace(m_b), 1.7), *expected);
+  }
+
+  void test_chain_matches_operations_one_by_one() {
+    // log((a + b) * c / 2 - a) ^ 2
+    auto expected = m_a->clone();
+    expected->add(*m_b);
+    expected->multiply(*m_c);
+    expected->divide(2.0, 0.1);
+    expected->subtract(*m_a);
+    expected->log(0.0);
+    expected->power(2.0);
+
+    const auto a = Expr::workspace(m_a);
+    const auto sum = Expr::plus(a, Expr::workspace(m_b));
+    const auto product = Expr::multiply(sum, Expr::workspace(m_c));
+    const auto half = Expr::divide(product, Expr::scalar(2.0, 0.1));
+    const auto difference = Expr::minus(half, a);
+    checkEvaluate(Expr::power(Expr::log(difference), 2.0), *expected);
+  }
+
+  void test_evaluate_in_place() {
+    auto expected = m_a->clone();
+    expected->multiply(*m_b);
+    expected->add(*m_a);
+    // a = a * b + a, with the output as an operand
+    const auto a = Expr::workspace(m_a);
+    Expr::plus(Expr::multiply(a, Expr::workspace(m_b)), a)->evaluate(*m_a);
+    checkSameBins(*m_a, *expected);
+  }
+
+  void test_scalars_only_fill_the_output() {
+    auto out = m_a->clone();
+    Expr::exp(Expr::multiply(Expr::scalar(2.0, 0.5), Expr::scalar(0.5, 0.0)))
+        ->evaluate(*out);
+    const signal_t expected = std::exp(1.0);
+    for (size_t i = 0; i < out->getNPoints(); ++i) {
+      TS_ASSERT_EQUALS(out->getSignalAt(i), expected);
+      TS_ASSERT_DELTA(out->getErrorSquaredArray()[i],
+                      expected * expected * 0.0625, 1e-12);
+      TS_ASSERT_EQUALS(out->getNumEventsAt(i), 0.);
+    }
+  }
+
+  void test_evaluate_throws_on_different_sizes() {
+    auto small = createWorkspace(5, 4);
+    auto out = m_a->clone();
+    TS_ASSERT_THROWS(
+        Expr::plus(Expr::workspace(m_a), Expr::workspace(small))
+            ->evaluate(*out),
+        std::invalid_argument);
+  }
+
+  void test_missing_operands_throw() {
+    TS_ASSERT_THROWS(Expr::workspace(MDHistoWorkspace_sptr()),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(Expr::plus(Expr::workspace(m_a), Expr::sptr()),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(Expr::exp(Expr::sptr()), std::invalid_argument);
+  }
+
+private:
+  /// Check that an expression evaluates to the expected workspace
+  void checkEvaluate(Expr::sptr expression, const MDHistoWorkspace &expected) {
+    auto out = m_c->clone();
+    TS_ASSERT_THROWS_NOTHING(expression->evaluate(*out));
+    checkSameBins(*out, expected);
+  }
+
+  MDHistoWorkspace_sptr m_a;
+  MDHistoWorkspace_sptr m_b;
+  MDHistoWorkspace_sptr m_c;
+};
+
+/** A chain of 6 operations on 200^3 bins: one by one, as the MD arithmetic
+ * algorithms do, and as one expression. */
+class MDHistoExpressionTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoExpressionTestPerformance *createSuite() {
+    return new MDHistoExpressionTestPerformance();
+  }
+  static void destroySuite(MDHistoExpressionTestPerformance *suite) {
+    delete suite;
+  }
+
+  MDHistoExpressionTestPerformance() {
+    m_a = createWorkspace(200, 1);
+    m_b = createWorkspace(200, 2);
+    m_c = createWorkspace(200, 3);
+  }
+
+  void test_operations_one_by_one() {
+    // Each algorithm clones its input into its output
+    auto sum = m_a->clone();
+    sum->add(*m_b);
+    auto product = sum->clone();
+    product->multiply(*m_c);
+    auto scaled = product->clone();
+    scaled->divide(2.0, 0.1);
+    auto difference = scaled->clone();
+    difference->subtract(*m_a);
+    auto logarithm = difference->clone();
+    logarithm->log(0.0);
+    auto squared = logarithm->clone();
+    squared->power(2.0);
+  }
+
+  void test_expression() {
+    const auto a = Expr::workspace(m_a);
+    const auto sum = Expr::plus(a, Expr::workspace(m_b));
+    const auto product = Expr::multiply(sum, Expr::workspace(m_c));
+    const auto scaled = Expr::divide(product, Expr::scalar(2.0, 0.1));
+    const auto difference = Expr::minus(scaled, a);
+    auto out = m_a->clone();
+    Expr::power(Expr::log(difference), 2.0)->evaluate(*out);
+  }
+
+private:
+  MDHistoWorkspace_sptr m_a;
+  MDHistoWorkspace_sptr m_b;
+  MDHistoWorkspace_sptr m_c;
+};
+
+#endif /* MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_ */
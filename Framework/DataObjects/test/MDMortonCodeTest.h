@@ -0,0 +1,65 @@
+#ifndef MANTID_DATAOBJECTS_MDMORTONCODETEST_H_
+#define MANTID_DATAOBJECTS_MDMORTONCODETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDMortonCode.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using namespace Mantid::DataObjects;
+using Mantid::coord_t;
+
+class MDMortonCodeTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDMortonCodeTest *createSuite() { return new MDMortonCodeTest(); }
+  static void destroySuite(MDMortonCodeTest *suite) { delete suite; }
+
+  void test_interleaveBits() {
+    const uint64_t origin[2] = {0, 0};
+    const uint64_t x[2] = {1, 0};
+    const uint64_t y[2] = {0, 1};
+    const uint64_t xy[2] = {1, 1};
+    const uint64_t nextX[2] = {2, 0};
+    const uint64_t corner[2] = {3, 3};
+    TS_ASSERT_EQUALS(interleaveBits(origin, 2), 0);
+    TS_ASSERT_EQUALS(interleaveBits(x, 2), 1);
+    TS_ASSERT_EQUALS(interleaveBits(y, 2), 2);
+    TS_ASSERT_EQUALS(interleaveBits(xy, 2), 3);
+    TS_ASSERT_EQUALS(interleaveBits(nextX, 2), 4);
+    TS_ASSERT_EQUALS(interleaveBits(corner, 2), 15);
+    const uint64_t cells[3] = {1, 1, 1};
+    TS_ASSERT_EQUALS(interleaveBits(cells, 3), 7);
+    TS_ASSERT_EQUALS(mortonBitsPerDimension(1), 32);
+    TS_ASSERT_EQUALS(mortonBitsPerDimension(3), 21);
+  }
+
+  void test_codes_follow_the_Z_curve() {
+    auto ws = MDEventsTestHelper::makeMDEW<2>(2, 0.0, 10.0, 0);
+    MDMortonCode mortonCode(*ws->getBox());
+    TS_ASSERT_EQUALS(mortonCode.getNumDims(), 2);
+    // The four quadrants, in Z order
+    const coord_t lowLeft[2] = {1.f, 1.f};
+    const coord_t lowRight[2] = {9.f, 1.f};
+    const coord_t highLeft[2] = {1.f, 9.f};
+    const coord_t highRight[2] = {9.f, 9.f};
+    TS_ASSERT_LESS_THAN(mortonCode(lowLeft), mortonCode(lowRight));
+    TS_ASSERT_LESS_THAN(mortonCode(lowRight), mortonCode(highLeft));
+    TS_ASSERT_LESS_THAN(mortonCode(highLeft), mortonCode(highRight));
+  }
+
+  void test_points_outside_take_the_nearest_code() {
+    auto ws = MDEventsTestHelper::makeMDEW<2>(2, 0.0, 10.0, 0);
+    MDMortonCode mortonCode(*ws->getBox());
+    const coord_t origin[2] = {0.f, 0.f};
+    const coord_t below[2] = {-5.f, -1.f};
+    const coord_t corner[2] = {10.f, 10.f};
+    const coord_t above[2] = {20.f, 15.f};
+    TS_ASSERT_EQUALS(mortonCode(below), mortonCode(origin));
+    TS_ASSERT_EQUALS(mortonCode(above), mortonCode(corner));
+    TS_ASSERT_EQUALS(mortonCode(above), ~uint64_t(0));
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDMORTONCODETEST_H_ */
@@ -0,0 +1,161 @@
+#ifndef MANTID_DATAOBJECTS_MDSPHEREINTEGRATORTEST_H_
+#define MANTID_DATAOBJECTS_MDSPHEREINTEGRATORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CoordTransformDistance.h"
+#include "MantidDataObjects/MDSphereIntegrator.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::coord_t;
+using Mantid::signal_t;
+
+namespace {
+using MDE = MDLeanEvent<3>;
+using MDEW = MDEventWorkspace<MDE, 3>;
+
+/// A split workspace in (0, 10)^3 with uniform events of signal 1 to 3
+MDEW::sptr createWorkspace(std::vector<MDE> &events) {
+  auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+  ws->getBoxController()->setSplitThreshold(100);
+  ws->splitBox();
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<coord_t> uniform(0.f, 10.f);
+  for (size_t i = 0; i < 50000; ++i) {
+    coord_t center[3] = {uniform(generator), uniform(generator),
+                         uniform(generator)};
+    events.emplace_back(static_cast<float>(i % 3 + 1),
+                        static_cast<float>(i % 2 + 1), center);
+    ws->addEvent(events.back());
+  }
+  ws->splitAllIfNeeded(nullptr);
+  ws->refreshCache();
+  return ws;
+}
+
+/// Sum the events within a shell one by one
+void integrateAll(const std::vector<MDE> &events, const coord_t *center,
+                  const coord_t radiusSquared, const coord_t innerRadiusSquared,
+                  signal_t &signal, signal_t &errorSquared) {
+  for (const auto &event : events) {
+    coord_t dist2 = 0;
+    for (size_t d = 0; d < 3; ++d) {
+      const coord_t dist = event.getCenter(d) - center[d];
+      dist2 += dist * dist;
+    }
+    if (dist2 < radiusSquared &&
+        (innerRadiusSquared == 0.0 || dist2 > innerRadiusSquared)) {
+      signal += event.getSignal();
+      errorSquared += event.getErrorSquared();
+    }
+  }
+}
+} // namespace
+
+class MDSphereIntegratorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDSphereIntegratorTest *createSuite() {
+    return new MDSphereIntegratorTest();
+  }
+  static void destroySuite(MDSphereIntegratorTest *suite) { delete suite; }
+
+  void test_integrates_a_grid_box_like_integrateSphere() {
+    // 10x10 boxes with one event in the middle of each
+    auto box = MDEventsTestHelper::makeMDGridBox<2>();
+    MDEventsTestHelper::feedMDBox<2>(box, 1);
+    const bool dimensionsUsed[2] = {true, true};
+    const coord_t centers[4][2] = {{4.5f, 4.5f}, {5.f, 5.f}, {1.5f, 1.5f},
+                                   {-1.f, 0.5f}};
+    const coord_t radii[4] = {0.5f, 1.f, 1.95f, 1.55f};
+    const double expected[4] = {1.0, 4.0, 9.0, 1.0};
+    for (size_t i = 0; i < 4; ++i) {
+      MDSphereIntegrator<MDLeanEvent<2>, 2> integrator(centers[i],
+                                                       dimensionsUsed);
+      signal_t signal = 0;
+      signal_t errorSquared = 0;
+      integrator.integrate(box, radii[i] * radii[i], signal, errorSquared);
+      TS_ASSERT_DELTA(signal, expected[i], 1e-5);
+      TS_ASSERT_DELTA(errorSquared, expected[i], 1e-5);
+
+      CoordTransformDistance sphere(2, centers[i], dimensionsUsed);
+      signal_t oldSignal = 0;
+      signal_t oldErrorSquared = 0;
+      box->integrateSphere(sphere, radii[i] * radii[i], oldSignal,
+                           oldErrorSquared);
+      TS_ASSERT_DELTA(signal, oldSignal, 1e-5);
+      TS_ASSERT_DELTA(errorSquared, oldErrorSquared, 1e-5);
+    }
+    auto bc = box->getBoxController();
+    delete box;
+    delete bc;
+  }
+
+  void test_sphere_matches_the_events() {
+    std::vector<MDE> events;
+    auto ws = createWorkspace(events);
+    TS_ASSERT_LESS_THAN(125, ws->getBoxController()->getTotalNumMDBoxes());
+    const bool dimensionsUsed[3] = {true, true, true};
+    const coord_t centers[3][3] = {
+        {5.f, 5.f, 5.f}, {0.3f, 9.1f, 4.4f}, {-0.5f, 2.f, 2.f}};
+    for (const auto &center : centers) {
+      MDSphereIntegrator<MDE, 3> integrator(center, dimensionsUsed);
+      for (const coord_t radius : {0.1f, 0.8f, 2.5f}) {
+        signal_t signal = 0;
+        signal_t errorSquared = 0;
+        integrator.integrate(ws->getBox(), radius * radius, signal,
+                             errorSquared);
+        signal_t expectedSignal = 0;
+        signal_t expectedErrorSquared = 0;
+        integrateAll(events, center, radius * radius, 0.0, expectedSignal,
+                     expectedErrorSquared);
+        TS_ASSERT_DELTA(signal, expectedSignal, 1e-3);
+        TS_ASSERT_DELTA(errorSquared, expectedErrorSquared, 1e-3);
+      }
+    }
+  }
+
+  void test_shell_matches_the_events() {
+    std::vector<MDE> events;
+    auto ws = createWorkspace(events);
+    const bool dimensionsUsed[3] = {true, true, true};
+    const coord_t center[3] = {4.2f, 6.f, 5.1f};
+    MDSphereIntegrator<MDE, 3> integrator(center, dimensionsUsed);
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    integrator.integrate(ws->getBox(), 9.f, signal, errorSquared, 1.f, false);
+    signal_t expectedSignal = 0;
+    signal_t expectedErrorSquared = 0;
+    integrateAll(events, center, 9.f, 1.f, expectedSignal,
+                 expectedErrorSquared);
+    TS_ASSERT_LESS_THAN(0, signal);
+    TS_ASSERT_DELTA(signal, expectedSignal, 1e-3);
+    TS_ASSERT_DELTA(errorSquared, expectedErrorSquared, 1e-3);
+  }
+
+  void test_unused_dimensions_are_ignored() {
+    std::vector<MDE> events;
+    auto ws = createWorkspace(events);
+    // A cylinder along the last dimension
+    const bool dimensionsUsed[3] = {true, true, false};
+    const coord_t center[3] = {5.f, 5.f, 100.f};
+    MDSphereIntegrator<MDE, 3> integrator(center, dimensionsUsed);
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    integrator.integrate(ws->getBox(), 1.f, signal, errorSquared);
+    signal_t expectedSignal = 0;
+    for (const auto &event : events) {
+      const coord_t dx = event.getCenter(0) - 5.f;
+      const coord_t dy = event.getCenter(1) - 5.f;
+      if (dx * dx + dy * dy < 1.f)
+        expectedSignal += event.getSignal();
+    }
+    TS_ASSERT_DELTA(signal, expectedSignal, 1e-3);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDSPHEREINTEGRATORTEST_H_ */
@@ -0,0 +1,220 @@
+#ifndef MANTID_DATAOBJECTS_PARALLELMDEVENTINSERTERTEST_H_
+#define MANTID_DATAOBJECTS_PARALLELMDEVENTINSERTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/FakeMD.h"
+#include "MantidDataObjects/ParallelMDEventInserter.h"
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::API::IMDNode;
+using Mantid::Kernel::FunctionTask;
+using Mantid::Kernel::ThreadPool;
+using Mantid::Kernel::ThreadSchedulerFIFO;
+using Mantid::coord_t;
+
+namespace {
+using MDE = MDLeanEvent<3>;
+using MDEW = MDEventWorkspace<MDE, 3>;
+
+/// Events around a few peaks on top of a uniform background in (0, 10)^3
+std::vector<MDE> createEvents(const size_t numEvents) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<coord_t> uniform(0.f, 10.f);
+  std::normal_distribution<coord_t> peak(0.f, 0.2f);
+  std::vector<MDE> events;
+  events.reserve(numEvents);
+  for (size_t i = 0; i < numEvents; ++i) {
+    coord_t centers[3];
+    const coord_t peakCenter = static_cast<coord_t>(i % 4) * 2.f + 2.f;
+    for (auto &center : centers)
+      center = i % 2 == 0 ? uniform(generator)
+                          : std::min(9.9f, std::max(0.1f, peakCenter +
+                                                              peak(generator)));
+    events.emplace_back(1.f, 1.f, centers);
+  }
+  return events;
+}
+
+/// Add events to a workspace from a number of threads, each using its own
+/// slot
+void addInParallel(MDEW &ws, const std::vector<MDE> &events,
+                   const size_t numThreads) {
+  ParallelMDEventInserter<MDE, 3> inserter(ws, numThreads);
+  ThreadPool pool(new ThreadSchedulerFIFO(), numThreads);
+  for (size_t thread = 0; thread < numThreads; ++thread) {
+    pool.schedule(new FunctionTask([&inserter, &events, thread, numThreads] {
+      for (size_t i = thread; i < events.size(); i += numThreads)
+        inserter.addEvent(thread, events[i]);
+    }));
+  }
+  pool.joinAll();
+  inserter.finish();
+  ws.refreshCache();
+}
+
+/// Add events to a workspace one by one, then split the boxes
+void addSerially(MDEW &ws, const std::vector<MDE> &events) {
+  ws.splitBox();
+  for (const auto &event : events)
+    ws.addEvent(event);
+  ws.splitAllIfNeeded(nullptr);
+  ws.refreshCache();
+}
+
+/// @return the leaf boxes of a workspace
+std::vector<IMDNode *> getLeaves(MDEW &ws) {
+  std::vector<IMDNode *> leaves;
+  ws.getBox()->getBoxes(leaves, 1000, true);
+  return leaves;
+}
+} // namespace
+
+class ParallelMDEventInserterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ParallelMDEventInserterTest *createSuite() {
+    return new ParallelMDEventInserterTest();
+  }
+  static void destroySuite(ParallelMDEventInserterTest *suite) {
+    delete suite;
+  }
+
+  void test_constructor_splits_top_box() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    TS_ASSERT(ws->getBox()->isBox());
+    ParallelMDEventInserter<MDE, 3> inserter(*ws, 2);
+    TS_ASSERT(!ws->getBox()->isBox());
+    TS_ASSERT_EQUALS(ws->getBox()->getNumChildren(), 125);
+    TS_ASSERT_EQUALS(inserter.numThreads(), 2);
+  }
+
+  void test_events_outside_are_rejected() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    ParallelMDEventInserter<MDE, 3> inserter(*ws, 1);
+    coord_t outside[3] = {5.f, 10.5f, 5.f};
+    TS_ASSERT(!inserter.addEvent(0, MDE(1.f, 1.f, outside)));
+    coord_t nan[3] = {5.f, 5.f, std::nanf("")};
+    TS_ASSERT(!inserter.addEvent(0, MDE(1.f, 1.f, nan)));
+    // The upper boundary belongs to the workspace
+    coord_t corner[3] = {10.f, 10.f, 10.f};
+    TS_ASSERT(inserter.addEvent(0, MDE(2.f, 1.f, corner)));
+    inserter.finish();
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 1);
+    TS_ASSERT_DELTA(ws->getBox()->getSignal(), 2.0, 1e-6);
+    // In the last box
+    const auto leaves = getLeaves(*ws);
+    TS_ASSERT_EQUALS(leaves.back()->getNPoints(), 1);
+  }
+
+  void test_staged_events_are_only_inserted_when_handed_over() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    ParallelMDEventInserter<MDE, 3> inserter(*ws, 2);
+    coord_t centers[3] = {1.f, 1.f, 1.f};
+    inserter.addEvent(1, MDE(1.f, 1.f, centers));
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 0);
+    inserter.flush(1);
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 1);
+  }
+
+  void test_matches_serial_adding() {
+    const auto events = createEvents(200000);
+    auto serial = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    addSerially(*serial, events);
+    auto parallel = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 0);
+    addInParallel(*parallel, events, 4);
+
+    TS_ASSERT_EQUALS(parallel->getNPoints(), events.size());
+    TS_ASSERT_DELTA(parallel->getBox()->getSignal(),
+                    serial->getBox()->getSignal(), 1e-3);
+    // A box is split as soon as it holds too many events, so the trees are
+    // the same
+    const auto serialLeaves = getLeaves(*serial);
+    const auto parallelLeaves = getLeaves(*parallel);
+    TS_ASSERT_EQUALS(parallelLeaves.size(), serialLeaves.size());
+    auto bc = parallel->getBoxController();
+    for (auto leaf : parallelLeaves) {
+      TS_ASSERT(!bc->willSplit(leaf->getNPoints(), leaf->getDepth()));
+    }
+  }
+
+  void test_events_are_in_their_boxes() {
+    const auto events = createEvents(50000);
+    auto ws = MDEventsTestHelper::makeMDEW<3>(4, 0.0, 10.0, 0);
+    addInParallel(*ws, events, 3);
+    for (auto leaf : getLeaves(*ws)) {
+      auto box = dynamic_cast<MDBox<MDE, 3> *>(leaf);
+      TS_ASSERT(box);
+      for (const auto &event : box->getConstEvents()) {
+        for (size_t d = 0; d < 3; ++d) {
+          TS_ASSERT_LESS_THAN_EQUALS(box->getExtents(d).getMin(),
+                                     event.getCenter(d));
+          TS_ASSERT_LESS_THAN_EQUALS(event.getCenter(d),
+                                     box->getExtents(d).getMax());
+        }
+      }
+    }
+  }
+};
+
+/** Scaling of the insertion of 4 million events from FakeMD with the number of
+ * threads, against adding them serially and splitting the boxes afterwards. */
+class ParallelMDEventInserterTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ParallelMDEventInserterTestPerformance *createSuite() {
+    return new ParallelMDEventInserterTestPerformance();
+  }
+  static void destroySuite(ParallelMDEventInserterTestPerformance *suite) {
+    delete suite;
+  }
+
+  ParallelMDEventInserterTestPerformance() {
+    // Uniform background and a peak, as FakeMDEventData makes them
+    auto source = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 0);
+    FakeMD faker({3e6}, {1e6, 5.0, 5.0, 5.0, 1.0}, 0, false);
+    faker.fill(source);
+    for (auto leaf : getLeaves(*source)) {
+      auto box = dynamic_cast<MDBox<MDE, 3> *>(leaf);
+      const auto &events = box->getConstEvents();
+      m_events.insert(m_events.end(), events.begin(), events.end());
+      box->releaseEvents();
+    }
+    // FakeMD leaves the events sorted by box: shuffle them as they come from
+    // a conversion
+    std::shuffle(m_events.begin(), m_events.end(), std::mt19937(5678));
+  }
+
+  void setUp() override {
+    m_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 0);
+    m_ws->getBoxController()->setSplitThreshold(1000);
+  }
+
+  void test_add_serially_then_split() { addSerially(*m_ws, m_events); }
+
+  void test_parallel_insert_1_thread() { addInParallel(*m_ws, m_events, 1); }
+
+  void test_parallel_insert_2_threads() { addInParallel(*m_ws, m_events, 2); }
+
+  void test_parallel_insert_4_threads() { addInParallel(*m_ws, m_events, 4); }
+
+  void test_parallel_insert_8_threads() { addInParallel(*m_ws, m_events, 8); }
+
+private:
+  std::vector<MDE> m_events;
+  MDEW::sptr m_ws;
+};
+
+#endif /* MANTID_DATAOBJECTS_PARALLELMDEVENTINSERTERTEST_H_ */
@@ -0,0 +1,95 @@
+#ifndef MANTID_DATAOBJECTS_SPARSEMDHISTOGRIDTEST_H_
+#define MANTID_DATAOBJECTS_SPARSEMDHISTOGRIDTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/SparseMDHistoGrid.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using namespace Mantid::DataObjects;
+using Mantid::signal_t;
+
+class SparseMDHistoGridTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SparseMDHistoGridTest *createSuite() {
+    return new SparseMDHistoGridTest();
+  }
+  static void destroySuite(SparseMDHistoGridTest *suite) { delete suite; }
+
+  void test_empty_grid() {
+    SparseMDHistoGrid grid(1000, 100);
+    TS_ASSERT_EQUALS(grid.getNPoints(), 1000);
+    TS_ASSERT_EQUALS(grid.getNumBricks(), 10);
+    TS_ASSERT_EQUALS(grid.getNumAllocatedBricks(), 0);
+    TS_ASSERT_EQUALS(grid.getSignalAt(523), 0.);
+    TS_ASSERT_LESS_THAN(grid.getMemorySize(), 1000 * sizeof(signal_t));
+  }
+
+  void test_last_brick_may_be_partial() {
+    SparseMDHistoGrid grid(1001, 100);
+    TS_ASSERT_EQUALS(grid.getNumBricks(), 11);
+    grid.addSignal(1000, 2.);
+    TS_ASSERT_EQUALS(grid.getSignalAt(1000), 2.);
+    TS_ASSERT(grid.isBrickAllocated(10));
+  }
+
+  void test_zero_brick_size_throws() {
+    TS_ASSERT_THROWS(SparseMDHistoGrid(1000, 0), std::invalid_argument);
+  }
+
+  void test_only_touched_bricks_are_allocated() {
+    SparseMDHistoGrid grid(1000, 100);
+    grid.addSignal(150, 1.5);
+    grid.addSignal(150, 2.);
+    grid.addSignal(720, 1.);
+    TS_ASSERT_EQUALS(grid.getNumAllocatedBricks(), 2);
+    TS_ASSERT(grid.isBrickAllocated(1));
+    TS_ASSERT(grid.isBrickAllocated(7));
+    TS_ASSERT(!grid.isBrickAllocated(0));
+    TS_ASSERT_EQUALS(grid.getSignalAt(150), 3.5);
+    TS_ASSERT_EQUALS(grid.getSignalAt(151), 0.);
+    TS_ASSERT_EQUALS(grid.getSignalAt(720), 1.);
+    TS_ASSERT_EQUALS(grid.getMemorySize(),
+                     10 * sizeof(void *) + 2 * 100 * sizeof(signal_t));
+  }
+
+  void test_concurrent_additions() {
+    SparseMDHistoGrid grid(10000, 64);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 100000; ++i)
+      grid.addSignal(static_cast<size_t>(i % 5000) * 2, 1.);
+    for (size_t i = 0; i < 10000; ++i)
+      TS_ASSERT_EQUALS(grid.getSignalAt(i), i % 2 == 0 ? 20. : 0.);
+  }
+
+  void test_copyTo_and_addTo_workspace_signals() {
+    // 10^3 bins
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 3, 10, 10.0,
+                                                           2.0, "", 1.0);
+    SparseMDHistoGrid grid(ws->getNPoints(), 64);
+    grid.addSignal(5, 4.);
+    grid.addSignal(999, 7.);
+
+    grid.addTo(*ws);
+    TS_ASSERT_EQUALS(ws->getSignalAt(5), 5.);
+    TS_ASSERT_EQUALS(ws->getSignalAt(999), 8.);
+    TS_ASSERT_EQUALS(ws->getSignalAt(500), 1.);
+
+    grid.copyTo(*ws);
+    TS_ASSERT_EQUALS(ws->getSignalAt(5), 4.);
+    TS_ASSERT_EQUALS(ws->getSignalAt(999), 7.);
+    TS_ASSERT_EQUALS(ws->getSignalAt(500), 0.);
+    // Errors and events are not touched
+    TS_ASSERT_EQUALS(ws->getErrorSquaredArray()[5], 2.);
+    TS_ASSERT_EQUALS(ws->getNumEventsAt(500), 1.);
+
+    SparseMDHistoGrid wrongSize(999, 64);
+    TS_ASSERT_THROWS(wrongSize.copyTo(*ws), std::invalid_argument);
+    TS_ASSERT_THROWS(wrongSize.addTo(*ws), std::invalid_argument);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_SPARSEMDHISTOGRIDTEST_H_ */
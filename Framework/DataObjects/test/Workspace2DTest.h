@@ -210,6 +210,45 @@ public:
                      nhist * (nbins + 1) * sizeof(double));
   }
 
+  void test_setSinglePrecision() {
+    auto workspace = create2DWorkspaceBinned(nhist, nbins);
+    workspace->mutableY(3)[2] = 0.1;
+    const size_t doubleSize = workspace->getMemorySize();
+    TS_ASSERT(!workspace->isSinglePrecision());
+    workspace->setSinglePrecision(true);
+    TS_ASSERT(workspace->isSinglePrecision());
+    TS_ASSERT_LESS_THAN(workspace->getMemorySize(), doubleSize);
+    TS_ASSERT_EQUALS(workspace->blocksize(), nbins);
+    TS_ASSERT_EQUALS(workspace->histogram(3).y()[2], static_cast<double>(0.1f));
+
+    // A clone keeps the values in single precision
+    auto clone = workspace->clone();
+    TS_ASSERT(clone->isSinglePrecision());
+    TS_ASSERT(clone->getSpectrum(3).isSinglePrecision());
+    TS_ASSERT_EQUALS(clone->y(3)[2], static_cast<double>(0.1f));
+    TS_ASSERT(!clone->getSpectrum(3).isSinglePrecision());
+    TS_ASSERT(workspace->getSpectrum(3).isSinglePrecision());
+    // Narrow the spectrum widened by the access again
+    clone->setSinglePrecision(true);
+    TS_ASSERT(clone->getSpectrum(3).isSinglePrecision());
+
+    workspace->setSinglePrecision(false);
+    TS_ASSERT(!workspace->isSinglePrecision());
+    TS_ASSERT(!workspace->getSpectrum(0).isSinglePrecision());
+    TS_ASSERT_EQUALS(workspace->getMemorySize(), doubleSize);
+  }
+
+  void test_propagateSinglePrecision() {
+    auto input = create2DWorkspaceBinned(2, nbins);
+    auto output = create2DWorkspaceBinned(2, nbins);
+    propagateSinglePrecision(*input, *output);
+    TS_ASSERT(!output->isSinglePrecision());
+    input->setSinglePrecision(true);
+    propagateSinglePrecision(*input, *output);
+    TS_ASSERT(output->isSinglePrecision());
+    TS_ASSERT(output->getSpectrum(1).isSinglePrecision());
+  }
+
   /** Refs #3003: very odd bug when getting detector in parallel only!
    * This does not reproduce it :( */
   void test_getDetector_parallel() {
@@ -0,0 +1,56 @@
+#ifndef MANTID_HISTOGRAMDATA_HISTOGRAMXPOOL_H_
+#define MANTID_HISTOGRAMDATA_HISTOGRAMXPOOL_H_
+
+#include "MantidHistogramData/DllConfig.h"
+#include "MantidHistogramData/HistogramX.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Mantid {
+namespace HistogramData {
+
+/** HistogramXPool
+
+  Interns HistogramX objects: intern() returns a previously interned object
+  holding identical values if there is one, so that histograms with equal x
+  values can share a single copy. Candidates are found with a hash of the
+  values and then compared value by value.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_HISTOGRAMDATA_DLL HistogramXPool {
+public:
+  Kernel::cow_ptr<HistogramX> intern(const Kernel::cow_ptr<HistogramX> &x);
+  /// Returns the number of distinct HistogramX objects interned.
+  size_t size() const { return m_size; }
+
+private:
+  std::unordered_map<size_t, std::vector<Kernel::cow_ptr<HistogramX>>> m_pool;
+  size_t m_size{0};
+};
+
+} // namespace HistogramData
+} // namespace Mantid
+
+#endif /* MANTID_HISTOGRAMDATA_HISTOGRAMXPOOL_H_ */
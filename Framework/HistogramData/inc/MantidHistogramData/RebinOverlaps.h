@@ -0,0 +1,79 @@
+#ifndef MANTID_HISTOGRAMDATA_REBINOVERLAPS_H_
+#define MANTID_HISTOGRAMDATA_REBINOVERLAPS_H_
+
+#include "MantidHistogramData/BinEdges.h"
+#include "MantidHistogramData/DllConfig.h"
+#include "MantidHistogramData/HistogramX.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace HistogramData {
+class Histogram;
+
+/** RebinOverlaps
+
+  The overlaps between the bins of a set of input bin edges and those of a set
+  of output bin edges, computed once so that all the histograms sharing the
+  input bin edges can be rebinned without recomputing them. rebin() gives the
+  same result as HistogramData::rebin().
+
+  The overlaps are held as a sparse matrix, row by row: each output bin covers
+  a contiguous range of input bins, stored as the index of the first of them
+  and the weights of all of them. Rebinning a histogram is then a sparse matrix
+  times vector product.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_HISTOGRAMDATA_DLL RebinOverlaps {
+public:
+  RebinOverlaps(const HistogramX &oldEdges, const BinEdges &newEdges);
+
+  Histogram rebin(const Histogram &input) const;
+
+  /// Returns the number of overlapping pairs of input and output bins.
+  size_t size() const { return m_countWeights.size(); }
+
+private:
+  Histogram rebinCounts(const Histogram &input) const;
+  Histogram rebinFrequencies(const Histogram &input) const;
+
+  BinEdges m_newEdges;
+  /// Number of input bins.
+  size_t m_oldSize;
+  /// Index of the first overlap of each output bin, and the number of overlaps
+  /// at the end.
+  std::vector<size_t> m_offsets;
+  /// Index of the first input bin overlapping each output bin.
+  std::vector<size_t> m_firstOld;
+  /// Fraction of each input bin in the output bin, for counts.
+  std::vector<double> m_countWeights;
+  /// Width of each overlap, for frequencies.
+  std::vector<double> m_frequencyWeights;
+  /// Width of each overlap times the input bin width, for frequency variances.
+  std::vector<double> m_frequencyVarianceWeights;
+};
+
+} // namespace HistogramData
+} // namespace Mantid
+
+#endif /* MANTID_HISTOGRAMDATA_REBINOVERLAPS_H_ */
@@ -0,0 +1,40 @@
+#include "MantidHistogramData/HistogramXPool.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Mantid {
+namespace HistogramData {
+
+namespace {
+/// Hash of the bit patterns of the values.
+size_t hashValues(const std::vector<double> &values) {
+  size_t hash = values.size();
+  for (const double value : values) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash ^= static_cast<size_t>(bits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+} // namespace
+
+/** Returns an interned HistogramX with the same values as x.
+ *
+ * If an identical HistogramX was interned before, it is returned, otherwise x
+ * itself is interned and returned. */
+Kernel::cow_ptr<HistogramX>
+HistogramXPool::intern(const Kernel::cow_ptr<HistogramX> &x) {
+  const auto &values = x->rawData();
+  auto &candidates = m_pool[hashValues(values)];
+  for (const auto &candidate : candidates) {
+    if (candidate == x || candidate->rawData() == values)
+      return candidate;
+  }
+  candidates.push_back(x);
+  ++m_size;
+  return x;
+}
+
+} // namespace HistogramData
+} // namespace Mantid
@@ -0,0 +1,172 @@
+#include "MantidHistogramData/RebinOverlaps.h"
+#include "MantidHistogramData/Exception.h"
+#include "MantidHistogramData/Histogram.h"
+
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace HistogramData {
+
+using Exception::InvalidBinEdgesError;
+
+/** Computes the overlaps of the input and the output bins.
+ *
+ * The bins are walked through as HistogramData::rebin() does, and the same
+ * errors are thrown for invalid bin edges.
+ * @param oldEdges :: the bin edges of the histograms to rebin.
+ * @param newEdges :: the bin edges to rebin to.
+ * @throws InvalidBinEdgesError for non-positive input or output bin widths.
+ */
+RebinOverlaps::RebinOverlaps(const HistogramX &oldEdges,
+                             const BinEdges &newEdges)
+    : m_newEdges(newEdges),
+      m_oldSize(oldEdges.empty() ? 0 : oldEdges.size() - 1) {
+  const auto &xold = oldEdges.rawData();
+  const auto &xnew = newEdges.rawData();
+  const size_t newSize = xnew.empty() ? 0 : xnew.size() - 1;
+  m_offsets.assign(newSize + 1, 0);
+  m_firstOld.assign(newSize, 0);
+
+  size_t iold = 0;
+  size_t inew = 0;
+  bool rowStarted = false;
+  while ((inew < newSize) && (iold < m_oldSize)) {
+    const double xo_low = xold[iold];
+    const double xo_high = xold[iold + 1];
+    const double xn_low = xnew[inew];
+    const double xn_high = xnew[inew + 1];
+    const double owidth = xo_high - xo_low;
+    const double nwidth = xn_high - xn_low;
+
+    if (owidth <= 0.0 || nwidth <= 0.0) {
+      if (xo_high == -DBL_MAX && xo_low == -DBL_MAX) {
+        throw InvalidBinEdgesError(
+            "One or more x-values was unusually low "
+            "(below -1e100). This usually occurs when a "
+            "monitor spectrum has not been masked after "
+            "ConvertUnits has been run on the workspace");
+      } else {
+        throw InvalidBinEdgesError("Negative or zero bin widths not allowed.");
+      }
+    }
+
+    if (xn_high <= xo_low) {
+      // old and new bins do not overlap
+      m_offsets[++inew] = m_countWeights.size();
+      rowStarted = false;
+    } else if (xo_high <= xn_low) {
+      // old and new bins do not overlap
+      iold++;
+    } else {
+      // delta is the overlap of the bins on the x axis
+      double delta = xo_high < xn_high ? xo_high : xn_high;
+      delta -= xo_low > xn_low ? xo_low : xn_low;
+
+      if (!rowStarted) {
+        m_firstOld[inew] = iold;
+        rowStarted = true;
+      }
+      m_countWeights.push_back(delta / owidth);
+      m_frequencyWeights.push_back(delta);
+      m_frequencyVarianceWeights.push_back(delta * owidth);
+
+      if (xn_high > xo_high) {
+        iold++;
+      } else {
+        m_offsets[++inew] = m_countWeights.size();
+        rowStarted = false;
+      }
+    }
+  }
+  // The output bins beyond the input range do not overlap any input bin
+  for (++inew; inew <= newSize; ++inew)
+    m_offsets[inew] = m_countWeights.size();
+}
+
+/** Rebins a histogram having the input bin edges given on construction.
+ * @param input :: the histogram to rebin.
+ * @returns The rebinned histogram.
+ * @throws std::runtime_error if the input histogram xmode is not BinEdges or
+ * the input yMode is undefined.
+ * @throws std::logic_error if the input histogram does not have as many bins
+ * as the input bin edges.
+ */
+Histogram RebinOverlaps::rebin(const Histogram &input) const {
+  if (input.xMode() != Histogram::XMode::BinEdges)
+    throw std::runtime_error(
+        "XMode must be Histogram::XMode::BinEdges for input histogram");
+  if (input.size() != m_oldSize)
+    throw std::logic_error("RebinOverlaps: the input histogram does not have "
+                           "the bin edges the overlaps were computed for");
+  if (input.yMode() == Histogram::YMode::Counts)
+    return rebinCounts(input);
+  else if (input.yMode() == Histogram::YMode::Frequencies)
+    return rebinFrequencies(input);
+  else
+    throw std::runtime_error("YMode must be defined for input histogram.");
+}
+
+Histogram RebinOverlaps::rebinCounts(const Histogram &input) const {
+  const auto &yold = input.y().rawData();
+  const auto &eold = input.e().rawData();
+  const size_t newSize = m_firstOld.size();
+  Counts newCounts(newSize);
+  CountVariances newCountVariances(newSize);
+  auto &ynew = newCounts.mutableData();
+  auto &enew = newCountVariances.mutableData();
+
+  for (size_t inew = 0; inew < newSize; ++inew) {
+    const size_t begin = m_offsets[inew];
+    const size_t count = m_offsets[inew + 1] - begin;
+    const double *weights = m_countWeights.data() + begin;
+    const double *y = yold.data() + m_firstOld[inew];
+    const double *e = eold.data() + m_firstOld[inew];
+    double sum = 0.0;
+    double variance = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+      sum += y[k] * weights[k];
+      variance += e[k] * e[k] * weights[k];
+    }
+    ynew[inew] = sum;
+    enew[inew] = variance;
+  }
+
+  return Histogram(m_newEdges, newCounts,
+                   CountStandardDeviations(std::move(newCountVariances)));
+}
+
+Histogram RebinOverlaps::rebinFrequencies(const Histogram &input) const {
+  const auto &yold = input.y().rawData();
+  const auto &eold = input.e().rawData();
+  const auto &xnew = m_newEdges.rawData();
+  const size_t newSize = m_firstOld.size();
+  Frequencies newFrequencies(newSize);
+  FrequencyStandardDeviations newFrequencyStdDev(newSize);
+  auto &ynew = newFrequencies.mutableData();
+  auto &enew = newFrequencyStdDev.mutableData();
+
+  for (size_t inew = 0; inew < newSize; ++inew) {
+    const size_t begin = m_offsets[inew];
+    const size_t count = m_offsets[inew + 1] - begin;
+    const double *weights = m_frequencyWeights.data() + begin;
+    const double *varianceWeights = m_frequencyVarianceWeights.data() + begin;
+    const double *y = yold.data() + m_firstOld[inew];
+    const double *e = eold.data() + m_firstOld[inew];
+    double sum = 0.0;
+    double variance = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+      sum += y[k] * weights[k];
+      variance += e[k] * e[k] * varianceWeights[k];
+    }
+    const double factor = 1 / (xnew[inew + 1] - xnew[inew]);
+    ynew[inew] = sum * factor;
+    enew[inew] = std::sqrt(variance) * factor;
+  }
+
+  return Histogram(m_newEdges, newFrequencies, newFrequencyStdDev);
+}
+
+} // namespace HistogramData
+} // namespace Mantid
@@ -0,0 +1,70 @@
+#ifndef MANTID_HISTOGRAMDATA_HISTOGRAMXPOOLTEST_H_
+#define MANTID_HISTOGRAMDATA_HISTOGRAMXPOOLTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidHistogramData/HistogramXPool.h"
+#include "MantidKernel/make_cow.h"
+
+#include <cmath>
+
+using namespace Mantid::HistogramData;
+using Mantid::Kernel::make_cow;
+
+class HistogramXPoolTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static HistogramXPoolTest *createSuite() { return new HistogramXPoolTest(); }
+  static void destroySuite(HistogramXPoolTest *suite) { delete suite; }
+
+  void test_first_x_is_kept() {
+    HistogramXPool pool;
+    auto x = make_cow<HistogramX>(std::vector<double>{1, 2, 3});
+    TS_ASSERT_EQUALS(pool.intern(x), x);
+    TS_ASSERT_EQUALS(pool.size(), 1);
+  }
+
+  void test_identical_values_are_shared() {
+    HistogramXPool pool;
+    auto x1 = make_cow<HistogramX>(std::vector<double>{1, 2, 3});
+    auto x2 = make_cow<HistogramX>(std::vector<double>{1, 2, 3});
+    TS_ASSERT_DIFFERS(x1, x2);
+    pool.intern(x1);
+    TS_ASSERT_EQUALS(pool.intern(x2), x1);
+    TS_ASSERT_EQUALS(pool.intern(x1), x1);
+    TS_ASSERT_EQUALS(pool.size(), 1);
+  }
+
+  void test_different_values_are_not_shared() {
+    HistogramXPool pool;
+    auto x1 = make_cow<HistogramX>(std::vector<double>{1, 2, 3});
+    auto x2 = make_cow<HistogramX>(std::vector<double>{1, 2, 3.0000001});
+    auto x3 = make_cow<HistogramX>(std::vector<double>{1, 2});
+    auto x4 = make_cow<HistogramX>(std::vector<double>{1, 2, 3, 4});
+    TS_ASSERT_EQUALS(pool.intern(x1), x1);
+    TS_ASSERT_EQUALS(pool.intern(x2), x2);
+    TS_ASSERT_EQUALS(pool.intern(x3), x3);
+    TS_ASSERT_EQUALS(pool.intern(x4), x4);
+    TS_ASSERT_EQUALS(pool.size(), 4);
+  }
+
+  void test_nan_is_never_shared() {
+    HistogramXPool pool;
+    auto x1 = make_cow<HistogramX>(std::vector<double>{1, NAN});
+    auto x2 = make_cow<HistogramX>(std::vector<double>{1, NAN});
+    pool.intern(x1);
+    TS_ASSERT_EQUALS(pool.intern(x2), x2);
+    TS_ASSERT_EQUALS(pool.size(), 2);
+  }
+
+  void test_empty_x() {
+    HistogramXPool pool;
+    auto x1 = make_cow<HistogramX>(0);
+    auto x2 = make_cow<HistogramX>(0);
+    pool.intern(x1);
+    TS_ASSERT_EQUALS(pool.intern(x2), x1);
+  }
+};
+
+#endif /* MANTID_HISTOGRAMDATA_HISTOGRAMXPOOLTEST_H_ */
@@ -0,0 +1,114 @@
+#ifndef MANTID_HISTOGRAMDATA_REBINOVERLAPSTEST_H_
+#define MANTID_HISTOGRAMDATA_REBINOVERLAPSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidHistogramData/Exception.h"
+#include "MantidHistogramData/Histogram.h"
+#include "MantidHistogramData/LinearGenerator.h"
+#include "MantidHistogramData/Rebin.h"
+#include "MantidHistogramData/RebinOverlaps.h"
+
+using namespace Mantid::HistogramData;
+using namespace Mantid::HistogramData::Exception;
+
+class RebinOverlapsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static RebinOverlapsTest *createSuite() { return new RebinOverlapsTest(); }
+  static void destroySuite(RebinOverlapsTest *suite) { delete suite; }
+
+  void test_size() {
+    const BinEdges edges{0, 1, 2, 3};
+    TS_ASSERT_EQUALS(RebinOverlaps(edges.data(), edges).size(), 3);
+    // Each new bin overlaps two old bins
+    TS_ASSERT_EQUALS(RebinOverlaps(edges.data(), BinEdges{0, 2, 3}).size(), 3);
+    TS_ASSERT_EQUALS(RebinOverlaps(edges.data(), BinEdges{0.5, 2.5}).size(), 3);
+    TS_ASSERT_EQUALS(RebinOverlaps(edges.data(), BinEdges{4, 5, 6}).size(), 0);
+  }
+
+  void test_counts_match_rebin() {
+    const auto input = getCountsHistogram();
+    for (const auto &edges : getBinEdges())
+      assertMatchesRebin(input, edges);
+  }
+
+  void test_frequencies_match_rebin() {
+    const auto input = getFrequencyHistogram();
+    for (const auto &edges : getBinEdges())
+      assertMatchesRebin(input, edges);
+  }
+
+  void test_output_shares_the_new_bin_edges() {
+    const auto input = getCountsHistogram();
+    const BinEdges edges(5, LinearGenerator(0, 2));
+    const RebinOverlaps overlaps(input.x(), edges);
+    TS_ASSERT_EQUALS(overlaps.rebin(input).sharedX(), edges.cowData());
+  }
+
+  void test_invalid_bin_edges_throw() {
+    const BinEdges edges(10, LinearGenerator(0, 1));
+    TS_ASSERT_THROWS(RebinOverlaps(edges.data(), BinEdges{1, 3, 2, 4}),
+                     InvalidBinEdgesError);
+    TS_ASSERT_THROWS(RebinOverlaps(BinEdges{0, 2, 1, 3}.data(), edges),
+                     InvalidBinEdgesError);
+  }
+
+  void test_input_with_other_bin_edges_throws() {
+    const auto input = getCountsHistogram();
+    const RebinOverlaps overlaps(BinEdges{0, 1, 2}.data(), BinEdges{0, 2});
+    TS_ASSERT_THROWS(overlaps.rebin(input), std::logic_error);
+  }
+
+  void test_undefined_modes_throw() {
+    const BinEdges edges(5, LinearGenerator(0, 2));
+    const RebinOverlaps overlaps(edges.data(), edges);
+    TS_ASSERT_THROWS(overlaps.rebin(Histogram(Points(4, LinearGenerator(0, 1)),
+                                              Counts{10, 1, 3, 4})),
+                     std::runtime_error);
+    TS_ASSERT_THROWS(overlaps.rebin(Histogram(edges)), std::runtime_error);
+  }
+
+private:
+  void assertMatchesRebin(const Histogram &input, const BinEdges &edges) {
+    const auto expected = rebin(input, edges);
+    const auto result = RebinOverlaps(input.x(), edges).rebin(input);
+    TS_ASSERT_EQUALS(result.yMode(), expected.yMode());
+    TS_ASSERT_EQUALS(result.x(), expected.x());
+    TS_ASSERT_EQUALS(result.y().size(), expected.y().size());
+    TS_ASSERT_EQUALS(result.e().size(), expected.e().size());
+    for (size_t i = 0; i < expected.y().size(); ++i) {
+      TS_ASSERT_DELTA(result.y()[i], expected.y()[i], 1e-12);
+      TS_ASSERT_DELTA(result.e()[i], expected.e()[i], 1e-12);
+    }
+  }
+
+  std::vector<BinEdges> getBinEdges() {
+    return {BinEdges(10, LinearGenerator(0, 1)),
+            BinEdges(19, LinearGenerator(0, 0.5)),
+            BinEdges(5, LinearGenerator(0, 2)),
+            BinEdges{-3, -1, 0.5, 0.7, 2.9, 3.1, 6, 8.25, 9, 12},
+            BinEdges{1.5, 2.25, 7.75},
+            BinEdges{-5, -4, -2},
+            BinEdges{8.5, 10, 11, 12}};
+  }
+
+  Histogram getCountsHistogram() {
+    return Histogram(BinEdges(10, LinearGenerator(0, 1)),
+                     Counts{10.5, 11.2, 19.3, 25.4, 36.8, 40.3, 17.7, 9.3, 4.6},
+                     CountStandardDeviations{3.2404, 3.3466, 4.3932, 5.0398,
+                                             6.0663, 6.3482, 4.2071, 3.0496,
+                                             2.1448});
+  }
+
+  Histogram getFrequencyHistogram() {
+    return Histogram(
+        BinEdges{0, 0.5, 1, 3, 4, 4.25, 5, 7, 8, 9},
+        Frequencies{10.5, 11.2, 19.3, 25.4, 36.8, 40.3, 17.7, 9.3, 4.6},
+        FrequencyStandardDeviations{3.2404, 3.3466, 4.3932, 5.0398, 6.0663,
+                                    6.3482, 4.2071, 3.0496, 2.1448});
+  }
+};
+
+#endif /* MANTID_HISTOGRAMDATA_REBINOVERLAPSTEST_H_ */
@@ -0,0 +1,124 @@
+#ifndef MANTID_KERNEL_TIMESERIESCOLUMNS_H_
+#define MANTID_KERNEL_TIMESERIESCOLUMNS_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/System.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TimeSeriesColumns : A compact, columnar store for a time series that is
+  sorted by time.
+
+  The values are held in a typed array and the times in a separate column of
+  delta-encoded nanoseconds: each time is stored as the variable-length
+  encoded difference to the previous one, which takes 2-4 bytes for logs
+  recorded at kHz to Hz rates instead of 8.
+
+  The samples are grouped in blocks of BLOCK_SIZE. Each block records the
+  absolute time of its first sample and where its times start in the delta
+  column, so that any sample can be accessed by decoding at most one block.
+  Each block also keeps summaries of its values (minimum, maximum and the
+  time-weighted sum over the time the values hold), so that time averages
+  and value-range filters over long windows only decode the blocks at the
+  ends of the window.
+
+  As in TimeSeriesProperty, a value holds from its time until the time of the
+  next sample. The first value is taken to hold before the first time and the
+  last one after the last time.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename TYPE> class DLLExport TimeSeriesColumns {
+public:
+  /// Number of samples in a block
+  static const size_t BLOCK_SIZE = 256;
+
+  /// Index entry and summaries of a block of samples
+  struct Block {
+    /// Time of the first sample, in nanoseconds
+    int64_t firstTime;
+    /// Time of the last sample, in nanoseconds
+    int64_t lastTime;
+    /// Position of the time deltas of the block in the delta column
+    size_t deltaOffset;
+    /// Smallest value, NaN if any value is NaN
+    double minimum;
+    /// Largest value, NaN if any value is NaN
+    double maximum;
+    /// Time integral of the values from the first sample of the series to
+    /// the first sample of the block, in value-seconds
+    double integralBefore;
+  };
+
+  /// Add a sample. Its time must not be before the time of the last sample.
+  void append(const int64_t time, const TYPE value);
+  void reserve(const size_t size);
+  void clear();
+
+  /// @return the number of samples
+  size_t size() const { return m_values.size(); }
+  /// @return true if there are no samples
+  bool empty() const { return m_values.empty(); }
+  size_t getMemorySize() const;
+
+  /// @return the value of the i-th sample
+  TYPE value(const size_t i) const { return m_values[i]; }
+  /// Read-only access to the value column
+  const std::vector<TYPE> &values() const { return m_values; }
+  int64_t time(const size_t i) const;
+  std::vector<int64_t> times() const;
+
+  /// @return the number of blocks
+  size_t numberOfBlocks() const { return m_blocks.size(); }
+  /// @return the index entry and summaries of a block
+  const Block &block(const size_t i) const { return m_blocks[i]; }
+
+  size_t upperBound(const int64_t time) const;
+  double timeIntegral(const int64_t start, const int64_t stop) const;
+  double timeAverage(const int64_t start, const int64_t stop) const;
+  std::vector<std::pair<size_t, size_t>>
+  findValueRanges(const double minValue, const double maxValue) const;
+
+private:
+  void decodeBlock(const size_t block, int64_t *times) const;
+  double integralTo(const int64_t time) const;
+
+  /// The values
+  std::vector<TYPE> m_values;
+  /// Variable-length encoded time differences to the previous sample, for
+  /// all but the first sample of each block
+  std::vector<uint8_t> m_timeDeltas;
+  /// The block index
+  std::vector<Block> m_blocks;
+  /// Time integral of the values from the first to the last sample
+  double m_integralToLast = 0.;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TIMESERIESCOLUMNS_H_ */
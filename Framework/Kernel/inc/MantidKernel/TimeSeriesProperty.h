@@ -10,6 +10,7 @@
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 // Forward declare
@@ -21,6 +22,7 @@ namespace Mantid {
 namespace Kernel {
 class DataItem;
 class SplittingInterval;
+template <typename TYPE> class TimeSeriesColumns;
 
 enum TimeSeriesSortStatus { TSUNKNOWN, TSUNSORTED, TSSORTED };
 
@@ -326,6 +328,8 @@ private:
   int upperBound(Types::Core::DateAndTime t, int istart, int iend) const;
   /// Apply a filter
   void applyFilter() const;
+  /// The values in columns with block summaries, for long series
+  std::shared_ptr<const TimeSeriesColumns<TYPE>> columns() const;
   /// A new algorithm to find Nth index.  It is simple and leave a lot work to
   /// the callers
   size_t findNthIndexFromQuickRef(int n) const;
@@ -350,6 +354,9 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// The sorted values in columns, built when first needed and dropped when
+  /// the values change. Only accessed through std::atomic_load/atomic_store
+  mutable std::shared_ptr<const TimeSeriesColumns<TYPE>> m_columns;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
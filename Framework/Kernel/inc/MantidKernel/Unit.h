@@ -183,6 +183,39 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Convert many X values to TOF. The default calls singleToTOF() for each
+   * value; the closed-form units override it with a loop the compiler can
+   * vectorize.
+   * @param x :: the values to convert
+   * @param tof :: the converted values, may be the same array as x
+   * @param count :: the number of values
+   */
+  virtual void multipleToTOF(const double *x, double *tof,
+                             const size_t count) const;
+
+  /** Convert many TOF values to this unit.
+   * @param tof :: the values to convert
+   * @param x :: the converted values, may be the same array as tof
+   * @param count :: the number of values
+   */
+  virtual void multipleFromTOF(const double *tof, double *x,
+                               const size_t count) const;
+
+  /** Get the relation tof = factor * x^power + offset between this unit and
+   * TOF, if there is one for the current initialization.
+   * @param factor :: returns the factor
+   * @param power :: returns the power
+   * @param offset :: returns the offset
+   * @return true if the unit converts to and from TOF with such a relation
+   */
+  virtual bool getTOFRelation(double &factor, double &power,
+                              double &offset) const;
+
+  // Convert many values from this unit to another one, skipping TOF if
+  // possible
+  void convertTo(const Unit &destination, const double *values,
+                 double *converted, const size_t count) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -303,6 +336,12 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -320,6 +359,12 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -347,6 +392,12 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -394,6 +445,12 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -444,6 +501,12 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -489,6 +552,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -574,6 +641,12 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -593,6 +666,12 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof,
+                     const size_t count) const override;
+  void multipleFromTOF(const double *tof, double *x,
+                       const size_t count) const override;
+  bool getTOFRelation(double &factor, double &power,
+                      double &offset) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
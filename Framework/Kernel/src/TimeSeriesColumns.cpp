@@ -0,0 +1,280 @@
+#include "MantidKernel/TimeSeriesColumns.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Nanoseconds to seconds
+const double SECONDS_PER_NANOSECOND = 1e-9;
+
+/// Append a non-negative integer in LEB128 variable-length encoding
+void encodeDelta(uint64_t delta, std::vector<uint8_t> &bytes) {
+  while (delta >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+    delta >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(delta));
+}
+
+/// Read an integer in LEB128 variable-length encoding and move past it
+uint64_t decodeDelta(const uint8_t *&bytes) {
+  uint64_t delta = 0;
+  int shift = 0;
+  uint8_t byte;
+  do {
+    byte = *bytes++;
+    delta |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return delta;
+}
+
+/// Comparison of a time with the first time of a block, for std::upper_bound
+template <typename BLOCK>
+bool isBeforeBlock(const int64_t time, const BLOCK &block) {
+  return time < block.firstTime;
+}
+} // namespace
+
+template <typename TYPE> const size_t TimeSeriesColumns<TYPE>::BLOCK_SIZE;
+
+/** Add a sample at the end of the series
+ * @param time :: time of the sample in nanoseconds. Must not be before the
+ * time of the last sample.
+ * @param value :: the value
+ * @throw std::invalid_argument if the time is before the last time
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::append(const int64_t time, const TYPE value) {
+  const size_t index = m_values.size();
+  const double newValue = static_cast<double>(value);
+  if (index > 0) {
+    Block &last = m_blocks.back();
+    if (time < last.lastTime)
+      throw std::invalid_argument(
+          "TimeSeriesColumns::append: times must be in increasing order");
+    // The previous value holds until this sample
+    m_integralToLast += static_cast<double>(m_values.back()) *
+                        static_cast<double>(time - last.lastTime) *
+                        SECONDS_PER_NANOSECOND;
+    if (index % BLOCK_SIZE != 0) {
+      encodeDelta(static_cast<uint64_t>(time - last.lastTime), m_timeDeltas);
+      last.lastTime = time;
+      if (std::isnan(newValue)) {
+        last.minimum = newValue;
+        last.maximum = newValue;
+      } else if (!std::isnan(last.minimum)) {
+        last.minimum = std::min(last.minimum, newValue);
+        last.maximum = std::max(last.maximum, newValue);
+      }
+      m_values.push_back(value);
+      return;
+    }
+  }
+  // First sample of a new block
+  m_blocks.push_back(Block{time, time, m_timeDeltas.size(), newValue, newValue,
+                           m_integralToLast});
+  m_values.push_back(value);
+}
+
+/** Reserve memory for a number of samples
+ * @param size :: the expected number of samples
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::reserve(const size_t size) {
+  m_values.reserve(size);
+  // Deltas of up to 2^21 ns take 3 bytes
+  m_timeDeltas.reserve(3 * size);
+  m_blocks.reserve(size / BLOCK_SIZE + 1);
+}
+
+/// Remove all the samples
+template <typename TYPE> void TimeSeriesColumns<TYPE>::clear() {
+  m_values.clear();
+  m_timeDeltas.clear();
+  m_blocks.clear();
+  m_integralToLast = 0.;
+}
+
+/// @return the memory used by the series, in bytes
+template <typename TYPE>
+size_t TimeSeriesColumns<TYPE>::getMemorySize() const {
+  return m_values.capacity() * sizeof(TYPE) + m_timeDeltas.capacity() +
+         m_blocks.capacity() * sizeof(Block);
+}
+
+/** Decode the times of a block
+ * @param block :: index of the block
+ * @param times :: returns the times of the samples of the block, in
+ * nanoseconds. Room for BLOCK_SIZE times.
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::decodeBlock(const size_t block,
+                                          int64_t *times) const {
+  const size_t count = std::min(BLOCK_SIZE, size() - block * BLOCK_SIZE);
+  const uint8_t *bytes = m_timeDeltas.data() + m_blocks[block].deltaOffset;
+  times[0] = m_blocks[block].firstTime;
+  for (size_t i = 1; i < count; ++i)
+    times[i] = times[i - 1] + static_cast<int64_t>(decodeDelta(bytes));
+}
+
+/** @param i :: index of the sample
+ * @return the time of the sample in nanoseconds
+ */
+template <typename TYPE>
+int64_t TimeSeriesColumns<TYPE>::time(const size_t i) const {
+  const Block &block = m_blocks[i / BLOCK_SIZE];
+  const uint8_t *bytes = m_timeDeltas.data() + block.deltaOffset;
+  int64_t result = block.firstTime;
+  for (size_t j = 0; j < i % BLOCK_SIZE; ++j)
+    result += static_cast<int64_t>(decodeDelta(bytes));
+  return result;
+}
+
+/// @return the times of all the samples in nanoseconds
+template <typename TYPE>
+std::vector<int64_t> TimeSeriesColumns<TYPE>::times() const {
+  std::vector<int64_t> result(size());
+  for (size_t block = 0; block < m_blocks.size(); ++block)
+    decodeBlock(block, result.data() + block * BLOCK_SIZE);
+  return result;
+}
+
+/** Find the samples up to a time
+ * @param time :: the time in nanoseconds
+ * @return the number of samples at or before the time
+ */
+template <typename TYPE>
+size_t TimeSeriesColumns<TYPE>::upperBound(const int64_t time) const {
+  if (empty() || time < m_blocks.front().firstTime)
+    return 0;
+  const auto next = std::upper_bound(m_blocks.begin(), m_blocks.end(), time,
+                                     isBeforeBlock<Block>);
+  const size_t block = std::distance(m_blocks.begin(), next) - 1;
+  const size_t start = block * BLOCK_SIZE;
+  const size_t count = std::min(BLOCK_SIZE, size() - start);
+  if (time >= m_blocks[block].lastTime)
+    return start + count;
+  int64_t times[BLOCK_SIZE];
+  decodeBlock(block, times);
+  return start + std::distance(times, std::upper_bound(times, times + count,
+                                                       time));
+}
+
+/** Time integral of the values from the first sample to a time. Only the
+ * block holding the time is decoded.
+ * @param time :: the time in nanoseconds
+ * @return the integral in value-seconds, negative for a time before the first
+ * sample
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::integralTo(const int64_t time) const {
+  if (empty())
+    return 0.;
+  const int64_t firstTime = m_blocks.front().firstTime;
+  if (time <= firstTime)
+    return static_cast<double>(m_values.front()) *
+           static_cast<double>(time - firstTime) * SECONDS_PER_NANOSECOND;
+
+  const auto next = std::upper_bound(m_blocks.begin(), m_blocks.end(), time,
+                                     isBeforeBlock<Block>);
+  const size_t block = std::distance(m_blocks.begin(), next) - 1;
+  const size_t start = block * BLOCK_SIZE;
+  const size_t count = std::min(BLOCK_SIZE, size() - start);
+  int64_t times[BLOCK_SIZE];
+  decodeBlock(block, times);
+  // Last sample at or before the time
+  const size_t last =
+      std::distance(times, std::upper_bound(times, times + count, time)) - 1;
+
+  double integral = m_blocks[block].integralBefore;
+  for (size_t i = 0; i < last; ++i)
+    integral += static_cast<double>(m_values[start + i]) *
+                static_cast<double>(times[i + 1] - times[i]) *
+                SECONDS_PER_NANOSECOND;
+  integral += static_cast<double>(m_values[start + last]) *
+              static_cast<double>(time - times[last]) * SECONDS_PER_NANOSECOND;
+  return integral;
+}
+
+/** Time integral of the values over a time window. Only the blocks holding
+ * the ends of the window are decoded.
+ * @param start :: start of the window in nanoseconds
+ * @param stop :: end of the window in nanoseconds
+ * @return the integral in value-seconds
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::timeIntegral(const int64_t start,
+                                             const int64_t stop) const {
+  return integralTo(stop) - integralTo(start);
+}
+
+/** Time-weighted average of the values over a time window
+ * @param start :: start of the window in nanoseconds
+ * @param stop :: end of the window in nanoseconds
+ * @return the average, NaN if there are no samples or the window is empty
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::timeAverage(const int64_t start,
+                                            const int64_t stop) const {
+  if (empty() || stop <= start)
+    return std::numeric_limits<double>::quiet_NaN();
+  return timeIntegral(start, stop) /
+         (static_cast<double>(stop - start) * SECONDS_PER_NANOSECOND);
+}
+
+/** Find the runs of samples with values in a range. Blocks entirely inside
+ * or outside the range are accepted or skipped from their summaries.
+ * @param minValue :: lowest value in the range
+ * @param maxValue :: highest value in the range
+ * @return the runs as [first, last) sample indices, in increasing order
+ */
+template <typename TYPE>
+std::vector<std::pair<size_t, size_t>>
+TimeSeriesColumns<TYPE>::findValueRanges(const double minValue,
+                                         const double maxValue) const {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  auto addRange = [&ranges](const size_t first, const size_t last) {
+    if (!ranges.empty() && ranges.back().second == first)
+      ranges.back().second = last;
+    else
+      ranges.emplace_back(first, last);
+  };
+
+  for (size_t block = 0; block < m_blocks.size(); ++block) {
+    const Block &summary = m_blocks[block];
+    const size_t start = block * BLOCK_SIZE;
+    const size_t end = std::min(start + BLOCK_SIZE, size());
+    // The comparisons are false for blocks holding NaN, which are scanned
+    if (summary.minimum >= minValue && summary.maximum <= maxValue) {
+      addRange(start, end);
+    } else if (summary.maximum < minValue || summary.minimum > maxValue) {
+      continue;
+    } else {
+      for (size_t i = start; i < end; ++i) {
+        const double value = static_cast<double>(m_values[i]);
+        if (value >= minValue && value <= maxValue)
+          addRange(i, i + 1);
+      }
+    }
+  }
+  return ranges;
+}
+
+/// @cond
+template class DLLExport TimeSeriesColumns<int32_t>;
+template class DLLExport TimeSeriesColumns<int64_t>;
+template class DLLExport TimeSeriesColumns<uint32_t>;
+template class DLLExport TimeSeriesColumns<uint64_t>;
+template class DLLExport TimeSeriesColumns<float>;
+template class DLLExport TimeSeriesColumns<double>;
+template class DLLExport TimeSeriesColumns<bool>;
+/// @endcond
+
+} // namespace Kernel
+} // namespace Mantid
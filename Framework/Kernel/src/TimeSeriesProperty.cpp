@@ -2,18 +2,26 @@
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/TimeSeriesColumns.h"
 #include "MantidKernel/TimeSplitter.h"
 #include "MantidKernel/make_unique.h"
 #include <nexus/NeXusFile.hpp>
 
 #include <boost/regex.hpp>
 
+#include <mutex>
+
 namespace Mantid {
 using namespace Types::Core;
 namespace Kernel {
 namespace {
 /// static Logger definition
 Logger g_log("TimeSeriesProperty");
+/// Smallest number of values for which queries use the block summaries of
+/// TimeSeriesColumns rather than a scan of the values
+const size_t MIN_SIZE_FOR_COLUMNS = 1024;
+/// Serialises the lazy builds of the columns from const queries
+std::mutex g_columnsMutex;
 }
 
 /**
@@ -109,7 +117,10 @@ TimeSeriesProperty<std::string>::getDerivative() const {
 template <typename TYPE>
 size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
   // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  size_t memory = m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  if (const auto series = std::atomic_load(&m_columns))
+    memory += series->getMemorySize();
+  return memory;
 }
 
 /**
@@ -138,6 +149,7 @@ operator+=(Property const *right) {
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      std::atomic_store(&m_columns, {});
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -268,47 +280,51 @@ void TimeSeriesProperty<TYPE>::filterByTime(
   if (m_values.size() <= 1)
     return;
 
-  typename std::vector<TimeValueUnit<TYPE>>::iterator iterhead, iterend;
-
-  // 2. Determine index for start and remove  Note erase is [...)
-  int istart = this->findIndex(start);
-  if (istart >= 0 && static_cast<size_t>(istart) < m_values.size()) {
-    // "start time" is behind time-series's starting time
-    iterhead = m_values.begin() + istart;
-
-    // False - The filter time is on the mark.  Erase [begin(),  istart)
-    // True - The filter time is larger than T[istart]. Erase[begin(), istart)
-    // ...
-    //       filter start(time) and move istart to filter startime
-    bool useprefiltertime = !(m_values[istart].time() == start);
+  // 2. Find both cut points in the values as they are. A long log whose
+  // columns are already built finds them from the block index, decoding a
+  // single block per cut, rather than searching the values
+  const auto series = std::atomic_load(&m_columns);
+  // The index of the first entry at "time", or else of the last one before it
+  auto indexAt = [this, &series](const DateAndTime &time) -> size_t {
+    size_t before;
+    if (series) {
+      before = series->upperBound(time.totalNanoseconds() - 1);
+    } else {
+      before = std::lower_bound(m_values.begin(), m_values.end(), time,
+                                [](const TimeValueUnit<TYPE> &entry,
+                                   const DateAndTime &t) {
+                                  return entry.time() < t;
+                                }) -
+               m_values.begin();
+    }
+    return m_values[before].time() == time ? before : before - 1;
+  };
+  const DateAndTime first = m_values.front().time();
+  const DateAndTime last = m_values.back().time();
 
-    // Remove the series
-    m_values.erase(m_values.begin(), iterhead);
+  // The head is cut only if "start" falls inside the log. The log then starts
+  // from the entry at or just before "start", moved to "start"
+  const bool cutHead = first < start && start < last;
+  const size_t head = cutHead ? indexAt(start) : 0;
+  const DateAndTime newFirst = cutHead ? start : first;
 
-    if (useprefiltertime) {
-      m_values[0].setTime(start);
-    }
-  } else {
-    // "start time" is before/after time-series's starting time: do nothing
-    ;
+  // 3. Remove the tail first, so the head index stays valid. Note erase is
+  // [...). A filter stop on a log deletes that log, otherwise the entry just
+  // before the stop is kept
+  if (newFirst < stop && stop < last) {
+    const size_t iend = indexAt(stop);
+    const bool onLog = m_values[iend].time() == stop;
+    m_values.erase(m_values.begin() + (onLog ? iend : iend + 1),
+                   m_values.end());
   }
-
-  // 3. Determine index for end and remove  Note erase is [...)
-  int iend = this->findIndex(stop);
-  if (static_cast<size_t>(iend) < m_values.size()) {
-    if (m_values[iend].time() == stop) {
-      // Filter stop is on a log.  Delete that log
-      iterend = m_values.begin() + iend;
-    } else {
-      // Filter stop is behind iend. Keep iend
-      iterend = m_values.begin() + iend + 1;
-    }
-    // Delete from [iend to mp.end)
-    m_values.erase(iterend, m_values.end());
+  if (cutHead) {
+    m_values.erase(m_values.begin(), m_values.begin() + head);
+    m_values[0].setTime(start);
   }
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  std::atomic_store(&m_columns, {});
 }
 
 /**
@@ -386,6 +402,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  std::atomic_store(&m_columns, {});
 }
 
 /**
@@ -421,6 +438,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.push_back(myOutput);
+      std::atomic_store(&myOutput->m_columns, {});
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -731,8 +749,27 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   sortIfNecessary();
 
   // 2. Do the rest
-  bool lastGood(false);
   time_duration tol = DateAndTime::durationFromSeconds(TimeTolerance);
+
+  // Long logs: the ranges of good values are found from the block summaries
+  if (const auto series = columns()) {
+    for (const auto &range : series->findValueRanges(min, max)) {
+      const DateAndTime &first = m_values[range.first].time();
+      DateAndTime start = centre ? first - tol : first;
+      DateAndTime stop;
+      if (range.second == m_values.size()) {
+        // The log ended on "good"
+        stop = m_values.back().time() + tol;
+      } else {
+        stop = centre ? m_values[range.second - 1].time() + tol
+                      : m_values[range.second].time();
+      }
+      split.emplace_back(start, stop, 0);
+    }
+    return;
+  }
+
+  bool lastGood(false);
   int numgood = 0;
   DateAndTime t;
   DateAndTime start, stop;
@@ -876,6 +913,16 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
   sortIfNecessary();
 
   double numerator(0.0), totalTime(0.0);
+  // Long logs: integrate from the block summaries
+  if (const auto series = columns()) {
+    for (const auto &time : filter) {
+      totalTime += time.duration();
+      numerator += series->timeIntegral(time.start().totalNanoseconds(),
+                                        time.stop().totalNanoseconds());
+    }
+    return numerator / totalTime;
+  }
+
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
@@ -1048,6 +1095,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
   TimeValueUnit<TYPE> newvalue(time, value);
   // Add the value to the back of the vector
   m_values.push_back(newvalue);
+  std::atomic_store(&m_columns, {});
   // Increment the separate record of the property's size
   m_size++;
 
@@ -1110,6 +1158,7 @@ void TimeSeriesProperty<TYPE>::addValues(
   for (size_t i = 0; i < length; ++i) {
     m_values.emplace_back(times[i], values[i]);
   }
+  std::atomic_store(&m_columns, {});
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
@@ -1323,6 +1372,7 @@ TimeSeriesProperty<TYPE>::setDataItem(const boost::shared_ptr<DataItem>) {
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
   m_values.clear();
+  std::atomic_store(&m_columns, {});
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1915,6 +1965,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  std::atomic_store(&m_columns, {});
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved
@@ -1958,9 +2009,48 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
         "TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+    std::atomic_store(&m_columns, {});
   }
 }
 
+/** The sorted values in columns with block summaries, built on first use.
+ * Short series are scanned directly, so they are not copied into columns.
+ * Concurrent const queries may ask for the columns at the same time, so the
+ * build is serialised and the pointer is published atomically.
+ * @return the columns, or nullptr for a series shorter than
+ * MIN_SIZE_FOR_COLUMNS
+ */
+template <typename TYPE>
+std::shared_ptr<const TimeSeriesColumns<TYPE>>
+TimeSeriesProperty<TYPE>::columns() const {
+  if (m_values.size() < MIN_SIZE_FOR_COLUMNS)
+    return nullptr;
+  auto series = std::atomic_load(&m_columns);
+  if (series)
+    return series;
+
+  std::lock_guard<std::mutex> lock(g_columnsMutex);
+  series = std::atomic_load(&m_columns);
+  if (!series) {
+    sortIfNecessary();
+    auto built = std::make_shared<TimeSeriesColumns<TYPE>>();
+    built->reserve(m_values.size());
+    for (const auto &entry : m_values)
+      built->append(entry.time().totalNanoseconds(), entry.value());
+    series = built;
+    std::atomic_store(&m_columns, series);
+  }
+  return series;
+}
+
+/// Function specialization for TimeSeriesProperty<std::string>: strings are
+/// not summarised
+template <>
+std::shared_ptr<const TimeSeriesColumns<std::string>>
+TimeSeriesProperty<std::string>::columns() const {
+  return nullptr;
+}
+
 /** Find the index of the entry of time t in the mP vector (sorted)
  *  Return @ if t is within log.begin and log.end, then the index of the log
  * equal or just smaller than t
@@ -2210,6 +2300,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  std::atomic_store(&m_columns, std::atomic_load(&prop->m_columns));
   return "";
 }
 
@@ -5,7 +5,9 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 
 namespace Mantid {
 namespace Kernel {
@@ -138,9 +140,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                  const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->multipleToTOF(xdata.data(), xdata.data(), xdata.size());
 }
 
 /** Convert a single value to TOF
@@ -169,9 +169,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                    const double &_efixed, const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->multipleFromTOF(xdata.data(), xdata.data(), xdata.size());
 }
 
 /** Convert a single value from TOF
@@ -198,6 +196,86 @@ std::pair<double, double> Unit::conversionRange() const {
   return std::pair<double, double>(std::min(u1, u2), std::max(u1, u2));
 }
 
+//---------------------------------------------------------------------------------------
+/** Convert many X values to TOF, one at a time
+ * @param x :: the values to convert
+ * @param tof :: the converted values, may be the same array as x
+ * @param count :: the number of values
+ */
+void Unit::multipleToTOF(const double *x, double *tof,
+                         const size_t count) const {
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = this->singleToTOF(x[i]);
+}
+
+/** Convert many TOF values to this unit, one at a time
+ * @param tof :: the values to convert
+ * @param x :: the converted values, may be the same array as tof
+ * @param count :: the number of values
+ */
+void Unit::multipleFromTOF(const double *tof, double *x,
+                           const size_t count) const {
+  for (size_t i = 0; i < count; ++i)
+    x[i] = this->singleFromTOF(tof[i]);
+}
+
+/// @return false: by default, no simple relation to TOF is known
+bool Unit::getTOFRelation(double &factor, double &power,
+                          double &offset) const {
+  UNUSED_ARG(factor);
+  UNUSED_ARG(power);
+  UNUSED_ARG(offset);
+  return false;
+}
+
+/** Convert many values from this unit to another one. Both units must be
+ * initialized. If both units have a relation to TOF, and the composition of
+ * the relations is a power law or an affine function, the values are
+ * converted directly; otherwise they go through TOF.
+ * @param destination :: the unit to convert to
+ * @param values :: the values to convert
+ * @param converted :: the converted values, may be the same array as values
+ * @param count :: the number of values
+ */
+void Unit::convertTo(const Unit &destination, const double *values,
+                     double *converted, const size_t count) const {
+  double factorFrom, powerFrom, offsetFrom;
+  double factorTo, powerTo, offsetTo;
+  if (this->getTOFRelation(factorFrom, powerFrom, offsetFrom) &&
+      destination.getTOFRelation(factorTo, powerTo, offsetTo)) {
+    if (offsetFrom == offsetTo) {
+      // converted = (factorFrom / factorTo)^(1/powerTo) *
+      //             values^(powerFrom/powerTo)
+      const double factor = std::pow(factorFrom / factorTo, 1.0 / powerTo);
+      const double power = powerFrom / powerTo;
+      // The units with a negative power protect against dividing by zero
+      const double zero = powerFrom < 0.0 ? DBL_MIN : 0.0;
+      if (power == 1.0) {
+        for (size_t i = 0; i < count; ++i)
+          converted[i] = factor * values[i];
+      } else if (power == -1.0) {
+        for (size_t i = 0; i < count; ++i)
+          converted[i] = factor / (values[i] == 0.0 ? zero : values[i]);
+      } else {
+        for (size_t i = 0; i < count; ++i)
+          converted[i] =
+              factor * std::pow(values[i] == 0.0 ? zero : values[i], power);
+      }
+      return;
+    }
+    if (powerFrom == 1.0 && powerTo == 1.0) {
+      // converted = (factorFrom * values + offsetFrom - offsetTo) / factorTo
+      const double factor = factorFrom / factorTo;
+      const double offset = (offsetFrom - offsetTo) / factorTo;
+      for (size_t i = 0; i < count; ++i)
+        converted[i] = factor * values[i] + offset;
+      return;
+    }
+  }
+  this->multipleToTOF(values, converted, count);
+  destination.multipleFromTOF(converted, converted, count);
+}
+
 namespace Units {
 
 /* =============================================================================
@@ -287,6 +365,25 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+void TOF::multipleToTOF(const double *x, double *tof,
+                        const size_t count) const {
+  if (tof != x)
+    std::copy(x, x + count, tof);
+}
+
+void TOF::multipleFromTOF(const double *tof, double *x,
+                          const size_t count) const {
+  if (x != tof)
+    std::copy(tof, tof + count, x);
+}
+
+bool TOF::getTOFRelation(double &factor, double &power, double &offset) const {
+  factor = 1.0;
+  power = 1.0;
+  offset = 0.0;
+  return true;
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -415,6 +512,33 @@ double Wavelength::conversionTOFMax() const {
   return max_tof;
 }
 
+void Wavelength::multipleToTOF(const double *x, double *tof,
+                               const size_t count) const {
+  // If Direct or Indirect we want to correct TOF values..
+  const double shift = (emode == 1 || emode == 2) ? sfpTo : 0.0;
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = x[i] * factorTo + shift;
+}
+
+void Wavelength::multipleFromTOF(const double *tof, double *x,
+                                 const size_t count) const {
+  const double shift = do_sfpFrom ? sfpFrom : 0.0;
+  for (size_t i = 0; i < count; ++i)
+    x[i] = (tof[i] - shift) * factorFrom;
+}
+
+/// The relation is linear, offset by the fixed energy path in inelastic modes
+bool Wavelength::getTOFRelation(double &factor, double &power,
+                                double &offset) const {
+  // The to and from conversions only agree in these cases
+  if (factorTo == 0.0 || !(emode == 0 || do_sfpFrom))
+    return false;
+  factor = factorTo;
+  power = 1.0;
+  offset = emode == 0 ? 0.0 : sfpTo;
+  return true;
+}
+
 Unit *Wavelength::clone() const { return new Wavelength(*this); }
 
 // ============================================================================================
@@ -471,6 +595,34 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy::multipleToTOF(const double *x, double *tof,
+                           const size_t count) const {
+  for (size_t i = 0; i < count; ++i) {
+    // Protect against divide by zero
+    const double temp = x[i] == 0.0 ? DBL_MIN : x[i];
+    tof[i] = factorTo / sqrt(temp);
+  }
+}
+
+void Energy::multipleFromTOF(const double *tof, double *x,
+                             const size_t count) const {
+  for (size_t i = 0; i < count; ++i) {
+    // Protect against divide by zero
+    const double temp = tof[i] == 0.0 ? DBL_MIN : tof[i];
+    x[i] = factorFrom / (temp * temp);
+  }
+}
+
+bool Energy::getTOFRelation(double &factor, double &power,
+                            double &offset) const {
+  if (factorTo == 0.0)
+    return false;
+  factor = factorTo;
+  power = -0.5;
+  offset = 0.0;
+  return true;
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -580,6 +732,28 @@ double dSpacing::singleFromTOF(const double tof) const {
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
+void dSpacing::multipleToTOF(const double *x, double *tof,
+                             const size_t count) const {
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = x[i] * factorTo;
+}
+
+void dSpacing::multipleFromTOF(const double *tof, double *x,
+                               const size_t count) const {
+  for (size_t i = 0; i < count; ++i)
+    x[i] = tof[i] / factorFrom;
+}
+
+bool dSpacing::getTOFRelation(double &factor, double &power,
+                              double &offset) const {
+  if (factorTo == 0.0)
+    return false;
+  factor = factorTo;
+  power = 1.0;
+  offset = 0.0;
+  return true;
+}
+
 Unit *dSpacing::clone() const { return new dSpacing(*this); }
 
 // ==================================================================================================
@@ -693,6 +867,34 @@ double MomentumTransfer::conversionTOFMin() const {
 }
 double MomentumTransfer::conversionTOFMax() const { return DBL_MAX; }
 
+void MomentumTransfer::multipleToTOF(const double *x, double *tof,
+                                     const size_t count) const {
+  for (size_t i = 0; i < count; ++i) {
+    // Protect against divide by zero
+    const double temp = x[i] == 0.0 ? DBL_MIN : x[i];
+    tof[i] = factorTo / temp;
+  }
+}
+
+void MomentumTransfer::multipleFromTOF(const double *tof, double *x,
+                                       const size_t count) const {
+  for (size_t i = 0; i < count; ++i) {
+    // Protect against divide by zero
+    const double temp = tof[i] == 0.0 ? DBL_MIN : tof[i];
+    x[i] = factorFrom / temp;
+  }
+}
+
+bool MomentumTransfer::getTOFRelation(double &factor, double &power,
+                                      double &offset) const {
+  if (factorTo == 0.0)
+    return false;
+  factor = factorTo;
+  power = -1.0;
+  offset = 0.0;
+  return true;
+}
+
 Unit *MomentumTransfer::clone() const { return new MomentumTransfer(*this); }
 
 /* ===================================================================================================
@@ -877,6 +1079,45 @@ double DeltaE::conversionTOFMax() const {
     return t_otherFrom + sqrt(factorFrom) / sqrt(DBL_MIN);
 }
 
+void DeltaE::multipleToTOF(const double *x, double *tof,
+                           const size_t count) const {
+  const double tofMax = DeltaE::conversionTOFMax();
+  if (emode == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      const double e2 = efixed - x[i] / unitScaling;
+      tof[i] = e2 <= 0.0 ? tofMax : factorTo / sqrt(e2) + t_other;
+    }
+  } else if (emode == 2) {
+    for (size_t i = 0; i < count; ++i) {
+      const double e1 = efixed + x[i] / unitScaling;
+      tof[i] = e1 <= 0.0 ? tofMax : factorTo / sqrt(e1) + t_other;
+    }
+  } else {
+    std::fill(tof, tof + count, tofMax);
+  }
+}
+
+void DeltaE::multipleFromTOF(const double *tof, double *x,
+                             const size_t count) const {
+  if (emode == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      const double this_t = tof[i] - t_otherFrom;
+      x[i] = this_t <= 0.0
+                 ? -DBL_MAX
+                 : (efixed - factorFrom / (this_t * this_t)) * unitScaling;
+    }
+  } else if (emode == 2) {
+    for (size_t i = 0; i < count; ++i) {
+      const double this_t = tof[i] - t_otherFrom;
+      x[i] = this_t <= 0.0
+                 ? DBL_MAX
+                 : (factorFrom / (this_t * this_t) - efixed) * unitScaling;
+    }
+  } else {
+    std::fill(x, x + count, DBL_MAX);
+  }
+}
+
 Unit *DeltaE::clone() const { return new DeltaE(*this); }
 
 // =====================================================================================================
@@ -1114,6 +1355,22 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// The batched conversions of Wavelength do not apply: convert value by value
+void SpinEchoLength::multipleToTOF(const double *x, double *tof,
+                                   const size_t count) const {
+  Unit::multipleToTOF(x, tof, count);
+}
+
+void SpinEchoLength::multipleFromTOF(const double *tof, double *x,
+                                     const size_t count) const {
+  Unit::multipleFromTOF(tof, x, count);
+}
+
+bool SpinEchoLength::getTOFRelation(double &factor, double &power,
+                                    double &offset) const {
+  return Unit::getTOFRelation(factor, power, offset);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1159,6 +1416,22 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// The batched conversions of Wavelength do not apply: convert value by value
+void SpinEchoTime::multipleToTOF(const double *x, double *tof,
+                                 const size_t count) const {
+  Unit::multipleToTOF(x, tof, count);
+}
+
+void SpinEchoTime::multipleFromTOF(const double *tof, double *x,
+                                   const size_t count) const {
+  Unit::multipleFromTOF(tof, x, count);
+}
+
+bool SpinEchoTime::getTOFRelation(double &factor, double &power,
+                                  double &offset) const {
+  return Unit::getTOFRelation(factor, power, offset);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
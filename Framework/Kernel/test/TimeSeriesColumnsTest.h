@@ -0,0 +1,258 @@
+#ifndef MANTID_KERNEL_TIMESERIESCOLUMNSTEST_H_
+#define MANTID_KERNEL_TIMESERIESCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/TimeSeriesColumns.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using Mantid::Kernel::TimeSeriesColumns;
+
+namespace {
+/// One second in nanoseconds
+const int64_t SECOND = 1000000000;
+/// A start time, in nanoseconds
+const int64_t START = 1000 * SECOND;
+
+/// Time integral of a series by walking through all its samples
+double bruteForceIntegral(const std::vector<int64_t> &times,
+                          const std::vector<double> &values,
+                          const int64_t start, const int64_t stop) {
+  auto valueAt = [&](const int64_t time) {
+    const size_t n = std::distance(
+        times.begin(), std::upper_bound(times.begin(), times.end(), time));
+    return n == 0 ? values.front() : values[n - 1];
+  };
+  double integral = 0.;
+  int64_t from = start;
+  double value = valueAt(start);
+  for (size_t i = std::distance(times.begin(), std::upper_bound(times.begin(),
+                                                                times.end(),
+                                                                start));
+       i < times.size() && times[i] < stop; ++i) {
+    integral += value * static_cast<double>(times[i] - from) * 1e-9;
+    from = times[i];
+    value = values[i];
+  }
+  return integral + value * static_cast<double>(stop - from) * 1e-9;
+}
+} // namespace
+
+class TimeSeriesColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TimeSeriesColumnsTest *createSuite() {
+    return new TimeSeriesColumnsTest();
+  }
+  static void destroySuite(TimeSeriesColumnsTest *suite) { delete suite; }
+
+  void setUp() override {
+    std::mt19937_64 generator(1234);
+    std::uniform_int_distribution<int64_t> steps(0, 5 * SECOND);
+    std::uniform_int_distribution<int> levels(0, 99);
+    m_times.clear();
+    m_values.clear();
+    m_columns.clear();
+    int64_t time = START;
+    for (size_t i = 0; i < 2000; ++i) {
+      // Some repeated times
+      if (i % 7 != 0)
+        time += steps(generator);
+      m_times.push_back(time);
+      m_values.push_back(static_cast<double>(levels(generator)));
+      m_columns.append(time, m_values.back());
+    }
+  }
+
+  void test_empty() {
+    TimeSeriesColumns<double> columns;
+    TS_ASSERT(columns.empty());
+    TS_ASSERT_EQUALS(columns.size(), 0);
+    TS_ASSERT_EQUALS(columns.upperBound(START), 0);
+    TS_ASSERT(std::isnan(columns.timeAverage(START, START + SECOND)));
+    TS_ASSERT(columns.findValueRanges(0., 1.).empty());
+  }
+
+  void test_times_and_values_round_trip() {
+    TS_ASSERT_EQUALS(m_columns.size(), m_times.size());
+    TS_ASSERT_EQUALS(m_columns.numberOfBlocks(),
+                     (m_times.size() + TimeSeriesColumns<double>::BLOCK_SIZE -
+                      1) /
+                         TimeSeriesColumns<double>::BLOCK_SIZE);
+    TS_ASSERT_EQUALS(m_columns.times(), m_times);
+    TS_ASSERT_EQUALS(m_columns.values(), m_values);
+    for (size_t i = 0; i < m_times.size(); i += 13) {
+      TS_ASSERT_EQUALS(m_columns.time(i), m_times[i]);
+      TS_ASSERT_EQUALS(m_columns.value(i), m_values[i]);
+    }
+  }
+
+  void test_times_are_compressed() {
+    // A log recorded at 1 kHz: the time steps take 3 bytes instead of 8
+    TimeSeriesColumns<double> columns;
+    const size_t numSamples = 10000;
+    columns.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+      columns.append(START + static_cast<int64_t>(i) * SECOND / 1000, 1.0);
+    TS_ASSERT_LESS_THAN(columns.getMemorySize(),
+                        numSamples * (sizeof(double) + 4));
+  }
+
+  void test_append_out_of_order_throws() {
+    TS_ASSERT_THROWS(m_columns.append(START, 1.0), std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(m_columns.append(m_times.back(), 1.0));
+  }
+
+  void test_upperBound() {
+    TS_ASSERT_EQUALS(m_columns.upperBound(START - 1), 0);
+    TS_ASSERT_EQUALS(m_columns.upperBound(m_times.back()), m_times.size());
+    for (size_t i = 0; i < m_times.size(); i += 11) {
+      for (int64_t offset : {int64_t(-1), int64_t(0), int64_t(1)}) {
+        const int64_t time = m_times[i] + offset;
+        TS_ASSERT_EQUALS(
+            m_columns.upperBound(time),
+            std::distance(m_times.begin(), std::upper_bound(m_times.begin(),
+                                                            m_times.end(),
+                                                            time)));
+      }
+    }
+  }
+
+  void test_block_summaries() {
+    const size_t blockSize = TimeSeriesColumns<double>::BLOCK_SIZE;
+    for (size_t block = 0; block < m_columns.numberOfBlocks(); ++block) {
+      const auto first = m_values.begin() + block * blockSize;
+      const auto last = m_values.begin() +
+                        std::min(m_values.size(), (block + 1) * blockSize);
+      const auto &summary = m_columns.block(block);
+      TS_ASSERT_EQUALS(summary.minimum, *std::min_element(first, last));
+      TS_ASSERT_EQUALS(summary.maximum, *std::max_element(first, last));
+      TS_ASSERT_EQUALS(summary.firstTime, m_times[block * blockSize]);
+    }
+  }
+
+  void test_timeIntegral_matches_walk_through_samples() {
+    const int64_t end = m_times.back();
+    const std::vector<std::pair<int64_t, int64_t>> windows{
+        {START, end},
+        {START - 10 * SECOND, START + 3 * SECOND},
+        {m_times[300], m_times[1700]},
+        {m_times[300] + 1, m_times[1700] - 1},
+        {m_times[500] + SECOND / 2, m_times[510]},
+        {end - SECOND, end + 100 * SECOND}};
+    for (const auto &window : windows) {
+      const double expected =
+          bruteForceIntegral(m_times, m_values, window.first, window.second);
+      TS_ASSERT_DELTA(m_columns.timeIntegral(window.first, window.second),
+                      expected, 1e-9 * std::abs(expected) + 1e-9);
+    }
+  }
+
+  void test_timeAverage_of_constant_steps() {
+    TimeSeriesColumns<int> columns;
+    // 10s at 1, 10s at 3
+    columns.append(START, 1);
+    columns.append(START + 10 * SECOND, 3);
+    TS_ASSERT_DELTA(columns.timeAverage(START, START + 20 * SECOND), 2.0,
+                    1e-12);
+    // The first value holds before the first time
+    TS_ASSERT_DELTA(columns.timeAverage(START - 10 * SECOND, START), 1.0,
+                    1e-12);
+    TS_ASSERT(std::isnan(columns.timeAverage(START, START)));
+  }
+
+  void test_findValueRanges() {
+    const double minValue = 20.;
+    const double maxValue = 60.;
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t i = 0; i < m_values.size(); ++i) {
+      if (m_values[i] < minValue || m_values[i] > maxValue)
+        continue;
+      if (!expected.empty() && expected.back().second == i)
+        expected.back().second = i + 1;
+      else
+        expected.emplace_back(i, i + 1);
+    }
+    TS_ASSERT_EQUALS(m_columns.findValueRanges(minValue, maxValue), expected);
+  }
+
+  void test_findValueRanges_whole_blocks() {
+    TimeSeriesColumns<double> columns;
+    for (size_t i = 0; i < 1000; ++i)
+      columns.append(START + static_cast<int64_t>(i) * SECOND,
+                     i < 600 ? 1.0 : 5.0);
+    auto ranges = columns.findValueRanges(0.5, 1.5);
+    TS_ASSERT_EQUALS(ranges.size(), 1);
+    TS_ASSERT_EQUALS(ranges[0], std::make_pair(size_t(0), size_t(600)));
+    ranges = columns.findValueRanges(4.0, 6.0);
+    TS_ASSERT_EQUALS(ranges.size(), 1);
+    TS_ASSERT_EQUALS(ranges[0], std::make_pair(size_t(600), size_t(1000)));
+    TS_ASSERT(columns.findValueRanges(2.0, 3.0).empty());
+  }
+
+  void test_findValueRanges_skips_nan() {
+    TimeSeriesColumns<double> columns;
+    for (size_t i = 0; i < 10; ++i)
+      columns.append(START + static_cast<int64_t>(i) * SECOND,
+                     i == 4 ? std::nan("") : 1.0);
+    const auto ranges = columns.findValueRanges(0.0, 2.0);
+    TS_ASSERT_EQUALS(ranges.size(), 2);
+    TS_ASSERT_EQUALS(ranges[0], std::make_pair(size_t(0), size_t(4)));
+    TS_ASSERT_EQUALS(ranges[1], std::make_pair(size_t(5), size_t(10)));
+  }
+
+  void test_clear() {
+    m_columns.clear();
+    TS_ASSERT(m_columns.empty());
+    TS_ASSERT_EQUALS(m_columns.numberOfBlocks(), 0);
+    TS_ASSERT_THROWS_NOTHING(m_columns.append(START, 1.0));
+    TS_ASSERT_EQUALS(m_columns.time(0), START);
+  }
+
+private:
+  std::vector<int64_t> m_times;
+  std::vector<double> m_values;
+  TimeSeriesColumns<double> m_columns;
+};
+
+/** Time averages and value filters of a 10 hour log recorded at 1 kHz */
+class TimeSeriesColumnsTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TimeSeriesColumnsTestPerformance *createSuite() {
+    return new TimeSeriesColumnsTestPerformance();
+  }
+  static void destroySuite(TimeSeriesColumnsTestPerformance *suite) {
+    delete suite;
+  }
+
+  TimeSeriesColumnsTestPerformance() {
+    const size_t numSamples = 36000000;
+    m_columns.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+      m_columns.append(START + static_cast<int64_t>(i) * SECOND / 1000,
+                       300.0 + std::sin(static_cast<double>(i) * 1e-5));
+  }
+
+  void test_timeAverage_of_many_windows() {
+    for (int64_t window = 0; window < 36000; ++window)
+      m_columns.timeAverage(START + window * SECOND,
+                            START + (window + 1) * SECOND);
+  }
+
+  void test_timeAverage_of_whole_log() {
+    m_columns.timeAverage(START, START + 36000 * SECOND);
+  }
+
+  void test_findValueRanges() { m_columns.findValueRanges(299.5, 300.5); }
+
+private:
+  TimeSeriesColumns<double> m_columns;
+};
+
+#endif /* MANTID_KERNEL_TIMESERIESCOLUMNSTEST_H_ */
@@ -40,6 +40,18 @@ class TimeSeriesPropertyTest : public CxxTest::TestSuite {
     return log;
   }
 
+  // Create a TSP<double> of 3000 values 1s apart, stepping through 0, 1 and 2
+  // every 100s.
+  std::unique_ptr<TimeSeriesProperty<double>> createLongSteppedTSP() {
+    auto log = Mantid::Kernel::make_unique<TimeSeriesProperty<double>>(
+        "steppedProp");
+    DateAndTime startTime("2007-11-30T16:17:00");
+    for (int i = 0; i < 3000; ++i)
+      log->addValue(startTime + static_cast<double>(i),
+                    static_cast<double>((i / 100) % 3));
+    return log;
+  }
+
 public:
   void setUp() override {
     iProp = new TimeSeriesProperty<int>("intProp");
@@ -460,6 +472,27 @@ public:
     delete log;
   }
 
+  void test_makeFilterByValue_long_log() {
+    // Long enough for the block summaries to be used
+    auto log = createLongSteppedTSP();
+    TimeSplitterType splitter;
+    log->makeFilterByValue(splitter, 0.5, 1.5, 0.0, false);
+
+    TS_ASSERT_EQUALS(splitter.size(), 10);
+    const DateAndTime start("2007-11-30T16:17:00");
+    TS_ASSERT_DELTA(splitter[0].start(), start + 100.0, 1e-3);
+    TS_ASSERT_DELTA(splitter[0].stop(), start + 200.0, 1e-3);
+    TS_ASSERT_DELTA(splitter[9].start(), start + 2800.0, 1e-3);
+    TS_ASSERT_DELTA(splitter[9].stop(), start + 2900.0, 1e-3);
+
+    // Ending on a good value, with centred boundaries
+    log->makeFilterByValue(splitter, 1.5, 2.5, 1.0, true);
+    TS_ASSERT_EQUALS(splitter.size(), 10);
+    TS_ASSERT_DELTA(splitter[0].start(), start + 199.0, 1e-3);
+    TS_ASSERT_DELTA(splitter[0].stop(), start + 300.0, 1e-3);
+    TS_ASSERT_DELTA(splitter[9].stop(), start + 3000.0, 1e-3);
+  }
+
   void test_makeFilterByValue_throws_for_string_property() {
     TimeSeriesProperty<std::string> log("StringTSP");
     TimeSplitterType splitter;
@@ -609,6 +642,49 @@ public:
     delete intLog;
   }
 
+  void test_filterByTime_long_log() {
+    auto log = createLongSteppedTSP();
+    auto unindexed = createLongSteppedTSP();
+    const DateAndTime start("2007-11-30T16:17:00");
+    // Build the block summaries so that the cuts are found from them
+    TimeSplitterType filter;
+    filter.push_back(SplittingInterval(start, start + 3000.0));
+    log->averageValueInFilter(filter);
+
+    // Start between two logs, stop on a log
+    log->filterByTime(start + 100.5, start + 2500.0);
+    unindexed->filterByTime(start + 100.5, start + 2500.0);
+    TS_ASSERT_EQUALS(log->realSize(), 2400);
+    TS_ASSERT_EQUALS(log->firstTime(), start + 100.5);
+    TS_ASSERT_EQUALS(log->lastTime(), start + 2499.0);
+    TS_ASSERT_EQUALS(log->timesAsVector(), unindexed->timesAsVector());
+    TS_ASSERT_EQUALS(log->valuesAsVector(), unindexed->valuesAsVector());
+
+    // The summaries are rebuilt for the filtered values
+    filter.clear();
+    filter.push_back(SplittingInterval(start + 100.5, start + 200.5));
+    TS_ASSERT_DELTA(log->averageValueInFilter(filter), 1.005, 1e-9);
+  }
+
+  void test_averageValueInFilter_long_log() {
+    auto log = createLongSteppedTSP();
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSplitterType filter;
+    // 50s of 0, 100s of 1, 100s of 2 and 50s of 0
+    filter.push_back(SplittingInterval(start + 50.0, start + 350.0));
+    TS_ASSERT_DELTA(log->averageValueInFilter(filter), 1.0, 1e-9);
+    // Before the first value and after the last one
+    filter.push_back(SplittingInterval(start - 100.0, start));
+    filter.push_back(SplittingInterval(start + 3100.0, start + 3200.0));
+    TS_ASSERT_DELTA(log->averageValueInFilter(filter), 1.0, 1e-9);
+
+    // Changing the log drops the summaries
+    log->addValue(start + 3000.0, 10.0);
+    filter.clear();
+    filter.push_back(SplittingInterval(start + 2950.0, start + 3050.0));
+    TS_ASSERT_DELTA(log->averageValueInFilter(filter), 6.0, 1e-9);
+  }
+
   void test_timeAverageValue() {
     auto dblLog = createDoubleTSP();
     auto intLog = createIntegerTSP(5);
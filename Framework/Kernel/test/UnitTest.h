@@ -122,6 +122,21 @@ class UnitTest : public CxxTest::TestSuite {
     Unit *clone() const override { return new UnitTester(); }
   };
 
+  /// @return a new unit of the given type
+  static Unit_sptr makeUnit(const std::string &unitID) {
+    if (unitID == "TOF")
+      return Unit_sptr(new TOF);
+    if (unitID == "Wavelength")
+      return Unit_sptr(new Wavelength);
+    if (unitID == "Energy")
+      return Unit_sptr(new Energy);
+    if (unitID == "dSpacing")
+      return Unit_sptr(new dSpacing);
+    if (unitID == "MomentumTransfer")
+      return Unit_sptr(new MomentumTransfer);
+    return Unit_sptr(new DeltaE);
+  }
+
 public:
   //----------------------------------------------------------------------
   // Label tests
@@ -1384,6 +1399,101 @@ public:
     }
   }
 
+  //----------------------------------------------------------------------
+  // Batched conversion tests
+  //----------------------------------------------------------------------
+
+  void test_multiple_conversions_match_single_ones() {
+    const std::vector<double> values = {0.0, 0.5, 1.5, 3.0, 250.0, 12000.0};
+    for (const int emode : {0, 1, 2}) {
+      std::vector<Unit_sptr> units = {
+          Unit_sptr(new TOF), Unit_sptr(new Wavelength),
+          Unit_sptr(new Energy), Unit_sptr(new dSpacing),
+          Unit_sptr(new MomentumTransfer), Unit_sptr(new QSquared)};
+      if (emode == 0) {
+        units.emplace_back(new SpinEchoLength);
+        units.emplace_back(new SpinEchoTime);
+      } else {
+        units.emplace_back(new DeltaE);
+        units.emplace_back(new DeltaE_inWavenumber);
+      }
+      for (const auto &unit : units) {
+        unit->initialize(10.0, 1.1, 1.1, emode, 12.0, 0.0);
+        std::vector<double> tofs(values.size());
+        unit->multipleToTOF(values.data(), tofs.data(), values.size());
+        std::vector<double> xs(values.size());
+        unit->multipleFromTOF(values.data(), xs.data(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+          const double tof = unit->singleToTOF(values[i]);
+          TSM_ASSERT_DELTA(unit->unitID(), tofs[i], tof, 1e-12 * fabs(tof));
+          const double x = unit->singleFromTOF(values[i]);
+          TSM_ASSERT_DELTA(unit->unitID(), xs[i], x, 1e-12 * fabs(x));
+        }
+      }
+    }
+  }
+
+  void test_multiple_conversions_in_place() {
+    Units::dSpacing unit;
+    unit.initialize(10.0, 1.1, 1.1, 0, 0.0, 0.0);
+    std::vector<double> values = {0.5, 1.0, 2.0};
+    unit.multipleToTOF(values.data(), values.data(), values.size());
+    TS_ASSERT_DELTA(values[1], unit.singleToTOF(1.0), 1e-9);
+    unit.multipleFromTOF(values.data(), values.data(), values.size());
+    TS_ASSERT_DELTA(values[2], 2.0, 1e-12);
+  }
+
+  void test_getTOFRelation() {
+    double factor, power, offset;
+    Units::Wavelength wavelength;
+    wavelength.initialize(10.0, 1.1, 1.1, 0, 0.0, 0.0);
+    TS_ASSERT(wavelength.getTOFRelation(factor, power, offset));
+    TS_ASSERT_DELTA(factor, wavelength.singleToTOF(1.0), 1e-9);
+    TS_ASSERT_EQUALS(power, 1.0);
+    TS_ASSERT_EQUALS(offset, 0.0);
+    wavelength.initialize(10.0, 1.1, 1.1, 1, 12.0, 0.0);
+    TS_ASSERT(wavelength.getTOFRelation(factor, power, offset));
+    TS_ASSERT_DELTA(offset, wavelength.singleToTOF(0.0), 1e-9);
+
+    Units::Energy energy;
+    energy.initialize(10.0, 1.1, 1.1, 0, 0.0, 0.0);
+    TS_ASSERT(energy.getTOFRelation(factor, power, offset));
+    TS_ASSERT_EQUALS(power, -0.5);
+
+    // No simple relation
+    Units::dSpacing dspacing;
+    dspacing.initialize(10.0, 1.1, 0.0, 0, 0.0, 0.0);
+    TS_ASSERT(!dspacing.getTOFRelation(factor, power, offset));
+    Units::DeltaE deltaE;
+    deltaE.initialize(10.0, 1.1, 1.1, 1, 12.0, 0.0);
+    TS_ASSERT(!deltaE.getTOFRelation(factor, power, offset));
+    Units::SpinEchoLength spinEcho;
+    spinEcho.initialize(10.0, 1.1, 1.1, 0, 12.0, 0.0);
+    TS_ASSERT(!spinEcho.getTOFRelation(factor, power, offset));
+  }
+
+  void test_convertTo_matches_conversion_via_TOF() {
+    const std::vector<double> values = {0.0, 0.5, 1.5, 3.0, 250.0};
+    // Linear, affine, power law and via TOF
+    const std::vector<std::pair<std::string, std::string>> pairs = {
+        {"dSpacing", "Wavelength"}, {"Wavelength", "dSpacing"},
+        {"Energy", "dSpacing"},     {"MomentumTransfer", "Energy"},
+        {"TOF", "dSpacing"},        {"DeltaE", "dSpacing"}};
+    for (const auto &pair : pairs) {
+      Unit_sptr from = makeUnit(pair.first);
+      Unit_sptr to = makeUnit(pair.second);
+      from->initialize(10.0, 1.1, 1.1, 1, 12.0, 0.0);
+      to->initialize(10.0, 1.1, 1.1, 1, 12.0, 0.0);
+      std::vector<double> converted(values.size());
+      from->convertTo(*to, values.data(), converted.data(), values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        const double expected = to->singleFromTOF(from->singleToTOF(values[i]));
+        TSM_ASSERT_DELTA(pair.first + " to " + pair.second, converted[i],
+                         expected, 1e-9 * fabs(expected));
+      }
+    }
+  }
+
   /// Test unit Degress
   void testDegress() {
     TS_ASSERT_EQUALS(degrees.caption(), "Scattering angle");
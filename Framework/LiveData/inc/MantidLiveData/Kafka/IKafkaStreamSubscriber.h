@@ -2,6 +2,8 @@
 #define MANTID_LIVEDATA_IKAFKASTREAMSUBSCRIBER_H_
 
 #include "MantidKernel/System.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -19,6 +21,34 @@ enum class SubscribeAtOption {
   TIME
 };
 
+/**
+  A read-only view of the payload of a message consumed from a stream. The
+  payload is owned by the message and stays valid for as long as the message
+  is alive, so it can be decoded in place without being copied first.
+*/
+class DLLExport KafkaMessage {
+public:
+  virtual ~KafkaMessage() = default;
+  virtual const uint8_t *payload() const = 0;
+  virtual size_t size() const = 0;
+  bool empty() const { return size() == 0; }
+};
+using KafkaMessage_const_sptr = std::shared_ptr<const KafkaMessage>;
+
+/// A KafkaMessage owning a copy of its payload
+class DLLExport KafkaStringMessage : public KafkaMessage {
+public:
+  explicit KafkaStringMessage(std::string payload)
+      : m_payload(std::move(payload)) {}
+  const uint8_t *payload() const override {
+    return reinterpret_cast<const uint8_t *>(m_payload.data());
+  }
+  size_t size() const override { return m_payload.size(); }
+
+private:
+  std::string m_payload;
+};
+
 /**
   Interface for classes that subscribe to Kafka streams.
 
@@ -50,6 +80,19 @@ public:
   virtual void subscribe(int64_t offset) = 0;
   virtual void consumeMessage(std::string *message, int64_t &offset,
                               int32_t &partition, std::string &topic) = 0;
+  /**
+   * Consume a message without copying its payload. The default
+   * implementation copies the payload from consumeMessage(), implementations
+   * that can hand out their receive buffer should override it.
+   * @return The message. It is empty if no message was available
+   */
+  virtual KafkaMessage_const_sptr consumeMessageView(int64_t &offset,
+                                                     int32_t &partition,
+                                                     std::string &topic) {
+    std::string buffer;
+    consumeMessage(&buffer, offset, partition, topic);
+    return std::make_shared<KafkaStringMessage>(std::move(buffer));
+  }
   virtual std::unordered_map<std::string, std::vector<int64_t>>
   getOffsetsForTimestamp(int64_t timestamp) = 0;
   virtual void seek(const std::string &topic, uint32_t partition,
@@ -107,8 +107,12 @@ private:
   int64_t getRunInfoMessage(std::string &rawMsgBuffer);
   RunStartStruct getRunStartMessage(std::string &rawMsgBuffer);
 
-  void eventDataFromMessage(const std::string &buffer);
-  void sampleDataFromMessage(const std::string &buffer);
+  void eventDataFromMessage(const uint8_t *buffer);
+  void sampleDataFromMessage(const uint8_t *buffer);
+  void stageEvents(const uint32_t *tofData, const uint32_t *detData,
+                   const size_t nEvents,
+                   const Types::Core::DateAndTime &pulseTime);
+  void appendStagedEvents(DataObjects::EventWorkspace &periodBuffer);
 
   API::Workspace_sptr extractDataImpl();
 
@@ -127,6 +131,19 @@ private:
   std::vector<DataObjects::EventWorkspace_sptr> m_localEvents;
   /// Mapping of spectrum number to workspace index.
   spec2index_map m_specToIdx;
+  /// Raw times-of-flight of the message being decoded, grouped by workspace
+  /// index
+  std::vector<uint32_t> m_stagedTofs;
+  /// Pulse time of the message being decoded
+  Types::Core::DateAndTime m_stagedPulseTime;
+  /// Workspace index of each event of the message being decoded
+  std::vector<size_t> m_stagedIndices;
+  /// Number of staged events for each workspace index
+  std::vector<size_t> m_stagedCounts;
+  /// One past the last staged event for each workspace index
+  std::vector<size_t> m_stagedEnds;
+  /// Workspace indices that have staged events
+  std::vector<size_t> m_stagedSpectra;
   /// Start time of the run
   Types::Core::DateAndTime m_runStart;
   /// Subscriber for the run info stream
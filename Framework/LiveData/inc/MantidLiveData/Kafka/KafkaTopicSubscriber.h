@@ -51,6 +51,9 @@ public:
   void subscribe(int64_t offset) override;
   void consumeMessage(std::string *payload, int64_t &offset, int32_t &partition,
                       std::string &topic) override;
+  KafkaMessage_const_sptr consumeMessageView(int64_t &offset,
+                                             int32_t &partition,
+                                             std::string &topic) override;
   std::unordered_map<std::string, std::vector<int64_t>>
   getOffsetsForTimestamp(int64_t timestamp) override;
   void seek(const std::string &topic, uint32_t partition,
@@ -71,6 +74,9 @@ private:
   std::vector<std::string> m_topicNames;
   SubscribeAtOption m_subscribeOption = SubscribeAtOption::OFFSET;
 
+  std::unique_ptr<RdKafka::Message> consume(int64_t &offset,
+                                            int32_t &partition,
+                                            std::string &topic);
   void subscribeAtTime(int64_t time);
   void reportSuccessOrFailure(const RdKafka::ErrorCode &error,
                               int64_t confOffset) const;
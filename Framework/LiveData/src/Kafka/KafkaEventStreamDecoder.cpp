@@ -6,6 +6,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
@@ -39,6 +40,9 @@ const std::string SAMPLE_MESSAGE_ID = "f142";
 
 const std::chrono::seconds MAX_LATENCY(1);
 
+/// Messages with fewer events than this are decoded on a single thread
+const size_t MIN_EVENTS_FOR_PARALLEL_DECODE = 10000;
+
 /**
  * Append sample log data to existing log or create a new log if one with
  * specified name does not already exist
@@ -252,7 +256,6 @@ void KafkaEventStreamDecoder::captureImplExcept() {
   m_endRun = false;
   m_runStatusSeen = false;
   m_extractedEndRunData = true;
-  std::string buffer;
   int64_t offset;
   int32_t partition;
   std::string topicName;
@@ -267,9 +270,11 @@ void KafkaEventStreamDecoder::captureImplExcept() {
     else
       waitForDataExtraction();
     // Pull in events
-    m_eventStream->consumeMessage(&buffer, offset, partition, topicName);
+    // The message is decoded in place from the buffer owned by the subscriber
+    const auto message =
+        m_eventStream->consumeMessageView(offset, partition, topicName);
     // No events, wait for some to come along...
-    if (buffer.empty()) {
+    if (!message || message->empty()) {
       m_cbIterationEnd();
       continue;
     }
@@ -302,23 +307,19 @@ void KafkaEventStreamDecoder::captureImplExcept() {
 
     // Check if we have an event message
     // Most will be event messages so we check for this type first
-    if (flatbuffers::BufferHasIdentifier(
-            reinterpret_cast<const uint8_t *>(buffer.c_str()),
-            EVENT_MESSAGE_ID.c_str())) {
+    const uint8_t *buffer = message->payload();
+    if (flatbuffers::BufferHasIdentifier(buffer, EVENT_MESSAGE_ID.c_str())) {
       eventDataFromMessage(buffer);
     }
     // Check if we have a sample environment log message
-    else if (flatbuffers::BufferHasIdentifier(
-                 reinterpret_cast<const uint8_t *>(buffer.c_str()),
-                 SAMPLE_MESSAGE_ID.c_str())) {
+    else if (flatbuffers::BufferHasIdentifier(buffer,
+                                              SAMPLE_MESSAGE_ID.c_str())) {
       sampleDataFromMessage(buffer);
     }
     // Check if we have a runMessage
-    else if (flatbuffers::BufferHasIdentifier(
-                 reinterpret_cast<const uint8_t *>(buffer.c_str()),
-                 RUN_MESSAGE_ID.c_str())) {
-      auto runMsg =
-          GetRunInfo(reinterpret_cast<const uint8_t *>(buffer.c_str()));
+    else if (flatbuffers::BufferHasIdentifier(buffer,
+                                              RUN_MESSAGE_ID.c_str())) {
+      auto runMsg = GetRunInfo(buffer);
       if (!checkOffsets && runMsg->info_type_type() == InfoTypes_RunStop) {
         auto runStopMsg = static_cast<const RunStop *>(runMsg->info_type());
         auto stopTime = runStopMsg->stop_time();
@@ -458,15 +459,14 @@ void KafkaEventStreamDecoder::waitForRunEndObservation() {
  * @param nSEEvents : number of sample environment log values in the flatbuffer
  * @param mutableRunInfo : Log manager containing the existing sample logs
  */
-void KafkaEventStreamDecoder::sampleDataFromMessage(const std::string &buffer) {
+void KafkaEventStreamDecoder::sampleDataFromMessage(const uint8_t *buffer) {
 
   std::lock_guard<std::mutex> lock(m_mutex);
   // Add sample log values to every the workspace for every period
   for (const auto &periodBuffer : m_localEvents) {
     auto &mutableRunInfo = periodBuffer->mutableRun();
 
-    auto seEvent =
-        GetLogData(reinterpret_cast<const uint8_t *>(buffer.c_str()));
+    auto seEvent = GetLogData(buffer);
 
     auto name = seEvent->source_name()->str();
 
@@ -498,14 +498,22 @@ void KafkaEventStreamDecoder::sampleDataFromMessage(const std::string &buffer) {
   }
 }
 
-void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer) {
-  auto eventMsg =
-      GetEventMessage(reinterpret_cast<const uint8_t *>(buffer.c_str()));
+/**
+ * Decode the events of an ev42 message and append them to the buffer of the
+ * period they belong to. The events are decoded into the staging buffers
+ * before the lock on the workspace buffers is taken, so that extractData()
+ * only has to wait for the events to be appended. The buffer is not copied;
+ * the event arrays are read directly from the flatbuffer.
+ *
+ * @param buffer : Raw flatbuffer of the event message
+ */
+void KafkaEventStreamDecoder::eventDataFromMessage(const uint8_t *buffer) {
+  auto eventMsg = GetEventMessage(buffer);
 
   DateAndTime pulseTime = static_cast<int64_t>(eventMsg->pulse_time());
   const auto &tofData = *(eventMsg->time_of_flight());
   const auto &detData = *(eventMsg->detector_id());
-  auto nEvents = tofData.size();
+  stageEvents(tofData.data(), detData.data(), tofData.size(), pulseTime);
 
   DataObjects::EventWorkspace_sptr periodBuffer;
   std::lock_guard<std::mutex> lock(m_mutex);
@@ -519,13 +527,77 @@ void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer) {
   } else {
     periodBuffer = m_localEvents[0];
   }
-  for (decltype(nEvents) i = 0; i < nEvents; ++i) {
-    auto &spectrum = periodBuffer->getSpectrum(
-        m_specToIdx[static_cast<int32_t>(detData[i])]);
-    spectrum.addEventQuickly(TofEvent(static_cast<double>(tofData[i]) *
-                                          1e-3, // nanoseconds to microseconds
-                                      pulseTime));
+  appendStagedEvents(*periodBuffer);
+}
+
+/**
+ * Group the raw times-of-flight of a message by workspace index in the
+ * staging buffers. The conversion to TofEvents is deferred until they are
+ * appended to the spectra. The buffer workspaces are not accessed so this
+ * does not require m_mutex to be held.
+ *
+ * @param tofData : Time-of-flight of each event in nanoseconds
+ * @param detData : Spectrum number of each event
+ * @param nEvents : Number of events in the message
+ * @param pulseTime : Pulse time shared by all events of the message
+ */
+void KafkaEventStreamDecoder::stageEvents(const uint32_t *tofData,
+                                          const uint32_t *detData,
+                                          const size_t nEvents,
+                                          const DateAndTime &pulseTime) {
+  m_stagedIndices.resize(nEvents);
+  m_stagedTofs.resize(nEvents);
+  m_stagedPulseTime = pulseTime;
+
+  // Look up the workspace indices in parallel. A spectrum number that is not
+  // in the mapping goes to workspace index 0.
+  const auto nEventsSigned = static_cast<int64_t>(nEvents);
+  PARALLEL_FOR_IF(nEvents > MIN_EVENTS_FOR_PARALLEL_DECODE)
+  for (int64_t i = 0; i < nEventsSigned; ++i) {
+    const auto found = m_specToIdx.find(static_cast<int32_t>(detData[i]));
+    m_stagedIndices[i] = (found != m_specToIdx.end()) ? found->second : 0;
   }
+
+  // Counting sort of the events by workspace index. Only the counters of the
+  // spectra present in the message are touched.
+  for (const auto index : m_stagedIndices) {
+    if (m_stagedCounts[index]++ == 0)
+      m_stagedSpectra.push_back(index);
+  }
+  size_t end(0);
+  for (const auto index : m_stagedSpectra) {
+    m_stagedEnds[index] = end;
+    end += m_stagedCounts[index];
+  }
+  for (size_t i = 0; i < nEvents; ++i)
+    m_stagedTofs[m_stagedEnds[m_stagedIndices[i]]++] = tofData[i];
+}
+
+/**
+ * Append the staged events to the spectra of a buffer workspace and reset the
+ * staging buffers. Each spectrum is appended to by a single thread with one
+ * bulk append of its contiguous run of staged times-of-flight.
+ * The caller must hold m_mutex.
+ *
+ * @param periodBuffer : Buffer workspace receiving the events
+ */
+void KafkaEventStreamDecoder::appendStagedEvents(
+    DataObjects::EventWorkspace &periodBuffer) {
+  const auto nSpectra = static_cast<int64_t>(m_stagedSpectra.size());
+  PARALLEL_FOR_IF(m_stagedTofs.size() > MIN_EVENTS_FOR_PARALLEL_DECODE)
+  for (int64_t i = 0; i < nSpectra; ++i) {
+    const auto index = m_stagedSpectra[i];
+    const auto count = m_stagedCounts[index];
+    const auto begin = m_stagedEnds[index] - count;
+    periodBuffer.getSpectrum(index).addEventsQuickly(
+        m_stagedTofs.data() + begin, count,
+        1e-3, // nanoseconds to microseconds
+        m_stagedPulseTime);
+  }
+
+  for (const auto index : m_stagedSpectra)
+    m_stagedCounts[index] = 0;
+  m_stagedSpectra.clear();
 }
 
 KafkaEventStreamDecoder::RunStartStruct
@@ -614,6 +686,11 @@ void KafkaEventStreamDecoder::initLocalCaches() {
 
   // Cache spec->index mapping. We assume it is the same across all periods
   m_specToIdx = eventBuffer->getSpectrumToWorkspaceIndexMap();
+  // Size the staging buffers used to group the events of a message
+  const auto nHistograms = eventBuffer->getNumberHistograms();
+  m_stagedCounts.assign(nHistograms, 0);
+  m_stagedEnds.assign(nHistograms, 0);
+  m_stagedSpectra.clear();
 
   // Buffers for each period
   const size_t nperiods = runStartData.nPeriods;
@@ -15,6 +15,20 @@ using RdKafka::TopicMetadata;
 namespace {
 /// Timeout for message consume
 const int CONSUME_TIMEOUT_MS = 30000;
+
+/// A KafkaMessage viewing the payload buffer of a librdkafka message
+class RdKafkaMessage : public Mantid::LiveData::KafkaMessage {
+public:
+  explicit RdKafkaMessage(std::unique_ptr<RdKafka::Message> message)
+      : m_message(std::move(message)) {}
+  const uint8_t *payload() const override {
+    return static_cast<const uint8_t *>(m_message->payload());
+  }
+  size_t size() const override { return m_message->len(); }
+
+private:
+  std::unique_ptr<RdKafka::Message> m_message;
+};
 /// A reference to the static logger
 Mantid::Kernel::Logger &LOGGER() {
   static Mantid::Kernel::Logger logger("KafkaTopicSubscriber");
@@ -414,12 +428,43 @@ void KafkaTopicSubscriber::reportSuccessOrFailure(
 void KafkaTopicSubscriber::consumeMessage(std::string *payload, int64_t &offset,
                                           int32_t &partition,
                                           std::string &topic) {
-  using RdKafka::Message;
-  using RdKafka::err2str;
-  assert(m_consumer);
   assert(payload);
 
   payload->clear();
+  auto kfMsg = consume(offset, partition, topic);
+  if (kfMsg) {
+    payload->assign(static_cast<const char *>(kfMsg->payload()),
+                    static_cast<int>(kfMsg->len()));
+  }
+}
+
+/**
+ * Consume a message from the stream without copying its payload. The
+ * returned message keeps the librdkafka message, and therefore its buffer,
+ * alive. Errors are handled as for consumeMessage().
+ * @return The message. It is empty if the consume timed out or reached the
+ * end of a partition
+ */
+KafkaMessage_const_sptr
+KafkaTopicSubscriber::consumeMessageView(int64_t &offset, int32_t &partition,
+                                         std::string &topic) {
+  auto kfMsg = consume(offset, partition, topic);
+  if (kfMsg)
+    return std::make_shared<RdKafkaMessage>(std::move(kfMsg));
+  return std::make_shared<KafkaStringMessage>(std::string());
+}
+
+/**
+ * Consume a message from the broker and check it for errors.
+ * @return The message if one with a payload was received, nullptr on a
+ * timeout or at the end of a partition
+ */
+std::unique_ptr<RdKafka::Message>
+KafkaTopicSubscriber::consume(int64_t &offset, int32_t &partition,
+                              std::string &topic) {
+  using RdKafka::Message;
+  assert(m_consumer);
+
   auto kfMsg =
       std::unique_ptr<Message>(m_consumer->consume(CONSUME_TIMEOUT_MS));
 
@@ -427,11 +472,10 @@ void KafkaTopicSubscriber::consumeMessage(std::string *payload, int64_t &offset,
   case RdKafka::ERR_NO_ERROR:
     // Real message
     if (kfMsg->len() > 0) {
-      payload->assign(static_cast<const char *>(kfMsg->payload()),
-                      static_cast<int>(kfMsg->len()));
       offset = kfMsg->offset();
       partition = kfMsg->partition();
       topic = kfMsg->topic_name();
+      return kfMsg;
     } else {
       // If RdKafka indicates no error then we should always get a
       // non-zero length message
@@ -439,12 +483,11 @@ void KafkaTopicSubscriber::consumeMessage(std::string *payload, int64_t &offset,
                                "indicated no error but a zero-length payload "
                                "was received");
     }
-    break;
 
   case RdKafka::ERR__TIMED_OUT:
   case RdKafka::ERR__PARTITION_EOF:
     // Not errors as the broker might come back or more data might be pushed
-    break;
+    return nullptr;
 
   default:
     /* All other errors */
@@ -170,6 +170,43 @@ public:
                       eventWksp->getNumberEvents());
   }
 
+  void test_Events_Are_Added_To_The_Spectrum_Of_Their_Spectrum_Number() {
+    using namespace ::testing;
+    using namespace KafkaTesting;
+    using Mantid::API::Workspace_sptr;
+    using Mantid::DataObjects::EventWorkspace;
+    using namespace Mantid::LiveData;
+
+    auto mockBroker = std::make_shared<MockKafkaBroker>();
+    EXPECT_CALL(*mockBroker, subscribe_(_, _))
+        .Times(Exactly(3))
+        .WillOnce(Return(new FakeDataStreamSubscriber(1)))
+        .WillOnce(Return(new FakeRunInfoStreamSubscriber(1)))
+        .WillOnce(Return(new FakeISISSpDetStreamSubscriber));
+    auto decoder = createTestDecoder(mockBroker);
+    // A run start message, a single event message and a run stop message
+    startCapturing(*decoder, 3);
+    Workspace_sptr workspace;
+    TS_ASSERT_THROWS_NOTHING(workspace = decoder->extractData());
+    TS_ASSERT(decoder->hasReachedEndOfRun());
+    TS_ASSERT_THROWS_NOTHING(decoder->stopCapture());
+
+    auto eventWksp = boost::dynamic_pointer_cast<EventWorkspace>(workspace);
+    TS_ASSERT(eventWksp);
+    // The message holds spectrum numbers {5, 4, 3, 2, 1, 2} with tofs
+    // {11000, 10000, 9000, 8000, 7000, 6000} ns
+    const std::array<size_t, 5> expectedCounts = {{1, 2, 1, 1, 1}};
+    for (size_t i = 0; i < expectedCounts.size(); ++i) {
+      TS_ASSERT_EQUALS(expectedCounts[i],
+                       eventWksp->getSpectrum(i).getNumberEvents());
+    }
+    const auto &spectrum2 = eventWksp->getSpectrum(1).getEvents();
+    TS_ASSERT_DELTA(8.0, spectrum2[0].tof(), 1e-10);
+    TS_ASSERT_DELTA(6.0, spectrum2[1].tof(), 1e-10);
+    TS_ASSERT_DELTA(11.0, eventWksp->getSpectrum(4).getEvents()[0].tof(),
+                    1e-10);
+  }
+
   void
   test_Get_All_Run_Events_When_Run_Stop_Message_Received_Before_Last_Event_Message() {
     using namespace ::testing;
@@ -427,4 +464,87 @@ private:
   uint8_t m_niterations = 0;
 };
 
+class KafkaEventStreamDecoderTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static KafkaEventStreamDecoderTestPerformance *createSuite() {
+    return new KafkaEventStreamDecoderTestPerformance();
+  }
+  static void destroySuite(KafkaEventStreamDecoderTestPerformance *suite) {
+    delete suite;
+  }
+
+  KafkaEventStreamDecoderTestPerformance() {
+    // Record the messages to replay up front so that only decoding is timed
+    m_messages.resize(NMESSAGES);
+    for (size_t i = 0; i < NMESSAGES; ++i) {
+      KafkaTesting::fakeReceiveALargeEventMessage(&m_messages[i], NEVENTS, 5,
+                                                  i + 1);
+    }
+  }
+
+  void setUp() override {
+    using Mantid::Kernel::ConfigService;
+    auto &config = ConfigService::Instance();
+    auto baseInstDir = config.getInstrumentDirectory();
+    Poco::Path testFile =
+        Poco::Path(baseInstDir)
+            .resolve("IDFs_for_UNIT_TESTING/UnitTestFacilities.xml");
+    config.updateFacilities(testFile.toString());
+    config.setFacility("TEST");
+    config.setString("instrumentDefinition.directory",
+                     baseInstDir + "/IDFs_for_UNIT_TESTING");
+  }
+
+  void tearDown() override {
+    using Mantid::Kernel::ConfigService;
+    auto &config = ConfigService::Instance();
+    config.reset();
+    config.updateFacilities();
+  }
+
+  void test_Decoding_Throughput_Of_Large_Event_Messages() {
+    using namespace ::testing;
+    using namespace KafkaTesting;
+    using Mantid::DataObjects::EventWorkspace;
+    using namespace Mantid::LiveData;
+
+    auto mockBroker = std::make_shared<MockKafkaBroker>();
+    EXPECT_CALL(*mockBroker, subscribe_(_, _))
+        .Times(Exactly(3))
+        .WillOnce(Return(new FakeReplayEventSubscriber(m_messages)))
+        .WillOnce(Return(new FakeRunInfoStreamSubscriber(1)))
+        .WillOnce(Return(new FakeISISSpDetStreamSubscriber));
+    KafkaEventStreamDecoder decoder(mockBroker, "", "", "", "");
+
+    size_t niterations(0);
+    std::mutex callbackMutex;
+    std::condition_variable callbackCondition;
+    decoder.registerIterationEndCb([&]() {
+      std::lock_guard<std::mutex> lock(callbackMutex);
+      if (++niterations == NITERATIONS)
+        callbackCondition.notify_one();
+    });
+    decoder.startCapture();
+    {
+      std::unique_lock<std::mutex> lock(callbackMutex);
+      callbackCondition.wait(lock,
+                             [&]() { return niterations >= NITERATIONS; });
+    }
+    auto workspace = boost::dynamic_pointer_cast<EventWorkspace>(
+        decoder.extractData());
+    decoder.stopCapture();
+
+    TS_ASSERT(workspace);
+    TS_ASSERT(workspace->getNumberEvents() >= NITERATIONS * NEVENTS);
+  }
+
+private:
+  static constexpr size_t NMESSAGES = 10;
+  static constexpr uint32_t NEVENTS = 1000000;
+  static constexpr size_t NITERATIONS = 50;
+  std::vector<std::string> m_messages;
+};
+
 #endif /* MANTID_LIVEDATA_KAFKAEVENTSTREAMDECODERTEST_H_ */
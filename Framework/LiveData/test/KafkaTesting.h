@@ -159,6 +159,27 @@ void fakeReceiveAnEventMessage(std::string *buffer) {
                  builder.GetSize());
 }
 
+void fakeReceiveALargeEventMessage(std::string *buffer, uint32_t nEvents,
+                                   uint32_t nSpectra, uint64_t frameTime) {
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<uint32_t> spec(nEvents);
+  std::vector<uint32_t> tof(nEvents);
+  for (uint32_t i = 0; i < nEvents; ++i) {
+    // Spectrum numbers start at 1
+    spec[i] = 1 + (i * 7919) % nSpectra;
+    tof[i] = 1000 + (i * 104729) % 20000000;
+  }
+
+  auto messageFlatbuf = CreateEventMessage(
+      builder, builder.CreateString("KafkaTesting"), 0, frameTime,
+      builder.CreateVector(tof), builder.CreateVector(spec));
+  FinishEventMessageBuffer(builder, messageFlatbuf);
+
+  // Copy to provided buffer
+  buffer->assign(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                 builder.GetSize());
+}
+
 void fakeReceiveASampleEnvMessage(std::string *buffer) {
   flatbuffers::FlatBufferBuilder builder;
   // Sample environment log
@@ -304,6 +325,50 @@ private:
   std::string m_stopTime = "2016-08-31T12:07:52";
 };
 
+// -----------------------------------------------------------------------------
+// Fake event stream replaying a set of recorded messages in a loop
+// -----------------------------------------------------------------------------
+class FakeReplayEventSubscriber
+    : public Mantid::LiveData::IKafkaStreamSubscriber {
+public:
+  explicit FakeReplayEventSubscriber(std::vector<std::string> messages)
+      : m_messages(std::move(messages)), m_nextMessage(0) {}
+  void subscribe() override {}
+  void subscribe(int64_t offset) override { UNUSED_ARG(offset) }
+  void consumeMessage(std::string *message, int64_t &offset, int32_t &partition,
+                      std::string &topic) override {
+    assert(message);
+
+    *message = m_messages[m_nextMessage];
+    m_nextMessage = (m_nextMessage + 1) % m_messages.size();
+
+    UNUSED_ARG(offset);
+    UNUSED_ARG(partition);
+    UNUSED_ARG(topic);
+  }
+  std::unordered_map<std::string, std::vector<int64_t>>
+  getOffsetsForTimestamp(int64_t timestamp) override {
+    UNUSED_ARG(timestamp);
+    return {
+        std::pair<std::string, std::vector<int64_t>>("topic_name", {1, 2, 3})};
+  }
+  std::unordered_map<std::string, std::vector<int64_t>>
+  getCurrentOffsets() override {
+    std::unordered_map<std::string, std::vector<int64_t>> offsets;
+    return offsets;
+  }
+  void seek(const std::string &topic, uint32_t partition,
+            int64_t offset) override {
+    UNUSED_ARG(topic);
+    UNUSED_ARG(partition);
+    UNUSED_ARG(offset);
+  }
+
+private:
+  const std::vector<std::string> m_messages;
+  size_t m_nextMessage;
+};
+
 // -----------------------------------------------------------------------------
 // Fake event stream to provide sample environment data
 // -----------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/CoordTransform.h"
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
+#include "MantidDataObjects/CoordTransformKernel.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
@@ -66,10 +67,26 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Helper method binning in parallel into per-thread buffers
+  template <typename MDE, size_t nd>
+  void binWithThreadBuffers(
+      typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+      const DataObjects::CoordTransformKernel<nd> &transform,
+      const size_t numThreads);
+
+  /// The arrays that events are binned into
+  struct BinArrays {
+    signal_t *signals;
+    signal_t *errors;
+    signal_t *numEvents;
+  };
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                const size_t *const chunkMax);
+                const size_t *const chunkMax,
+                const DataObjects::CoordTransformKernel<nd> &transform,
+                const BinArrays &arrays);
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
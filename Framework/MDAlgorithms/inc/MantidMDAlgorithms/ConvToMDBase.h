@@ -71,6 +71,14 @@ public:
      (if such conversion is necessary) */
   UnitsConversionHelper &getUnitConversionHelper() { return m_UnitConversion; }
 
+  /** method asks the conversion to spill the converted events to a file and
+     build the target workspace one top-level box at a time, within a memory
+     budget. Only used when converting events. */
+  void setSpilling(size_t memoryBudget, const std::string &spillFilename) {
+    m_spillMemoryBudget = memoryBudget;
+    m_spillFilename = spillFilename;
+  }
+
 protected:
   // pointer to input matrix workspace;
   API::MatrixWorkspace_const_sptr m_InWS2D;
@@ -107,6 +115,11 @@ protected:
   bool m_ignoreZeros;
   /// Any special coordinate system used.
   Mantid::Kernel::SpecialCoordinateSystem m_coordinateSystem;
+  /// Bytes of converted events to buffer before spilling them, 0 to add them
+  /// to the workspace directly
+  size_t m_spillMemoryBudget;
+  /// Path of the file to spill the converted events to
+  std::string m_spillFilename;
 
 private:
   /** internal function which do one peace of work, which should be performed by
@@ -10,6 +10,7 @@
 #include "MantidMDAlgorithms/MDEventWSWrapper.h"
 #include "MantidMDAlgorithms/MDTransfFactory.h"
 
+#include <atomic>
 #include <vector>
 
 namespace Mantid {
@@ -67,9 +68,18 @@ private:
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
+  size_t convertSpectrum(size_t workspaceIndex,
+                         MDTransfInterface &qConverter, size_t thread);
   /**function converts particular type of events into MD space and add these
    * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  template <class T>
+  size_t convertEventList(size_t workspaceIndex,
+                          MDTransfInterface &qConverter, size_t thread);
+
+  void runParallelConversion(API::Progress *pProgress);
+  void runSpillingConversion(API::Progress *pProgress);
+  void convertSpectra(size_t thread, std::atomic<size_t> &nextSpectrum,
+                      API::Progress *pProgress);
 };
 
 } // endNamespace DataObjects
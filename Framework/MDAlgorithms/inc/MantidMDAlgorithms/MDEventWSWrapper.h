@@ -5,6 +5,8 @@
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidMDAlgorithms/MDWSDescription.h"
 
+#include <mutex>
+
 namespace Mantid {
 namespace MDAlgorithms {
 /**  The class which wraps MD Events factory and allow to work with a
@@ -54,6 +56,24 @@ using fpAddData = void (MDEventWSWrapper::*)(float *, uint16_t *, uint32_t *,
                                              coord_t *, size_t) const;
 /// signature for the internal templated function pointer to create workspace
 using fpCreateWS = void (MDEventWSWrapper::*)(const MDWSDescription &);
+/// signature for the internal templated function pointer to prepare adding
+/// data from a number of threads
+using fpStartAdding = void (MDEventWSWrapper::*)(size_t);
+/// signature for the internal templated function pointer to add data from one
+/// of the threads adding in parallel
+using fpAddDataInParallel = void (MDEventWSWrapper::*)(size_t, float *,
+                                                       uint16_t *, uint32_t *,
+                                                       coord_t *, size_t);
+
+/// signature for the internal templated function pointer to prepare spilling
+/// the added data within a memory budget
+using fpStartSpilling = void (MDEventWSWrapper::*)(size_t,
+                                                   const std::string &);
+/// signature for the internal templated function pointer to add data to the
+/// spill
+using fpAddDataToSpill = void (MDEventWSWrapper::*)(float *, uint16_t *,
+                                                    uint32_t *, coord_t *,
+                                                    size_t);
 
 class DLLExport MDEventWSWrapper {
 public:
@@ -74,6 +94,28 @@ public:
   void addMDData(std::vector<float> &sigErr, std::vector<uint16_t> &runIndex,
                  std::vector<uint32_t> &detId, std::vector<coord_t> &Coord,
                  size_t dataSize) const;
+  /// prepare adding data to the internal workspace from several threads at
+  /// once
+  void startParallelAdding(size_t numThreads);
+  /// add the data to the internal workspace from one of the threads adding
+  /// in parallel
+  void addMDDataInParallel(size_t thread, std::vector<float> &sigErr,
+                           std::vector<uint16_t> &runIndex,
+                           std::vector<uint32_t> &detId,
+                           std::vector<coord_t> &Coord, size_t dataSize);
+  /// insert all the data added in parallel into the internal workspace
+  void finishParallelAdding();
+  /// prepare adding data to the internal workspace through a spill file,
+  /// within a memory budget
+  void startSpilling(size_t memoryBudget, const std::string &spillFilename);
+  /// add the data to the spill. Thread-safe.
+  void addMDDataToSpill(std::vector<float> &sigErr,
+                        std::vector<uint16_t> &runIndex,
+                        std::vector<uint32_t> &detId,
+                        std::vector<coord_t> &Coord, size_t dataSize);
+  /// insert all the spilled data into the internal workspace, one top-level
+  /// box at a time
+  void finishSpilling();
   /// releases the shared pointer to the MD workspace, stored by the class and
   /// makes the class instance undefined;
   void releaseWorkspace();
@@ -114,6 +156,33 @@ private:
   /// vector holding function pointers to the code, which split list of boxes
   /// need splitting
   std::vector<fpVoidMethod> mdBoxListSplitter;
+  /// vector holding function pointers to the code, which prepares adding
+  /// events from several threads
+  std::vector<fpStartAdding> mdParallelAddingStarter;
+  /// vector holding function pointers to the code, which adds events from one
+  /// of the threads adding in parallel
+  std::vector<fpAddDataInParallel> mdEvAddInParallel;
+  /// vector holding function pointers to the code, which inserts all the
+  /// events added in parallel
+  std::vector<fpVoidMethod> mdParallelAddingFinisher;
+
+  /// vector holding function pointers to the code, which prepares spilling
+  /// the added events
+  std::vector<fpStartSpilling> mdSpillingStarter;
+  /// vector holding function pointers to the code, which adds events to the
+  /// spill
+  std::vector<fpAddDataToSpill> mdEvAddToSpill;
+  /// vector holding function pointers to the code, which inserts all the
+  /// spilled events
+  std::vector<fpVoidMethod> mdSpillingFinisher;
+  /// the DataObjects::ParallelMDEventInserter used while adding in parallel,
+  /// of the type matching the workspace
+  boost::shared_ptr<void> m_parallelInserter;
+  /// the DataObjects::MDEventSpiller used while spilling, of the type
+  /// matching the workspace
+  boost::shared_ptr<void> m_spiller;
+  /// serializes the adding of data to the spill
+  std::mutex m_spillMutex;
 
   // helper class to generate methaloop on MD workspaces dimensions:
   template <size_t i> friend class LOOP;
@@ -128,6 +197,18 @@ private:
                            uint32_t *det_id, coord_t *Coord,
                            size_t data_size) const;
 
+  template <size_t nd> void startParallelAddingND(size_t numThreads);
+  template <size_t nd>
+  void addMDDataInParallelND(size_t thread, float *sigErr, uint16_t *runIndex,
+                             uint32_t *detId, coord_t *Coord, size_t dataSize);
+  template <size_t nd> void finishParallelAddingND();
+  template <size_t nd>
+  void startSpillingND(size_t memoryBudget, const std::string &spillFilename);
+  template <size_t nd>
+  void addMDDataToSpillND(float *sigErr, uint16_t *runIndex, uint32_t *detId,
+                          coord_t *Coord, size_t dataSize);
+  template <size_t nd> void finishSpillingND();
+
   template <size_t nd> void calcCentroidND();
 
   template <size_t nd>
@@ -76,7 +76,7 @@ private:
   double m_Ei, m_ki, m_kfmin, m_kfmax;
   /// flag for integrated h,k,l, dE dimensions
   bool m_hIntegrated, m_kIntegrated, m_lIntegrated, m_dEIntegrated;
-  /// (2*PiRUBW)^-1
+  /// (2*PiRUBW)^-1, negated for the Crystallography convention
   Mantid::Kernel::DblMatrix m_rubw;
   /// index of h,k,l, dE dimensions in the output workspaces
   size_t m_hIdx, m_kIdx, m_lIdx, m_eIdx;
@@ -77,7 +77,7 @@ private:
   coord_t m_hmin, m_hmax, m_kmin, m_kmax, m_lmin, m_lmax;
   /// flag for integrated h,k,l dimensions
   bool m_hIntegrated, m_kIntegrated, m_lIntegrated;
-  /// (2*PiRUBW)^-1
+  /// (2*PiRUBW)^-1, negated for the Crystallography convention
   Mantid::Kernel::DblMatrix m_rubw;
   /// limits for momentum
   double m_kiMin, m_kiMax;
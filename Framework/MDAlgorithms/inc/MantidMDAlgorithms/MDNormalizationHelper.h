@@ -0,0 +1,45 @@
+#ifndef MANTID_MDALGORITHMS_MDNORMALIZATIONHELPER_H_
+#define MANTID_MDALGORITHMS_MDNORMALIZATIONHELPER_H_
+
+#include "MantidMDAlgorithms/DllConfig.h"
+
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** MDNormalizationHelper : Functions shared by the single-crystal
+  normalization algorithms, MDNormSCD and MDNormDirectSC.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+
+/// Find the planes lying strictly between two positions along an axis
+MANTID_MDALGORITHMS_DLL std::pair<size_t, size_t>
+planesBetween(const std::vector<double> &planes, const double start,
+              const double end);
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_MDNORMALIZATIONHELPER_H_ */
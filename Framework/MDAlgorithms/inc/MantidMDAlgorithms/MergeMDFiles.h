@@ -75,7 +75,10 @@ private:
 
   void finalizeOutput(const std::string &outputFile);
 
-  uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+  void mergeBoxes(const std::vector<API::IMDNode *> &boxes,
+                  const bool parallel);
+
+  void reportThroughput(const double seconds) const;
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
@@ -109,6 +112,15 @@ protected:
   /// # of events loaded from all tasks
   uint64_t m_totalLoaded;
 
+  /// # of bytes read from the input files
+  uint64_t m_bytesRead;
+  /// # of bytes written to the output file
+  uint64_t m_bytesWritten;
+  /// Time spent reading the input files, in seconds
+  double m_readTime;
+  /// Time spent writing the output file, in seconds
+  double m_writeTime;
+
   /// Mutex for file access
   std::mutex m_fileMutex;
 
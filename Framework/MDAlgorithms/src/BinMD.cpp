@@ -3,8 +3,10 @@
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/CoordTransformAffineParser.h"
 #include "MantidDataObjects/CoordTransformAligned.h"
+#include "MantidDataObjects/CoordTransformKernel.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
@@ -28,6 +30,14 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// Number of events transformed at once
+const size_t EVENT_BATCH_SIZE = 256;
+/// Most bins held in per-thread buffers in all, 3 doubles each. Larger outputs
+/// are binned in chunks instead.
+const size_t MAX_BUFFERED_BINS = 16 * 1024 * 1024;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -91,10 +101,14 @@ void BinMD::init() {
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @param transform :: the transformation to the output bins
+ * @param arrays :: the arrays to add the signal of the box to
  */
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
+                            const size_t *const chunkMax,
+                            const CoordTransformKernel<nd> &transform,
+                            const BinArrays &arrays) {
   // An array to hold the rotated/transformed coordinates
   auto outCenter = new coord_t[m_outD];
 
@@ -114,7 +128,7 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
       const coord_t *inCenter = vertexes.get() + i * nd;
 
       // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
+      transform.apply(inCenter, outCenter);
       // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
       // <<  VMD(nd,outCenter) << '\n';
 
@@ -159,11 +173,12 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
       //        std::cout << "Box at " << box->getExtentsStr() << " is within a
       //        single bin.\n";
       // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
+      arrays.signals[lastLinearIndex] += box->getSignal();
+      arrays.errors[lastLinearIndex] += box->getErrorSquared();
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+      arrays.numEvents[lastLinearIndex] +=
+          static_cast<signal_t>(box->getNPoints());
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
@@ -174,43 +189,51 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
   // If you get here, you could not determine that the entire box was in the
   // same bin.
-  // So you need to iterate through events.
+  // So you need to iterate through events, transforming them in batches.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
+  std::vector<coord_t> outCenters(std::min(events.size(), EVENT_BATCH_SIZE) *
+                                  m_outD);
+  for (size_t batch = 0; batch < events.size(); batch += EVENT_BATCH_SIZE) {
+    const size_t batchSize = std::min(EVENT_BATCH_SIZE, events.size() - batch);
     // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
+    transform.applyToEvents(events.data() + batch, batchSize,
+                            outCenters.data());
 
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
+    for (size_t i = 0; i < batchSize; ++i) {
+      const coord_t *eventOutCenter = outCenters.data() + i * m_outD;
 
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
-      }
-    } // (for each dim in MDHisto)
+      // To build up the linear index
+      size_t linearIndex = 0;
+      // To mark events outside range
+      bool badOne = false;
 
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
+      /// Loop through the dimensions on which we bin
+      for (size_t bd = 0; bd < m_outD; bd++) {
+        // What is the bin index in that dimension
+        coord_t x = eventOutCenter[bd];
+        size_t ix = size_t(x);
+        // Within range (for this chunk)?
+        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+          // Build up the linear index
+          linearIndex += indexMultiplier[bd] * ix;
+        } else {
+          // Outside the range
+          badOne = true;
+          break;
+        }
+      } // (for each dim in MDHisto)
+
+      if (!badOne) {
+        const MDE &event = events[batch + i];
+        // Sum the signals as doubles to preserve precision
+        arrays.signals[linearIndex] +=
+            static_cast<signal_t>(event.getSignal());
+        arrays.errors[linearIndex] +=
+            static_cast<signal_t>(event.getErrorSquared());
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        arrays.numEvents[linearIndex] += 1.0;
+      }
     }
   }
   // Done with the events list
@@ -278,9 +301,22 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     prog->resetNumSteps(100, 0.00, 1.0);
   }
 
-  // Run the chunks in parallel. There is no overlap in the output workspace so
-  // it is thread safe to write to it..
-  // cppcheck-suppress syntaxError
+  // The transformation to the output bins, without a virtual call per event
+  const CoordTransformKernel<nd> transform(*m_transform);
+  const BinArrays outputArrays = {signals, errors, numEvents};
+
+  // Bin into a buffer per thread if the buffers are small enough: the threads
+  // then share out the boxes, instead of each going through all the boxes
+  // overlapping its chunk and skipping the events outside of it
+  const size_t numBins = outWS->getNPoints();
+  const auto numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  if (doParallel && numThreads > 1 &&
+      numBins * (numThreads - 1) <= MAX_BUFFERED_BINS) {
+    this->binWithThreadBuffers<MDE, nd>(ws, transform, numThreads);
+  } else {
+    // Run the chunks in parallel. There is no overlap in the output workspace
+    // so it is thread safe to write to it..
+    // cppcheck-suppress syntaxError
     PRAGMA_OMP( parallel for schedule(dynamic,1) if (doParallel) )
     for (int chunk = 0;
          chunk < int(m_binDimensions[chunkDimension]->getNBins());
@@ -327,34 +363,114 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
       }
 
-      // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
-        // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
-
-        // Progress reporting
-        if (prog)
-          prog->report();
-        // For early cancelling of the loop
-        if (this->m_cancel)
-          break;
-      } // for each box in the vector
+      if (bc->isFileBacked()) {
+        // Read the events of the next boxes in large sequential blocks while
+        // binning the boxes already read
+        MDBoxPrefetcher<MDE, nd> prefetcher(boxes);
+        while (MDBox<MDE, nd> *box = prefetcher.next()) {
+          if (!box->getIsMasked())
+            this->binMDBox(box, chunkMin.data(), chunkMax.data(), transform,
+                           outputArrays);
+          if (prog)
+            prog->report();
+          if (this->m_cancel)
+            break;
+        }
+      } else {
+        // Go through every box for this chunk.
+        for (auto &boxe : boxes) {
+          MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+          // Perform the binning in this separate method.
+          if (box && !box->getIsMasked())
+            this->binMDBox(box, chunkMin.data(), chunkMax.data(), transform,
+                           outputArrays);
+
+          // Progress reporting
+          if (prog)
+            prog->report();
+          // For early cancelling of the loop
+          if (this->m_cancel)
+            break;
+        } // for each box in the vector
+      }
       PARALLEL_END_INTERUPT_REGION
     } // for each chunk in parallel
     PARALLEL_CHECK_INTERUPT_REGION
+  }
 
-    // Now the implicit function
-    if (implicitFunction) {
-      if (prog)
-        prog->report("Applying implicit function.");
-      signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-      outWS->applyImplicitFunction(implicitFunction, nan, nan);
-    }
+  // Now the implicit function
+  if (implicitFunction) {
+    if (prog)
+      prog->report("Applying implicit function.");
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    outWS->applyImplicitFunction(implicitFunction, nan, nan);
+  }
 
-    // return the size of the input workspace write buffer to its initial value
-    // bc->setCacheParameters(sizeof(MDE),writeBufSize);
+  // return the size of the input workspace write buffer to its initial value
+  // bc->setCacheParameters(sizeof(MDE),writeBufSize);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin all the boxes in parallel, each thread adding the signal into its own
+ * buffers. The buffers are then added to the output workspace.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @param transform :: the transformation to the output bins
+ * @param numThreads :: number of threads
+ */
+template <typename MDE, size_t nd>
+void BinMD::binWithThreadBuffers(
+    typename MDEventWorkspace<MDE, nd>::sptr ws,
+    const CoordTransformKernel<nd> &transform, const size_t numThreads) {
+  // The whole output is a single chunk
+  std::vector<size_t> chunkMin(m_outD, 0);
+  std::vector<size_t> chunkMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    chunkMax[bd] = m_binDimensions[bd]->getNBins();
+  std::unique_ptr<MDImplicitFunction> function(
+      this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data()));
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+  if (prog)
+    prog->setNumSteps(boxes.size());
+
+  // The first thread bins into the output workspace, the others into a buffer
+  // holding their signal, error and number of events arrays in turn
+  const size_t numBins = outWS->getNPoints();
+  std::vector<std::vector<signal_t>> buffers(numThreads - 1);
+
+  const auto numBoxes = static_cast<int64_t>(boxes.size());
+  PRAGMA_OMP(parallel for schedule(dynamic, 16) num_threads(static_cast<int>(numThreads)))
+  for (int64_t i = 0; i < numBoxes; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+    BinArrays arrays = {signals, errors, numEvents};
+    if (thread > 0) {
+      auto &buffer = buffers[thread - 1];
+      if (buffer.empty())
+        buffer.resize(3 * numBins, 0.0);
+      arrays = {buffer.data(), buffer.data() + numBins,
+                buffer.data() + 2 * numBins};
+    }
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (box && !box->getIsMasked())
+      this->binMDBox(box, chunkMin.data(), chunkMax.data(), transform, arrays);
+    if (prog)
+      prog->report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t bin = 0; bin < static_cast<int64_t>(numBins); ++bin) {
+    for (const auto &buffer : buffers) {
+      if (buffer.empty())
+        continue;
+      signals[bin] += buffer[bin];
+      errors[bin] += buffer[numBins + bin];
+      numEvents[bin] += buffer[2 * numBins + bin];
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------------
@@ -104,7 +104,7 @@ ConvToMDBase::ConvToMDBase()
       m_NSpectra(0),        // no valid spectra by default.
       m_NumThreads(-1),     // run with all cores availible
       m_ignoreZeros(false), // 0-s added to workspace
-      m_coordinateSystem(Mantid::Kernel::None) {}
+      m_coordinateSystem(Mantid::Kernel::None), m_spillMemoryBudget(0) {}
 
 /**
  * Set the normalization options
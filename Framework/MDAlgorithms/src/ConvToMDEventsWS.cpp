@@ -1,13 +1,25 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
+#include "MantidKernel/FunctionTask.h"
+
+#include <memory>
 
 namespace Mantid {
 namespace MDAlgorithms {
 /**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+ * adds these events to the workspace itself
+ *@param workspaceIndex -- the index of the spectrum to convert
+ *@param qConverter     -- the transformation to use, with its generic variables
+ *                         calculated
+ *@param thread         -- the number of the thread when adding in parallel,
+ *                         UNDEF_SIZET to add the events directly
+ */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                          MDTransfInterface &qConverter,
+                                          size_t thread) {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
@@ -24,7 +36,7 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
   //
@@ -51,7 +63,7 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
     double val = localUnitConv.convertUnits(it->tof());
     double signal = it->weight();
     double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+    if (!qConverter.calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
     sig_err.push_back(static_cast<float>(signal));
@@ -63,25 +75,46 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
 
   // Add them to the MDEW
   size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
+  if (m_spillMemoryBudget > 0)
+    m_OutWSWrapper->addMDDataToSpill(sig_err, run_index, det_ids, allCoord,
+                                     n_added_events);
+  else if (thread == UNDEF_SIZET)
+    m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
+                              n_added_events);
+  else
+    m_OutWSWrapper->addMDDataInParallel(thread, sig_err, run_index, det_ids,
+                                        allCoord, n_added_events);
   return n_added_events;
 }
 
 /** The method runs conversion for a single event list, corresponding to a
  * particular workspace index */
 size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+  return this->convertSpectrum(workspaceIndex, *m_QConverter, UNDEF_SIZET);
+}
 
+/** The method converts the event list of a particular workspace index with the
+ * type of events it holds
+ *@param workspaceIndex -- the index of the spectrum to convert
+ *@param qConverter     -- the transformation to use
+ *@param thread         -- the number of the thread when adding in parallel,
+ *                         UNDEF_SIZET to add the events directly
+ */
+size_t ConvToMDEventsWS::convertSpectrum(size_t workspaceIndex,
+                                         MDTransfInterface &qConverter,
+                                         size_t thread) {
+  // A spectrum of a file-backed workspace is released once converted
+  DataObjects::SpectraPinScope pinned(*m_EventWS);
   switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
   case Mantid::API::TOF:
     return this->convertEventList<Mantid::Types::Event::TofEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, thread);
   case Mantid::API::WEIGHTED:
     return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, thread);
   case Mantid::API::WEIGHTED_NOTIME:
     return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
+        workspaceIndex, qConverter, thread);
   default:
     throw std::runtime_error("EventList had an unexpected data type!");
   }
@@ -113,6 +146,20 @@ ConvToMDEventsWS::initialize(const MDWSDescription &WSD,
 }
 
 void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
+  // With a memory budget, spill the events and build the workspace one
+  // top-level box at a time
+  if (m_spillMemoryBudget > 0) {
+    this->runSpillingConversion(pProgress);
+    return;
+  }
+
+  // Unless running on a single thread, convert the spectra in parallel. The
+  // boxes of a file-backed workspace are written to disk when splitting, which
+  // is done in passes over the whole workspace below.
+  if (m_NumThreads != 0 && !m_OutWSWrapper->pWorkspace()->isFileBacked()) {
+    this->runParallelConversion(pProgress);
+    return;
+  }
 
   // Get the box controller
   Mantid::API::BoxController_sptr bc =
@@ -193,5 +240,105 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
 }
 
+/** Convert the spectra on a pool of threads. Each thread stages the events it
+ * converts and hands them over to the workspace in batches (see
+ * DataObjects::ParallelMDEventInserter): the box tree is never locked and the
+ * boxes are split as they fill up, instead of stopping all the threads to
+ * split them.
+ *@param pProgress -- progress reporter, advanced for each spectrum
+ */
+void ConvToMDEventsWS::runParallelConversion(API::Progress *pProgress) {
+  // if any property dimension is outside of the data range requested, the job
+  // is done;
+  if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
+    return;
+
+  // negative m_NumThreads correspond to all cores used
+  const size_t nThreads = m_NumThreads > 0
+                              ? static_cast<size_t>(m_NumThreads)
+                              : Kernel::ThreadPool::getNumPhysicalCores();
+  pProgress->resetNumSteps(m_NSpectra, 0, 1);
+
+  m_OutWSWrapper->startParallelAdding(nThreads);
+  // The threads take the spectra one at a time, as their numbers of events
+  // vary widely
+  std::atomic<size_t> nextSpectrum(0);
+  Kernel::ThreadPool tp(new Kernel::ThreadSchedulerFIFO(), nThreads);
+  for (size_t thread = 0; thread < nThreads; ++thread) {
+    tp.schedule(new Kernel::FunctionTask(
+        [this, thread, &nextSpectrum, pProgress] {
+          this->convertSpectra(thread, nextSpectrum, pProgress);
+        }));
+  }
+  tp.joinAll();
+  m_OutWSWrapper->finishParallelAdding();
+
+  // Recount totals at the end.
+  m_OutWSWrapper->pWorkspace()->refreshCache();
+  pProgress->report();
+
+  /// Set the special coordinate system flag on the output workspace.
+  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
+}
+
+/** Convert the spectra, spilling the events to a file sorted by top-level box
+ * whenever they use up the memory budget (see DataObjects::MDEventSpiller).
+ * The workspace is then built, and written to its back-end file if it is
+ * file-backed, one top-level box at a time. The spectra are converted on a
+ * pool of threads, which take turns adding their events to the spill.
+ *@param pProgress -- progress reporter, advanced for each spectrum
+ */
+void ConvToMDEventsWS::runSpillingConversion(API::Progress *pProgress) {
+  // if any property dimension is outside of the data range requested, the job
+  // is done;
+  if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
+    return;
+
+  size_t nThreads = 1;
+  if (m_NumThreads > 0)
+    nThreads = static_cast<size_t>(m_NumThreads);
+  else if (m_NumThreads < 0)
+    nThreads = Kernel::ThreadPool::getNumPhysicalCores();
+  pProgress->resetNumSteps(m_NSpectra, 0, 1);
+
+  m_OutWSWrapper->startSpilling(m_spillMemoryBudget, m_spillFilename);
+  std::atomic<size_t> nextSpectrum(0);
+  Kernel::ThreadPool tp(new Kernel::ThreadSchedulerFIFO(), nThreads);
+  for (size_t thread = 0; thread < nThreads; ++thread) {
+    tp.schedule(new Kernel::FunctionTask(
+        [this, thread, &nextSpectrum, pProgress] {
+          this->convertSpectra(thread, nextSpectrum, pProgress);
+        }));
+  }
+  tp.joinAll();
+  m_OutWSWrapper->finishSpilling();
+
+  // Recount totals at the end.
+  m_OutWSWrapper->pWorkspace()->refreshCache();
+  pProgress->report();
+
+  /// Set the special coordinate system flag on the output workspace.
+  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
+}
+
+/** Convert spectra until there are none left, as one of the threads of
+ * runParallelConversion or runSpillingConversion
+ *@param thread       -- the number of the thread
+ *@param nextSpectrum -- the index of the next spectrum to convert, shared by
+ *                       the threads
+ *@param pProgress    -- progress reporter
+ */
+void ConvToMDEventsWS::convertSpectra(size_t thread,
+                                      std::atomic<size_t> &nextSpectrum,
+                                      API::Progress *pProgress) {
+  // The transformation keeps the spectrum-dependent variables: each thread
+  // needs its own copy
+  std::unique_ptr<MDTransfInterface> qConverter(m_QConverter->clone());
+  for (size_t wi = nextSpectrum++; wi < m_NSpectra; wi = nextSpectrum++) {
+    this->convertSpectrum(wi, *qConverter, thread);
+    pProgress->report();
+  }
+}
+
 } // endNamespace DataObjects
 } // endNamespace Mantid
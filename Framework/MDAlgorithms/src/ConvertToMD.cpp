@@ -18,6 +18,7 @@
 #include "MantidKernel/VisibleWhenProperty.h"
 
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/EventWorkspaceFileBacking.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
@@ -112,6 +113,20 @@ void ConvertToMD::init() {
                   "will create the specified file in addition to an output "
                   "workspace. The workspace will load data from the file on "
                   "demand in order to reduce memory use.");
+
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty(
+      "MemoryBudget", 0, mustBeNonNegative,
+      "Only used if FileBackEnd is true and the input is an event workspace. "
+      "If greater than 0, the memory, in MB, to hold the converted events "
+      "in. Whenever they fill it up, the events are spilled to a scratch "
+      "file next to Filename, sorted by top-level box. The workspace is then "
+      "built and written to Filename one top-level box at a time, so that "
+      "the memory used grows with the largest top-level box rather than with "
+      "the number of events.");
+  setPropertySettings("MemoryBudget", make_unique<EnabledWhenProperty>(
+                                          "FileBackEnd", IS_EQUAL_TO, "1"));
 }
 //----------------------------------------------------------------------------------------------
 
@@ -255,6 +270,11 @@ void ConvertToMD::exec() {
   // copy the metadata, necessary for resolution corrections
   copyMetaData(spws);
 
+  const int memoryBudget = getProperty("MemoryBudget");
+  if (fileBackEnd && memoryBudget > 0)
+    m_Convertor->setSpilling(static_cast<size_t>(memoryBudget) * 1024 * 1024,
+                             out_filename + ".spill");
+
   // progress reporter
   m_Progress.reset(new API::Progress(this, 0.0, 1.0, n_steps));
 
@@ -347,7 +367,10 @@ void ConvertToMD::copyMetaData(API::IMDEventWorkspace_sptr &mdEventWS) const {
   }
 
   // retrieve representative bin boundaries
-  auto binBoundaries = m_InWS2D->x(spectra_index);
+  auto binBoundaries = [this, spectra_index] {
+    DataObjects::SpectraPinScope pinned(*m_InWS2D);
+    return m_InWS2D->x(spectra_index);
+  }();
 
   // check if the boundaries transformation is necessary
   if (m_Convertor->getUnitConversionHelper().isUnitConverted()) {
@@ -377,6 +400,7 @@ void ConvertToMD::copyMetaData(API::IMDEventWorkspace_sptr &mdEventWS) const {
   // objects instead
   auto mapping = boost::make_shared<det2group_map>();
   for (size_t i = 0; i < m_InWS2D->getNumberHistograms(); ++i) {
+    DataObjects::SpectraPinScope pinned(*m_InWS2D);
     const auto &dets = m_InWS2D->getSpectrum(i).getDetectorIDs();
     if (!dets.empty())
       mapping->emplace(*dets.begin(), dets);
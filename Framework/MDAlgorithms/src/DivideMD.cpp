@@ -4,6 +4,7 @@
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -113,7 +114,9 @@ void DivideMD::execEvent() {
 void DivideMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->divide(*operand);
+  MDHistoExpression::divide(MDHistoExpression::workspace(out),
+                            MDHistoExpression::workspace(operand))
+      ->evaluate(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -121,7 +124,10 @@ void DivideMD::execHistoHisto(
 void DivideMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->divide(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression::divide(
+      MDHistoExpression::workspace(out),
+      MDHistoExpression::scalar(scalar->y(0)[0], scalar->e(0)[0]))
+      ->evaluate(*out);
 }
 
 } // namespace Mantid
@@ -0,0 +1,249 @@
+#include "MantidMDAlgorithms/EvaluateMDHistoExpression.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/IMDHistoWorkspace.h"
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/MandatoryValidator.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using Mantid::DataObjects::MDHistoExpression;
+using Mantid::DataObjects::MDHistoWorkspace;
+using Mantid::DataObjects::MDHistoWorkspace_const_sptr;
+using Mantid::DataObjects::MDHistoWorkspace_sptr;
+
+namespace {
+/** Recursive descent parser of an expression over workspaces:
+ *
+ *   expression := term (('+' | '-') term)*
+ *   term := factor (('*' | '/') factor)*
+ *   factor := '-' factor | primary ('^' number)?
+ *   primary := number | name | function '(' expression ')' |
+ *              '(' expression ')'
+ *
+ * with the functions log, log10 and exp. A number is a scalar without error.
+ */
+class ExpressionParser {
+public:
+  ExpressionParser(const std::string &text,
+                   const std::map<std::string, MDHistoExpression::sptr> &names,
+                   const double filler)
+      : m_text(text), m_names(names), m_filler(filler), m_pos(0) {}
+
+  /// @return the expression of the whole text
+  MDHistoExpression::sptr parse() {
+    auto result = expression();
+    skipSpaces();
+    if (m_pos != m_text.size())
+      fail("unexpected '" + m_text.substr(m_pos, 1) + "'");
+    return result;
+  }
+
+private:
+  MDHistoExpression::sptr expression() {
+    auto result = term();
+    while (true) {
+      if (accept('+'))
+        result = MDHistoExpression::plus(result, term());
+      else if (accept('-'))
+        result = MDHistoExpression::minus(result, term());
+      else
+        return result;
+    }
+  }
+
+  MDHistoExpression::sptr term() {
+    auto result = factor();
+    while (true) {
+      if (accept('*'))
+        result = MDHistoExpression::multiply(result, factor());
+      else if (accept('/'))
+        result = MDHistoExpression::divide(result, factor());
+      else
+        return result;
+    }
+  }
+
+  MDHistoExpression::sptr factor() {
+    if (accept('-'))
+      return MDHistoExpression::multiply(MDHistoExpression::scalar(-1.0, 0.0),
+                                         factor());
+    auto result = primary();
+    if (accept('^')) {
+      const bool negative = accept('-');
+      const double exponent = number();
+      result =
+          MDHistoExpression::power(result, negative ? -exponent : exponent);
+    }
+    return result;
+  }
+
+  MDHistoExpression::sptr primary() {
+    skipSpaces();
+    if (accept('(')) {
+      auto result = expression();
+      expect(')');
+      return result;
+    }
+    if (m_pos < m_text.size() &&
+        (std::isdigit(static_cast<unsigned char>(m_text[m_pos])) ||
+         m_text[m_pos] == '.'))
+      return MDHistoExpression::scalar(number(), 0.0);
+
+    const std::string name = identifier();
+    if (name == "log" || name == "log10" || name == "exp") {
+      expect('(');
+      auto operand = expression();
+      expect(')');
+      if (name == "log")
+        return MDHistoExpression::log(operand, m_filler);
+      if (name == "log10")
+        return MDHistoExpression::log10(operand, m_filler);
+      return MDHistoExpression::exp(operand);
+    }
+    auto workspace = m_names.find(name);
+    if (workspace == m_names.end())
+      fail("'" + name + "' is not one of the InputWorkspaces");
+    return workspace->second;
+  }
+
+  double number() {
+    skipSpaces();
+    const char *begin = m_text.c_str() + m_pos;
+    char *end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin)
+      fail("a number is expected");
+    m_pos += static_cast<size_t>(end - begin);
+    return value;
+  }
+
+  std::string identifier() {
+    skipSpaces();
+    const size_t begin = m_pos;
+    while (m_pos < m_text.size() &&
+           (std::isalnum(static_cast<unsigned char>(m_text[m_pos])) ||
+            m_text[m_pos] == '_'))
+      ++m_pos;
+    if (m_pos == begin)
+      fail(m_pos < m_text.size() ? "unexpected '" + m_text.substr(m_pos, 1) +
+                                       "'"
+                                 : "unexpected end");
+    return m_text.substr(begin, m_pos - begin);
+  }
+
+  void skipSpaces() {
+    while (m_pos < m_text.size() &&
+           std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+      ++m_pos;
+  }
+
+  bool accept(const char c) {
+    skipSpaces();
+    if (m_pos < m_text.size() && m_text[m_pos] == c) {
+      ++m_pos;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(const char c) {
+    if (!accept(c))
+      fail(std::string("'") + c + "' is expected");
+  }
+
+  void fail(const std::string &message) const {
+    throw std::invalid_argument("Invalid Expression at position " +
+                                std::to_string(m_pos) + ": " + message +
+                                ".");
+  }
+
+  const std::string &m_text;
+  const std::map<std::string, MDHistoExpression::sptr> &m_names;
+  const double m_filler;
+  size_t m_pos;
+};
+} // namespace
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(EvaluateMDHistoExpression)
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithm's version for identification. @see Algorithm::version
+int EvaluateMDHistoExpression::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const std::string EvaluateMDHistoExpression::category() const {
+  return "MDAlgorithms\\MDArithmetic";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const std::string EvaluateMDHistoExpression::summary() const {
+  return "Evaluates an arithmetic expression over MDHistoWorkspaces in a "
+         "single pass, without intermediate workspaces.";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void EvaluateMDHistoExpression::init() {
+  declareProperty(
+      Kernel::make_unique<ArrayProperty<std::string>>(
+          "InputWorkspaces",
+          boost::make_shared<MandatoryValidator<std::vector<std::string>>>()),
+      "The names of the input MDHistoWorkspaces as a comma-separated list. "
+      "They must all have the same number of bins.");
+  declareProperty("Expression", "",
+                  boost::make_shared<MandatoryValidator<std::string>>(),
+                  "The expression, with the names of the InputWorkspaces, "
+                  "numbers, + - * /, ^ with a number as exponent, and the "
+                  "functions log, log10 and exp. For example "
+                  "log((a + b) * c / 2).");
+  declareProperty("Filler", 0.0, "The value of log(x) and log10(x) for the "
+                                 "bins where x <= 0.");
+  declareProperty(Kernel::make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "An output workspace, with the dimensions and masks of the "
+                  "first of the InputWorkspaces.");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void EvaluateMDHistoExpression::exec() {
+  const std::vector<std::string> inputs = getProperty("InputWorkspaces");
+  std::map<std::string, MDHistoExpression::sptr> names;
+  MDHistoWorkspace_const_sptr first;
+  for (const auto &input : inputs) {
+    MDHistoWorkspace_const_sptr ws =
+        AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(input);
+    if (!ws)
+      throw std::invalid_argument("Workspace " + input +
+                                  " is not a MDHistoWorkspace.");
+    if (!first)
+      first = ws;
+    names[input] = MDHistoExpression::workspace(ws);
+  }
+
+  const std::string text = getProperty("Expression");
+  const double filler = getProperty("Filler");
+  auto expression = ExpressionParser(text, names, filler).parse();
+
+  // Only the output is allocated: the expression overwrites its values
+  MDHistoWorkspace_sptr out(first->clone());
+  expression->evaluate(*out);
+  setProperty("OutputWorkspace",
+              boost::static_pointer_cast<IMDHistoWorkspace>(out));
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -1,8 +1,10 @@
 #include "MantidMDAlgorithms/ExponentialMD.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
+using Mantid::DataObjects::MDHistoExpression;
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -37,7 +39,7 @@ void ExponentialMD::execEvent(Mantid::API::IMDEventWorkspace_sptr /*out*/) {
 //----------------------------------------------------------------------------------------------
 /// ExponentialMD::Run the algorithm with a MDHistoWorkspace
 void ExponentialMD::execHisto(Mantid::DataObjects::MDHistoWorkspace_sptr out) {
-  out->exp();
+  MDHistoExpression::exp(MDHistoExpression::workspace(out))->evaluate(*out);
 }
 
 } // namespace Mantid
@@ -13,8 +13,10 @@
 #include "MantidAPI/TableRow.h"
 #include "MantidAPI/TextAxis.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/CompactMDEventLayout.h"
 #include "MantidDataObjects/CoordTransformDistance.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDSphereIntegrator.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
@@ -148,6 +150,12 @@ void IntegratePeaksMD2::init() {
                   "If this options is enabled, then the the top 1% of the "
                   "background will be removed"
                   "before the background subtraction.");
+
+  declareProperty("UseCompactLayout", false,
+                  "Copy the events into one contiguous array in Morton order "
+                  "before integrating, and integrate every sphere from that "
+                  "copy rather than from the box tree. Needs memory for a "
+                  "second copy of the events; ignored for cylinders.");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -288,6 +296,13 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
+
+  // Freeze the events into the compact layout once, for all the spheres
+  std::unique_ptr<CompactMDEventLayout<MDE, nd>> layout;
+  bool useCompactLayout = getProperty("UseCompactLayout");
+  if (useCompactLayout && !cylinderBool && nPeaks > 0)
+    layout = Kernel::make_unique<CompactMDEventLayout<MDE, nd>>(*ws);
+
   Progress progress(this, 0., 1., nPeaks);
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
@@ -362,7 +377,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
       BackgroundOuterRadiusVector[i] =
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
+      MDSphereIntegrator<MDE, nd> sphere(center, dimensionsUsed);
 
       if (Peak *shapeablePeak = dynamic_cast<Peak *>(&p)) {
 
@@ -374,27 +389,39 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       }
 
       // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(
-          sphere, static_cast<coord_t>(adaptiveRadius * adaptiveRadius), signal,
-          errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      const auto radiusSquared =
+          static_cast<coord_t>(adaptiveRadius * adaptiveRadius);
+      if (layout)
+        layout->integrateSphere(center, radiusSquared, signal, errorSquared,
+                                0.0 /* innerRadiusSquared */,
+                                useOnePercentBackgroundCorrection);
+      else
+        sphere.integrate(ws->getBox(), radiusSquared, signal, errorSquared,
+                         0.0 /* innerRadiusSquared */,
+                         useOnePercentBackgroundCorrection);
 
       // Integrate around the background radius
 
       if (BackgroundOuterRadius > PeakRadius) {
         // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(
-            sphere,
+        const auto bgOuterRadiusSquared =
             static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
                                   BackgroundOuterRadius) *
                                  (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius)),
-            bgSignal, bgErrorSquared,
+                                  BackgroundOuterRadius));
+        const auto bgInnerRadiusSquared =
             static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
                                   BackgroundInnerRadius) *
                                  (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius)),
-            useOnePercentBackgroundCorrection);
+                                  BackgroundInnerRadius));
+        if (layout)
+          layout->integrateSphere(center, bgOuterRadiusSquared, bgSignal,
+                                  bgErrorSquared, bgInnerRadiusSquared,
+                                  useOnePercentBackgroundCorrection);
+        else
+          sphere.integrate(ws->getBox(), bgOuterRadiusSquared, bgSignal,
+                           bgErrorSquared, bgInnerRadiusSquared,
+                           useOnePercentBackgroundCorrection);
 
         // Relative volume of peak vs the BackgroundOuterRadius sphere
         double ratio = (PeakRadius / BackgroundOuterRadius);
@@ -27,8 +27,10 @@
 #include "MantidMDAlgorithms/SetMDFrame.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
+#include <algorithm>
 #include <iostream>
 #include <nexus/NeXusException.hpp>
+#include <numeric>
 #include <vector>
 
 using file_holder_type = std::unique_ptr<Mantid::API::IBoxControllerIO>;
@@ -583,7 +585,16 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     const std::vector<uint64_t> &BoxEventIndex = FlatBoxTree.getEventIndex();
     prog->setNumSteps(numBoxes);
 
-    for (size_t i = 0; i < numBoxes; i++) {
+    // Visit the boxes in the order of their events on file, so the file is
+    // read sequentially whether it was saved in box ID or Morton order.
+    std::vector<size_t> fileOrder(numBoxes);
+    std::iota(fileOrder.begin(), fileOrder.end(), size_t(0));
+    std::stable_sort(fileOrder.begin(), fileOrder.end(),
+                     [&BoxEventIndex](const size_t a, const size_t b) {
+                       return BoxEventIndex[2 * a] < BoxEventIndex[2 * b];
+                     });
+
+    for (const size_t i : fileOrder) {
       prog->report();
       MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxTree[i]);
       if (!box)
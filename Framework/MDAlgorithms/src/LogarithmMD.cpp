@@ -1,8 +1,10 @@
 #include "MantidMDAlgorithms/LogarithmMD.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
+using Mantid::DataObjects::MDHistoExpression;
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -53,10 +55,11 @@ void LogarithmMD::execEvent(Mantid::API::IMDEventWorkspace_sptr /*out*/) {
 void LogarithmMD::execHisto(Mantid::DataObjects::MDHistoWorkspace_sptr out) {
   bool natural = getProperty("Natural");
   double filler = getProperty("Filler");
+  auto operand = MDHistoExpression::workspace(out);
   if (natural)
-    out->log(filler);
+    MDHistoExpression::log(operand, filler)->evaluate(*out);
   else
-    out->log10(filler);
+    MDHistoExpression::log10(operand, filler)->evaluate(*out);
 }
 
 } // namespace Mantid
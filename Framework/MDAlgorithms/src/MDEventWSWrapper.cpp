@@ -1,6 +1,10 @@
 #include "MantidMDAlgorithms/MDEventWSWrapper.h"
+#include "MantidDataObjects/MDEventSpiller.h"
+#include "MantidDataObjects/ParallelMDEventInserter.h"
 #include "MantidGeometry/MDGeometry/MDTypes.h"
 
+#include <boost/make_shared.hpp>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -120,6 +124,221 @@ void MDEventWSWrapper::addMDDataND<0>(float *, uint16_t *, uint32_t *,
                               "to 0-dimensional workspace"));
 }
 
+/** templated by number of dimensions function to prepare adding events to the
+workspace from a number of threads
+*@param numThreads -- the number of threads, which will add events
+*/
+template <size_t nd>
+void MDEventWSWrapper::startParallelAddingND(size_t numThreads) {
+  DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
+      dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get());
+  if (pWs) {
+    m_parallelInserter = boost::make_shared<
+        DataObjects::ParallelMDEventInserter<DataObjects::MDEvent<nd>, nd>>(
+        *pWs, numThreads);
+  } else {
+    DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *const
+        pLWs = dynamic_cast<
+            DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *>(
+            m_Workspace.get());
+
+    if (!pLWs)
+      throw std::runtime_error("Bad Cast: Target MD workspace to add events "
+                               "does not correspond to type of events you try "
+                               "to add to it");
+    m_parallelInserter = boost::make_shared<
+        DataObjects::ParallelMDEventInserter<DataObjects::MDLeanEvent<nd>, nd>>(
+        *pLWs, numThreads);
+  }
+}
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <> void MDEventWSWrapper::startParallelAddingND<0>(size_t) {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
+/** templated by number of dimensions function to add multidimensional data to
+the workspace from one of the threads adding in parallel. The events are
+staged and inserted into the workspace in batches.
+
+*@param thread   -- the number of the calling thread, from 0 to the number of
+threads given to startParallelAdding
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+signal and squared error
+*@param runIndex -- pointer to the beginning of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containing the
+coordinates of nd-dimensional events
+*
+*@param dataSize -- the length of the vector of MD events
+*/
+template <size_t nd>
+void MDEventWSWrapper::addMDDataInParallelND(size_t thread, float *sigErr,
+                                             uint16_t *runIndex,
+                                             uint32_t *detId, coord_t *Coord,
+                                             size_t dataSize) {
+  if (dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get())) {
+    auto inserter = static_cast<
+        DataObjects::ParallelMDEventInserter<DataObjects::MDEvent<nd>, nd> *>(
+        m_parallelInserter.get());
+    for (size_t i = 0; i < dataSize; i++) {
+      inserter->addEvent(thread, DataObjects::MDEvent<nd>(
+                                     *(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                                     *(runIndex + i), *(detId + i),
+                                     (Coord + i * nd)));
+    }
+  } else {
+    auto inserter = static_cast<DataObjects::ParallelMDEventInserter<
+        DataObjects::MDLeanEvent<nd>, nd> *>(m_parallelInserter.get());
+    for (size_t i = 0; i < dataSize; i++) {
+      inserter->addEvent(thread, DataObjects::MDLeanEvent<nd>(
+                                     *(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                                     (Coord + i * nd)));
+    }
+  }
+}
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <>
+void MDEventWSWrapper::addMDDataInParallelND<0>(size_t, float *, uint16_t *,
+                                                uint32_t *, coord_t *, size_t) {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
+/// templated by number of dimensions function to insert all the events added
+/// in parallel into the workspace
+template <size_t nd> void MDEventWSWrapper::finishParallelAddingND() {
+  if (dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get()))
+    static_cast<
+        DataObjects::ParallelMDEventInserter<DataObjects::MDEvent<nd>, nd> *>(
+        m_parallelInserter.get())
+        ->finish();
+  else
+    static_cast<DataObjects::ParallelMDEventInserter<
+        DataObjects::MDLeanEvent<nd>, nd> *>(m_parallelInserter.get())
+        ->finish();
+}
+/// the function used in template metaloop termination on 0 dimensions
+template <> void MDEventWSWrapper::finishParallelAddingND<0>() {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
+/** templated by number of dimensions function to prepare adding events to the
+workspace through a spill file
+*@param memoryBudget  -- bytes of events to buffer before spilling them
+*@param spillFilename -- path of the spill file
+*/
+template <size_t nd>
+void MDEventWSWrapper::startSpillingND(size_t memoryBudget,
+                                       const std::string &spillFilename) {
+  DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
+      dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get());
+  if (pWs) {
+    m_spiller = boost::make_shared<
+        DataObjects::MDEventSpiller<DataObjects::MDEvent<nd>, nd>>(
+        *pWs, memoryBudget, spillFilename);
+  } else {
+    DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *const
+        pLWs = dynamic_cast<
+            DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *>(
+            m_Workspace.get());
+
+    if (!pLWs)
+      throw std::runtime_error("Bad Cast: Target MD workspace to add events "
+                               "does not correspond to type of events you try "
+                               "to add to it");
+    m_spiller = boost::make_shared<
+        DataObjects::MDEventSpiller<DataObjects::MDLeanEvent<nd>, nd>>(
+        *pLWs, memoryBudget, spillFilename);
+  }
+}
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <>
+void MDEventWSWrapper::startSpillingND<0>(size_t, const std::string &) {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
+/** templated by number of dimensions function to add multidimensional data to
+the spill
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+signal and squared error
+*@param runIndex -- pointer to the beginning of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containing the
+coordinates of nd-dimensional events
+*
+*@param dataSize -- the length of the vector of MD events
+*/
+template <size_t nd>
+void MDEventWSWrapper::addMDDataToSpillND(float *sigErr, uint16_t *runIndex,
+                                          uint32_t *detId, coord_t *Coord,
+                                          size_t dataSize) {
+  if (dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get())) {
+    auto spiller = static_cast<
+        DataObjects::MDEventSpiller<DataObjects::MDEvent<nd>, nd> *>(
+        m_spiller.get());
+    for (size_t i = 0; i < dataSize; i++) {
+      spiller->addEvent(DataObjects::MDEvent<nd>(
+          *(sigErr + 2 * i), *(sigErr + 2 * i + 1), *(runIndex + i),
+          *(detId + i), (Coord + i * nd)));
+    }
+  } else {
+    auto spiller = static_cast<
+        DataObjects::MDEventSpiller<DataObjects::MDLeanEvent<nd>, nd> *>(
+        m_spiller.get());
+    for (size_t i = 0; i < dataSize; i++) {
+      spiller->addEvent(DataObjects::MDLeanEvent<nd>(
+          *(sigErr + 2 * i), *(sigErr + 2 * i + 1), (Coord + i * nd)));
+    }
+  }
+}
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <>
+void MDEventWSWrapper::addMDDataToSpillND<0>(float *, uint16_t *, uint32_t *,
+                                             coord_t *, size_t) {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
+/// templated by number of dimensions function to insert all the spilled
+/// events into the workspace
+template <size_t nd> void MDEventWSWrapper::finishSpillingND() {
+  if (dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get()))
+    static_cast<DataObjects::MDEventSpiller<DataObjects::MDEvent<nd>, nd> *>(
+        m_spiller.get())
+        ->finish();
+  else
+    static_cast<
+        DataObjects::MDEventSpiller<DataObjects::MDLeanEvent<nd>, nd> *>(
+        m_spiller.get())
+        ->finish();
+}
+/// the function used in template metaloop termination on 0 dimensions
+template <> void MDEventWSWrapper::finishSpillingND<0>() {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
 /***/
 template <size_t nd> void MDEventWSWrapper::splitBoxList() {
   DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
@@ -226,6 +445,95 @@ void MDEventWSWrapper::addMDData(std::vector<float> &sigErr,
                                              &detId[0], &Coord[0], dataSize);
 }
 
+/** method prepares adding data to the workspace, which was initiated before,
+*from several threads at once. Each thread then calls addMDDataInParallel with
+*its own number and, once all of them are done, finishParallelAdding has to be
+*called, followed by refreshCache() on the workspace.
+*
+*@param numThreads -- the number of threads, which will add data
+*/
+void MDEventWSWrapper::startParallelAdding(size_t numThreads) {
+  (this->*(mdParallelAddingStarter[m_NDimensions]))(numThreads);
+}
+
+/** method adds the data to the workspace from one of the threads adding in
+*parallel. Thread-safe as long as each thread gives its own number.
+*@param thread   -- the number of the calling thread, from 0 to the number of
+*threads given to startParallelAdding
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+*signal and squared error
+*@param runIndex -- pointer to the beginnign of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+*detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containig the
+*coordinates od nd-dimensional events
+*
+*@param dataSize -- the length of the vector of MD events
+*/
+void MDEventWSWrapper::addMDDataInParallel(size_t thread,
+                                           std::vector<float> &sigErr,
+                                           std::vector<uint16_t> &runIndex,
+                                           std::vector<uint32_t> &detId,
+                                           std::vector<coord_t> &Coord,
+                                           size_t dataSize) {
+  if (dataSize == 0)
+    return;
+  (this->*(mdEvAddInParallel[m_NDimensions]))(
+      thread, &sigErr[0], &runIndex[0], &detId[0], &Coord[0], dataSize);
+}
+
+/** method inserts all the data added in parallel into the workspace. To be
+called once all the threads are done adding. */
+void MDEventWSWrapper::finishParallelAdding() {
+  (this->*(mdParallelAddingFinisher[m_NDimensions]))();
+  m_parallelInserter.reset();
+}
+
+/** method prepares adding data to the workspace, which was initiated before,
+*through a spill file. The data added with addMDDataToSpill are buffered within
+*the memory budget and spilled to the file, sorted by top-level box; once all
+*the data are added, finishSpilling has to be called, followed by
+*refreshCache() on the workspace.
+*
+*@param memoryBudget  -- bytes of events to buffer before spilling them
+*@param spillFilename -- path of the spill file, removed by finishSpilling
+*/
+void MDEventWSWrapper::startSpilling(size_t memoryBudget,
+                                     const std::string &spillFilename) {
+  (this->*(mdSpillingStarter[m_NDimensions]))(memoryBudget, spillFilename);
+}
+
+/** method adds the data to the spill. Thread-safe: the calls are serialized.
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+*signal and squared error
+*@param runIndex -- pointer to the beginnign of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+*detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containig the
+*coordinates od nd-dimensional events
+*
+*@param dataSize -- the length of the vector of MD events
+*/
+void MDEventWSWrapper::addMDDataToSpill(std::vector<float> &sigErr,
+                                        std::vector<uint16_t> &runIndex,
+                                        std::vector<uint32_t> &detId,
+                                        std::vector<coord_t> &Coord,
+                                        size_t dataSize) {
+  if (dataSize == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_spillMutex);
+  (this->*(mdEvAddToSpill[m_NDimensions]))(&sigErr[0], &runIndex[0],
+                                           &detId[0], &Coord[0], dataSize);
+}
+
+/** method inserts all the spilled data into the workspace, one top-level box
+at a time, and removes the spill file. To be called once all the data are
+added. */
+void MDEventWSWrapper::finishSpilling() {
+  (this->*(mdSpillingFinisher[m_NDimensions]))();
+  m_spiller.reset();
+}
+
 /** method should be called at the end of the algorithm, to let the workspace
 manager know that it has whole responsibility for the workspace
 (As the algorithm is static, it will hold the pointer to the workspace
@@ -249,6 +557,14 @@ public:
     pH->mdEvAddAndForget[i] = &MDEventWSWrapper::addMDDataND<i>;
     pH->mdCalCentroid[i] = &MDEventWSWrapper::calcCentroidND<i>;
     pH->mdBoxListSplitter[i] = &MDEventWSWrapper::splitBoxList<i>;
+    pH->mdParallelAddingStarter[i] =
+        &MDEventWSWrapper::startParallelAddingND<i>;
+    pH->mdEvAddInParallel[i] = &MDEventWSWrapper::addMDDataInParallelND<i>;
+    pH->mdParallelAddingFinisher[i] =
+        &MDEventWSWrapper::finishParallelAddingND<i>;
+    pH->mdSpillingStarter[i] = &MDEventWSWrapper::startSpillingND<i>;
+    pH->mdEvAddToSpill[i] = &MDEventWSWrapper::addMDDataToSpillND<i>;
+    pH->mdSpillingFinisher[i] = &MDEventWSWrapper::finishSpillingND<i>;
   }
 };
 // the class terminates the compitlation-time metaloop and sets up functions
@@ -260,6 +576,14 @@ public:
     pH->mdEvAddAndForget[0] = &MDEventWSWrapper::addMDDataND<0>;
     pH->mdCalCentroid[0] = &MDEventWSWrapper::calcCentroidND<0>;
     pH->mdBoxListSplitter[0] = &MDEventWSWrapper::splitBoxList<0>;
+    pH->mdParallelAddingStarter[0] =
+        &MDEventWSWrapper::startParallelAddingND<0>;
+    pH->mdEvAddInParallel[0] = &MDEventWSWrapper::addMDDataInParallelND<0>;
+    pH->mdParallelAddingFinisher[0] =
+        &MDEventWSWrapper::finishParallelAddingND<0>;
+    pH->mdSpillingStarter[0] = &MDEventWSWrapper::startSpillingND<0>;
+    pH->mdEvAddToSpill[0] = &MDEventWSWrapper::addMDDataToSpillND<0>;
+    pH->mdSpillingFinisher[0] = &MDEventWSWrapper::finishSpillingND<0>;
   }
 };
 
@@ -270,6 +594,12 @@ MDEventWSWrapper::MDEventWSWrapper()
   mdEvAddAndForget.resize(MAX_N_DIM + 1);
   mdCalCentroid.resize(MAX_N_DIM + 1);
   mdBoxListSplitter.resize(MAX_N_DIM + 1);
+  mdParallelAddingStarter.resize(MAX_N_DIM + 1);
+  mdEvAddInParallel.resize(MAX_N_DIM + 1);
+  mdParallelAddingFinisher.resize(MAX_N_DIM + 1);
+  mdSpillingStarter.resize(MAX_N_DIM + 1);
+  mdEvAddToSpill.resize(MAX_N_DIM + 1);
+  mdSpillingFinisher.resize(MAX_N_DIM + 1);
   LOOP<MAX_N_DIM>::EXEC(this);
 }
 
@@ -8,6 +8,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/SparseMDHistoGrid.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ConfigService.h"
@@ -15,6 +16,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/MDNormalizationHelper.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -462,6 +464,9 @@ void MDNormDirectSC::calculateNormalization(
         (*rubwLog)()); // includes the 2*pi factor but not goniometer for now :)
     m_rubw = exptInfoZero.run().getGoniometerMatrix() * rubwValue;
     m_rubw.Invert();
+    if (convention == "Crystallography") {
+      m_rubw *= -1.0;
+    }
   }
   const double protonCharge = exptInfoZero.run().getProtonCharge();
 
@@ -479,7 +484,10 @@ void MDNormDirectSC::calculateNormalization(
   }
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  // Accumulate in a scratch grid before writing to the dense output. Most bins
+  // of the normalization are often empty: only the bricks of bins that are
+  // hit take memory
+  SparseMDHistoGrid signalGrid(m_normWS->getNPoints());
   std::vector<std::array<double, 4>> intersections;
   std::vector<coord_t> pos, posNew;
   auto prog = make_unique<API::Progress>(this, 0.3, 1.0, ndets);
@@ -540,8 +548,7 @@ for (int64_t i = 0; i < ndets; i++) {
     // signal = integral between two consecutive intersections *solid angle
     // *PC
     double signal = solid * delta;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    signalGrid.addSignal(linIndex, signal);
   }
   prog->report();
 
@@ -549,13 +556,9 @@ for (int64_t i = 0; i < ndets; i++) {
 }
 PARALLEL_CHECK_INTERUPT_REGION
 if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->getSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
+  signalGrid.addTo(*m_normWS);
 } else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->getSignalArray());
+  signalGrid.copyTo(*m_normWS);
 }
 }
 
@@ -575,10 +578,6 @@ void MDNormDirectSC::calculateIntersections(
 
   qout = m_rubw * qout;
   qin = m_rubw * qin;
-  if (convention == "Crystallography") {
-    qout *= -1;
-    qin *= -1;
-  }
   double hStart = qin.X() - qout.X() * m_kfmin,
          hEnd = qin.X() - qout.X() * m_kfmax;
   double kStart = qin.Y() - qout.Y() * m_kfmin,
@@ -600,10 +599,11 @@ void MDNormDirectSC::calculateIntersections(
     double fk = (kEnd - kStart) / (hEnd - hStart);
     double fl = (lEnd - lStart) / (hEnd - hStart);
     if (!m_hIntegrated) {
-      for (size_t i = 0; i < hNBins; i++) {
+      // only the planes between hStart and hEnd can be crossed
+      const auto planes = planesBetween(m_hX, hStart, hEnd);
+      for (size_t i = planes.first; i < planes.second; i++) {
         double hi = m_hX[i];
-        if ((hi >= m_hmin) && (hi <= m_hmax) &&
-            ((hStart - hi) * (hEnd - hi) < 0)) {
+        if ((hi >= m_hmin) && (hi <= m_hmax)) {
           // if hi is between hStart and hEnd, then ki and li will be between
           // kStart, kEnd and lStart, lEnd and momi will be between m_kfmin and
           // m_kfmax
@@ -646,10 +646,11 @@ void MDNormDirectSC::calculateIntersections(
     double fh = (hEnd - hStart) / (kEnd - kStart);
     double fl = (lEnd - lStart) / (kEnd - kStart);
     if (!m_kIntegrated) {
-      for (size_t i = 0; i < kNBins; i++) {
+      // only the planes between kStart and kEnd can be crossed
+      const auto planes = planesBetween(m_kX, kStart, kEnd);
+      for (size_t i = planes.first; i < planes.second; i++) {
         double ki = m_kX[i];
-        if ((ki >= m_kmin) && (ki <= m_kmax) &&
-            ((kStart - ki) * (kEnd - ki) < 0)) {
+        if ((ki >= m_kmin) && (ki <= m_kmax)) {
           // if ki is between kStart and kEnd, then hi and li will be between
           // hStart, hEnd and lStart, lEnd and momi will be between m_kfmin and
           // m_kfmax
@@ -691,10 +692,11 @@ void MDNormDirectSC::calculateIntersections(
     double fh = (hEnd - hStart) / (lEnd - lStart);
     double fk = (kEnd - kStart) / (lEnd - lStart);
     if (!m_lIntegrated) {
-      for (size_t i = 0; i < lNBins; i++) {
+      // only the planes between lStart and lEnd can be crossed
+      const auto planes = planesBetween(m_lX, lStart, lEnd);
+      for (size_t i = planes.first; i < planes.second; i++) {
         double li = m_lX[i];
-        if ((li >= m_lmin) && (li <= m_lmax) &&
-            ((lStart - li) * (lEnd - li) < 0)) {
+        if ((li >= m_lmin) && (li <= m_lmax)) {
           double hi = fh * (li - lStart) + hStart;
           double ki = fk * (li - lStart) + kStart;
           if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
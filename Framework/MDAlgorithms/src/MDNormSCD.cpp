@@ -9,12 +9,14 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/SparseMDHistoGrid.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/MDNormalizationHelper.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -415,6 +417,9 @@ void MDNormSCD::calculateNormalization(
         (*rubwLog)()); // includes the 2*pi factor but not goniometer for now :)
     m_rubw = exptInfoZero.run().getGoniometerMatrix() * rubwValue;
     m_rubw.Invert();
+    if (convention == "Crystallography") {
+      m_rubw *= -1.0;
+    }
   }
   const double protonCharge = exptInfoZero.run().getProtonCharge();
 
@@ -428,7 +433,10 @@ void MDNormSCD::calculateNormalization(
       solidAngleWS->getDetectorIDToWorkspaceIndexMap();
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  // Accumulate in a scratch grid before writing to the dense output. Most bins
+  // of the normalization are often empty: only the bricks of bins that are
+  // hit take memory
+  SparseMDHistoGrid signalGrid(m_normWS->getNPoints());
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
@@ -501,8 +509,7 @@ for (int64_t i = 0; i < ndets; i++) {
     size_t k = static_cast<size_t>(std::distance(intersectionsBegin, it));
     // signal = integral between two consecutive intersections
     signal_t signal = (yValues[k] - yValues[k - 1]) * solid;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    signalGrid.addSignal(linIndex, signal);
   }
   prog->report();
 
@@ -510,13 +517,9 @@ for (int64_t i = 0; i < ndets; i++) {
 }
 PARALLEL_CHECK_INTERUPT_REGION
 if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->getSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
+  signalGrid.addTo(*m_normWS);
 } else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->getSignalArray());
+  signalGrid.copyTo(*m_normWS);
 }
 }
 
@@ -609,9 +612,6 @@ void MDNormSCD::calculateIntersections(
     const double phi) {
   V3D q(-sin(theta) * cos(phi), -sin(theta) * sin(phi), 1. - cos(theta));
   q = m_rubw * q;
-  if (convention == "Crystallography") {
-    q *= -1;
-  }
 
   double hStart = q.X() * m_kiMin, hEnd = q.X() * m_kiMax;
   double kStart = q.Y() * m_kiMin, kEnd = q.Y() * m_kiMax;
@@ -631,10 +631,11 @@ void MDNormSCD::calculateIntersections(
     double fk = (kEnd - kStart) / (hEnd - hStart);
     double fl = (lEnd - lStart) / (hEnd - hStart);
     if (!m_hIntegrated) {
-      for (size_t i = 0; i < hNBins; i++) {
+      // only the planes between hStart and hEnd can be crossed
+      const auto planes = planesBetween(m_hX, hStart, hEnd);
+      for (size_t i = planes.first; i < planes.second; i++) {
         double hi = m_hX[i];
-        if ((hi >= m_hmin) && (hi <= m_hmax) &&
-            ((hStart - hi) * (hEnd - hi) < 0)) {
+        if ((hi >= m_hmin) && (hi <= m_hmax)) {
           // if hi is between hStart and hEnd, then ki and li will be between
           // kStart, kEnd and lStart, lEnd and momi will be between m_kiMin and
           // KnincidemtmMax
@@ -677,10 +678,11 @@ void MDNormSCD::calculateIntersections(
     double fh = (hEnd - hStart) / (kEnd - kStart);
     double fl = (lEnd - lStart) / (kEnd - kStart);
     if (!m_kIntegrated) {
-      for (size_t i = 0; i < kNBins; i++) {
+      // only the planes between kStart and kEnd can be crossed
+      const auto planes = planesBetween(m_kX, kStart, kEnd);
+      for (size_t i = planes.first; i < planes.second; i++) {
         double ki = m_kX[i];
-        if ((ki >= m_kmin) && (ki <= m_kmax) &&
-            ((kStart - ki) * (kEnd - ki) < 0)) {
+        if ((ki >= m_kmin) && (ki <= m_kmax)) {
           // if ki is between kStart and kEnd, then hi and li will be between
           // hStart, hEnd and lStart, lEnd
           double hi = fh * (ki - kStart) + hStart;
@@ -722,10 +724,11 @@ void MDNormSCD::calculateIntersections(
     double fh = (hEnd - hStart) / (lEnd - lStart);
     double fk = (kEnd - kStart) / (lEnd - lStart);
     if (!m_lIntegrated) {
-      for (size_t i = 0; i < lNBins; i++) {
+      // only the planes between lStart and lEnd can be crossed
+      const auto planes = planesBetween(m_lX, lStart, lEnd);
+      for (size_t i = planes.first; i < planes.second; i++) {
         double li = m_lX[i];
-        if ((li >= m_lmin) && (li <= m_lmax) &&
-            ((lStart - li) * (lEnd - li) < 0)) {
+        if ((li >= m_lmin) && (li <= m_lmax)) {
           // if li is between lStart and lEnd, then hi and ki will be between
           // hStart, hEnd and kStart, kEnd
           double hi = fh * (li - lStart) + hStart;
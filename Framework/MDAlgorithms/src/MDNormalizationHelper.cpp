@@ -0,0 +1,27 @@
+#include "MantidMDAlgorithms/MDNormalizationHelper.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/**
+ * Find the planes lying strictly between two positions along an axis.
+ * @param planes :: the positions of the planes, in increasing order
+ * @param start :: one end of the segment
+ * @param end :: the other end of the segment
+ * @return the range [first, last) of the indices of the planes
+ */
+std::pair<size_t, size_t> planesBetween(const std::vector<double> &planes,
+                                        const double start, const double end) {
+  const auto low = std::min(start, end);
+  const auto high = std::max(start, end);
+  const auto first = std::upper_bound(planes.begin(), planes.end(), low);
+  const auto last = std::lower_bound(first, planes.end(), high);
+  return {static_cast<size_t>(std::distance(planes.begin(), first)),
+          static_cast<size_t>(std::distance(planes.begin(), last))};
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
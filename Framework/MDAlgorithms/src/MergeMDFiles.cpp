@@ -5,8 +5,10 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/Timer.h"
 #include "MantidKernel/VectorHelper.h"
 
 #include <Poco/File.h>
@@ -22,12 +24,18 @@ namespace MDAlgorithms {
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(MergeMDFiles)
 
+namespace {
+/// Largest number of events merged at once, unless a single box has more
+const uint64_t EVENTS_PER_MERGE = 10000000;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
 MergeMDFiles::MergeMDFiles()
     : m_nDims(0), m_MDEventType(), m_fileBasedTargetWS(false), m_Filenames(),
       m_EventLoader(), m_OutIWS(), m_totalEvents(0), m_totalLoaded(0),
+      m_bytesRead(0), m_bytesWritten(0), m_readTime(0), m_writeTime(0),
       m_fileMutex(), m_statsMutex() {}
 
 //----------------------------------------------------------------------------------------------
@@ -54,8 +62,9 @@ void MergeMDFiles::init() {
       "If not, it will be created in memory.");
 
   declareProperty("Parallel", false,
-                  "Run the loading tasks in parallel.\n"
-                  "This can be faster but might use more memory.");
+                  "Merge the events of the boxes in parallel.\n"
+                  "The files are still read and written one block at a "
+                  "time.");
 
   declareProperty(make_unique<WorkspaceProperty<IMDEventWorkspace>>(
                       "OutputWorkspace", "", Direction::Output),
@@ -147,39 +156,162 @@ void MergeMDFiles::loadBoxData() {
                  << " files.\n";
 }
 
-/** Task that loads all of the events from corresponded boxes of all files
-  * that is being merged into a particular box in the output workspace.
-*/
-
-uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
-  /// get rid of the events and averages which are in the memory erroneously
-  /// (from cloning)
-  TargetBox->clear();
-
-  uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
+/** Merge the events of a run of boxes of the output workspace from all input
+ * files.
+ *
+ * The files are read one at a time, in as few blocks as possible: the events
+ * of consecutive boxes, stored one after the other in a file, are read at
+ * once. The events of each box are then gathered from the blocks, in parallel
+ * if requested. The NeXus files are not accessed concurrently, as the NeXus
+ * library is not thread-safe.
+ *
+ * @param boxes :: the boxes (no grid boxes) to merge, in the order of the
+ *boxes of the workspace
+ * @param parallel :: gather the events of the boxes in parallel
+ */
+void MergeMDFiles::mergeBoxes(const std::vector<API::IMDNode *> &boxes,
+                              const bool parallel) {
+  const size_t numBoxes = boxes.size();
+  const size_t numFiles = m_EventLoader.size();
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+
+  // Blocks read from the files, and the start of the events of each box of
+  // each file in these blocks
+  std::vector<std::vector<coord_t>> blocks;
+  std::vector<const coord_t *> fileEvents(numFiles * numBoxes, nullptr);
+  size_t numColumns = 0;
+
+  Kernel::Timer readTimer;
+  for (size_t iw = 0; iw < numFiles; iw++) {
+    const std::vector<uint64_t> &eventIndex =
+        m_fileComponentsStructure[iw].getEventIndex();
+    size_t first = 0;
+    while (first < numBoxes) {
+      // Find the boxes stored one after the other in this file
+      const uint64_t position = eventIndex[2 * boxes[first]->getID()];
+      uint64_t numEvents = eventIndex[2 * boxes[first]->getID() + 1];
+      size_t last = first + 1;
+      for (; last < numBoxes; last++) {
+        const size_t ID = boxes[last]->getID();
+        if (eventIndex[2 * ID] != position + numEvents)
+          break;
+        numEvents += eventIndex[2 * ID + 1];
+      }
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
+      if (numEvents > 0) {
+        // Moving the vector of blocks does not move the data of the blocks
+        blocks.emplace_back();
+        m_EventLoader[iw]->loadBlock(blocks.back(), position,
+                                     static_cast<size_t>(numEvents));
+        numColumns = blocks.back().size() / numEvents;
+        m_bytesRead += blocks.back().size() * sizeof(coord_t);
+
+        const coord_t *events = blocks.back().data();
+        for (size_t ib = first; ib < last; ib++) {
+          fileEvents[iw * numBoxes + ib] = events;
+          events += eventIndex[2 * boxes[ib]->getID() + 1] * numColumns;
+        }
+      }
+      first = last;
+    }
   }
+  m_readTime += readTimer.elapsed();
+
+  // Gather the events of each box from all files
+  std::vector<std::vector<coord_t>> boxEvents(numBoxes);
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t ib = 0; ib < static_cast<int64_t>(numBoxes); ib++) {
+    const size_t ID = boxes[ib]->getID();
+    std::vector<coord_t> &events = boxEvents[ib];
+    events.reserve(targetEventIndexes[2 * ID + 1] * numColumns);
+    for (size_t iw = 0; iw < numFiles; iw++) {
+      const coord_t *first = fileEvents[iw * numBoxes + ib];
+      if (!first)
+        continue;
+      const uint64_t numEvents =
+          m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1];
+      events.insert(events.end(), first, first + numEvents * numColumns);
+    }
 
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
+    if (!m_fileBasedTargetWS && !events.empty()) {
+      boxes[ib]->setEventsData(events);
+      std::vector<coord_t>().swap(events);
+    } else {
+      // The box keeps no events in memory, only their totals
+      double totalSignal(0), totalErrSq(0);
+      for (size_t i = 0; i < events.size(); i += numColumns) {
+        totalSignal += events[i];
+        totalErrSq += events[i + 1];
+      }
+      boxes[ib]->setSignal(static_cast<signal_t>(totalSignal));
+      boxes[ib]->setErrorSquared(static_cast<signal_t>(totalErrSq));
+    }
+  }
+  blocks.clear();
+
+  for (size_t ib = 0; ib < numBoxes; ib++)
+    m_totalLoaded += targetEventIndexes[2 * boxes[ib]->getID() + 1];
+  if (!m_fileBasedTargetWS)
+    return;
+
+  // Write the boxes, stored one after the other in the output file, at once
+  Kernel::Timer writeTimer;
+  API::IBoxControllerIO *saver = m_OutIWS->getBoxController()->getFileIO();
+  std::vector<coord_t> block;
+  size_t first = 0;
+  while (first < numBoxes) {
+    const uint64_t position = targetEventIndexes[2 * boxes[first]->getID()];
+    uint64_t numEvents = 0;
+    size_t last = first;
+    for (; last < numBoxes; last++) {
+      const size_t ID = boxes[last]->getID();
+      if (targetEventIndexes[2 * ID] != position + numEvents)
+        break;
+      numEvents += targetEventIndexes[2 * ID + 1];
+    }
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
-      continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+    if (numEvents > 0) {
+      block.clear();
+      block.reserve(numEvents * numColumns);
+      for (size_t ib = first; ib < last; ib++) {
+        block.insert(block.end(), boxEvents[ib].begin(), boxEvents[ib].end());
+        std::vector<coord_t>().swap(boxEvents[ib]);
+        const size_t ID = boxes[ib]->getID();
+        if (targetEventIndexes[2 * ID + 1] > 0)
+          boxes[ib]->getISaveable()->setFilePosition(
+              targetEventIndexes[2 * ID],
+              static_cast<size_t>(targetEventIndexes[2 * ID + 1]), true);
+      }
+      saver->saveBlock(block, position);
+      m_bytesWritten += block.size() * sizeof(coord_t);
+    }
+    first = last;
   }
+  m_writeTime += writeTimer.elapsed();
+}
 
-  return nBoxEvents;
+/** Log the rates of merging, reading and writing the events.
+ *
+ * @param seconds :: the time it took to merge all the boxes
+ */
+void MergeMDFiles::reportThroughput(const double seconds) const {
+  // Rate of an amount over a time, 0 if no time was measured
+  auto rate = [](const double amount, const double time) {
+    return time > 0 ? amount / time : 0.;
+  };
+  const double megabytesRead = static_cast<double>(m_bytesRead) / 1048576.;
+  const double megabytesWritten =
+      static_cast<double>(m_bytesWritten) / 1048576.;
+
+  std::ostringstream report;
+  report << "Merged " << m_totalLoaded << " events in " << seconds << " s ("
+         << rate(static_cast<double>(m_totalLoaded), seconds)
+         << " events/s). Read " << megabytesRead << " MB ("
+         << rate(megabytesRead, m_readTime) << " MB/s)";
+  if (m_fileBasedTargetWS)
+    report << ", wrote " << megabytesWritten << " MB ("
+           << rate(megabytesWritten, m_writeTime) << " MB/s)";
+  g_log.notice() << report.str() << ".\n";
 }
 
 //----------------------------------------------------------------------------------------------
@@ -196,8 +328,7 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
+  const bool parallel = this->getProperty("Parallel");
 
   // Fix the box controller settings in the output workspace so that it splits
   // normally
@@ -218,10 +349,6 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
     bc->getFileIO()->setWriteBufferSize(400000000 / m_OutIWS->sizeofEvent());
   }
 
-  /*   else
-     {
-         saver->openFile(outputFile,"w");
-     }*/
   // Init box structure used for memory/file space calculations
   m_BoxStruct.initFlatStructure(ws, outputFile);
 
@@ -234,65 +361,48 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_progress = Kernel::make_unique<Progress>(this, 0.1, 0.9, size_t(numBoxes));
   m_progress->setNotifyStep(0.1);
 
-  // For tracking progress
-  // uint64_t m_totalEventsInTasks = 0;
-
-  // Prepare thread pool
   CPUTimer overallTime;
-
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
-  Kernel::DiskBuffer *DiskBuf(nullptr);
-  if (m_fileBasedTargetWS) {
-    DiskBuf = bc->getFileIO();
-  }
-
-  this->m_totalLoaded = 0;
+  Kernel::Timer mergeTimer;
+  m_totalLoaded = 0;
+  m_bytesRead = 0;
+  m_bytesWritten = 0;
+  m_readTime = 0;
+  m_writeTime = 0;
+
+  // Merge runs of consecutive boxes with up to EVENTS_PER_MERGE events
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
   std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
-
+  std::vector<API::IMDNode *> mergedBoxes;
+  uint64_t mergedEvents = 0;
   for (size_t ib = 0; ib < numBoxes; ib++) {
     auto box = boxes[ib];
-    if (!box->isBox())
+    if (!box->isBox()) {
+      m_progress->report("Loading and merging box data");
       continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    m_progress->reportIncrement(ib, "Loading and merging box data");
+    const uint64_t numEvents = targetEventIndexes[2 * box->getID() + 1];
+    if (!mergedBoxes.empty() && mergedEvents + numEvents > EVENTS_PER_MERGE) {
+      this->mergeBoxes(mergedBoxes, parallel);
+      m_progress->reportIncrement(mergedBoxes.size(),
+                                  "Loading and merging box data");
+      interruption_point();
+      mergedBoxes.clear();
+      mergedEvents = 0;
+    }
+    mergedBoxes.push_back(box);
+    mergedEvents += numEvents;
+  }
+  if (!mergedBoxes.empty()) {
+    this->mergeBoxes(mergedBoxes, parallel);
+    m_progress->reportIncrement(mergedBoxes.size(),
+                                "Loading and merging box data");
   }
-  if (DiskBuf) {
-    DiskBuf->flushCache();
+
+  if (m_fileBasedTargetWS) {
+    bc->getFileIO()->flushCache();
     bc->getFileIO()->flushData();
   }
-  //// Run any final tasks
-  // tp.joinAll();
+  reportThroughput(mergeTimer.elapsed());
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
@@ -3,6 +3,7 @@
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -127,7 +128,9 @@ void MinusMD::execEvent() {
 void MinusMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->subtract(*operand);
+  MDHistoExpression::minus(MDHistoExpression::workspace(out),
+                           MDHistoExpression::workspace(operand))
+      ->evaluate(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -135,7 +138,10 @@ void MinusMD::execHistoHisto(
 void MinusMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->subtract(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression::minus(
+      MDHistoExpression::workspace(out),
+      MDHistoExpression::scalar(scalar->y(0)[0], scalar->e(0)[0]))
+      ->evaluate(*out);
 }
 
 } // namespace Mantid
@@ -3,6 +3,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -111,7 +112,9 @@ void MultiplyMD::execEvent() {
 void MultiplyMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->multiply(*operand);
+  MDHistoExpression::multiply(MDHistoExpression::workspace(out),
+                              MDHistoExpression::workspace(operand))
+      ->evaluate(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -119,7 +122,10 @@ void MultiplyMD::execHistoHisto(
 void MultiplyMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->multiply(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression::multiply(
+      MDHistoExpression::workspace(out),
+      MDHistoExpression::scalar(scalar->y(0)[0], scalar->e(0)[0]))
+      ->evaluate(*out);
 }
 
 } // namespace Mantid
@@ -3,6 +3,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -141,7 +142,9 @@ void PlusMD::checkInputs() {
 void PlusMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->add(*operand);
+  MDHistoExpression::plus(MDHistoExpression::workspace(out),
+                          MDHistoExpression::workspace(operand))
+      ->evaluate(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -149,7 +152,10 @@ void PlusMD::execHistoHisto(
 void PlusMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->add(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression::plus(
+      MDHistoExpression::workspace(out),
+      MDHistoExpression::scalar(scalar->y(0)[0], scalar->e(0)[0]))
+      ->evaluate(*out);
 }
 
 //----------------------------------------------------------------------------------------------
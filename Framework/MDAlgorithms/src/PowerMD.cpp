@@ -1,8 +1,10 @@
 #include "MantidMDAlgorithms/PowerMD.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
+using Mantid::DataObjects::MDHistoExpression;
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -45,7 +47,8 @@ void PowerMD::execEvent(Mantid::API::IMDEventWorkspace_sptr /*out*/) {
 /// PowerMD::Run the algorithm with a MDHistoWorkspace
 void PowerMD::execHisto(Mantid::DataObjects::MDHistoWorkspace_sptr out) {
   double exponent = getProperty("Exponent");
-  out->power(exponent);
+  MDHistoExpression::power(MDHistoExpression::workspace(out), exponent)
+      ->evaluate(*out);
 }
 
 } // namespace Mantid
@@ -76,6 +76,16 @@ void SaveMD::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("MortonOrder", false,
+                  "For an MDEventWorkspace that is not saved yet:\n"
+                  "Write the events of the boxes along the Morton (Z-order) "
+                  "curve of the box centres rather than in the order of the "
+                  "box IDs, so that boxes close in space are close on file. "
+                  "LoadMD reads either order.");
+  setPropertySettings(
+      "MortonOrder",
+      make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -89,6 +99,7 @@ template <typename MDE, size_t nd>
 void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   bool updateFileBackend = getProperty("UpdateFileBackEnd");
   bool makeFileBackend = getProperty("MakeFileBacked");
+  bool mortonOrder = getProperty("MortonOrder");
   if (updateFileBackend && makeFileBackend)
     throw std::invalid_argument(
         "Please choose either UpdateFileBackEnd or MakeFileBacked, not both.");
@@ -169,7 +180,7 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       std::vector<API::IMDNode *> &boxes = BoxFlatStruct.getBoxes();
       // calculate the position of the boxes on file, indicating to make them
       // saveable and that the boxes were not saved.
-      BoxFlatStruct.setBoxesFilePositions(true);
+      BoxFlatStruct.setBoxesFilePositions(true, mortonOrder);
       prog->resetNumSteps(boxes.size(), 0.06, 0.90);
       for (auto &boxe : boxes) {
         auto saveableTag = boxe->getISaveable();
@@ -197,7 +208,7 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     } else // just save data, and finish with it
     {
       Saver->openFile(filename, "w");
-      BoxFlatStruct.setBoxesFilePositions(false);
+      BoxFlatStruct.setBoxesFilePositions(false, mortonOrder);
       std::vector<API::IMDNode *> &boxes = BoxFlatStruct.getBoxes();
       std::vector<uint64_t> &eventIndex = BoxFlatStruct.getEventIndex();
       prog->resetNumSteps(boxes.size(), 0.06, 0.90);
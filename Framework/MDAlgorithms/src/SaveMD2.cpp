@@ -64,6 +64,16 @@ void SaveMD2::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("MortonOrder", false,
+                  "For an MDEventWorkspace that is not saved yet:\n"
+                  "Write the events of the boxes along the Morton (Z-order) "
+                  "curve of the box centres rather than in the order of the "
+                  "box IDs, so that boxes close in space are close on file. "
+                  "LoadMD reads either order.");
+  setPropertySettings(
+      "MortonOrder",
+      make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -210,6 +220,7 @@ void SaveMD2::exec() {
                                 getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked",
                                 getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("MortonOrder", getProperty("MortonOrder"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
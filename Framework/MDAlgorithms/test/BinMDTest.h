@@ -103,6 +103,33 @@ public:
     TS_ASSERT(alg.isInitialized())
   }
 
+  /// Bin the fake data of BinMDTest_ws over a rotated or aligned grid
+  MDHistoWorkspace_sptr binFakeData(const bool axisAligned,
+                                    const bool parallel) {
+    BinMD alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+    if (axisAligned) {
+      alg.setPropertyValue("AlignedDim0", "Axis0,1.0,9.0, 40");
+      alg.setPropertyValue("AlignedDim1", "Axis1,1.0,9.0, 30");
+      alg.setPropertyValue("AlignedDim2", "Axis2,3.0,7.0, 1");
+    } else {
+      alg.setProperty("AxisAligned", false);
+      alg.setPropertyValue("BasisVector0", "OutX,m, 0.8,0.6,0");
+      alg.setPropertyValue("BasisVector1", "OutY,m, -0.6,0.8,0");
+      alg.setPropertyValue("OutputExtents", "0,8, -4,4");
+      alg.setPropertyValue("OutputBins", "40,40");
+    }
+    alg.setProperty("Parallel", parallel);
+    alg.setPropertyValue("OutputWorkspace", "BinMDTest_binned");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    auto out = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "BinMDTest_binned");
+    AnalysisDataService::Instance().remove("BinMDTest_binned");
+    return out;
+  }
+
   /** Test the algo
   * @param nameX : name of the axis
   * @param expected_signal :: how many events in each resulting bin
@@ -1004,6 +1031,31 @@ public:
                binned->allBasisNormalized());
   }
 
+  void test_parallel_matches_serial() {
+    auto in_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 0);
+    in_ws->getBoxController()->setSplitThreshold(100);
+    in_ws->splitAllIfNeeded(nullptr);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                      "BinMDTest_ws", "UniformParams", "50000",
+                                      "PeakParams", "20000, 4.2, 5.1, 6.3, 1");
+    for (const bool axisAligned : {true, false}) {
+      MDHistoWorkspace_sptr serial = binFakeData(axisAligned, false);
+      MDHistoWorkspace_sptr parallel = binFakeData(axisAligned, true);
+      TS_ASSERT(serial && parallel);
+      if (!serial || !parallel)
+        continue;
+      TS_ASSERT_EQUALS(parallel->getNPoints(), serial->getNPoints());
+      for (size_t i = 0; i < serial->getNPoints(); ++i) {
+        TS_ASSERT_DELTA(parallel->getSignalAt(i), serial->getSignalAt(i),
+                        1e-6);
+        TS_ASSERT_DELTA(parallel->getNumEventsAt(i), serial->getNumEventsAt(i),
+                        1e-6);
+      }
+    }
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+  }
+
   void test_filebackend_and_unrecognised_instrument() {
     // The algorithm should still successfully execute, even if the workspace is
     // file-backed and the named instrument doesn't exist
@@ -1125,7 +1177,8 @@ public:
     AnalysisDataService::Instance().remove("BinMDTest_ws");
   }
 
-  void do_test(std::string binParams, bool IterateEvents) {
+  void do_test(std::string binParams, bool IterateEvents,
+               bool parallel = false) {
     BinMD alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize())
     TS_ASSERT(alg.isInitialized())
@@ -1139,6 +1192,7 @@ public:
         alg.setPropertyValue("AlignedDim2", "Axis2," + binParams));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AlignedDim3", ""));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("IterateEvents", IterateEvents));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", "BinMDTest_ws_histo"));
     TS_ASSERT_THROWS_NOTHING(alg.execute();)
@@ -1155,6 +1209,10 @@ public:
       do_test("5.3,5.4, 60", true);
   }
 
+  void test_3D_60cube_IterateEvents_Parallel() {
+    do_test("2.0,8.0, 60", true, true);
+  }
+
   void test_3D_1cube_IterateEvents() {
     for (size_t i = 0; i < 1; i++)
       do_test("2.0,8.0, 1", true);
@@ -530,6 +530,79 @@ public:
     }
   }
 
+  void test_execute_filebackend_with_memory_budget() {
+    std::string file_name = "convert_to_md_budget_test_file.nxs";
+    if (Poco::File(file_name).exists())
+      Poco::File(file_name).remove();
+    {
+      // The memory budget only applies to event workspaces
+      auto to_events = AlgorithmManager::Instance().createUnmanaged(
+          "ConvertToEventWorkspace");
+      to_events->initialize();
+      to_events->setChild(true);
+      to_events->setProperty("InputWorkspace", createTestWorkspaces());
+      to_events->setPropertyValue("OutputWorkspace", "events");
+      to_events->execute();
+      Mantid::API::MatrixWorkspace_sptr test_workspace =
+          to_events->getProperty("OutputWorkspace");
+
+      auto convert = [&test_workspace](const std::string &file_name,
+                                       const int memory_budget) {
+        Algorithm_sptr convert_alg =
+            AlgorithmManager::Instance().createUnmanaged("ConvertToMD");
+        convert_alg->initialize();
+        convert_alg->setChild(true);
+        convert_alg->setProperty("InputWorkspace", test_workspace);
+        convert_alg->setProperty("QDimensions", "Q3D");
+        convert_alg->setProperty("QConversionScales", "HKL");
+        convert_alg->setProperty("dEAnalysisMode", "Direct");
+        convert_alg->setPropertyValue("MinValues", "-10,-10,-10,-3");
+        convert_alg->setPropertyValue("MaxValues", "10,10,10,3");
+        if (!file_name.empty()) {
+          convert_alg->setProperty("Filename", file_name);
+          convert_alg->setProperty("FileBackEnd", true);
+          convert_alg->setProperty("MemoryBudget", memory_budget);
+        }
+        convert_alg->setProperty("OutputWorkspace", "blank");
+        TS_ASSERT_THROWS_NOTHING(convert_alg->execute());
+        Mantid::API::IMDEventWorkspace_sptr out_ws =
+            convert_alg->getProperty("OutputWorkspace");
+        return out_ws;
+      };
+
+      // Act
+      auto out_ws = convert(file_name, 1);
+      auto reference_out_ws = convert("", 0);
+
+      // Assert
+      TS_ASSERT(out_ws);
+      TS_ASSERT(reference_out_ws);
+      // The scratch file of the spilled events is gone
+      TS_ASSERT(!Poco::File(file_name + ".spill").exists());
+      file_name = out_ws->getBoxController()->getFilename();
+      TS_ASSERT(out_ws->isFileBacked());
+      TS_ASSERT_EQUALS(out_ws->getNPoints(), reference_out_ws->getNPoints());
+
+      auto compare_alg =
+          Mantid::API::AlgorithmManager::Instance().createUnmanaged(
+              "CompareMDWorkspaces");
+      compare_alg->setChild(true);
+      compare_alg->initialize();
+      compare_alg->setProperty("Workspace1", out_ws);
+      compare_alg->setProperty("Workspace2", reference_out_ws);
+      compare_alg->setProperty("Tolerance", 0.00001);
+      compare_alg->setProperty("CheckEvents", true);
+      compare_alg->setProperty("IgnoreBoxID", true);
+      TS_ASSERT_THROWS_NOTHING(compare_alg->execute());
+      bool is_equal = compare_alg->getProperty("Equals");
+      TS_ASSERT(is_equal);
+    }
+
+    if (Poco::File(file_name).exists()) {
+      Poco::File(file_name).remove();
+    }
+  }
+
 private:
   void checkHistogramsHaveBeenStored(const std::string &wsName,
                                      double val = 0.34, double bin_min = 0.3,
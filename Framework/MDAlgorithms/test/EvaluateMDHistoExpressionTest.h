@@ -0,0 +1,159 @@
+#ifndef MANTID_MDALGORITHMS_EVALUATEMDHISTOEXPRESSIONTEST_H_
+#define MANTID_MDALGORITHMS_EVALUATEMDHISTOEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidMDAlgorithms/EvaluateMDHistoExpression.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using Mantid::MDAlgorithms::EvaluateMDHistoExpression;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::signal_t;
+
+class EvaluateMDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EvaluateMDHistoExpressionTest *createSuite() {
+    return new EvaluateMDHistoExpressionTest();
+  }
+  static void destroySuite(EvaluateMDHistoExpressionTest *suite) {
+    delete suite;
+  }
+
+  EvaluateMDHistoExpressionTest() {
+    m_a = makeWorkspace("exprA", 1.0);
+    m_b = makeWorkspace("exprB", 2.0);
+    m_c = makeWorkspace("exprC", 3.0);
+  }
+
+  ~EvaluateMDHistoExpressionTest() override {
+    AnalysisDataService::Instance().remove("exprA");
+    AnalysisDataService::Instance().remove("exprB");
+    AnalysisDataService::Instance().remove("exprC");
+  }
+
+  void test_Init() {
+    EvaluateMDHistoExpression alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_chain_creates_no_intermediate_workspace() {
+    const auto numWorkspaces = AnalysisDataService::Instance().size();
+    const signal_t a0 = m_a->getSignalAt(7);
+
+    auto out = runAlgorithm("log((exprA + exprB) * exprC / 2) - exprA^2");
+    TS_ASSERT(out);
+    if (!out)
+      return;
+    // Only the output was added, where PlusMD, MultiplyMD, DivideMD,
+    // LogarithmMD, PowerMD and MinusMD would have left five intermediates
+    TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(),
+                     numWorkspaces + 1);
+    TS_ASSERT_EQUALS(m_a->getSignalAt(7), a0);
+
+    // The same as the operations one at a time
+    MDHistoWorkspace_sptr expected(m_a->clone());
+    expected->add(*m_b);
+    expected->multiply(*m_c);
+    expected->divide(2.0, 0.0);
+    expected->log();
+    MDHistoWorkspace_sptr aSquared(m_a->clone());
+    aSquared->power(2.0);
+    expected->subtract(*aSquared);
+    checkEqual(*out, *expected);
+
+    AnalysisDataService::Instance().remove(OUT_NAME);
+  }
+
+  void test_numbers_unary_minus_and_exp() {
+    auto out = runAlgorithm("-exp(exprA) + 3 * exprB");
+    TS_ASSERT(out);
+    if (!out)
+      return;
+    MDHistoWorkspace_sptr expected(m_a->clone());
+    expected->exp();
+    expected->multiply(-1.0, 0.0);
+    MDHistoWorkspace_sptr b3(m_b->clone());
+    b3->multiply(3.0, 0.0);
+    expected->add(*b3);
+    checkEqual(*out, *expected);
+    AnalysisDataService::Instance().remove(OUT_NAME);
+  }
+
+  void test_invalid_expressions_fail() {
+    for (const std::string expression :
+         {"exprA + exprD", "(exprA + exprB", "exprA ^ exprB", "exprA +",
+          "sqrt(exprA)"}) {
+      EvaluateMDHistoExpression alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspaces", "exprA,exprB");
+      alg.setPropertyValue("Expression", expression);
+      alg.setPropertyValue("OutputWorkspace", OUT_NAME);
+      TS_ASSERT_THROWS_NOTHING(alg.execute());
+      TS_ASSERT(!alg.isExecuted());
+    }
+  }
+
+  void test_different_number_of_bins_fails() {
+    auto other = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        1.0, 2, 5, 10.0, 1.0, "exprSmall");
+    EvaluateMDHistoExpression alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspaces", "exprA,exprSmall");
+    alg.setPropertyValue("Expression", "exprA + exprSmall");
+    alg.setPropertyValue("OutputWorkspace", OUT_NAME);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(!alg.isExecuted());
+    AnalysisDataService::Instance().remove("exprSmall");
+  }
+
+private:
+  /// A 10x10 workspace with different values in each bin
+  MDHistoWorkspace_sptr makeWorkspace(const std::string &name,
+                                      const signal_t signal) {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(signal, 2, 10, 10.0,
+                                                           1.0, name);
+    for (size_t i = 0; i < ws->getNPoints(); ++i) {
+      ws->setSignalAt(i, signal + 0.1 * static_cast<signal_t>(i));
+      ws->setErrorSquaredAt(i, 0.01 * static_cast<signal_t>(i + 1));
+    }
+    return ws;
+  }
+
+  MDHistoWorkspace_sptr runAlgorithm(const std::string &expression) {
+    EvaluateMDHistoExpression alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("InputWorkspaces", "exprA,exprB,exprC"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Expression", expression));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", OUT_NAME));
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    if (!alg.isExecuted())
+      return MDHistoWorkspace_sptr();
+    return AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        OUT_NAME);
+  }
+
+  void checkEqual(const MDHistoWorkspace &out,
+                  const MDHistoWorkspace &expected) {
+    TS_ASSERT_EQUALS(out.getNPoints(), expected.getNPoints());
+    for (size_t i = 0; i < expected.getNPoints(); ++i) {
+      TS_ASSERT_DELTA(out.getSignalAt(i), expected.getSignalAt(i), 1e-10);
+      TS_ASSERT_DELTA(out.getErrorSquaredArray()[i],
+                      expected.getErrorSquaredArray()[i], 1e-10);
+    }
+  }
+
+  const std::string OUT_NAME = "EvaluateMDHistoExpressionTest_out";
+  MDHistoWorkspace_sptr m_a;
+  MDHistoWorkspace_sptr m_b;
+  MDHistoWorkspace_sptr m_c;
+};
+
+#endif /* MANTID_MDALGORITHMS_EVALUATEMDHISTOEXPRESSIONTEST_H_ */
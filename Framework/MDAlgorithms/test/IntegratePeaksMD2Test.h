@@ -5,7 +5,9 @@
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/Run.h"
+#include "MantidDataObjects/CoordTransformDistance.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDSphereIntegrator.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
@@ -36,6 +38,8 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::Geometry;
 using namespace Mantid::MDAlgorithms;
 using Mantid::Kernel::V3D;
+using Mantid::coord_t;
+using Mantid::signal_t;
 
 class IntegratePeaksMD2Test : public CxxTest::TestSuite {
 public:
@@ -54,7 +58,7 @@ public:
                     std::string OutputWorkspace = "IntegratePeaksMD2Test_peaks",
                     double BackgroundStartRadius = 0.0, bool edge = true,
                     bool cyl = false, std::string fnct = "NoFit",
-                    double adaptive = 0.0) {
+                    double adaptive = 0.0, bool compact = false) {
     IntegratePeaksMD2 alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize())
     TS_ASSERT(alg.isInitialized())
@@ -78,6 +82,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("AdaptiveQMultiplier", adaptive));
     if (adaptive > 0.0)
       TS_ASSERT_THROWS_NOTHING(alg.setProperty("AdaptiveQBackground", true));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("UseCompactLayout", compact));
     TS_ASSERT_THROWS_NOTHING(alg.execute());
     TS_ASSERT(alg.isExecuted());
   }
@@ -369,6 +374,42 @@ public:
                          peakWS->getPeak(0).getIntensity(), 1500);
   }
 
+  /// The compact layout gives the same intensities as the box tree
+  void test_exec_shellBackground_compactLayout() {
+    createMDEW();
+    addPeak(1000, 0., 0., 0., 1.0);
+    addPeak(1000 * 4, 0., 0., 0., 2.0);
+    addPeak(1000 * 9, 0., 0., 0., 3.0);
+    addPeak(1000, 4., 4., 4., 0.5);
+
+    PeaksWorkspace_sptr peakWS(new PeaksWorkspace());
+    Instrument_sptr inst =
+        ComponentCreationHelper::createTestInstrumentCylindrical(5);
+    peakWS->addPeak(Peak(inst, 1, 1.0, V3D(0., 0., 0.)));
+    peakWS->addPeak(Peak(inst, 1, 1.0, V3D(4., 4., 4.)));
+    AnalysisDataService::Instance().addOrReplace("IntegratePeaksMD2Test_peaks",
+                                                 peakWS);
+
+    for (const double innerRadius : {0.0, 2.0}) {
+      doRun(1.0, 3.0, "IntegratePeaksMD2Test_peaks", innerRadius);
+      std::vector<double> intensities, sigmas;
+      for (int i = 0; i < peakWS->getNumberPeaks(); ++i) {
+        intensities.push_back(peakWS->getPeak(i).getIntensity());
+        sigmas.push_back(peakWS->getPeak(i).getSigmaIntensity());
+      }
+
+      doRun(1.0, 3.0, "IntegratePeaksMD2Test_peaks", innerRadius, true, false,
+            "NoFit", 0.0, true);
+      for (int i = 0; i < peakWS->getNumberPeaks(); ++i) {
+        TS_ASSERT_DELTA(peakWS->getPeak(i).getIntensity(), intensities[i],
+                        1e-3);
+        TS_ASSERT_DELTA(peakWS->getPeak(i).getSigmaIntensity(), sigmas[i],
+                        1e-3);
+      }
+    }
+    TS_ASSERT_DELTA(peakWS->getPeak(1).getIntensity(), 1000.0, 1e-2);
+  }
+
   void test_writes_out_selected_algorithm_parameters() {
     createMDEW();
     const double peakRadius = 2;
@@ -535,6 +576,58 @@ public:
       IntegratePeaksMD2Test::doRun(0.02, 0.03);
     }
   }
+
+  /// The sphere integration through the virtual MDBoxBase::integrateSphere()
+  void test_performance_integrateSphere_virtual() {
+    auto ws = AnalysisDataService::Instance().retrieveWS<MDEventWorkspace3Lean>(
+        "IntegratePeaksMD2Test_MDEWS");
+    for (size_t run = 0; run < 10; ++run) {
+      for (size_t i = 0; i < numPeaks; ++i)
+        integrateSphereVirtual(*ws, i);
+    }
+  }
+
+  /// The same integration through the templated MDSphereIntegrator
+  void test_performance_integrateSphere_templated() {
+    auto ws = AnalysisDataService::Instance().retrieveWS<MDEventWorkspace3Lean>(
+        "IntegratePeaksMD2Test_MDEWS");
+    std::vector<double> signals(numPeaks, 0.0);
+    bool dimensionsUsed[3] = {true, true, true};
+    for (size_t run = 0; run < 10; ++run) {
+      for (size_t i = 0; i < numPeaks; ++i) {
+        const V3D pos = peakWS->getPeak(int(i)).getHKL();
+        coord_t center[3] = {static_cast<coord_t>(pos.X()),
+                             static_cast<coord_t>(pos.Y()),
+                             static_cast<coord_t>(pos.Z())};
+        MDSphereIntegrator<MDLeanEvent<3>, 3> sphere(center, dimensionsUsed);
+        signal_t signal = 0;
+        signal_t errorSquared = 0;
+        sphere.integrate(ws->getBox(), 0.02f * 0.02f, signal, errorSquared);
+        signals[i] = signal;
+      }
+    }
+    // Same intensities as through the virtual integration
+    for (size_t i = 0; i < numPeaks; ++i) {
+      const signal_t expected = integrateSphereVirtual(*ws, i);
+      TS_ASSERT_DELTA(signals[i], expected, 1e-6 * (1.0 + expected));
+    }
+  }
+
+private:
+  /// @return the intensity of a peak through MDBoxBase::integrateSphere()
+  signal_t integrateSphereVirtual(MDEventWorkspace3Lean &ws,
+                                  const size_t peak) {
+    const V3D pos = peakWS->getPeak(int(peak)).getHKL();
+    coord_t center[3] = {static_cast<coord_t>(pos.X()),
+                         static_cast<coord_t>(pos.Y()),
+                         static_cast<coord_t>(pos.Z())};
+    bool dimensionsUsed[3] = {true, true, true};
+    CoordTransformDistance sphere(3, center, dimensionsUsed);
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    ws.getBox()->integrateSphere(sphere, 0.02f * 0.02f, signal, errorSquared);
+    return signal;
+  }
 };
 
 #endif /* MANTID_MDEVENTS_MDEWPEAKINTEGRATION2TEST_H_ */
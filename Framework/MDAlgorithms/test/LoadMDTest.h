@@ -170,7 +170,8 @@ public:
   //=================================================================================================================
   template <size_t nd>
   void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true,
-                    double memory = 0, bool BoxStructureOnly = false) {
+                    double memory = 0, bool BoxStructureOnly = false,
+                    bool MortonOrder = false) {
     using MDE = MDLeanEvent<nd>;
 
     //------ Start by creating the file
@@ -203,6 +204,7 @@ public:
         saver.setProperty("InputWorkspace", "LoadMDTest_ws"));
     TS_ASSERT_THROWS_NOTHING(saver.setPropertyValue(
         "Filename", "LoadMDTest" + Strings::toString(nd) + ".nxs"));
+    TS_ASSERT_THROWS_NOTHING(saver.setProperty("MortonOrder", MortonOrder));
 
     // Retrieve the full path; delete any pre-existing file
     std::string filename = saver.getPropertyValue("Filename");
@@ -421,6 +423,16 @@ public:
     do_test_exec<3>(false, true, 0.0, true);
   }
 
+  /// Load directly to memory a file saved with the boxes in Morton order
+  void test_exec_3D_MortonOrder() {
+    do_test_exec<3>(false, true, 0.0, false, true);
+  }
+
+  /// Load on demand a file saved with the boxes in Morton order
+  void test_exec_3D_MortonOrder_with_FileBackEnd() {
+    do_test_exec<3>(true, true, 0.0, false, true);
+  }
+
   //=================================================================================================================
 
   void testMetaDataOnly() {
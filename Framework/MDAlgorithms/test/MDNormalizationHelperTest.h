@@ -0,0 +1,45 @@
+#ifndef MANTID_MDALGORITHMS_MDNORMALIZATIONHELPERTEST_H_
+#define MANTID_MDALGORITHMS_MDNORMALIZATIONHELPERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidMDAlgorithms/MDNormalizationHelper.h"
+
+using Mantid::MDAlgorithms::planesBetween;
+
+class MDNormalizationHelperTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormalizationHelperTest *createSuite() {
+    return new MDNormalizationHelperTest();
+  }
+  static void destroySuite(MDNormalizationHelperTest *suite) { delete suite; }
+
+  void test_planesBetween_finds_the_planes_strictly_inside() {
+    const std::vector<double> planes{0.0, 1.0, 2.0, 3.0, 4.0};
+    TS_ASSERT_EQUALS(planesBetween(planes, 0.5, 3.5),
+                     std::make_pair(size_t(1), size_t(4)));
+    // The planes at the ends are excluded
+    TS_ASSERT_EQUALS(planesBetween(planes, 1.0, 3.0),
+                     std::make_pair(size_t(2), size_t(3)));
+  }
+
+  void test_planesBetween_does_not_depend_on_the_direction() {
+    const std::vector<double> planes{0.0, 1.0, 2.0, 3.0, 4.0};
+    TS_ASSERT_EQUALS(planesBetween(planes, 3.5, 0.5),
+                     planesBetween(planes, 0.5, 3.5));
+  }
+
+  void test_planesBetween_gives_an_empty_range_outside_the_planes() {
+    const std::vector<double> planes{0.0, 1.0, 2.0};
+    const auto below = planesBetween(planes, -2.0, -1.0);
+    TS_ASSERT_EQUALS(below.first, below.second);
+    const auto above = planesBetween(planes, 2.5, 5.0);
+    TS_ASSERT_EQUALS(above.first, above.second);
+    const auto between = planesBetween(planes, 1.2, 1.8);
+    TS_ASSERT_EQUALS(between.first, between.second);
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_MDNORMALIZATIONHELPERTEST_H_ */
@@ -27,7 +27,13 @@ public:
 
   void test_exec_fileBacked() { do_test_exec("MergeMDFilesTest_OutputWS.nxs"); }
 
-  void do_test_exec(std::string OutputFilename) {
+  void test_exec_parallel() { do_test_exec("", true); }
+
+  void test_exec_fileBacked_parallel() {
+    do_test_exec("MergeMDFilesTest_OutputWS.nxs", true);
+  }
+
+  void do_test_exec(std::string OutputFilename, bool parallel = false) {
     if (OutputFilename != "") {
       if (Poco::File(OutputFilename).exists())
         Poco::File(OutputFilename).remove();
@@ -41,6 +47,7 @@ public:
     std::vector<MDEventWorkspace3Lean::sptr> inWorkspaces;
     // how many events put into each file.
     long nFileEvents(1000);
+    double totalSignal(0);
     for (size_t i = 0; i < 3; i++) {
       std::ostringstream mess;
       mess << "MergeMDFilesTestInput" << i;
@@ -48,6 +55,7 @@ public:
           MDAlgorithmsTestHelper::makeFileBackedMDEWwithMDFrame(
               mess.str(), true, frame, -nFileEvents, appliedCoord);
       inWorkspaces.push_back(ws);
+      totalSignal += ws->getBox()->getSignal();
       filenames.push_back(
           std::vector<std::string>(1, ws->getBoxController()->getFilename()));
     }
@@ -63,6 +71,7 @@ public:
         alg.setPropertyValue("OutputFilename", OutputFilename));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
 
     // clean up possible rubbish from previous runs
     std::string fullName = alg.getPropertyValue("OutputFilename");
@@ -88,6 +97,7 @@ public:
     TS_ASSERT_EQUALS(ws->getNPoints(), 3 * nFileEvents);
     MDBoxBase3Lean *box = ws->getBox();
     TS_ASSERT_EQUALS(box->getNumChildren(), 1000);
+    TS_ASSERT_DELTA(box->getSignal(), totalSignal, 1e-3);
 
     // Every sub-box has on average 30 events (there are 1000 boxes)
     // Check that each box has at least SOMETHING
@@ -304,7 +304,14 @@ int NexusFileIO::writeNexusProcessedData2D(
   const size_t nHist = localworkspace->getNumberHistograms();
   if (nHist < 1)
     return (2);
-  const size_t nSpectBins = localworkspace->y(0).size();
+  // The values of a Workspace2D held in single precision are written as such
+  const auto workspace2D =
+      boost::dynamic_pointer_cast<const Workspace2D>(localworkspace);
+  const bool singlePrecision =
+      workspace2D && workspace2D->isSinglePrecision();
+  const size_t nSpectBins = singlePrecision
+                                ? workspace2D->getSpectrum(0).size()
+                                : localworkspace->y(0).size();
   const size_t nSpect = spec.size();
   int dims_array[2] = {static_cast<int>(nSpect), static_cast<int>(nSpectBins)};
 
@@ -342,13 +349,20 @@ int NexusFileIO::writeNexusProcessedData2D(
 
   // -------------- Actually write the 2D data ----------------------------
   if (write2Ddata) {
+    const int valuesType = singlePrecision ? NX_FLOAT32 : NX_FLOAT64;
+    std::vector<float> singleValues;
     std::string name = "values";
-    NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
+    NXcompmakedata(fileID, name.c_str(), valuesType, 2, dims_array,
                    m_nexuscompression, asize);
     NXopendata(fileID, name.c_str());
     for (size_t i = 0; i < nSpect; i++) {
       int s = spec[i];
-      NXputslab(fileID, localworkspace->y(s).rawData().data(), start, asize);
+      if (singlePrecision) {
+        workspace2D->getSpectrum(s).copySinglePrecisionY(singleValues);
+        NXputslab(fileID, singleValues.data(), start, asize);
+      } else {
+        NXputslab(fileID, localworkspace->y(s).rawData().data(), start, asize);
+      }
       start[0]++;
     }
     if (m_progress != nullptr)
@@ -369,13 +383,18 @@ int NexusFileIO::writeNexusProcessedData2D(
 
     // error
     name = "errors";
-    NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
+    NXcompmakedata(fileID, name.c_str(), valuesType, 2, dims_array,
                    m_nexuscompression, asize);
     NXopendata(fileID, name.c_str());
     start[0] = 0;
     for (size_t i = 0; i < nSpect; i++) {
       int s = spec[i];
-      NXputslab(fileID, localworkspace->e(s).rawData().data(), start, asize);
+      if (singlePrecision) {
+        workspace2D->getSpectrum(s).copySinglePrecisionE(singleValues);
+        NXputslab(fileID, singleValues.data(), start, asize);
+      } else {
+        NXputslab(fileID, localworkspace->e(s).rawData().data(), start, asize);
+      }
       start[0]++;
     }
 
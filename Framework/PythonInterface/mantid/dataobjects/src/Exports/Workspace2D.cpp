@@ -173,7 +173,14 @@ boost::shared_ptr<Mantid::API::Workspace> makeWorkspace2D() {
 void export_Workspace2D() {
   class_<Workspace2D, bases<MatrixWorkspace>, boost::noncopyable>("Workspace2D")
       .def_pickle(Workspace2DPickleSuite())
-      .def("__init__", boost::python::make_constructor(&makeWorkspace2D));
+      .def("__init__", boost::python::make_constructor(&makeWorkspace2D))
+      .def("setSinglePrecision", &Workspace2D::setSinglePrecision,
+           (arg("self"), arg("singlePrecision")),
+           "Hold the Y and E values in single precision, or back in double "
+           "precision. Spectra whose values are changed are widened back to "
+           "double precision.")
+      .def("isSinglePrecision", &Workspace2D::isSinglePrecision, arg("self"),
+           "Returns True if the Y and E values are held in single precision");
 
   // register pointers
   RegisterWorkspacePtrToPython<Workspace2D>();
@@ -0,0 +1,47 @@
+# pylint: disable=invalid-name, too-many-public-methods
+from __future__ import (absolute_import, division, print_function)
+
+import os
+import unittest
+
+from mantid.kernel import config
+from mantid.simpleapi import CreateWorkspace, DeleteWorkspace, LoadNexusProcessed, SaveNexusProcessed
+
+
+class Workspace2DTest(unittest.TestCase):
+    def setUp(self):
+        self.ws = CreateWorkspace(DataX=[1., 2., 3.], DataY=[4., 9.], DataE=[2., 3.],
+                                  OutputWorkspace='ws')
+
+    def tearDown(self):
+        DeleteWorkspace(self.ws)
+
+    def test_single_precision_is_off_by_default(self):
+        self.assertFalse(self.ws.isSinglePrecision())
+
+    def test_set_single_precision_keeps_values(self):
+        self.ws.setSinglePrecision(True)
+        self.assertTrue(self.ws.isSinglePrecision())
+        self.assertEqual(list(self.ws.readY(0)), [4., 9.])
+        self.assertEqual(list(self.ws.readE(0)), [2., 3.])
+        self.ws.setSinglePrecision(False)
+        self.assertFalse(self.ws.isSinglePrecision())
+
+    def test_load_single_precision_is_an_opt_in(self):
+        self.ws.setSinglePrecision(True)
+        filename = os.path.join(config['defaultsave.directory'], 'Workspace2DTest_single.nxs')
+        SaveNexusProcessed(InputWorkspace=self.ws, Filename=filename)
+        try:
+            loaded = LoadNexusProcessed(Filename=filename, OutputWorkspace='loaded')
+            self.assertFalse(loaded.isSinglePrecision())
+            DeleteWorkspace(loaded)
+            loaded = LoadNexusProcessed(Filename=filename, SinglePrecision=True, OutputWorkspace='loaded')
+            self.assertTrue(loaded.isSinglePrecision())
+            self.assertEqual(list(loaded.readY(0)), [4., 9.])
+            DeleteWorkspace(loaded)
+        finally:
+            os.remove(filename)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -86,6 +86,8 @@ public:
 
   // Auxiliary functions (non-virtual, used at testing)
   int64_t getNDataColums() const { return 2; }
+  /// @return the number of calls to loadBlock
+  size_t getNumBlocksLoaded() const { return m_numBlocksLoaded; }
 
 private:
   /// full file name (with path) of the Nexis file responsible for the IO
@@ -108,6 +110,8 @@ private:
   bool m_ReadOnly;
   /// identified of the file state, if it is open or not.
   bool m_isOpened;
+  /// number of calls to loadBlock
+  mutable size_t m_numBlocksLoaded;
 };
 }
 #endif
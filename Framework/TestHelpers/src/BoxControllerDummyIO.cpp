@@ -21,7 +21,7 @@ namespace MantidTestHelpers {
 */
 BoxControllerDummyIO::BoxControllerDummyIO(const Mantid::API::BoxController *bc)
     : m_bc(bc), m_CoordSize(4), m_TypeName("MDEvent"), m_ReadOnly(true),
-      m_isOpened(false) {
+      m_isOpened(false), m_numBlocksLoaded(0) {
   m_EventSize = static_cast<unsigned int>(bc->getNDims() + 4);
 }
 
@@ -156,6 +156,7 @@ void BoxControllerDummyIO::loadBlock(std::vector<float> &Block,
     throw Mantid::Kernel::Exception::FileError(
         "Attemtp to read behind the file end", m_fileName);
 
+  ++m_numBlocksLoaded;
   Block.resize(nPoints * m_EventSize);
   for (size_t i = 0; i < nPoints * m_EventSize; i++) {
     Block[i] = fileContents[blockPosition * m_EventSize + i];